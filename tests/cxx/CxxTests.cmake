@@ -77,3 +77,21 @@ macro(create_test_executable name)
   endforeach()
 endmacro()
 
+
+macro(add_cxx_benchmark name)
+  set(_benchmark_src ${name}Benchmark.cxx)
+  set(_executable_name "benchmark${name}")
+  add_executable(${_executable_name} ${_benchmark_src})
+  target_link_libraries(${_executable_name} tomvizlib)
+  # Need to set this property so that in stack traces, tomviz symbols
+  # can be resolved.
+  set_target_properties(${_executable_name} PROPERTIES ENABLE_EXPORTS TRUE)
+
+  # Benchmarks are only built with ENABLE_BENCHMARKS, and then a plain ctest
+  # runs them too. Their label selects them, "ctest -L benchmark", or skips
+  # them, "ctest -LE benchmark".
+  add_test(NAME "benchmark_${name}" COMMAND ${_executable_name} ${ARGN})
+  set_tests_properties("benchmark_${name}" PROPERTIES
+    LABELS benchmark
+    TIMEOUT 3600)
+endmacro()
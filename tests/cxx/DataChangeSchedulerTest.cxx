@@ -0,0 +1,141 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <QApplication>
+#include <QSignalSpy>
+#include <QStringList>
+#include <QTest>
+
+#include <pqApplicationCore.h>
+#include <pqObjectBuilder.h>
+#include <pqPVApplicationCore.h>
+#include <pqServerResource.h>
+
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+#include "DataChangeScheduler.h"
+#include "DataSource.h"
+#include "Pipeline.h"
+
+using namespace tomviz;
+
+class DataChangeSchedulerTest : public QObject
+{
+  Q_OBJECT
+
+private:
+  DataSource* createDataSource()
+  {
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(2, 2, 2);
+    image->AllocateScalars(VTK_FLOAT, 1);
+    return new DataSource(image);
+  }
+
+private slots:
+  void coalescesRepeatedChanges()
+  {
+    auto* ds = createDataSource();
+    QSignalSpy changedSpy(ds, &DataSource::dataChanged);
+    QSignalSpy propertiesSpy(ds, &DataSource::dataPropertiesChanged);
+
+    auto& scheduler = DataChangeScheduler::instance();
+    for (int i = 0; i < 10; ++i) {
+      scheduler.schedule(ds, false);
+    }
+    // Nothing is delivered synchronously
+    QCOMPARE(changedSpy.count(), 0);
+
+    QVERIFY(changedSpy.wait(1000));
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(propertiesSpy.count(), 0);
+
+    delete ds;
+  }
+
+  void mergesPropertiesChanged()
+  {
+    auto* ds = createDataSource();
+    QSignalSpy changedSpy(ds, &DataSource::dataChanged);
+    QSignalSpy propertiesSpy(ds, &DataSource::dataPropertiesChanged);
+
+    auto& scheduler = DataChangeScheduler::instance();
+    scheduler.schedule(ds, false);
+    scheduler.schedule(ds, true);
+    scheduler.flush();
+
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(propertiesSpy.count(), 1);
+
+    delete ds;
+  }
+
+  void marksDataModified()
+  {
+    auto* ds = createDataSource();
+    auto* data = ds->dataObject();
+    auto mtime = data->GetMTime();
+
+    DataChangeScheduler::instance().schedule(ds, false);
+    QCOMPARE(data->GetMTime(), mtime);
+    DataChangeScheduler::instance().flush();
+    QVERIFY(data->GetMTime() > mtime);
+
+    delete ds;
+  }
+
+  void notifiesBeforeExecuting()
+  {
+    auto* ds = createDataSource();
+    auto* pipeline = new Pipeline(ds);
+    QStringList events;
+    connect(ds, &DataSource::dataChanged,
+            [&events]() { events << "dataChanged"; });
+    connect(pipeline, &Pipeline::started,
+            [&events]() { events << "started"; });
+
+    auto& scheduler = DataChangeScheduler::instance();
+    for (int i = 0; i < 3; ++i) {
+      scheduler.schedule(ds, true, true);
+    }
+    QVERIFY(events.isEmpty());
+    scheduler.flush();
+
+    QCOMPARE(events, QStringList({ "dataChanged", "started" }));
+
+    delete pipeline;
+  }
+
+  void skipsDeletedSources()
+  {
+    auto* ds = createDataSource();
+    auto* other = createDataSource();
+    QSignalSpy otherSpy(other, &DataSource::dataChanged);
+
+    auto& scheduler = DataChangeScheduler::instance();
+    scheduler.schedule(ds);
+    scheduler.schedule(other);
+    delete ds;
+    scheduler.flush();
+
+    QCOMPARE(otherSpy.count(), 1);
+
+    delete other;
+  }
+};
+
+int main(int argc, char** argv)
+{
+  QApplication app(argc, argv);
+  pqPVApplicationCore appCore(argc, argv);
+
+  // Create a builtin server connection so proxies can be created
+  auto* builder = pqApplicationCore::instance()->getObjectBuilder();
+  builder->createServer(pqServerResource("builtin:"));
+
+  DataChangeSchedulerTest tc;
+  return QTest::qExec(&tc, argc, argv);
+}
+
+#include "DataChangeSchedulerTest.moc"
@@ -0,0 +1,768 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+// Measures how fast each of the file format paths moves data between disk
+// and a vtkImageData. Synthetic volumes are written and read back through
+// EmdFormat, DataExchangeFormat, Tvh5Format, vtkOMETiffReader, TIFF stacks
+// and raw files, and the throughput, peak resident memory and
+// time-to-first-slice of every case is reported.
+//
+// Reads are reported cold and warm. Before each cold read the files are
+// synced and dropped from the page cache (on Linux), so that it comes from
+// the device; the warm reads are the best of the repeats that follow.
+//
+// Everything runs on local disk. By default every case is run once in
+// /dev/shm (when present, to measure the format overhead without the
+// device, where cold and warm reads match since the files only live in
+// memory) and once in the system temporary directory.
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <pqApplicationCore.h>
+#include <pqObjectBuilder.h>
+#include <pqPVApplicationCore.h>
+#include <pqServerResource.h>
+
+#include <vtkImageData.h>
+#include <vtkImageReader.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+#include <vtkTIFFReader.h>
+#include <vtkTIFFWriter.h>
+
+#include "ActiveObjects.h"
+#include "DataExchangeFormat.h"
+#include "DataSource.h"
+#include "EmdFormat.h"
+#include "Pipeline.h"
+#include "PipelineManager.h"
+#include "ResourceUsage.h"
+#include "Tvh5Format.h"
+#include "h5cpp/h5capi.h"
+#include "modules/ModuleManager.h"
+#include "vtkOMETiffReader.h"
+
+extern "C" {
+#include "vtk_tiff.h"
+}
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using namespace tomviz;
+
+namespace {
+
+struct Measurement
+{
+  QString directory;
+  QString format;
+  QString variant;
+  QString operation;
+  double megabytes = 0.0;
+  // The best of the repeats, warm for reads
+  double seconds = 0.0;
+  // Negative for writes, and when the files cannot be evicted
+  double coldSeconds = -1.0;
+  double peakMegabytes = 0.0;
+  // Negative when the path has no meaningful notion of a first slice
+  double firstSliceMs = -1.0;
+  double firstSliceColdMs = -1.0;
+};
+
+const double MB = 1024.0 * 1024.0;
+
+// Write the pages of files to the device and drop them from the page cache,
+// so that the next read of the files comes from the device. Returns false
+// where this is not supported.
+bool evictFromPageCache(const QStringList& files)
+{
+#ifdef __linux__
+  for (const auto& file : files) {
+    int fd = ::open(QFile::encodeName(file).constData(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    // Dirty pages are not dropped
+    ::fsync(fd);
+    int status = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+    if (status != 0) {
+      return false;
+    }
+  }
+  return true;
+#else
+  Q_UNUSED(files);
+  return false;
+#endif
+}
+
+// The time of func in seconds, negative if it fails
+double timed(const std::function<bool()>& func)
+{
+  QElapsedTimer timer;
+  timer.start();
+  if (!func()) {
+    return -1.0;
+  }
+  return timer.nsecsElapsed() * 1e-9;
+}
+
+vtkSmartPointer<vtkImageData> syntheticVolume(int dim, int vtkType)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(dim, dim, dim);
+  image->AllocateScalars(vtkType, 1);
+  image->GetPointData()->GetScalars()->SetName("ImageScalars");
+
+  // A smooth field with some hashed noise, so that compressed variants see
+  // something closer to real data than a constant or pure noise.
+  const double scale = 2.0 * 3.141592653589793 / dim;
+  const size_t count = static_cast<size_t>(dim) * dim * dim;
+  auto* ptr = image->GetScalarPointer();
+  for (size_t i = 0; i < count; ++i) {
+    auto x = static_cast<int>(i % dim);
+    auto y = static_cast<int>((i / dim) % dim);
+    auto z = static_cast<int>(i / (static_cast<size_t>(dim) * dim));
+    uint32_t hash = static_cast<uint32_t>(i) * 2654435761u;
+    double noise = (hash >> 24) / 255.0;
+    double value =
+      std::sin(x * scale) * std::cos(y * scale) * std::sin(z * scale * 0.5);
+    value = 0.5 + 0.4 * value + 0.1 * noise;
+    if (vtkType == VTK_FLOAT) {
+      static_cast<float*>(ptr)[i] = static_cast<float>(value);
+    } else {
+      static_cast<uint16_t*>(ptr)[i] = static_cast<uint16_t>(value * 65535);
+    }
+  }
+  return image;
+}
+
+size_t imageBytes(vtkImageData* image)
+{
+  return static_cast<size_t>(image->GetNumberOfPoints()) *
+         image->GetScalarSize() * image->GetNumberOfScalarComponents();
+}
+
+// Write an EMD file with an explicitly chunked (and optionally deflated)
+// data set. EmdFormat::write always produces contiguous data sets.
+bool writeChunkedEmd(const QString& fileName, vtkImageData* image,
+                     const hsize_t chunk[3], int deflateLevel)
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  hsize_t fileDims[3] = { static_cast<hsize_t>(dims[2]),
+                          static_cast<hsize_t>(dims[1]),
+                          static_cast<hsize_t>(dims[0]) };
+  hid_t typeId = image->GetScalarType() == VTK_FLOAT ? H5T_NATIVE_FLOAT
+                                                     : H5T_NATIVE_UINT16;
+
+  hid_t fileId = H5Fcreate(fileName.toStdString().c_str(), H5F_ACC_TRUNC,
+                           H5P_DEFAULT, H5P_DEFAULT);
+  if (fileId < 0) {
+    return false;
+  }
+
+  hid_t dataGroup =
+    H5Gcreate(fileId, "/data", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  hid_t groupId = H5Gcreate(fileId, "/data/tomography", H5P_DEFAULT,
+                            H5P_DEFAULT, H5P_DEFAULT);
+
+  unsigned int groupType = 1;
+  hid_t scalarSpace = H5Screate(H5S_SCALAR);
+  hid_t attrId = H5Acreate2(groupId, "emd_group_type", H5T_NATIVE_UINT,
+                            scalarSpace, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attrId, H5T_NATIVE_UINT, &groupType);
+  H5Aclose(attrId);
+  H5Sclose(scalarSpace);
+
+  hid_t plist = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(plist, 3, chunk);
+  if (deflateLevel > 0) {
+    H5Pset_shuffle(plist);
+    H5Pset_deflate(plist, deflateLevel);
+  }
+
+  hid_t space = H5Screate_simple(3, fileDims, nullptr);
+  hid_t dataId = H5Dcreate(groupId, "data", typeId, space, H5P_DEFAULT, plist,
+                           H5P_DEFAULT);
+  herr_t status = H5Dwrite(dataId, typeId, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                           image->GetScalarPointer());
+  H5Dclose(dataId);
+  H5Sclose(space);
+  H5Pclose(plist);
+
+  // The dimension vectors, with unit spacing
+  const char* dimNames[3] = { "dim1", "dim2", "dim3" };
+  for (int i = 0; i < 3; ++i) {
+    std::vector<float> values(fileDims[i]);
+    for (size_t j = 0; j < values.size(); ++j) {
+      values[j] = static_cast<float>(j);
+    }
+    hsize_t length = fileDims[i];
+    hid_t dimSpace = H5Screate_simple(1, &length, nullptr);
+    hid_t dimId = H5Dcreate(groupId, dimNames[i], H5T_NATIVE_FLOAT, dimSpace,
+                            H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    H5Dwrite(dimId, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+             values.data());
+    H5Dclose(dimId);
+    H5Sclose(dimSpace);
+  }
+
+  H5Gclose(groupId);
+  H5Gclose(dataGroup);
+  H5Fclose(fileId);
+  return status >= 0;
+}
+
+// Write a multi-page OME-TIFF, one page per z slice.
+bool writeOmeTiff(const QString& fileName, vtkImageData* image,
+                  bool compress)
+{
+  int dims[3];
+  image->GetDimensions(dims);
+  bool isFloat = image->GetScalarType() == VTK_FLOAT;
+  const char* pixelType = isFloat ? "float" : "uint16";
+
+  TIFF* tiff = TIFFOpen(fileName.toStdString().c_str(), "w8");
+  if (!tiff) {
+    return false;
+  }
+
+  QString ome =
+    QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+            "<OME xmlns=\"http://www.openmicroscopy.org/Schemas/OME/2016-06\">"
+            "<Image ID=\"Image:0\"><Pixels ID=\"Pixels:0\" "
+            "DimensionOrder=\"XYZCT\" Type=\"%1\" SizeX=\"%2\" SizeY=\"%3\" "
+            "SizeZ=\"%4\" SizeC=\"1\" SizeT=\"1\" BigEndian=\"false\">"
+            "</Pixels></Image></OME>")
+      .arg(pixelType)
+      .arg(dims[0])
+      .arg(dims[1])
+      .arg(dims[2]);
+  QByteArray description = ome.toUtf8();
+
+  const size_t sliceBytes =
+    static_cast<size_t>(dims[0]) * dims[1] * image->GetScalarSize();
+  auto* data = static_cast<char*>(image->GetScalarPointer());
+  for (int z = 0; z < dims[2]; ++z) {
+    TIFFSetField(tiff, TIFFTAG_SUBFILETYPE, 0);
+    TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, dims[0]);
+    TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, dims[1]);
+    TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, 1);
+    TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, isFloat ? 32 : 16);
+    TIFFSetField(tiff, TIFFTAG_SAMPLEFORMAT,
+                 isFloat ? SAMPLEFORMAT_IEEEFP : SAMPLEFORMAT_UINT);
+    TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+    TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+    TIFFSetField(tiff, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+    TIFFSetField(tiff, TIFFTAG_COMPRESSION,
+                 compress ? COMPRESSION_ADOBE_DEFLATE : COMPRESSION_NONE);
+    TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP,
+                 TIFFDefaultStripSize(tiff, static_cast<uint32_t>(-1)));
+    if (z == 0) {
+      TIFFSetField(tiff, TIFFTAG_IMAGEDESCRIPTION, description.constData());
+    }
+
+    const size_t rowBytes = sliceBytes / dims[1];
+    for (int y = 0; y < dims[1]; ++y) {
+      if (TIFFWriteScanline(tiff, data + z * sliceBytes + y * rowBytes, y,
+                            0) < 0) {
+        TIFFClose(tiff);
+        return false;
+      }
+    }
+    TIFFWriteDirectory(tiff);
+  }
+
+  TIFFClose(tiff);
+  return true;
+}
+
+class IOThroughputBenchmark
+{
+public:
+  IOThroughputBenchmark(int dim, int vtkType, int repeats)
+    : m_image(syntheticVolume(dim, vtkType)), m_dim(dim), m_repeats(repeats)
+  {
+    m_megabytes = imageBytes(m_image) / MB;
+  }
+
+  void run(const QString& directory)
+  {
+    m_directory = directory;
+    QTemporaryDir scratch(QDir(directory).filePath("tomviz_io_XXXXXX"));
+    if (!scratch.isValid()) {
+      std::cerr << "Unable to create a scratch directory in "
+                << directory.toStdString() << std::endl;
+      return;
+    }
+    m_scratch = scratch.path();
+
+    benchmarkEmd();
+    benchmarkDataExchange();
+    benchmarkTvh5();
+    benchmarkOmeTiff();
+    benchmarkTiffStack();
+    benchmarkRaw();
+  }
+
+  const QList<Measurement>& results() const { return m_results; }
+
+private:
+  QString path(const QString& name) const
+  {
+    return QDir(m_scratch).filePath(name);
+  }
+
+  // Time an operation, keeping the best of the repeats. The peak memory is
+  // the high-water mark above the resident size at the start of the case.
+  // Reads give the files they read: the first slice and a full read are then
+  // timed cold before the repeats, and the first slice warm after them.
+  void measure(const QString& format, const QString& variant,
+               const QString& operation, double megabytes,
+               const std::function<bool()>& operationFunc,
+               const std::function<bool()>& firstSliceFunc = nullptr,
+               const QStringList& files = QStringList())
+  {
+    Measurement m;
+    m.directory = m_directory;
+    m.format = format;
+    m.variant = variant;
+    m.operation = operation;
+    m.megabytes = megabytes;
+
+    auto failed = [&]() {
+      std::cerr << "Failed: " << format.toStdString() << " "
+                << variant.toStdString() << " " << operation.toStdString()
+                << std::endl;
+    };
+
+    size_t peak = 0;
+    auto run = [&]() {
+      auto baseline = ResourceUsage::currentResidentSetSize();
+      ResourceUsage::resetPeakResidentSetSize();
+      double seconds = timed(operationFunc);
+      auto high = ResourceUsage::peakResidentSetSize();
+      peak = std::max(peak, high > baseline ? high - baseline : 0);
+      return seconds;
+    };
+
+    bool cold = !files.isEmpty() && evictFromPageCache(files);
+    if (!files.isEmpty() && !cold && !m_warnedEviction) {
+      std::cerr << "Warning: the files cannot be evicted from the page "
+                   "cache on this platform, only warm reads are timed."
+                << std::endl;
+      m_warnedEviction = true;
+    }
+    if (cold) {
+      if (firstSliceFunc) {
+        double seconds = timed(firstSliceFunc);
+        m.firstSliceColdMs = seconds < 0.0 ? -1.0 : seconds * 1e3;
+        evictFromPageCache(files);
+      }
+      m.coldSeconds = run();
+      if (m.coldSeconds < 0.0) {
+        failed();
+        return;
+      }
+    }
+
+    double best = -1.0;
+    for (int i = 0; i < m_repeats; ++i) {
+      double seconds = run();
+      if (seconds < 0.0) {
+        failed();
+        return;
+      }
+      if (best < 0.0 || seconds < best) {
+        best = seconds;
+      }
+    }
+    m.seconds = best;
+    m.peakMegabytes = peak / MB;
+
+    if (firstSliceFunc) {
+      double seconds = timed(firstSliceFunc);
+      m.firstSliceMs = seconds < 0.0 ? -1.0 : seconds * 1e3;
+    }
+
+    m_results.append(m);
+  }
+
+  QVariantMap noDialog() const
+  {
+    QVariantMap options;
+    options["askForSubsample"] = false;
+    return options;
+  }
+
+  void benchmarkEmd()
+  {
+    auto fileName = path("contiguous.emd");
+    measure("EMD", "contiguous", "write", m_megabytes, [&]() {
+      return EmdFormat::write(fileName.toStdString(), m_image.Get());
+    });
+    benchmarkEmdReads(fileName, "contiguous");
+
+    struct Layout
+    {
+      const char* name;
+      hsize_t chunk[3];
+      int deflate;
+    };
+    hsize_t c = static_cast<hsize_t>(std::min(64, m_dim));
+    hsize_t d = static_cast<hsize_t>(m_dim);
+    Layout layouts[] = { { "chunk64", { c, c, c }, 0 },
+                         { "chunk-slice", { 1, d, d }, 0 },
+                         { "chunk64-deflate1", { c, c, c }, 1 },
+                         { "chunk64-deflate6", { c, c, c }, 6 } };
+    for (auto& layout : layouts) {
+      auto chunkedName = path(QString("%1.emd").arg(layout.name));
+      measure("EMD", layout.name, "write", m_megabytes, [&]() {
+        return writeChunkedEmd(chunkedName, m_image, layout.chunk,
+                               layout.deflate);
+      });
+      benchmarkEmdReads(chunkedName, layout.name);
+    }
+  }
+
+  void benchmarkEmdReads(const QString& fileName, const QString& variant)
+  {
+    auto file = fileName.toStdString();
+    QStringList files = { fileName };
+    auto firstSlice = [this, file]() {
+      vtkNew<vtkImageData> image;
+      auto options = noDialog();
+      options["subsampleVolumeBounds"] = QVariantList{ 0, 1, 0, -1, 0, -1 };
+      return EmdFormat::read(file, image, options);
+    };
+
+    measure("EMD", variant, "read", m_megabytes,
+            [this, file]() {
+              vtkNew<vtkImageData> image;
+              return EmdFormat::read(file, image, noDialog());
+            },
+            firstSlice, files);
+
+    measure("EMD", variant, "read stride 2", m_megabytes / 8,
+            [this, file]() {
+              vtkNew<vtkImageData> image;
+              auto options = noDialog();
+              options["subsampleStrides"] = QVariantList{ 2, 2, 2 };
+              return EmdFormat::read(file, image, options);
+            },
+            nullptr, files);
+
+    int half = m_dim / 2;
+    measure("EMD", variant, "read half bounds", m_megabytes / 8,
+            [this, file, half]() {
+              vtkNew<vtkImageData> image;
+              auto options = noDialog();
+              options["subsampleVolumeBounds"] =
+                QVariantList{ 0, half, 0, half, 0, half };
+              return EmdFormat::read(file, image, options);
+            },
+            nullptr, files);
+  }
+
+  void benchmarkDataExchange()
+  {
+    auto fileName = path("exchange.h5").toStdString();
+    QStringList files = { path("exchange.h5") };
+    auto* source = new DataSource(m_image);
+    measure("DataExchange", "contiguous", "write", m_megabytes, [&]() {
+      DataExchangeFormat format;
+      return format.write(fileName, source);
+    });
+    delete source;
+
+    measure("DataExchange", "contiguous", "read", m_megabytes,
+            [this, fileName]() {
+              DataExchangeFormat format;
+              vtkNew<vtkImageData> image;
+              return format.read(fileName, image.Get(), noDialog());
+            },
+            [this, fileName]() {
+              DataExchangeFormat format;
+              vtkNew<vtkImageData> image;
+              auto options = noDialog();
+              options["subsampleVolumeBounds"] =
+                QVariantList{ 0, 1, 0, -1, 0, -1 };
+              return format.read(fileName, image.Get(), options);
+            },
+            files);
+
+    measure("DataExchange", "contiguous", "read stride 2", m_megabytes / 8,
+            [this, fileName]() {
+              DataExchangeFormat format;
+              vtkNew<vtkImageData> image;
+              auto options = noDialog();
+              options["subsampleStrides"] = QVariantList{ 2, 2, 2 };
+              return format.read(fileName, image.Get(), options);
+            },
+            nullptr, files);
+  }
+
+  void benchmarkTvh5()
+  {
+    // Tvh5 saves the whole application state, so the data source has to be
+    // registered with the application singletons.
+    auto* source = new DataSource(m_image);
+    auto* pipeline = new Pipeline(source);
+    PipelineManager::instance().addPipeline(pipeline);
+    ModuleManager::instance().addDataSource(source);
+    ActiveObjects::instance().setActiveDataSource(source);
+
+    auto fileName = path("state.tvh5").toStdString();
+    measure("Tvh5", "state", "write", m_megabytes,
+            [fileName]() { return Tvh5Format::write(fileName); });
+    ModuleManager::instance().reset();
+
+    measure("Tvh5", "state", "read", m_megabytes,
+            [fileName]() {
+              bool ok = Tvh5Format::read(fileName);
+              ModuleManager::instance().reset();
+              return ok;
+            },
+            nullptr, { path("state.tvh5") });
+  }
+
+  void benchmarkOmeTiff()
+  {
+    for (bool compress : { false, true }) {
+      QString variant = compress ? "deflate" : "uncompressed";
+      auto fileName = path(QString("%1.ome.tif").arg(variant));
+      measure("OME-TIFF", variant, "write", m_megabytes,
+              [&]() { return writeOmeTiff(fileName, m_image, compress); });
+
+      auto file = fileName.toStdString();
+      auto readAll = [file]() {
+        vtkNew<vtkOMETiffReader> reader;
+        reader->SetFileName(file.c_str());
+        reader->Update();
+        return reader->GetOutput()->GetNumberOfPoints() > 0;
+      };
+      auto readFirstSlice = [file]() {
+        vtkNew<vtkOMETiffReader> reader;
+        reader->SetFileName(file.c_str());
+        reader->UpdateInformation();
+        int extent[6];
+        reader->GetDataExtent(extent);
+        extent[5] = extent[4];
+        reader->UpdateExtent(extent);
+        return reader->GetOutput()->GetNumberOfPoints() > 0;
+      };
+      measure("OME-TIFF", variant, "read", m_megabytes, readAll,
+              readFirstSlice, { fileName });
+    }
+  }
+
+  void benchmarkTiffStack()
+  {
+    QDir dir(m_scratch);
+    dir.mkdir("stack");
+    auto prefix = dir.filePath("stack/slice").toStdString();
+    measure("TIFF stack", "per-slice files", "write", m_megabytes, [&]() {
+      vtkNew<vtkTIFFWriter> writer;
+      writer->SetInputData(m_image);
+      writer->SetFileDimensionality(2);
+      writer->SetFilePrefix(prefix.c_str());
+      writer->SetFilePattern("%s_%04d.tif");
+      writer->Write();
+      return writer->GetErrorCode() == 0;
+    });
+
+    vtkNew<vtkStringArray> fileNames;
+    QStringList files;
+    for (int z = 0; z < m_dim; ++z) {
+      files << QString("%1_%2.tif")
+                 .arg(prefix.c_str())
+                 .arg(z, 4, 10, QChar('0'));
+      fileNames->InsertNextValue(files.last().toStdString());
+    }
+
+    measure("TIFF stack", "per-slice files", "read", m_megabytes,
+            [&]() {
+              vtkNew<vtkTIFFReader> reader;
+              reader->SetFileNames(fileNames);
+              reader->Update();
+              return reader->GetOutput()->GetNumberOfPoints() > 0;
+            },
+            [&]() {
+              vtkNew<vtkTIFFReader> reader;
+              reader->SetFileName(fileNames->GetValue(0).c_str());
+              reader->Update();
+              return reader->GetOutput()->GetNumberOfPoints() > 0;
+            },
+            files);
+  }
+
+  void benchmarkRaw()
+  {
+    auto fileName = path("volume.raw").toStdString();
+    QStringList files = { path("volume.raw") };
+    size_t bytes = imageBytes(m_image);
+    measure("RAW", "little endian", "write", m_megabytes, [&]() {
+      std::ofstream out(fileName, std::ios::binary);
+      out.write(static_cast<const char*>(m_image->GetScalarPointer()), bytes);
+      return out.good();
+    });
+
+    auto makeReader = [this, fileName]() {
+      auto reader = vtkSmartPointer<vtkImageReader>::New();
+      reader->SetFileName(fileName.c_str());
+      reader->SetDataScalarType(m_image->GetScalarType());
+      reader->SetNumberOfScalarComponents(1);
+      reader->SetFileDimensionality(3);
+      reader->SetDataExtent(0, m_dim - 1, 0, m_dim - 1, 0, m_dim - 1);
+      reader->SetDataByteOrderToLittleEndian();
+      return reader;
+    };
+
+    auto readExtent = [makeReader](const int extent[6]) {
+      auto reader = makeReader();
+      reader->UpdateInformation();
+      reader->UpdateExtent(extent);
+      return reader->GetOutput()->GetNumberOfPoints() > 0;
+    };
+
+    int full[6] = { 0, m_dim - 1, 0, m_dim - 1, 0, m_dim - 1 };
+    int first[6] = { 0, m_dim - 1, 0, m_dim - 1, 0, 0 };
+    int half[6] = { 0, m_dim / 2 - 1, 0, m_dim / 2 - 1, 0, m_dim / 2 - 1 };
+    measure("RAW", "little endian", "read", m_megabytes,
+            [&]() { return readExtent(full); },
+            [&]() { return readExtent(first); }, files);
+    measure("RAW", "little endian", "read half bounds", m_megabytes / 8,
+            [&]() { return readExtent(half); }, nullptr, files);
+  }
+
+  vtkSmartPointer<vtkImageData> m_image;
+  int m_dim;
+  int m_repeats;
+  double m_megabytes = 0.0;
+  QString m_directory;
+  QString m_scratch;
+  QList<Measurement> m_results;
+  bool m_warnedEviction = false;
+};
+
+void printResults(const QList<Measurement>& results, QTextStream& out,
+                  bool csv)
+{
+  auto separator = csv ? QString(",") : QString(" | ");
+  QStringList header = { "directory",
+                         "format",
+                         "variant",
+                         "operation",
+                         "MB",
+                         "seconds",
+                         "MB/s",
+                         "cold seconds",
+                         "cold MB/s",
+                         "peak MB",
+                         "first slice ms",
+                         "cold first slice ms" };
+  out << header.join(separator) << "\n";
+  auto number = [](double value, int precision) {
+    return value < 0 ? QString("-") : QString::number(value, 'f', precision);
+  };
+  auto rate = [](double megabytes, double seconds) {
+    return seconds > 0 ? megabytes / seconds : (seconds < 0 ? -1.0 : 0.0);
+  };
+  for (const auto& m : results) {
+    QStringList row;
+    row << m.directory << m.format << m.variant << m.operation
+        << number(m.megabytes, 1) << number(m.seconds, 3)
+        << number(rate(m.megabytes, m.seconds), 1)
+        << number(m.coldSeconds, 3)
+        << number(rate(m.megabytes, m.coldSeconds), 1)
+        << number(m.peakMegabytes, 1) << number(m.firstSliceMs, 1)
+        << number(m.firstSliceColdMs, 1);
+    out << row.join(separator) << "\n";
+  }
+  out.flush();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  QApplication app(argc, argv);
+  pqPVApplicationCore appCore(argc, argv);
+
+  auto* builder = pqApplicationCore::instance()->getObjectBuilder();
+  builder->createServer(pqServerResource("builtin:"));
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("tomviz file format I/O benchmark");
+  parser.addHelpOption();
+  QCommandLineOption sizeOption("size", "Edge length of the cubic volume.",
+                                "voxels", "256");
+  QCommandLineOption typeOption("type", "Scalar type, uint16 or float.",
+                                "type", "uint16");
+  QCommandLineOption repeatOption("repeat", "Repeats per case (best is kept).",
+                                  "count", "3");
+  QCommandLineOption dirOption(
+    "dir", "Directory to benchmark in, may be given several times.", "path");
+  QCommandLineOption csvOption("csv", "Also write the results as CSV.",
+                               "file");
+  parser.addOptions(
+    { sizeOption, typeOption, repeatOption, dirOption, csvOption });
+  parser.process(app);
+
+  int dim = parser.value(sizeOption).toInt();
+  int vtkType = parser.value(typeOption) == "float" ? VTK_FLOAT
+                                                    : VTK_UNSIGNED_SHORT;
+  int repeats = std::max(1, parser.value(repeatOption).toInt());
+
+  QStringList directories = parser.values(dirOption);
+  if (directories.isEmpty()) {
+    if (QDir("/dev/shm").exists()) {
+      directories << "/dev/shm";
+    }
+    directories << QDir::tempPath();
+  }
+
+  if (!ResourceUsage::resetPeakResidentSetSize()) {
+    std::cerr << "Warning: the peak memory high-water mark cannot be reset on "
+                 "this platform, peak values are cumulative." << std::endl;
+  }
+
+  IOThroughputBenchmark benchmark(dim, vtkType, repeats);
+  for (const auto& directory : directories) {
+    benchmark.run(directory);
+  }
+
+  QTextStream out(stdout);
+  printResults(benchmark.results(), out, false);
+
+  if (parser.isSet(csvOption)) {
+    QFile file(parser.value(csvOption));
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+      QTextStream csv(&file);
+      printResults(benchmark.results(), csv, true);
+    }
+  }
+
+  return 0;
+}
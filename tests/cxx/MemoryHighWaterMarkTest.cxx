@@ -0,0 +1,336 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+// Peak memory regression tests for the loaders and pipelines. Each test
+// records the process high-water mark while one loader or pipeline runs on a
+// synthetic volume, and fails if the peak, relative to the dataset size,
+// exceeds the documented multiplier for that path below. If a change
+// legitimately moves a path, update its multiplier and the reason next to it.
+//
+// The volumes are large enough (> 32 MiB) that glibc serves them with mmap
+// and returns them to the system when freed, so earlier tests do not leave
+// reusable heap behind that would hide a later allocation.
+
+#include <QApplication>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <pqApplicationCore.h>
+#include <pqObjectBuilder.h>
+#include <pqPVApplicationCore.h>
+#include <pqServerResource.h>
+
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSmartPointer.h>
+#include <vtkVector.h>
+
+#include "ConvertToFloatOperator.h"
+#include "CropOperator.h"
+#include "DataExchangeFormat.h"
+#include "DataSource.h"
+#include "EmdFormat.h"
+#include "Pipeline.h"
+#include "PipelineProxy.h"
+#include "PythonUtilities.h"
+#include "ResourceUsage.h"
+#include "TomvizTest.h"
+#include "TranslateAlignOperator.h"
+#include "operators/OperatorProxy.h"
+#include "operators/OperatorPython.h"
+
+#include <cstdint>
+#include <functional>
+
+using namespace tomviz;
+
+namespace {
+
+// Documented peak multipliers, as a fraction of the full dataset size.
+
+// The HDF5 read fills one array, then the C to Fortran reorder makes a second
+// one before the first is released.
+const double emdReadBudget = 2.1;
+// Strided and sub-volume reads only ever hold 1/8 of the volume (twice).
+const double emdSubsampleBudget = 0.3;
+const double dataExchangeReadBudget = 2.1;
+// The pipeline copies its input (1x), then the float output is twice the
+// size of the 16 bit input (2x).
+const double convertToFloatBudget = 3.2;
+// Pipeline input copy (1x) plus the cropped octant (1/8x).
+const double cropBudget = 1.25;
+// Pipeline input copy (1x) plus the operator's output image (1x).
+const double translateAlignBudget = 2.2;
+// Pipeline input copy (1x), the script modifies the array in place.
+const double pythonOperatorBudget = 1.3;
+
+const int dim = 320;
+
+vtkSmartPointer<vtkImageData> syntheticVolume(int vtkType)
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(dim, dim, dim);
+  image->AllocateScalars(vtkType, 1);
+  image->GetPointData()->GetScalars()->SetName("ImageScalars");
+
+  // Touch every page so the volume is resident before the measurement
+  const size_t count = static_cast<size_t>(dim) * dim * dim;
+  auto* ptr = image->GetScalarPointer();
+  for (size_t i = 0; i < count; ++i) {
+    if (vtkType == VTK_FLOAT) {
+      static_cast<float*>(ptr)[i] = static_cast<float>(i % 251);
+    } else {
+      static_cast<uint16_t*>(ptr)[i] = static_cast<uint16_t>(i % 251);
+    }
+  }
+  return image;
+}
+
+size_t imageBytes(vtkImageData* image)
+{
+  return static_cast<size_t>(
+    image->GetPointData()->GetScalars()->GetDataSize() *
+    image->GetPointData()->GetScalars()->GetDataTypeSize());
+}
+
+QVariantMap noDialog()
+{
+  QVariantMap options;
+  options["askForSubsample"] = false;
+  return options;
+}
+
+QString loadFixture(const QString& name)
+{
+  QFile file(QString("%1/fixtures/%2").arg(SOURCE_DIR, name));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return QString();
+  }
+  return QString(file.readAll());
+}
+
+} // namespace
+
+class MemoryHighWaterMarkTest : public QObject
+{
+  Q_OBJECT
+
+private:
+  // Returns the peak resident set size reached while running func, above
+  // the resident set size before it, as a multiple of datasetBytes.
+  double peakRatio(const std::function<bool()>& func, size_t datasetBytes)
+  {
+    auto baseline = ResourceUsage::currentResidentSetSize();
+    ResourceUsage::resetPeakResidentSetSize();
+    bool ok = func();
+    auto peak = ResourceUsage::peakResidentSetSize();
+    if (!ok) {
+      return -1.0;
+    }
+    return peak > baseline
+             ? static_cast<double>(peak - baseline) / datasetBytes
+             : 0.0;
+  }
+
+  void verifyBudget(double ratio, double budget)
+  {
+    QVERIFY2(ratio >= 0.0, "The operation failed");
+    qInfo("peak %.2fx dataset, budget %.2fx", ratio, budget);
+    QVERIFY2(ratio <= budget,
+             qPrintable(QString("Peak memory %1x the dataset size exceeds "
+                                "the documented %2x")
+                          .arg(ratio, 0, 'f', 2)
+                          .arg(budget, 0, 'f', 2)));
+  }
+
+  // Run op on a pipeline over image and wait for it to finish
+  bool runPipeline(vtkImageData* image,
+                   const std::function<Operator*(DataSource*)>& createOp)
+  {
+    auto* ds = new DataSource(image);
+    Pipeline pipeline(ds);
+    pipeline.pause();
+    auto* op = createOp(ds);
+    ds->addOperator(op);
+    pipeline.resume();
+
+    QSignalSpy finishedSpy(&pipeline, &Pipeline::finished);
+    auto* future = pipeline.execute(ds, op);
+    bool finished = finishedSpy.wait(120000);
+    bool ok = finished && future->result() != nullptr;
+    delete future;
+    return ok;
+  }
+
+  QTemporaryDir m_dir;
+  std::string m_emdFile;
+  std::string m_exchangeFile;
+  size_t m_floatBytes = 0;
+
+private slots:
+  void initTestCase()
+  {
+    if (!ResourceUsage::resetPeakResidentSetSize()) {
+      QSKIP("The peak memory high-water mark cannot be reset on this "
+            "platform");
+    }
+
+    OperatorProxyFactory::registerWithFactory();
+    PipelineProxyFactory::registerWithFactory();
+
+    QVERIFY(m_dir.isValid());
+    m_emdFile = m_dir.filePath("volume.emd").toStdString();
+    m_exchangeFile = m_dir.filePath("volume.h5").toStdString();
+
+    auto image = syntheticVolume(VTK_FLOAT);
+    m_floatBytes = imageBytes(image);
+    QVERIFY(EmdFormat::write(m_emdFile, image));
+    auto* source = new DataSource(image);
+    DataExchangeFormat exchange;
+    QVERIFY(exchange.write(m_exchangeFile, source));
+    delete source;
+  }
+
+  void emdRead()
+  {
+    auto ratio = peakRatio(
+      [this]() {
+        vtkNew<vtkImageData> image;
+        return EmdFormat::read(m_emdFile, image, noDialog());
+      },
+      m_floatBytes);
+    verifyBudget(ratio, emdReadBudget);
+  }
+
+  void emdReadStrided()
+  {
+    auto ratio = peakRatio(
+      [this]() {
+        vtkNew<vtkImageData> image;
+        auto options = noDialog();
+        options["subsampleStrides"] = QVariantList{ 2, 2, 2 };
+        return EmdFormat::read(m_emdFile, image, options);
+      },
+      m_floatBytes);
+    verifyBudget(ratio, emdSubsampleBudget);
+  }
+
+  void emdReadSubVolume()
+  {
+    auto ratio = peakRatio(
+      [this]() {
+        vtkNew<vtkImageData> image;
+        auto options = noDialog();
+        int half = dim / 2;
+        options["subsampleVolumeBounds"] =
+          QVariantList{ 0, half, 0, half, 0, half };
+        return EmdFormat::read(m_emdFile, image, options);
+      },
+      m_floatBytes);
+    verifyBudget(ratio, emdSubsampleBudget);
+  }
+
+  void dataExchangeRead()
+  {
+    auto ratio = peakRatio(
+      [this]() {
+        DataExchangeFormat format;
+        vtkNew<vtkImageData> image;
+        return format.read(m_exchangeFile, image.Get(), noDialog());
+      },
+      m_floatBytes);
+    verifyBudget(ratio, dataExchangeReadBudget);
+  }
+
+  void convertToFloatPipeline()
+  {
+    auto image = syntheticVolume(VTK_UNSIGNED_SHORT);
+    auto ratio = peakRatio(
+      [this, &image]() {
+        return runPipeline(image, [](DataSource*) {
+          return new ConvertToFloatOperator();
+        });
+      },
+      imageBytes(image));
+    verifyBudget(ratio, convertToFloatBudget);
+  }
+
+  void cropPipeline()
+  {
+    auto image = syntheticVolume(VTK_FLOAT);
+    auto ratio = peakRatio(
+      [this, &image]() {
+        return runPipeline(image, [](DataSource*) {
+          auto op = new CropOperator();
+          int half = dim / 2;
+          int bounds[6] = { 0, half - 1, 0, half - 1, 0, half - 1 };
+          op->setCropBounds(bounds);
+          return op;
+        });
+      },
+      imageBytes(image));
+    verifyBudget(ratio, cropBudget);
+  }
+
+  void translateAlignPipeline()
+  {
+    auto image = syntheticVolume(VTK_FLOAT);
+    auto ratio = peakRatio(
+      [this, &image]() {
+        return runPipeline(image, [](DataSource* ds) {
+          auto op = new TranslateAlignOperator(ds);
+          op->setAlignOffsets(QVector<vtkVector2i>(dim, vtkVector2i(3, -2)));
+          return op;
+        });
+      },
+      imageBytes(image));
+    verifyBudget(ratio, translateAlignBudget);
+  }
+
+  void pythonOperatorPipeline()
+  {
+    QString script = loadFixture("increment_scalars.py");
+    QVERIFY(!script.isEmpty());
+    auto createOp = [&script](DataSource* ds) {
+      auto op = new OperatorPython(ds);
+      op->setLabel("increment");
+      op->setScript(script);
+      return op;
+    };
+
+    // Warm up on a small volume, so that the Python module imports are not
+    // counted against the dataset.
+    {
+      vtkNew<vtkImageData> small;
+      small->SetDimensions(4, 4, 4);
+      small->AllocateScalars(VTK_FLOAT, 1);
+      QVERIFY(runPipeline(small.Get(), createOp));
+    }
+
+    auto image = syntheticVolume(VTK_FLOAT);
+    auto ratio = peakRatio(
+      [this, &image, &createOp]() { return runPipeline(image, createOp); },
+      imageBytes(image));
+    verifyBudget(ratio, pythonOperatorBudget);
+  }
+};
+
+int main(int argc, char** argv)
+{
+  QApplication app(argc, argv);
+  pqPVApplicationCore appCore(argc, argv);
+
+  // Create a builtin server connection so proxies can be created
+  auto* builder = pqApplicationCore::instance()->getObjectBuilder();
+  builder->createServer(pqServerResource("builtin:"));
+
+  Python::initialize();
+
+  MemoryHighWaterMarkTest tc;
+  return QTest::qExec(&tc, argc, argv);
+}
+
+#include "MemoryHighWaterMarkTest.moc"
@@ -15,8 +15,14 @@
 #include <pqServerResource.h>
 #include <pqView.h>
 
+#include <vtkChartXY.h>
+#include <vtkContextScene.h>
+#include <vtkContextView.h>
 #include <vtkDoubleArray.h>
 #include <vtkNew.h>
+#include <vtkPVContextView.h>
+#include <vtkPlot.h>
+#include <vtkSMViewProxy.h>
 #include <vtkTable.h>
 
 #include "modules/ModulePlot.h"
@@ -231,6 +237,54 @@ private slots:
     objBuilder->destroy(pqView);
   }
 
+  void decimatesLongTables()
+  {
+    auto* objBuilder = pqApplicationCore::instance()->getObjectBuilder();
+    auto* server = pqApplicationCore::instance()->getActiveServer();
+    auto* pqView = objBuilder->createView("XYChartView", server);
+    auto* viewProxy = pqView->getViewProxy();
+
+    const vtkIdType rows = 1000000;
+    vtkNew<vtkTable> table;
+    vtkNew<vtkDoubleArray> xCol;
+    xCol->SetName("x");
+    xCol->SetNumberOfTuples(rows);
+    vtkNew<vtkDoubleArray> yCol;
+    yCol->SetName("y");
+    yCol->SetNumberOfTuples(rows);
+    for (vtkIdType i = 0; i < rows; ++i) {
+      xCol->SetValue(i, static_cast<double>(i));
+      yCol->SetValue(i, static_cast<double>(i % 1000));
+    }
+    table->AddColumn(xCol);
+    table->AddColumn(yCol);
+
+    auto* result = new OperatorResult(this);
+    result->setName("test_result");
+    result->setDataObject(table);
+
+    QVERIFY(modulePlot->initialize(result, viewProxy));
+
+    // The plot draws a fraction of the rows, with the same extremes
+    auto view =
+      vtkPVContextView::SafeDownCast(viewProxy->GetClientSideView());
+    auto chart = vtkChartXY::SafeDownCast(
+      view->GetContextView()->GetScene()->GetItem(0));
+    QVERIFY(chart != nullptr);
+    QCOMPARE(chart->GetNumberOfPlots(), static_cast<vtkIdType>(1));
+    auto plotted = chart->GetPlot(0)->GetInput();
+    QVERIFY(plotted != nullptr);
+    QVERIFY(plotted->GetNumberOfRows() > 0);
+    QVERIFY(plotted->GetNumberOfRows() < rows / 10);
+    double range[2];
+    vtkDataArray::SafeDownCast(plotted->GetColumn(1))->GetRange(range);
+    QCOMPARE(range[0], 0.0);
+    QCOMPARE(range[1], 999.0);
+
+    QVERIFY(modulePlot->finalize());
+    objBuilder->destroy(pqView);
+  }
+
   void visibilityToggleWithChart()
   {
     auto* objBuilder = pqApplicationCore::instance()->getObjectBuilder();
@@ -0,0 +1,182 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <gtest/gtest.h>
+
+#include <vtkMolecule.h>
+#include <vtkNew.h>
+#include <vtkPeriodicTable.h>
+#include <vtkPoints.h>
+
+#include "MoleculeSpatialIndex.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace tomviz;
+
+namespace {
+
+double distance2(vtkPoints* points, vtkIdType id, const double p[3])
+{
+  double q[3];
+  points->GetPoint(id, q);
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    d2 += (p[i] - q[i]) * (p[i] - q[i]);
+  }
+  return d2;
+}
+
+} // namespace
+
+class MoleculeSpatialIndexTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Carbon atoms in a 20 A box, with small leaves for a deep octree
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 20.0);
+    for (int i = 0; i < atoms; ++i) {
+      molecule->AppendAtom(6, coordinate(generator), coordinate(generator),
+                           coordinate(generator));
+    }
+    octree.build(molecule->GetAtomicPositionArray(), 8);
+  }
+
+  vtkPoints* positions() const { return molecule->GetAtomicPositionArray(); }
+
+  vtkIdType bruteNearest(const double p[3]) const
+  {
+    auto* points = molecule->GetAtomicPositionArray();
+    vtkIdType best = -1;
+    double best2 = VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < atoms; ++i) {
+      double d2 = distance2(points, i, p);
+      if (d2 < best2) {
+        best2 = d2;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  std::vector<vtkIdType> bruteWithin(const double p[3], double radius) const
+  {
+    auto* points = molecule->GetAtomicPositionArray();
+    std::vector<vtkIdType> ids;
+    for (vtkIdType i = 0; i < atoms; ++i) {
+      if (distance2(points, i, p) <= radius * radius) {
+        ids.push_back(i);
+      }
+    }
+    return ids;
+  }
+
+  const int atoms = 2000;
+  vtkNew<vtkMolecule> molecule;
+  MoleculeOctree octree;
+};
+
+TEST_F(MoleculeSpatialIndexTest, nearest_atom)
+{
+  ASSERT_EQ(octree.numberOfPoints(), atoms);
+
+  // Every atom is its own nearest atom
+  auto* points = molecule->GetAtomicPositionArray();
+  for (vtkIdType i = 0; i < atoms; i += 97) {
+    double p[3];
+    points->GetPoint(i, p);
+    ASSERT_EQ(octree.nearest(positions(), p), i);
+  }
+
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<double> coordinate(0.0, 20.0);
+  for (int i = 0; i < 100; ++i) {
+    double p[3] = { coordinate(generator), coordinate(generator),
+                    coordinate(generator) };
+    ASSERT_EQ(octree.nearest(positions(), p), bruteNearest(p));
+  }
+}
+
+TEST_F(MoleculeSpatialIndexTest, radius_queries)
+{
+  std::mt19937 generator(13);
+  std::uniform_real_distribution<double> coordinate(0.0, 20.0);
+  std::vector<vtkIdType> ids;
+  for (double radius : { 0.0, 0.5, 2.0, 5.0, 40.0 }) {
+    for (int i = 0; i < 20; ++i) {
+      double p[3] = { coordinate(generator), coordinate(generator),
+                      coordinate(generator) };
+      octree.withinRadius(positions(), p, radius, ids);
+      ASSERT_EQ(ids, bruteWithin(p, radius));
+    }
+  }
+
+  // The whole molecule
+  const double center[3] = { 10.0, 10.0, 10.0 };
+  octree.withinRadius(positions(), center, 40.0, ids);
+  ASSERT_EQ(ids.size(), static_cast<size_t>(atoms));
+}
+
+TEST_F(MoleculeSpatialIndexTest, outside_bounding_box)
+{
+  const double points[][3] = { { -50.0, 10.0, 10.0 },
+                               { 10.0, 35.0, 10.0 },
+                               { 25.0, -5.0, 40.0 },
+                               { -1e6, -1e6, -1e6 } };
+  std::vector<vtkIdType> ids;
+  for (const auto& p : points) {
+    ASSERT_EQ(octree.nearest(positions(), p), bruteNearest(p));
+
+    // Beyond the reach of the radius, then within it
+    octree.withinRadius(positions(), p, 1.0, ids);
+    ASSERT_EQ(ids, bruteWithin(p, 1.0));
+    octree.withinRadius(positions(), p, 40.0, ids);
+    ASSERT_EQ(ids, bruteWithin(p, 40.0));
+  }
+}
+
+TEST_F(MoleculeSpatialIndexTest, empty_molecule)
+{
+  vtkNew<vtkMolecule> empty;
+  MoleculeOctree index;
+  index.build(empty->GetAtomicPositionArray());
+  ASSERT_EQ(index.numberOfPoints(), 0);
+
+  const double p[3] = { 0.0, 0.0, 0.0 };
+  ASSERT_EQ(index.nearest(empty->GetAtomicPositionArray(), p), -1);
+  std::vector<vtkIdType> ids = { 1, 2 };
+  index.withinRadius(empty->GetAtomicPositionArray(), p, 10.0, ids);
+  ASSERT_TRUE(ids.empty());
+
+  ASSERT_TRUE(perceiveBonds(empty).empty());
+
+  // Rebuilding over no points releases the previous octree
+  octree.build(empty->GetAtomicPositionArray());
+  ASSERT_EQ(octree.numberOfPoints(), 0);
+  ASSERT_EQ(octree.nearest(positions(), p), -1);
+}
+
+TEST_F(MoleculeSpatialIndexTest, perceived_bonds)
+{
+  // Bonded atoms are closer than the sum of their covalent radii plus the
+  // tolerance, as vtkSimpleBondPerceiver has them
+  vtkNew<vtkPeriodicTable> table;
+  auto* points = molecule->GetAtomicPositionArray();
+  const double cutoff = 2 * table->GetCovalentRadius(6) + 0.45;
+  std::vector<std::pair<vtkIdType, vtkIdType>> expected;
+  for (vtkIdType i = 0; i < atoms; ++i) {
+    double p[3];
+    points->GetPoint(i, p);
+    for (vtkIdType j = i + 1; j < atoms; ++j) {
+      if (distance2(points, j, p) <= cutoff * cutoff) {
+        expected.emplace_back(i, j);
+      }
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(perceiveBonds(molecule), expected);
+}
@@ -0,0 +1,233 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <gtest/gtest.h>
+
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+#include <QTemporaryDir>
+
+#include "vtkOMETiffReader.h"
+
+extern "C" {
+#include "vtk_tiff.h"
+}
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace tomviz;
+
+namespace {
+
+const int width = 50;
+const int height = 37;
+const int pages = 4;
+
+// The value stored at a column and row of a page, distinct everywhere
+uint16_t stored(int x, int fileRow, int page, int level)
+{
+  return static_cast<uint16_t>(level * 20000 + page * 4096 + fileRow * 64 + x);
+}
+
+void writePage(TIFF* tiff, int level, int page, bool tiled)
+{
+  const int w = width >> level;
+  const int h = height >> level;
+  TIFFSetField(tiff, TIFFTAG_SUBFILETYPE,
+               level > 0 ? FILETYPE_REDUCEDIMAGE : 0);
+  TIFFSetField(tiff, TIFFTAG_IMAGEWIDTH, w);
+  TIFFSetField(tiff, TIFFTAG_IMAGELENGTH, h);
+  TIFFSetField(tiff, TIFFTAG_SAMPLESPERPIXEL, 1);
+  TIFFSetField(tiff, TIFFTAG_BITSPERSAMPLE, 16);
+  TIFFSetField(tiff, TIFFTAG_SAMPLEFORMAT, SAMPLEFORMAT_UINT);
+  TIFFSetField(tiff, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_MINISBLACK);
+  TIFFSetField(tiff, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+  TIFFSetField(tiff, TIFFTAG_COMPRESSION, COMPRESSION_ADOBE_DEFLATE);
+  if (level == 0 && page == 0) {
+    std::string ome =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+      "<OME xmlns=\"http://www.openmicroscopy.org/Schemas/OME/2016-06\">"
+      "<Image ID=\"Image:0\"><Pixels ID=\"Pixels:0\" "
+      "DimensionOrder=\"XYZCT\" Type=\"uint16\" SizeX=\"" +
+      std::to_string(width) + "\" SizeY=\"" + std::to_string(height) +
+      "\" SizeZ=\"" + std::to_string(pages) +
+      "\" SizeC=\"1\" SizeT=\"1\" PhysicalSizeX=\"0.5\" "
+      "PhysicalSizeY=\"0.5\" PhysicalSizeZ=\"2\" BigEndian=\"false\">"
+      "</Pixels></Image></OME>";
+    TIFFSetField(tiff, TIFFTAG_IMAGEDESCRIPTION, ome.c_str());
+  }
+
+  // The tiles and strips do not divide the image, to exercise the edges
+  if (tiled) {
+    const int tile = 16;
+    TIFFSetField(tiff, TIFFTAG_TILEWIDTH, tile);
+    TIFFSetField(tiff, TIFFTAG_TILELENGTH, tile);
+    std::vector<uint16_t> data(tile * tile);
+    for (int ty = 0; ty < h; ty += tile) {
+      for (int tx = 0; tx < w; tx += tile) {
+        for (int y = 0; y < tile; ++y) {
+          for (int x = 0; x < tile; ++x) {
+            data[y * tile + x] = stored(tx + x, ty + y, page, level);
+          }
+        }
+        TIFFWriteTile(tiff, data.data(), tx, ty, 0, 0);
+      }
+    }
+  } else {
+    TIFFSetField(tiff, TIFFTAG_ROWSPERSTRIP, 5);
+    std::vector<uint16_t> row(w);
+    for (int y = 0; y < h; ++y) {
+      for (int x = 0; x < w; ++x) {
+        row[x] = stored(x, y, page, level);
+      }
+      TIFFWriteScanline(tiff, row.data(), y, 0);
+    }
+  }
+}
+
+// Write pages without an orientation, which are stored from the bottom row,
+// each with a half resolution level in its SubIFDs
+bool writePyramid(const std::string& fileName, bool tiled)
+{
+  TIFF* tiff = TIFFOpen(fileName.c_str(), "w");
+  if (!tiff) {
+    return false;
+  }
+  for (int page = 0; page < pages; ++page) {
+    toff_t subIFDs[1] = { 0 };
+    TIFFSetField(tiff, TIFFTAG_SUBIFD, 1, subIFDs);
+    writePage(tiff, 0, page, tiled);
+    TIFFWriteDirectory(tiff);
+    // The directory after a page with SubIFDs is written as one of them
+    writePage(tiff, 1, page, tiled);
+    TIFFWriteDirectory(tiff);
+  }
+  TIFFClose(tiff);
+  return true;
+}
+
+uint16_t valueAt(vtkImageData* image, int x, int y, int z)
+{
+  return *static_cast<uint16_t*>(image->GetScalarPointer(x, y, z));
+}
+
+} // namespace
+
+class OMETiffReaderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_TRUE(dir.isValid());
+    // The same pyramid stored in tiles and in strips
+    for (bool tiled : { true, false }) {
+      auto name = QString("%1.ome.tif").arg(tiled ? "tiles" : "strips");
+      fileNames.push_back(dir.filePath(name).toStdString());
+      ASSERT_TRUE(writePyramid(fileNames.back(), tiled));
+    }
+  }
+
+  QTemporaryDir dir;
+  std::vector<std::string> fileNames;
+};
+
+TEST_F(OMETiffReaderTest, full_read)
+{
+  for (const auto& fileName : fileNames) {
+    vtkNew<vtkOMETiffReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    auto* image = reader->GetOutput();
+
+    int dims[3];
+    image->GetDimensions(dims);
+    ASSERT_EQ(dims[0], width);
+    ASSERT_EQ(dims[1], height);
+    ASSERT_EQ(dims[2], pages);
+    ASSERT_DOUBLE_EQ(image->GetSpacing()[0], 0.5);
+    ASSERT_DOUBLE_EQ(image->GetSpacing()[2], 2.0);
+    for (int z = 0; z < pages; ++z) {
+      for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+          ASSERT_EQ(valueAt(image, x, y, z), stored(x, height - 1 - y, z, 0));
+        }
+      }
+    }
+  }
+}
+
+TEST_F(OMETiffReaderTest, region_matches_full_read)
+{
+  // Regions within a tile, across tile edges and ending on the padded ones
+  const int regions[][6] = { { 3, 9, 2, 7, 1, 1 },
+                             { 14, 33, 10, 20, 0, 3 },
+                             { 40, 49, 30, 36, 2, 3 },
+                             { 0, 49, 36, 36, 3, 3 } };
+  for (const auto& fileName : fileNames) {
+    vtkNew<vtkOMETiffReader> full;
+    full->SetFileName(fileName.c_str());
+    full->Update();
+
+    for (const auto& extent : regions) {
+      vtkNew<vtkOMETiffReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->UpdateInformation();
+      reader->UpdateExtent(extent);
+      auto* image = reader->GetOutput();
+
+      int result[6];
+      image->GetExtent(result);
+      for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(result[i], extent[i]);
+      }
+      for (int z = extent[4]; z <= extent[5]; ++z) {
+        for (int y = extent[2]; y <= extent[3]; ++y) {
+          for (int x = extent[0]; x <= extent[1]; ++x) {
+            ASSERT_EQ(valueAt(image, x, y, z),
+                      valueAt(full->GetOutput(), x, y, z));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(OMETiffReaderTest, resolution_levels)
+{
+  const int w = width / 2;
+  const int h = height / 2;
+  for (const auto& fileName : fileNames) {
+    vtkNew<vtkOMETiffReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->UpdateInformation();
+    ASSERT_EQ(reader->GetNumberOfResolutionLevels(), 2);
+
+    int dims[3];
+    reader->GetResolutionLevelDimensions(1, dims);
+    ASSERT_EQ(dims[0], w);
+    ASSERT_EQ(dims[1], h);
+    ASSERT_EQ(dims[2], pages);
+
+    reader->SetResolutionLevel(1);
+    reader->Update();
+    auto* image = reader->GetOutput();
+    image->GetDimensions(dims);
+    ASSERT_EQ(dims[0], w);
+    ASSERT_EQ(dims[1], h);
+    ASSERT_EQ(dims[2], pages);
+    // The level spans the same physical extent as the full resolution
+    ASSERT_DOUBLE_EQ(image->GetSpacing()[0], 0.5 * width / w);
+    ASSERT_DOUBLE_EQ(image->GetSpacing()[1], 0.5 * height / h);
+    ASSERT_DOUBLE_EQ(image->GetSpacing()[2], 2.0);
+    for (int z = 0; z < pages; ++z) {
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          ASSERT_EQ(valueAt(image, x, y, z), stored(x, h - 1 - y, z, 1));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,100 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <gtest/gtest.h>
+
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkNew.h>
+
+#include "PlotDecimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace tomviz;
+
+class PlotDecimationTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    x->SetNumberOfTuples(rows);
+    y->SetNumberOfTuples(rows);
+    for (vtkIdType i = 0; i < rows; ++i) {
+      x->SetValue(i, i * 0.01);
+      y->SetValue(i, static_cast<float>(std::sin(i * 1e-3)));
+    }
+    // A single row spike must survive the decimation
+    y->SetValue(spike, 100.0f);
+  }
+
+  const vtkIdType rows = 200000;
+  const vtkIdType spike = 123457;
+  const double whole[2] = { -std::numeric_limits<double>::infinity(),
+                            std::numeric_limits<double>::infinity() };
+  vtkNew<vtkDoubleArray> x;
+  vtkNew<vtkFloatArray> y;
+};
+
+TEST_F(PlotDecimationTest, is_ascending)
+{
+  ASSERT_TRUE(isAscending(x));
+  ASSERT_FALSE(isAscending(y));
+}
+
+TEST_F(PlotDecimationTest, keeps_extremes)
+{
+  auto kept = decimatePlot(x, y, whole, true, 500);
+
+  ASSERT_LE(kept.size(), 4u * 500);
+  ASSERT_EQ(kept.front(), 0);
+  ASSERT_EQ(kept.back(), rows - 1);
+  ASSERT_TRUE(std::is_sorted(kept.begin(), kept.end()));
+  ASSERT_TRUE(std::adjacent_find(kept.begin(), kept.end()) == kept.end());
+  ASSERT_TRUE(std::find(kept.begin(), kept.end(), spike) != kept.end());
+
+  // The same lowest and highest values as the whole plot
+  auto lowest = std::numeric_limits<float>::max();
+  for (vtkIdType i = 0; i < rows; ++i) {
+    lowest = std::min(lowest, y->GetValue(i));
+  }
+  auto keptLowest = std::numeric_limits<float>::max();
+  for (auto row : kept) {
+    keptLowest = std::min(keptLowest, y->GetValue(row));
+  }
+  ASSERT_EQ(keptLowest, lowest);
+}
+
+TEST_F(PlotDecimationTest, range_of_view)
+{
+  const double range[2] = { 100.0, 200.0 };
+  auto kept = decimatePlot(x, y, range, true, 500);
+
+  // The rows in range, and one on either side
+  ASSERT_LT(x->GetValue(kept.front()), range[0]);
+  ASSERT_GE(x->GetValue(kept[1]), range[0]);
+  ASSERT_GT(x->GetValue(kept.back()), range[1]);
+  ASSERT_LE(x->GetValue(kept[kept.size() - 2]), range[1]);
+}
+
+TEST_F(PlotDecimationTest, short_range_kept_whole)
+{
+  const double range[2] = { 100.0, 101.0 };
+  auto kept = decimatePlot(x, y, range, true, 500);
+
+  ASSERT_EQ(kept.size(), 103u);
+  for (size_t i = 1; i < kept.size(); ++i) {
+    ASSERT_EQ(kept[i], kept[i - 1] + 1);
+  }
+}
+
+TEST_F(PlotDecimationTest, unsorted_x_ignores_range)
+{
+  const double range[2] = { 100.0, 200.0 };
+  auto kept = decimatePlot(x, y, range, false, 500);
+
+  ASSERT_EQ(kept.front(), 0);
+  ASSERT_EQ(kept.back(), rows - 1);
+}
@@ -0,0 +1,164 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <QApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTest>
+
+#include <pqApplicationCore.h>
+#include <pqObjectBuilder.h>
+#include <pqPVApplicationCore.h>
+#include <pqServerResource.h>
+#include <pqView.h>
+
+#include <vtkImageData.h>
+#include <vtkSMViewProxy.h>
+#include <vtkSmartPointer.h>
+
+#include "DataSource.h"
+#include "RenderStatistics.h"
+#include "modules/ModuleSlice.h"
+
+using namespace tomviz;
+
+class RenderStatisticsTest : public QObject
+{
+  Q_OBJECT
+
+private:
+  vtkSmartPointer<vtkImageData> createTestImage(int dim)
+  {
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(dim, dim, dim);
+    image->AllocateScalars(VTK_FLOAT, 1);
+    auto* data = static_cast<float*>(image->GetScalarPointer());
+    for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i) {
+      data[i] = static_cast<float>(i % 97);
+    }
+    return image;
+  }
+
+private slots:
+  void sliceReportsTimeAndVoxels()
+  {
+    auto* objBuilder = pqApplicationCore::instance()->getObjectBuilder();
+    auto* server = pqApplicationCore::instance()->getActiveServer();
+    auto* view = objBuilder->createView("RenderView", server);
+    QVERIFY(view != nullptr);
+
+    const int dim = 32;
+    auto* source = new DataSource(createTestImage(dim));
+    auto* slice = new ModuleSlice(this);
+    QVERIFY(slice->initialize(source, view->getViewProxy()));
+    view->forceRender();
+
+    auto stats = slice->renderStatistics();
+    QVERIFY(stats.renderTime > 0.0);
+    QCOMPARE(stats.voxels, static_cast<vtkIdType>(dim * dim));
+
+    // Hidden modules draw nothing
+    slice->setVisibility(false);
+    stats = slice->renderStatistics();
+    QCOMPARE(stats.renderTime, 0.0);
+    QCOMPARE(stats.voxels, static_cast<vtkIdType>(0));
+
+    delete slice;
+    delete source;
+    objBuilder->destroy(view);
+  }
+
+  void aggregatesFrameTimes()
+  {
+    auto* objBuilder = pqApplicationCore::instance()->getObjectBuilder();
+    auto* server = pqApplicationCore::instance()->getActiveServer();
+    auto* view = objBuilder->createView("RenderView", server);
+    auto* proxy = view->getViewProxy();
+    auto& statistics = RenderStatistics::instance();
+    statistics.setFrameBudgetEnabled(false);
+
+    statistics.recordFrame(proxy, false, 0.02);
+    auto json = statistics.statistics(proxy);
+    QCOMPARE(json["frame_time"].toDouble(), 0.02);
+    QCOMPARE(json["average_frame_time"].toDouble(), 0.02);
+    QCOMPARE(json["frames_per_second"].toDouble(), 50.0);
+    QCOMPARE(json["interactive"].toBool(), false);
+    QCOMPARE(json["modules"].toArray().size(), 0);
+    QCOMPARE(json["voxels"].toDouble(), 0.0);
+
+    // The average follows the frame times with a weight of 0.1
+    statistics.recordFrame(proxy, true, 0.04);
+    json = statistics.statistics(proxy);
+    QCOMPARE(json["frame_time"].toDouble(), 0.04);
+    QCOMPARE(json["average_frame_time"].toDouble(), 0.022);
+    QCOMPARE(json["frames_per_second"].toDouble(), 25.0);
+    QCOMPARE(json["interactive"].toBool(), true);
+
+    // Without the frame budget slow frames keep the quality
+    statistics.recordFrame(proxy, true, 1.0);
+    json = statistics.statistics(proxy);
+    QCOMPARE(json["budget_quality"].toDouble(), 1.0);
+    QCOMPARE(json["quality"].toDouble(), 1.0);
+
+    // Views that are not tracked have no statistics
+    QVERIFY(statistics.statistics(nullptr).isEmpty());
+
+    objBuilder->destroy(view);
+  }
+
+  void frameBudgetAdjustsQuality()
+  {
+    auto* objBuilder = pqApplicationCore::instance()->getObjectBuilder();
+    auto* server = pqApplicationCore::instance()->getActiveServer();
+    auto* view = objBuilder->createView("RenderView", server);
+    auto* proxy = view->getViewProxy();
+    auto& statistics = RenderStatistics::instance();
+    statistics.setTargetFramesPerSecond(10.0);
+    statistics.setFrameBudgetEnabled(true);
+
+    auto quality = [&](bool interactive, double frameTime) {
+      statistics.recordFrame(proxy, interactive, frameTime);
+      return statistics.statistics(proxy)["budget_quality"].toDouble();
+    };
+
+    // Frames within the 0.1 s budget keep the quality
+    QCOMPARE(quality(true, 0.08), 1.0);
+    // A slow frame scales it by the overshoot
+    QCOMPARE(quality(true, 0.4), 0.25);
+    // Still frames leave it
+    QCOMPARE(quality(false, 2.0), 0.25);
+    // It never drops below 0.1
+    QCOMPARE(quality(true, 10.0), 0.1);
+    // Fast frames raise it by a quarter, up to the full quality
+    QCOMPARE(quality(true, 0.01), 0.125);
+    QCOMPARE(quality(true, 0.07), 0.125);
+    for (int i = 0; i < 20; ++i) {
+      quality(true, 0.01);
+    }
+    QCOMPARE(quality(true, 0.01), 1.0);
+
+    // Disabling the budget restores the full quality
+    quality(true, 0.4);
+    statistics.setFrameBudgetEnabled(false);
+    QCOMPARE(statistics.statistics(proxy)["budget_quality"].toDouble(), 1.0);
+    QCOMPARE(statistics.statistics(proxy)["quality"].toDouble(), 1.0);
+
+    statistics.setTargetFramesPerSecond(15.0);
+    objBuilder->destroy(view);
+  }
+};
+
+int main(int argc, char** argv)
+{
+  QApplication app(argc, argv);
+  pqPVApplicationCore appCore(argc, argv);
+
+  // Create a builtin server connection so views and proxies can be created
+  auto* builder = pqApplicationCore::instance()->getObjectBuilder();
+  builder->createServer(pqServerResource("builtin:"));
+
+  RenderStatisticsTest tc;
+  return QTest::qExec(&tc, argc, argv);
+}
+
+#include "RenderStatisticsTest.moc"
@@ -0,0 +1,118 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizResourceUsage_h
+#define tomvizResourceUsage_h
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace tomviz {
+
+/**
+ * Process memory measurements shared by the benchmarks and the memory
+ * regression tests. All values are in bytes.
+ *
+ * The peak resident set size is a process-wide high-water mark. It can only
+ * be reset on Linux (through /proc/self/clear_refs); on other platforms
+ * resetPeakResidentSetSize() returns false and callers should run each
+ * measurement in its own process.
+ */
+class ResourceUsage
+{
+public:
+  static size_t currentResidentSetSize()
+  {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                             sizeof(counters))) {
+      return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info),
+                  &count) == KERN_SUCCESS) {
+      return info.resident_size;
+    }
+    return 0;
+#else
+    return statusField("VmRSS:");
+#endif
+  }
+
+  static size_t peakResidentSetSize()
+  {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                             sizeof(counters))) {
+      return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#elif defined(__APPLE__)
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    // ru_maxrss is reported in bytes on macOS
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    auto peak = statusField("VmHWM:");
+    if (peak == 0) {
+      rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      // ru_maxrss is reported in kilobytes on Linux
+      peak = static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+    return peak;
+#endif
+  }
+
+  /// Reset the peak resident set size to the current resident set size.
+  /// Returns false if the platform does not support it.
+  static bool resetPeakResidentSetSize()
+  {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (!clearRefs) {
+      return false;
+    }
+    clearRefs << "5";
+    clearRefs.close();
+    return !clearRefs.fail();
+#else
+    return false;
+#endif
+  }
+
+private:
+  // Read a "Name:   1234 kB" field from /proc/self/status
+  static size_t statusField(const std::string& name)
+  {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+      if (line.compare(0, name.size(), name) == 0) {
+        return std::stoull(line.substr(name.size())) * 1024;
+      }
+    }
+    return 0;
+  }
+};
+
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,112 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <gtest/gtest.h>
+
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+#include "TomographyTiltSeries.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace tomviz;
+
+namespace {
+
+// The interpolation of a single sinogram from a float copy of the tilts, as
+// it was done one slice at a time
+std::vector<float> referenceSinogram(const std::vector<float>& data,
+                                     const int dims[3], int slice, int Nray,
+                                     double axisPosition, int tiltAxis)
+{
+  const int tiltAxDim = tiltAxis == 0 ? dims[1] : dims[0];
+  const double rayWidth = static_cast<double>(tiltAxDim) / Nray;
+  std::vector<float> sinogram(Nray * dims[2], 0);
+  for (int z = 0; z < dims[2]; ++z) {
+    for (int r = 0; r < Nray; ++r) {
+      double rayCoord = (r - Nray / 2) * rayWidth + axisPosition;
+      int index[2];
+      index[0] = static_cast<int>(std::floor(rayCoord)) + tiltAxDim / 2;
+      index[1] = index[0] + 1;
+      float weight[2];
+      weight[0] = std::fabs(rayCoord - std::floor(rayCoord));
+      weight[1] = 1 - weight[0];
+      for (int n = 0; n < 2; ++n) {
+        if (index[n] < 0 || index[n] >= tiltAxDim) {
+          continue;
+        }
+        size_t i = static_cast<size_t>(z) * dims[0] * dims[1] +
+                   (tiltAxis == 0 ? index[n] * dims[0] + slice
+                                  : slice * dims[0] + index[n]);
+        sinogram[z * Nray + r] += data[i] * weight[n];
+      }
+    }
+  }
+  return sinogram;
+}
+
+} // namespace
+
+class TomographyTiltSeriesTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    image->SetDimensions(dims);
+    image->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+    auto* data = static_cast<uint16_t*>(image->GetScalarPointer());
+    for (size_t i = 0; i < static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+         ++i) {
+      data[i] = static_cast<uint16_t>((i * 7919) % 4093);
+      values.push_back(data[i]);
+    }
+  }
+
+  const int dims[3] = { 23, 17, 9 };
+  vtkNew<vtkImageData> image;
+  std::vector<float> values;
+};
+
+TEST_F(TomographyTiltSeriesTest, sinograms_match_single_extraction)
+{
+  const int Nray = 32;
+  for (int tiltAxis = 0; tiltAxis < 2; ++tiltAxis) {
+    // Shifts that move rays off of both sides of the tilts
+    const int slices[] = { 0, 8, tiltAxis == 0 ? 22 : 16 };
+    const double shifts[] = { -3.25, 0.0, 12.5 };
+    std::vector<std::vector<float>> sinograms(3);
+    float* pointers[3];
+    for (int s = 0; s < 3; ++s) {
+      sinograms[s].resize(Nray * dims[2]);
+      pointers[s] = sinograms[s].data();
+    }
+    TomographyTiltSeries::getSinograms(image, 3, slices, shifts, pointers,
+                                       Nray, tiltAxis);
+
+    for (int s = 0; s < 3; ++s) {
+      auto expected = referenceSinogram(values, dims, slices[s], Nray,
+                                        shifts[s], tiltAxis);
+      for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_FLOAT_EQ(sinograms[s][i], expected[i]);
+      }
+    }
+  }
+}
+
+TEST_F(TomographyTiltSeriesTest, sum)
+{
+  std::vector<double> sum(dims[0] * dims[1], -1.0);
+  TomographyTiltSeries::sumTiltSeries(image, sum.data());
+  for (int y = 0; y < dims[1]; ++y) {
+    for (int x = 0; x < dims[0]; ++x) {
+      double expected = 0;
+      for (int z = 0; z < dims[2]; ++z) {
+        expected += values[(z * dims[1] + y) * dims[0] + x];
+      }
+      ASSERT_DOUBLE_EQ(sum[y * dims[0] + x], expected);
+    }
+  }
+}
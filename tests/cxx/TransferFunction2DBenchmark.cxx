@@ -0,0 +1,195 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+// Measures the latency of redrawing a 2D transfer function while one of its
+// boxes is dragged across the histogram. Every step is redrawn both from
+// scratch, clearing the image and rastering each box as
+// vtkChartTransfer2DEditor used to, and incrementally with a
+// TransferFunction2DRaster, and the two images are checked to match.
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+#include <vtkColorTransferFunction.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointData.h>
+#include <vtkRect.h>
+#include <vtkSmartPointer.h>
+
+#include "TransferFunction2DRaster.h"
+#include "vtkTransferFunctionBoxItem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using namespace tomviz;
+
+namespace {
+
+struct Box
+{
+  vtkRectd rect;
+  vtkSmartPointer<vtkColorTransferFunction> color;
+  vtkSmartPointer<vtkPiecewiseFunction> opacity;
+};
+
+struct Latency
+{
+  QString method;
+  std::vector<double> ms;
+
+  double percentile(double p) const
+  {
+    std::vector<double> sorted(ms);
+    std::sort(sorted.begin(), sorted.end());
+    auto i = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+  }
+
+  double mean() const
+  {
+    double sum = 0.0;
+    for (double m : ms) {
+      sum += m;
+    }
+    return ms.empty() ? 0.0 : sum / ms.size();
+  }
+};
+
+std::vector<Box> makeBoxes(int bins, int count)
+{
+  std::vector<Box> boxes;
+  for (int i = 0; i < count; ++i) {
+    Box box;
+    // Spread the boxes along the diagonal, overlapping their neighbours
+    const double size = bins / 5.0;
+    const double offset = (bins - size) * (i + 0.5) / count;
+    box.rect.Set(offset, offset * 0.8, size, size * 0.75);
+    box.color = vtkSmartPointer<vtkColorTransferFunction>::New();
+    box.color->AddRGBPoint(0.0, 0.1 * i, 0.2, 1.0);
+    box.color->AddRGBPoint(255.0, 1.0, 0.5, 0.1 * i);
+    box.opacity = vtkSmartPointer<vtkPiecewiseFunction>::New();
+    box.opacity->AddPoint(0.0, 0.0);
+    box.opacity->AddPoint(255.0, 0.8);
+    boxes.push_back(box);
+  }
+  return boxes;
+}
+
+// The 2D transfer function redrawn from scratch
+void rasterAll(vtkImageData* histogram, const std::vector<Box>& boxes,
+               vtkImageData* transfer)
+{
+  auto array =
+    vtkFloatArray::SafeDownCast(transfer->GetPointData()->GetScalars());
+  std::memset(array->GetVoidPointer(0), 0,
+              array->GetNumberOfValues() * sizeof(float));
+  for (const auto& box : boxes) {
+    vtkTransferFunctionBoxItem::rasterTransferFunction2DBox(
+      histogram, box.rect, transfer, box.color, box.opacity);
+  }
+}
+
+double elapsedMs(const std::function<void()>& f)
+{
+  QElapsedTimer timer;
+  timer.start();
+  f();
+  return timer.nsecsElapsed() / 1e6;
+}
+
+bool sameImage(vtkImageData* a, vtkImageData* b)
+{
+  auto x = vtkFloatArray::SafeDownCast(a->GetPointData()->GetScalars());
+  auto y = vtkFloatArray::SafeDownCast(b->GetPointData()->GetScalars());
+  return x->GetNumberOfValues() == y->GetNumberOfValues() &&
+         std::equal(x->GetPointer(0),
+                    x->GetPointer(0) + x->GetNumberOfValues(),
+                    y->GetPointer(0));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  QCoreApplication app(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("tomviz 2D transfer function benchmark");
+  parser.addHelpOption();
+  QCommandLineOption binsOption("bins", "Bins along each histogram axis.",
+                                "bins", "1024");
+  QCommandLineOption boxesOption("boxes", "Number of boxes.", "count", "4");
+  QCommandLineOption stepsOption("steps", "Drag steps.", "count", "300");
+  parser.addOptions({ binsOption, boxesOption, stepsOption });
+  parser.process(app);
+
+  const int bins = std::max(16, parser.value(binsOption).toInt());
+  const int count = std::max(1, parser.value(boxesOption).toInt());
+  const int steps = std::max(1, parser.value(stepsOption).toInt());
+
+  vtkNew<vtkImageData> histogram;
+  histogram->SetDimensions(bins, bins, 1);
+  histogram->SetSpacing(1.0, 1.0, 1.0);
+
+  vtkNew<vtkImageData> full;
+  full->SetDimensions(bins, bins, 1);
+  full->AllocateScalars(VTK_FLOAT, 4);
+  vtkNew<vtkImageData> incremental;
+
+  auto boxes = makeBoxes(bins, count);
+  TransferFunction2DRaster raster;
+  raster.setHistogram(histogram);
+  for (int i = 0; i < count; ++i) {
+    raster.setBox(i, boxes[i].rect, boxes[i].color, boxes[i].opacity);
+  }
+  raster.update(incremental);
+
+  Latency scratch{ "from scratch", {} };
+  Latency layers{ "incremental", {} };
+  bool matches = true;
+  for (int step = 0; step < steps; ++step) {
+    // Drag the first box back and forth across the histogram
+    auto& rect = boxes[0].rect;
+    const double dx = (step / 100) % 2 == 0 ? 3.0 : -3.0;
+    rect.SetX(std::min(std::max(rect.GetX() + dx, 0.0),
+                       bins - rect.GetWidth()));
+    rect.SetY(std::min(std::max(rect.GetY() + dx / 2, 0.0),
+                       bins - rect.GetHeight()));
+
+    scratch.ms.push_back(
+      elapsedMs([&]() { rasterAll(histogram, boxes, full); }));
+    layers.ms.push_back(elapsedMs([&]() {
+      raster.setBox(0, rect, boxes[0].color, boxes[0].opacity);
+      raster.update(incremental);
+    }));
+    matches = matches && sameImage(full, incremental);
+  }
+
+  QTextStream out(stdout);
+  out << "bins " << bins << " x " << bins << ", " << count << " boxes, "
+      << steps << " drag steps\n";
+  out << "method | mean ms | median ms | p95 ms | max ms\n";
+  for (const auto& latency : { scratch, layers }) {
+    out << latency.method << " | " << QString::number(latency.mean(), 'f', 3)
+        << " | " << QString::number(latency.percentile(0.5), 'f', 3) << " | "
+        << QString::number(latency.percentile(0.95), 'f', 3) << " | "
+        << QString::number(latency.percentile(1.0), 'f', 3) << "\n";
+  }
+  out.flush();
+
+  if (!matches) {
+    std::cerr << "The incremental transfer function differs from the one "
+                 "rastered from scratch" << std::endl;
+    return 1;
+  }
+  return 0;
+}
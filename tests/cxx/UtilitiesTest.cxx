@@ -4,9 +4,13 @@
 #include <gtest/gtest.h>
 
 #include <vtkDoubleArray.h>
+#include <vtkIntArray.h>
 #include <vtkNew.h>
 #include <vtkTable.h>
 
+#include <QBuffer>
+#include <QJsonDocument>
+
 #include "TomvizTest.h"
 #include "Utilities.h"
 
@@ -118,3 +122,81 @@ TEST_F(UtilitiesTest, table_to_csv_single_row)
   ASSERT_STREQ(lines[0].toLatin1().constData(), "x,y");
   ASSERT_STREQ(lines[1].toLatin1().constData(), "42,99");
 }
+
+TEST_F(UtilitiesTest, table_to_csv_keeps_precision)
+{
+  vtkNew<vtkTable> table;
+
+  vtkNew<vtkDoubleArray> colX;
+  colX->SetName("x");
+  colX->SetNumberOfTuples(1);
+  colX->SetValue(0, 0.1234567891);
+  table->AddColumn(colX);
+
+  QString csv = tableToCsv(table);
+  QStringList lines = csv.split("\n");
+
+  ASSERT_EQ(lines.size(), 2);
+  ASSERT_EQ(lines[1].toDouble(), 0.1234567891);
+}
+
+TEST_F(UtilitiesTest, write_table_csv_many_rows)
+{
+  // More rows than are formatted in one block
+  const vtkIdType rows = 100000;
+  vtkNew<vtkTable> table;
+
+  vtkNew<vtkDoubleArray> colX;
+  colX->SetName("x");
+  colX->SetNumberOfTuples(rows);
+  vtkNew<vtkIntArray> colY;
+  colY->SetName("y");
+  colY->SetNumberOfTuples(rows);
+  for (vtkIdType i = 0; i < rows; ++i) {
+    colX->SetValue(i, i * 0.5);
+    colY->SetValue(i, static_cast<int>(i));
+  }
+  table->AddColumn(colX);
+  table->AddColumn(colY);
+
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  ASSERT_TRUE(writeTableCsv(table, &buffer));
+  QList<QByteArray> lines = buffer.data().split('\n');
+
+  ASSERT_EQ(lines.size(), rows + 1);
+  for (vtkIdType i = 0; i < rows; i += 997) {
+    QList<QByteArray> fields = lines[i + 1].split(',');
+    ASSERT_EQ(fields.size(), 2);
+    ASSERT_EQ(fields[0].toDouble(), i * 0.5);
+    ASSERT_EQ(fields[1].toLongLong(), i);
+  }
+}
+
+TEST_F(UtilitiesTest, write_table_json_rows)
+{
+  vtkNew<vtkTable> table;
+
+  vtkNew<vtkDoubleArray> colX;
+  colX->SetName("x");
+  colX->SetNumberOfTuples(3);
+  vtkNew<vtkIntArray> colY;
+  colY->SetName("y");
+  colY->SetNumberOfTuples(3);
+  for (int i = 0; i < 3; ++i) {
+    colX->SetValue(i, i + 0.25);
+    colY->SetValue(i, 10 * i);
+  }
+  table->AddColumn(colX);
+  table->AddColumn(colY);
+
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  ASSERT_TRUE(writeTableJson(table, &buffer));
+
+  // The same rows as tableToJson
+  QJsonParseError error;
+  auto document = QJsonDocument::fromJson(buffer.data(), &error);
+  ASSERT_EQ(error.error, QJsonParseError::NoError);
+  ASSERT_EQ(document, tableToJson(table));
+}
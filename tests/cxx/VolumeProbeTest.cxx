@@ -0,0 +1,138 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <gtest/gtest.h>
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkTable.h>
+
+#include "VolumeProbe.h"
+
+#include <cmath>
+
+using namespace tomviz;
+
+class VolumeProbeTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // A linear field, which trilinear sampling reproduces exactly, on an
+    // extent that does not start at 0
+    image->SetExtent(2, 9, 0, 5, 1, 4);
+    image->SetOrigin(-1.0, 10.0, 0.0);
+    image->SetSpacing(0.5, 1.0, 2.0);
+    image->AllocateScalars(VTK_FLOAT, 2);
+    for (int k = 1; k <= 4; ++k) {
+      for (int j = 0; j <= 5; ++j) {
+        for (int i = 2; i <= 9; ++i) {
+          auto* voxel = static_cast<float*>(image->GetScalarPointer(i, j, k));
+          voxel[0] = static_cast<float>(field(i, j, k));
+          voxel[1] = static_cast<float>(-field(i, j, k));
+        }
+      }
+    }
+    image->GetPointData()->GetScalars()->SetName("values");
+  }
+
+  static double field(double i, double j, double k)
+  {
+    return i + 10 * j + 100 * k;
+  }
+
+  vtkNew<vtkImageData> image;
+};
+
+TEST_F(VolumeProbeTest, voxel_value)
+{
+  VolumeProbe probe(image);
+  ASSERT_TRUE(probe.isValid());
+  ASSERT_EQ(probe.numberOfComponents(), 2);
+
+  // Nearest to voxel (4, 3, 2)
+  const double point[3] = { 1.1, 12.9, 4.3 };
+  int ijk[3];
+  double value = 0;
+  ASSERT_TRUE(probe.voxelValue(point, ijk, value));
+  ASSERT_EQ(ijk[0], 4);
+  ASSERT_EQ(ijk[1], 3);
+  ASSERT_EQ(ijk[2], 2);
+  ASSERT_DOUBLE_EQ(value, field(4, 3, 2));
+  ASSERT_TRUE(probe.voxelValue(point, ijk, value, 1));
+  ASSERT_DOUBLE_EQ(value, -field(4, 3, 2));
+
+  const double outside[3] = { -2.0, 12.0, 4.0 };
+  ASSERT_FALSE(probe.voxelValue(outside, ijk, value));
+  ASSERT_FALSE(probe.voxelValue(point, ijk, value, 2));
+}
+
+TEST_F(VolumeProbeTest, trilinear_sample)
+{
+  VolumeProbe probe(image);
+  const double point[3] = { 1.3, 11.25, 5.5 };
+  double value = 0;
+  ASSERT_TRUE(probe.sample(point, value));
+  ASSERT_NEAR(value, field(4.6, 1.25, 2.75), 1e-4);
+
+  // The last voxels along each axis are sampled without reading past them
+  const double corner[3] = { 3.5, 15.0, 8.0 };
+  ASSERT_TRUE(probe.sample(corner, value));
+  ASSERT_NEAR(value, field(9, 5, 4), 1e-4);
+}
+
+TEST_F(VolumeProbeTest, line_profile)
+{
+  VolumeProbe probe(image);
+  const double point1[3] = { 0.0, 10.0, 2.0 };
+  const double point2[3] = { 3.0, 14.0, 8.0 };
+  auto profile = probe.lineProfile(point1, point2);
+
+  // A distance column and one per component, a sample per voxel along x
+  ASSERT_EQ(profile->GetNumberOfColumns(), 3);
+  ASSERT_STREQ(profile->GetColumn(0)->GetName(), "Distance");
+  auto rows = profile->GetNumberOfRows();
+  ASSERT_EQ(rows, 7);
+
+  auto* distance = vtkDataArray::SafeDownCast(profile->GetColumn(0));
+  auto* values = vtkDataArray::SafeDownCast(profile->GetColumn(1));
+  auto* negated = vtkDataArray::SafeDownCast(profile->GetColumn(2));
+  const double length = std::sqrt(3.0 * 3.0 + 4.0 * 4.0 + 6.0 * 6.0);
+  ASSERT_DOUBLE_EQ(distance->GetTuple1(rows - 1), length);
+  for (vtkIdType s = 0; s < rows; ++s) {
+    double t = static_cast<double>(s) / (rows - 1);
+    double expected = field(2 + 6 * t, 4 * t, 1 + 3 * t);
+    ASSERT_NEAR(values->GetTuple1(s), expected, 1e-3);
+    ASSERT_NEAR(negated->GetTuple1(s), -expected, 1e-3);
+  }
+
+  // Samples outside of the image are not numbers
+  const double outside[3] = { 6.0, 14.0, 8.0 };
+  profile = probe.lineProfile(point1, outside, 11);
+  ASSERT_EQ(profile->GetNumberOfRows(), 11);
+  values = vtkDataArray::SafeDownCast(profile->GetColumn(1));
+  ASSERT_FALSE(std::isnan(values->GetTuple1(0)));
+  ASSERT_TRUE(std::isnan(values->GetTuple1(10)));
+}
+
+TEST_F(VolumeProbeTest, follows_modified_data)
+{
+  VolumeProbe probe(image);
+  const double point[3] = { 0.0, 10.0, 2.0 };
+  double value = 0;
+  ASSERT_TRUE(probe.sample(point, value));
+  ASSERT_DOUBLE_EQ(value, field(2, 0, 1));
+
+  image->GetPointData()->GetScalars()->SetComponent(0, 0, 42.0);
+  image->GetPointData()->GetScalars()->Modified();
+  probe.update(image);
+  ASSERT_TRUE(probe.sample(point, value));
+  ASSERT_DOUBLE_EQ(value, 42.0);
+
+  // Moving the origin moves the samples
+  image->SetOrigin(0.0, 10.0, 2.0);
+  probe.update(image);
+  ASSERT_FALSE(probe.sample(point, value));
+}
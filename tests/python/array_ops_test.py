@@ -0,0 +1,125 @@
+import numpy as np
+import pytest
+
+from utils import load_operator_module
+
+from tomviz.external_dataset import Dataset
+
+
+def _volume(shape, dtype=np.float32, seed=0):
+    rng = np.random.RandomState(seed)
+    return np.asfortranarray(rng.uniform(-100, 100, shape).astype(dtype))
+
+
+@pytest.mark.parametrize('mode', ['constant', 'edge', 'wrap'])
+@pytest.mark.parametrize('dtype', [np.int16, np.float64, np.complex128])
+def test_pad(mode, dtype, native):
+    array = _volume((9, 6, 4), dtype)
+    before = [2, 0, 7]
+    after = [11, 3, 1]
+    result = native.pad(array, before, after, mode)
+    assert np.isfortran(result)
+    np.testing.assert_array_equal(
+        result, np.pad(array, list(zip(before, after)), mode))
+
+
+@pytest.mark.parametrize('axis', [0, 1, 2])
+def test_delete_slices(axis, native):
+    array = _volume((9, 8, 7), np.uint8)
+    result = native.delete_slices(array, 2, 4, axis)
+    assert np.isfortran(result)
+    np.testing.assert_array_equal(result, np.delete(array, [2, 3, 4], axis))
+
+    with pytest.raises(ValueError):
+        native.delete_slices(array, 3, 2, axis)
+
+
+@pytest.mark.parametrize('axes', [(0, 1), (0, 2), (1, 2), (2, 0), (1, 1)])
+def test_swap_axes(axes, native):
+    array = _volume((70, 45, 33), np.int32)
+    result = native.swap_axes(array, *axes)
+    assert np.isfortran(result)
+    np.testing.assert_array_equal(result, array.swapaxes(*axes))
+
+    # C ordered arrays are converted
+    result = native.swap_axes(np.ascontiguousarray(array), *axes)
+    np.testing.assert_array_equal(result, array.swapaxes(*axes))
+
+
+@pytest.mark.parametrize('dtype', [np.uint16, np.float32, np.float64])
+def test_hann_window(dtype, native):
+    array = _volume((12, 9, 1), dtype)
+    if dtype == np.uint16:
+        array = np.asfortranarray(np.abs(array.astype(np.int32)), dtype=dtype)
+
+    expected = array.astype(np.float32)
+    for axis, size in enumerate(array.shape):
+        shape = [1] * array.ndim
+        shape[axis] = size
+        expected *= np.hanning(size).reshape(shape)
+    expected = expected.astype(dtype)
+
+    native.hann_window(array)
+    np.testing.assert_array_equal(array, expected)
+
+
+def test_in_place_needs_fortran_order(native):
+    array = np.ascontiguousarray(_volume((5, 4, 3)))
+    with pytest.raises(ValueError):
+        native.hann_window(array)
+
+
+@pytest.mark.parametrize('axis', [0, 1, 2])
+def test_circle_mask(axis, native):
+    array = _volume((10, 13, 8))
+    expected = np.moveaxis(array.copy(), axis, 0)
+    _, n1, n2 = expected.shape
+    rad1, rad2 = n1 / 2, n2 / 2
+    y, x = np.ogrid[0.5 - rad1:0.5 + rad1, 0.5 - rad2:0.5 + rad2]
+    r = 0.8 * min(rad1, rad2)
+    expected[:, ~(x * x + y * y < r * r)] = -1
+    expected = np.moveaxis(expected, 0, axis)
+
+    native.circle_mask(array, axis, 0.8, -1)
+    np.testing.assert_array_equal(array, expected)
+
+
+def test_clip_edges(native):
+    array = _volume((4, 20, 15), np.int16)
+    expected = array.copy()
+    num_x, num_y = array.shape[1:]
+    max_r = min(num_x, num_y) / 2 - 3
+    xx, yy = np.mgrid[0:num_x, 0:num_y]
+    rr = np.sqrt((xx - num_x / 2) ** 2 + (yy - num_y / 2) ** 2)
+    expected[:, rr >= max_r] = array.min()
+
+    native.clip_edges(array, 3)
+    np.testing.assert_array_equal(array, expected)
+
+
+@pytest.mark.parametrize('dtype', [np.int8, np.int16, np.int32])
+def test_reinterpret_signed_to_unsigned(dtype, native):
+    info = np.iinfo(dtype)
+    array = np.asfortranarray(
+        np.array([[[info.min, -1], [0, info.max]]], dtype=dtype))
+    expected = array.astype(f'u{array.itemsize}') - info.min
+
+    dataset = Dataset({'data': array}, 'data')
+    load_operator_module('ReinterpretSignedToUnsigned').transform(dataset)
+    result = dataset.active_scalars
+    assert result.dtype == expected.dtype
+    np.testing.assert_array_equal(result, expected)
+    # The values were changed in place
+    assert np.shares_memory(result, array)
+
+
+def test_operators_chain_without_copies(native):
+    array = _volume((16, 12, 10))
+    dataset = Dataset({'data': array}, 'data')
+    load_operator_module('HannWindow3D').transform(dataset)
+    load_operator_module('ClipEdges').transform(dataset, clipNum=2)
+    assert dataset.active_scalars is array
+
+    load_operator_module('SwapAxes').transform(dataset, axis1=0, axis2=2)
+    assert dataset.active_scalars.shape == (10, 12, 16)
+    assert np.isfortran(dataset.active_scalars)
@@ -0,0 +1,131 @@
+import json
+
+import h5py
+import numpy as np
+
+from click.testing import CliRunner
+
+from tomviz import executor
+from tomviz.cli import main
+from tomviz.cli.batch import MANIFEST_NAME
+from tomviz.external_dataset import Dataset
+
+
+DOUBLE_SCRIPT = '''
+def transform(dataset):
+    dataset.active_scalars = dataset.active_scalars * 2
+'''
+
+
+def _write_input(path, seed):
+    array = np.random.default_rng(seed).random((8, 9, 10)).astype(np.float32)
+    executor._write_emd(str(path), Dataset({'data': array}, 'data'))
+    return array
+
+
+def _read_output(path):
+    with h5py.File(path, 'r') as f:
+        return f['data/tomography/data'][:]
+
+
+def _write_state(tmp_path, input_name):
+    state = {
+        'dataSources': [{
+            'id': '0x1',
+            'reader': {'fileNames': [input_name]},
+            'operators': [{
+                'type': 'Python',
+                'label': 'Double',
+                'script': DOUBLE_SCRIPT,
+                'arguments': {},
+            }],
+        }],
+    }
+    path = tmp_path / 'state.tvsm'
+    path.write_text(json.dumps(state))
+    return path
+
+
+def test_batch_resumes(tmp_path):
+    input_dir = tmp_path / 'input'
+    output_dir = tmp_path / 'output'
+    input_dir.mkdir()
+    output_dir.mkdir()
+
+    inputs = {'f%d' % i: _write_input(input_dir / ('f%d.emd' % i), i)
+              for i in range(4)}
+    state_path = _write_state(tmp_path, 'input/f0.emd')
+
+    args = ['-s', str(state_path), '-d', str(input_dir), '-o',
+            str(output_dir), '-j', '2']
+
+    def run():
+        result = CliRunner().invoke(main, args)
+        assert result.exit_code == 0, result.output
+        return {name: (output_dir / ('%s_transformed.emd' % name))
+                for name in inputs}
+
+    outputs = run()
+    for name, array in inputs.items():
+        assert np.allclose(_read_output(outputs[name]), array * 2)
+
+    with open(output_dir / MANIFEST_NAME) as fp:
+        manifest = json.load(fp)
+    assert len(manifest['files']) == len(inputs)
+
+    # A rerun skips the finished files
+    written = {name: path.stat().st_mtime_ns
+               for name, path in outputs.items()}
+    run()
+    assert all(path.stat().st_mtime_ns == written[name]
+               for name, path in outputs.items())
+
+    # but not a changed input, nor a removed output
+    inputs['f1'] = _write_input(input_dir / 'f1.emd', 10)
+    outputs['f2'].unlink()
+    run()
+    for name, array in inputs.items():
+        assert np.allclose(_read_output(outputs[name]), array * 2)
+    assert outputs['f0'].stat().st_mtime_ns == written['f0']
+    assert outputs['f3'].stat().st_mtime_ns == written['f3']
+
+
+def _progress_messages(path):
+    count = len(list(path.glob('progress*')))
+    return [json.loads((path / ('progress%d' % i)).read_text())
+            for i in range(count)]
+
+
+def test_batch_progress_files(tmp_path):
+    input_dir = tmp_path / 'input'
+    output_dir = tmp_path / 'output'
+    progress_dir = tmp_path / 'progress'
+    for path in (input_dir, output_dir, progress_dir):
+        path.mkdir()
+
+    inputs = {'f%d' % i: _write_input(input_dir / ('f%d.emd' % i), i)
+              for i in range(2)}
+    state_path = _write_state(tmp_path, 'input/f0.emd')
+
+    args = ['-s', str(state_path), '-d', str(input_dir), '-o',
+            str(output_dir), '-j', '2', '-p', 'files', '-u',
+            str(progress_dir)]
+    result = CliRunner().invoke(main, args)
+    assert result.exit_code == 0, result.output
+
+    # Each file has its own output and a whole progress stream
+    for name, array in inputs.items():
+        output = output_dir / ('%s_transformed.emd' % name)
+        assert np.allclose(_read_output(output), array * 2)
+
+        messages = _progress_messages(progress_dir / ('%s.emd' % name))
+        assert messages[0] == {'type': 'started'}
+        assert messages[-1] == {'type': 'finished'}
+        assert sum(m['type'] == 'started' for m in messages) == 2
+        assert sum(m['type'] == 'finished' for m in messages) == 2
+
+    # Concurrent files can not share a socket
+    args[args.index('files')] = 'socket'
+    result = CliRunner().invoke(main, args)
+    assert result.exit_code != 0
+    assert 'socket' in str(result.exception)
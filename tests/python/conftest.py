@@ -1,11 +1,14 @@
+import contextlib
 import pytest
 import requests
 import diskcache
 import tempfile
 import os
 from pathlib import Path
+import sys
 import tarfile
 import shutil
+from unittest.mock import patch
 
 import numpy as np
 
@@ -14,9 +17,54 @@ from tomviz.external_dataset import Dataset
 
 from utils import download_file, download_and_unzip_file
 
+try:
+    import tomviz._native as _native
+except ImportError:
+    _native = None
+
 DATA_URL = 'https://data.kitware.com/api/v1/file'
 
 
+@pytest.fixture
+def native():
+    """The native module. The tests that use it are skipped without it."""
+    if _native is None:
+        pytest.skip('The native module is not available')
+    return _native
+
+
+@pytest.fixture
+def without_native():
+    """A context manager under which operator modules run their Python
+    fallback: the names they bound to the native module, or to anything the
+    native module exports, are set to None, and importing tomviz._native
+    fails. Without the native module, it changes nothing."""
+    exported = set()
+    if _native is not None:
+        exported = {id(x) for x in vars(_native).values() if callable(x)}
+        exported.add(id(_native))
+
+    @contextlib.contextmanager
+    def context(*modules):
+        with contextlib.ExitStack() as stack:
+            stack.enter_context(
+                patch.dict(sys.modules, {'tomviz._native': None}))
+            for module in modules:
+                for (name, value) in list(vars(module).items()):
+                    if id(value) in exported:
+                        stack.enter_context(patch.object(module, name, None))
+            yield
+
+    return context
+
+
+@pytest.fixture
+def fallback(native, without_native):
+    """without_native, for the tests that compare the native module with the
+    fallback. They are skipped without the native module."""
+    return without_native
+
+
 @pytest.fixture
 def data_dir() -> Path:
     return Path(__file__).parent / 'data'
@@ -0,0 +1,140 @@
+import numpy as np
+import pytest
+
+from utils import load_operator_class, load_operator_module
+
+from tomviz.executor import OperatorWrapper
+from tomviz.external_dataset import Dataset
+
+
+def _make_dataset():
+    rng = np.random.RandomState(0)
+    x, y, z = np.mgrid[:20, :18, :16]
+    clean = ((x - 10)**2 + (y - 9)**2 + (z - 8)**2 < 36).astype(np.float32)
+    noisy = clean + rng.normal(0, 0.3, clean.shape).astype(np.float32)
+    dataset = Dataset({'noisy': np.asfortranarray(noisy)})
+    dataset.spacing = [1.0, 1.0, 1.0]
+    return dataset, clean
+
+
+def _rms(a, b):
+    return np.sqrt(np.mean((a - b)**2))
+
+
+def test_native_tv_matches_skimage(native):
+    restoration = pytest.importorskip('skimage.restoration')
+
+    dataset, clean = _make_dataset()
+    tv = native.TotalVariationDenoise(dataset.active_scalars, 0.2)
+    tv.iterate(50)
+    denoised = tv.result
+
+    expected = restoration.denoise_tv_chambolle(
+        dataset.active_scalars, weight=0.2, max_num_iter=50)
+    assert denoised.shape == expected.shape
+    np.testing.assert_allclose(denoised, expected, atol=1e-3)
+    assert _rms(denoised, clean) < 0.5 * _rms(dataset.active_scalars, clean)
+
+
+def test_native_tv_filter(fallback):
+    module = load_operator_module('TV_Filter')
+
+    x, y = np.mgrid[:32, :32]
+    clean = np.exp(-((x - 16)**2 + (y - 16)**2) / 50.0)
+    striped = clean + 0.2 * (x % 4 == 0)
+    volume = np.asfortranarray(np.dstack([striped, 0.5 * striped, striped.T]))
+
+    class Wrapper(OperatorWrapper):
+        def __init__(self):
+            self.published = []
+
+        @property
+        def progress_data(self):
+            return self.published[-1]
+
+        @progress_data.setter
+        def progress_data(self, value):
+            self.published.append(value.active_scalars.copy())
+
+    def run():
+        np.random.seed(0)
+        dataset = Dataset({'striped': volume.copy(order='F')})
+        operator = load_operator_class(module)
+        operator._operator_wrapper = Wrapper()
+        result = operator.transform(dataset, Niter=5, wedgeSize=10, kmin=2)
+        filtered = result['filtered'].active_scalars
+        published = operator._operator_wrapper.published
+        # The input is left as is, and the last published images are the
+        # result
+        np.testing.assert_array_equal(dataset.active_scalars, volume)
+        np.testing.assert_array_equal(published[-1], filtered)
+        return filtered, len(published)
+
+    (result, published) = run()
+    with fallback(module):
+        (expected, _) = run()
+
+    # The same descent, on all of the images at once, publishing the images
+    # after every iteration
+    assert published == 5
+    assert result.shape == volume.shape
+    np.testing.assert_allclose(result, expected, rtol=1e-6, atol=1e-7)
+
+
+def test_native_perona_malik_matches_itk(fallback):
+    module = load_operator_module('PeronaMalikAnisotropicDiffusion')
+    pytest.importorskip('itk')
+
+    dataset, clean = _make_dataset()
+    noisy = dataset.active_scalars.copy(order='F')
+
+    def run():
+        dataset.active_scalars = noisy.copy(order='F')
+        operator = load_operator_class(module)
+        operator.transform(dataset, conductance=1.0, iterations=10,
+                           timestep=0.0625)
+        return dataset.active_scalars
+
+    result = run()
+    with fallback(module):
+        expected = run()
+
+    assert result.shape == expected.shape
+    np.testing.assert_allclose(result, expected, atol=1e-4)
+    assert _rms(result, clean) < _rms(noisy, clean)
+
+
+def test_native_perona_malik_progress_and_cancel(native):
+    module = load_operator_module('PeronaMalikAnisotropicDiffusion')
+
+    dataset, _ = _make_dataset()
+    noisy = dataset.active_scalars.copy(order='F')
+
+    class Wrapper(OperatorWrapper):
+        def __init__(self, cancel_at):
+            self.values = []
+            self.cancel_at = cancel_at
+
+        @property
+        def progress_value(self):
+            return self.values[-1]
+
+        @progress_value.setter
+        def progress_value(self, value):
+            self.values.append(value)
+            self.canceled = value == self.cancel_at
+
+    def run(cancel_at):
+        operator = load_operator_class(module)
+        operator._operator_wrapper = Wrapper(cancel_at)
+        operator.transform(dataset, iterations=10)
+        return operator._operator_wrapper.values
+
+    # Progress is reported after every iteration
+    assert run(None) == list(range(11))
+    assert not np.array_equal(dataset.active_scalars, noisy)
+
+    # and a canceled run stops after the current one, leaving the input
+    dataset.active_scalars = noisy.copy(order='F')
+    assert run(3) == [0, 1, 2, 3]
+    np.testing.assert_array_equal(dataset.active_scalars, noisy)
@@ -0,0 +1,60 @@
+import numpy as np
+import pytest
+
+from utils import load_operator_module
+
+from tomviz.external_dataset import Dataset
+
+
+def _images(shape, seed=0):
+    rng = np.random.RandomState(seed)
+    return np.asfortranarray(rng.uniform(0, 1, shape).astype(np.float32))
+
+
+@pytest.mark.parametrize('ctf_method', [0, 1, 2])
+def test_native_ctf_correct_matches_numpy(ctf_method, fallback):
+    module = load_operator_module('ctf_correct')
+    images = _images((32, 30, 4))
+
+    def run():
+        dataset = Dataset({'images': images.copy(order='F')})
+        module.transform(dataset, apix=2.0, df1=1.5, df2=1.2, ast=30.0,
+                         ampcon=0.1, cs=2.7, kev=300.0,
+                         ctf_method=ctf_method, snr=0.1)
+        return dataset.active_scalars
+
+    result = run()
+    with fallback(module):
+        expected = run()
+
+    np.testing.assert_allclose(result, expected, atol=1e-4)
+
+
+def test_native_wiener_filter_matches_numpy(fallback):
+    module = load_operator_module('WienerFilter')
+    volume = _images((16, 14, 12))
+
+    def run():
+        dataset = Dataset({'volume': volume.copy(order='F')})
+        module.transform(dataset, SX=0.5, SY=0.6, SZ=0.7, noise=15.0)
+        return dataset.active_scalars
+
+    result = run()
+    with fallback(module):
+        expected = run()
+
+    np.testing.assert_allclose(result, expected, atol=1e-5)
+
+
+def test_native_admm_matches_numpy(native):
+    module = load_operator_module('DeconvolutionDenoise')
+    images = _images((24, 20, 3))
+    psfs = np.stack([module.gauss((5, 5), w) for w in (0.8, 1.0, 1.5)],
+                    axis=2)
+
+    result = native.deconvolve_admm(images, psfs, 0.5, 20)
+    for i in range(images.shape[2]):
+        expected, _, _, _ = module.deconv_admm(
+            images[:, :, i].astype(np.float64), psfs[:, :, i], 0.5,
+            max_iter=20)
+        np.testing.assert_allclose(result[:, :, i], expected, atol=1e-4)
@@ -0,0 +1,32 @@
+import numpy as np
+import pytest
+
+from utils import load_operator_class, load_operator_module
+
+from tomviz.external_dataset import Dataset
+
+
+def _generate(module, volume, **kwargs):
+    dataset = Dataset({'volume': volume.copy(order='F')})
+    dataset.spacing = [1.0, 1.0, 1.0]
+    operator = load_operator_class(module)
+    operator.transform(dataset, **kwargs)
+    return dataset
+
+
+@pytest.mark.parametrize('shape', [(3, 16, 16), (4, 17, 11)])
+def test_native_projections_match_rotate(shape, fallback):
+    module = load_operator_module('GenerateTiltSeries')
+    rng = np.random.RandomState(0)
+    volume = np.asfortranarray(rng.rand(*shape).astype(np.float32))
+    kwargs = {'start_angle': -87.0, 'angle_increment': 7.0, 'num_tilts': 26}
+
+    result = _generate(module, volume, **kwargs)
+    with fallback(module):
+        expected = _generate(module, volume, **kwargs)
+
+    np.testing.assert_array_equal(result.tilt_angles, expected.tilt_angles)
+    assert result.active_scalars.shape == expected.active_scalars.shape
+    np.testing.assert_allclose(result.active_scalars,
+                               expected.active_scalars, rtol=1e-4,
+                               atol=1e-4)
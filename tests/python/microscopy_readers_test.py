@@ -0,0 +1,324 @@
+import struct
+
+import numpy as np
+import pytest
+
+from tomviz.io import dm, ser
+
+
+# Small DM files, laid out as DigitalMicrograph writes them: a tree of
+# groups and tags, with the counts and types in big endian order, 32 bit for
+# DM3 and 64 bit for DM4, and the values in little endian order.
+
+_DM_FORMATS = {2: '<h', 3: '<i', 4: '<H', 5: '<I', 6: '<f', 7: '<d', 8: '<B',
+               9: '<b'}
+
+# The DM image data type, and the tag type of its elements
+_DM_IMAGE_TYPES = {np.dtype(np.int16): (1, 2), np.dtype(np.float32): (2, 6),
+                   np.dtype(np.int32): (7, 3), np.dtype(np.uint16): (10, 4),
+                   np.dtype(np.uint32): (11, 5)}
+
+
+def _dm_count(version, value):
+    return struct.pack('>I' if version == 3 else '>Q', value)
+
+
+def _dm_entry(version, kind, label, body):
+    entry = struct.pack('>BH', kind, len(label)) + label.encode('latin-1')
+    if version == 4:
+        entry += _dm_count(version, len(body))
+    return entry + body
+
+
+def _dm_group_body(version, entries):
+    return b'\x00\x01' + _dm_count(version, len(entries)) + b''.join(entries)
+
+
+def _dm_group(version, label, entries):
+    return _dm_entry(version, 20, label, _dm_group_body(version, entries))
+
+
+def _dm_tag(version, label, types, payload):
+    body = b'%%%%' + _dm_count(version, len(types))
+    body += b''.join(_dm_count(version, t) for t in types)
+    return _dm_entry(version, 21, label, body + payload)
+
+
+def _dm_number(version, label, code, value):
+    return _dm_tag(version, label, [code], struct.pack(_DM_FORMATS[code],
+                                                       value))
+
+
+def _dm_string(version, label, text):
+    data = text.encode('latin-1')
+    return _dm_tag(version, label, [18], struct.pack('>I', len(data)) + data)
+
+
+def _dm_text(version, label, text):
+    # Text as an array of shorts, as the units are stored
+    return _dm_tag(version, label, [20, 4, len(text)],
+                   struct.pack('<%dH' % len(text), *map(ord, text)))
+
+
+def _dm_struct(version, label, codes, values):
+    types = [15, 0, len(codes)]
+    for code in codes:
+        types += [0, code]
+    payload = b''.join(struct.pack(_DM_FORMATS[code], value)
+                       for code, value in zip(codes, values))
+    return _dm_tag(version, label, types, payload)
+
+
+def _dm_image(version, data, data_type, element_type, scale, origin, units,
+              tags=(), dims=None):
+    # The axes of the C ordered data are listed from x, unless dims overrides
+    # them
+    if dims is None:
+        dims = [(5, n) for n in data.shape[::-1]]
+    else:
+        dims = [(7, n) for n in dims]
+    dimensions = [_dm_group(version, '', [
+        _dm_number(version, 'Origin', 6, o),
+        _dm_number(version, 'Scale', 6, s),
+        _dm_text(version, 'Units', u)]) for s, o, u in zip(scale, origin,
+                                                          units)]
+    image_data = _dm_group(version, 'ImageData', [
+        _dm_group(version, 'Calibrations', [
+            _dm_group(version, 'Dimension', dimensions)]),
+        _dm_tag(version, 'Data', [20, element_type, data.size],
+                data.tobytes()),
+        _dm_number(version, 'DataType', 3, data_type),
+        _dm_group(version, 'Dimensions', [_dm_number(version, '', code, n)
+                                          for code, n in dims])])
+    return _dm_group(version, '', [image_data,
+                                   _dm_group(version, 'ImageTags',
+                                             list(tags))])
+
+
+def _write_dm(path, version, data, scale, origin, units, dims=None):
+    tags = [
+        _dm_group(version, 'Microscope Info', [
+            _dm_group(version, 'Stage Position', [
+                _dm_number(version, 'Stage Alpha', 6, 12.5)]),
+            _dm_number(version, 'Voltage', 7, 300000.0)]),
+        _dm_string(version, 'Name', 'tomviz \xe9'),
+        _dm_struct(version, 'Region', [3, 3, 7], [1, 2, 3.5]),
+        _dm_number(version, 'Count', 4, 7),
+        _dm_number(version, 'Flag', 8, 1)]
+    thumbnail = np.arange(4, dtype=np.uint32).reshape((2, 2))
+    image_list = [
+        _dm_image(version, thumbnail, 23, 5, [1, 1], [0, 0], ['', '']),
+        _dm_image(version, data, *_DM_IMAGE_TYPES[data.dtype], scale, origin,
+                  units, tags, dims)]
+    root = _dm_group_body(version, [
+        _dm_group(version, 'ImageList', image_list),
+        _dm_number(version, 'InImageMode', 8, 1)]) + b'\x00' * 8
+    header = struct.pack('>I', version) + _dm_count(version, len(root))
+    header += struct.pack('>I', 1)
+    with open(path, 'wb') as f:
+        f.write(header + root)
+
+
+# Small SER files, laid out as TIA writes them: a header, the elements,
+# their tags, and the offsets of both
+
+_SER_TYPES = {np.dtype(np.uint16): 2, np.dtype(np.int16): 5,
+              np.dtype(np.int32): 6, np.dtype(np.float32): 7,
+              np.dtype(np.float64): 8}
+
+
+def _write_ser(path, elements, calibrations, dimensions, version=0x0220):
+    images = elements[0].ndim == 2
+    offset_format = '<q' if version == 0x0220 else '<i'
+    dims = b''
+    for size, offset, delta, element, description, units in dimensions:
+        dims += struct.pack('<iddii', size, offset, delta, element,
+                            len(description)) + description.encode()
+        dims += struct.pack('<i', len(units)) + units.encode()
+    header = struct.pack('<3h', 0x4949, 0x0197, version)
+    header += struct.pack('<4i', 0x4122 if images else 0x4120, 0x4152,
+                          len(elements), len(elements))
+    start = len(header) + struct.calcsize(offset_format) + 4 + len(dims)
+
+    body = b''
+    data_offsets = []
+    for element in elements:
+        data_offsets.append(start + len(body))
+        for offset, delta, index in calibrations:
+            body += struct.pack('<ddi', offset, delta, index)
+        body += struct.pack('<h', _SER_TYPES[element.dtype])
+        if images:
+            # The rows are stored bottom up
+            body += struct.pack('<2i', *element.shape[::-1])
+            body += np.flipud(element).tobytes()
+        else:
+            body += struct.pack('<i', element.shape[0])
+            body += element.tobytes()
+    tag_offsets = []
+    for i in range(len(elements)):
+        tag_offsets.append(start + len(body))
+        body += struct.pack('<2i', 0x4152, 1000 + i)
+    offset_array = start + len(body)
+    body += b''.join(struct.pack(offset_format, offset)
+                     for offset in data_offsets + tag_offsets)
+
+    header += struct.pack(offset_format, offset_array)
+    header += struct.pack('<i', len(dimensions)) + dims
+    with open(path, 'wb') as f:
+        f.write(header + body)
+
+
+def _assert_metadata_equal(result, expected):
+    assert set(result) == set(expected)
+    for key, value in expected.items():
+        if isinstance(value, str):
+            assert result[key] == value, key
+        else:
+            np.testing.assert_allclose(result[key], value, err_msg=key)
+
+
+@pytest.mark.parametrize('version', [3, 4])
+@pytest.mark.parametrize('dtype', [np.float32, np.int16, np.uint16])
+@pytest.mark.parametrize('shape', [(24, 17), (5, 24, 17)])
+def test_dm(tmp_path, version, dtype, shape, native):
+    rng = np.random.RandomState(version)
+    data = rng.uniform(0, 1000, shape).astype(dtype)
+    scale = [0.25, 0.5, 2.0][:len(shape)]
+    origin = [4.0, -3.0, 1.0][:len(shape)]
+    units = ['nm', '\xb5m', 'deg'][:len(shape)]
+    path = str(tmp_path / ('image.dm%d' % version))
+    _write_dm(path, version, data, scale, origin, units)
+
+    result = native.read_dm(path)
+    f = dm.FileDM(path)
+    expected = f.getDataset(0)
+    # The thumbnail is skipped
+    assert len(result['datasets']) == 1
+    dataset = result['datasets'][0]
+    assert np.isfortran(dataset['data']) or len(shape) == 1
+    assert dataset['data'].dtype == expected['data'].dtype
+    np.testing.assert_array_equal(dataset['data'], expected['data'].T)
+    np.testing.assert_allclose(dataset['scale'], expected['pixelSize'][::-1])
+    np.testing.assert_allclose(
+        dataset['origin'],
+        [-o * s for o, s in zip(expected['pixelOrigin'][::-1],
+                                expected['pixelSize'][::-1])])
+    assert dataset['units'] == expected['pixelUnit'][::-1]
+
+    # Every tag but the arrays dm.py leaves unread
+    tags = {key: value for key, value in f.allTags.items()
+            if not (isinstance(value, str) and 'unread' in value)}
+    _assert_metadata_equal(result['metadata'], tags)
+    alpha = '.ImageList.2.ImageTags.Microscope Info.Stage Position.Stage Alpha'
+    assert result['metadata'][alpha] == 12.5
+
+
+def test_dm_invalid(tmp_path, native):
+    path = str(tmp_path / 'invalid.dm4')
+    with open(path, 'wb') as f:
+        f.write(struct.pack('>I', 5) + b'\x00' * 32)
+    with pytest.raises(RuntimeError):
+        native.read_dm(path)
+
+    # A file cut short in its tags
+    _write_dm(path, 4, np.zeros((4, 4), np.float32), [1, 1], [0, 0],
+              ['', ''])
+    with open(path, 'rb') as f:
+        content = f.read()
+    with open(path, 'wb') as f:
+        f.write(content[:200])
+    with pytest.raises(RuntimeError):
+        native.read_dm(path)
+
+
+@pytest.mark.parametrize('dims', [[4, -4], [0, 4], [4, 1.5e10],
+                                  [2**32 - 1] * 4])
+def test_dm_invalid_dimensions(tmp_path, dims, native):
+    # Dimensions that are not positive, or whose bytes overflow, instead of
+    # wrapping around to sizes that pass the bounds checks
+    path = str(tmp_path / 'dimensions.dm4')
+    _write_dm(path, 4, np.zeros((4, 4), np.float32), [1, 1], [0, 0],
+              ['', ''], dims)
+    with pytest.raises(RuntimeError):
+        native.read_dm(path)
+
+
+def _ser_dataset(path):
+    f = ser.FileSER(path)
+    frames = []
+    for i in range(f.head['ValidNumberElements']):
+        data, meta = f.getDataset(i)
+        frames.append(data)
+    return f.head, np.squeeze(np.stack(frames)), meta
+
+
+def _ser_metadata(head):
+    metadata = {key: value for key, value in head.items()
+                if key not in ('Dimensions', 'DataOffsetArray',
+                               'TagOffsetArray')}
+    for i, dimension in enumerate(head['Dimensions']):
+        for key, value in dimension.items():
+            metadata['Dimensions.%d.%s' % (i, key)] = value
+    return metadata
+
+
+@pytest.mark.parametrize('version', [0x0210, 0x0220])
+@pytest.mark.parametrize('dtype', [np.float32, np.int16, np.int32])
+@pytest.mark.parametrize('count', [1, 6])
+def test_ser_images(tmp_path, version, dtype, count, native):
+    rng = np.random.RandomState(count)
+    elements = [rng.uniform(-100, 100, (20, 13)).astype(dtype)
+                for _ in range(count)]
+    path = str(tmp_path / 'series_1.ser')
+    _write_ser(path, elements, [(1e-9, 2e-10, 0), (-1e-9, 3e-10, 2)],
+               [(count, -60.0, 2.0, 0, 'Tilt', 'deg')], version)
+
+    result = native.read_ser(path)
+    head, expected, meta = _ser_dataset(path)
+    dataset = result['datasets'][0]
+    assert dataset['data'].dtype == expected.dtype
+    np.testing.assert_array_equal(dataset['data'], expected.T)
+    calibration = meta['Calibration']
+    np.testing.assert_allclose(dataset['scale'][:2],
+                               [c['CalibrationDelta'] for c in calibration])
+    np.testing.assert_allclose(
+        dataset['origin'][:2],
+        [c['CalibrationOffset'] - c['CalibrationElement'] *
+         c['CalibrationDelta'] for c in calibration])
+    if count > 1:
+        assert dataset['scale'][2] == 2.0
+        assert dataset['origin'][2] == -60.0
+        assert dataset['units'][2] == 'deg'
+    _assert_metadata_equal(result['metadata'], _ser_metadata(head))
+
+
+def test_ser_spectrum_map(tmp_path, native):
+    rng = np.random.RandomState(0)
+    elements = [rng.uniform(0, 10, 50).astype(np.float64) for _ in range(12)]
+    path = str(tmp_path / 'map_1.ser')
+    _write_ser(path, elements, [(100.0, 0.5, 0)],
+               [(4, 0.0, 1e-9, 0, 'X', 'm'), (3, 0.0, 2e-9, 0, 'Y', 'm')])
+
+    result = native.read_ser(path)
+    head, expected, meta = _ser_dataset(path)
+    # ser.py lays the spectra out over the scan
+    expected = expected.reshape((3, 4, 50))
+    dataset = result['datasets'][0]
+    np.testing.assert_array_equal(dataset['data'], expected.T)
+    np.testing.assert_allclose(dataset['scale'], [0.5, 1e-9, 2e-9])
+    assert dataset['origin'][0] == 100.0
+    _assert_metadata_equal(result['metadata'], _ser_metadata(head))
+
+
+def test_ser_invalid(tmp_path, native):
+    path = str(tmp_path / 'invalid_1.ser')
+    with open(path, 'wb') as f:
+        f.write(struct.pack('<3h', 0x4949, 0x0198, 0x0220) + b'\x00' * 32)
+    with pytest.raises(RuntimeError):
+        native.read_ser(path)
+
+    # Elements of different shapes
+    elements = [np.zeros((4, 4), np.float32), np.zeros((4, 5), np.float32)]
+    _write_ser(path, elements, [(0, 1, 0), (0, 1, 0)], [])
+    with pytest.raises(RuntimeError):
+        native.read_ser(path)
@@ -2,11 +2,13 @@ import numpy as np
 
 from utils import load_operator_module
 
+from tomviz import registration
 from tomviz.external_dataset import Dataset
 
 
 def test_pystackreg(hxn_xrf_example_dataset: Dataset,
-                    pystackreg_reference_output: dict[str, np.ndarray]):
+                    pystackreg_reference_output: dict[str, np.ndarray],
+                    without_native):
     dataset = hxn_xrf_example_dataset
     reference_output = pystackreg_reference_output
 
@@ -22,21 +24,22 @@ def test_pystackreg(hxn_xrf_example_dataset: Dataset,
         for key in reference_output
     )
 
-    # Apply the transformation
-    module.transform(
-        dataset,
-        transform_source='generate',
-        padding=10,
-        apply_to_all_arrays=True,
-        # Only used if `transform_source` is `generate`
-        transform_type='translation',
-        reference='slice_index',
-        transforms_save_file='',
-        # Only used if `transform_type` is `slice_index`
-        ref_slice_index=90,
-        # Only used if `transform_source` is `from_file`.
-        transform_file=None,
-    )
+    # Apply the transformation with pystackreg, which made the reference
+    with without_native(module, registration):
+        module.transform(
+            dataset,
+            transform_source='generate',
+            padding=10,
+            apply_to_all_arrays=True,
+            # Only used if `transform_source` is `generate`
+            transform_type='translation',
+            reference='slice_index',
+            transforms_save_file='',
+            # Only used if `transform_type` is `slice_index`
+            ref_slice_index=90,
+            # Only used if `transform_source` is `from_file`.
+            transform_file=None,
+        )
 
     # Verify the keys match
     assert list(sorted(pystackreg_reference_output)) == list(sorted(dataset.arrays))
@@ -0,0 +1,65 @@
+import numpy as np
+import pytest
+
+
+def _write_raw(path, volume, dtype, header=b''):
+    # Raw files store x fastest, which is the Fortran order of the volume
+    with open(path, 'wb') as f:
+        f.write(header)
+        f.write(np.asfortranarray(volume).astype(dtype).tobytes(order='F'))
+
+
+@pytest.mark.parametrize('dtype', ['<u1', '<i2', '>i2', '>u4', '<f4',
+                                   '>f8'])
+def test_read_raw(tmp_path, dtype, native):
+    stored = np.dtype(dtype)
+    rng = np.random.default_rng(0)
+    volume = (rng.random((13, 11, 7)) * 100).astype(stored.newbyteorder('='))
+    path = str(tmp_path / 'volume.raw')
+    _write_raw(path, volume, stored)
+
+    result = native.read_raw(path, volume.dtype, volume.shape,
+                             big_endian=stored.byteorder == '>')
+    assert result.flags.f_contiguous
+    assert result.dtype == volume.dtype
+    assert np.array_equal(result, volume)
+
+
+def test_read_raw_subsample(tmp_path, native):
+    volume = np.arange(20 * 18 * 16, dtype=np.float32).reshape(20, 18, 16)
+    path = str(tmp_path / 'volume.raw')
+    _write_raw(path, volume, '>f4', header=b'\xab' * 37)
+
+    bounds = (3, 17, 0, 18, 5, 16)
+    strides = (2, 3, 4)
+    result = native.read_raw(path, np.float32, volume.shape, big_endian=True,
+                             header_size=37, bounds=bounds, strides=strides)
+    # The subsample counts are rounded down, as the HDF5 ones are
+    expected = volume[3:17:2, 0:18:3, 5:16:4][:7, :6, :2]
+    assert np.array_equal(result, expected)
+
+    # The data ends the file when no header size is given
+    whole = native.read_raw(path, np.float32, volume.shape, big_endian=True)
+    assert np.array_equal(whole, volume)
+
+
+def test_read_raw_components(tmp_path, native):
+    rgb = np.arange(5 * 4 * 3 * 3, dtype=np.uint16).reshape(5, 4, 3, 3)
+    path = str(tmp_path / 'rgb.raw')
+    # The components of a voxel are interleaved
+    with open(path, 'wb') as f:
+        f.write(np.transpose(rgb, (3, 0, 1, 2)).tobytes(order='F'))
+
+    result = native.read_raw(path, np.uint16, rgb.shape[:3], components=3)
+    assert result.shape == rgb.shape
+    assert np.array_equal(result, rgb)
+
+
+def test_read_raw_errors(tmp_path, native):
+    path = str(tmp_path / 'small.raw')
+    _write_raw(path, np.zeros((4, 4, 4)), '<f4')
+
+    with pytest.raises(RuntimeError):
+        native.read_raw(path, np.float32, (4, 4, 5))
+    with pytest.raises(ValueError):
+        native.read_raw(path, np.float32, (4, 4, 4), strides=(0, 1, 1))
@@ -0,0 +1,190 @@
+import os
+import threading
+import time
+
+import numpy as np
+
+from tomviz._realtime import logger
+from tomviz._realtime.watcher import DirectoryWatcher
+
+
+# A synthetic session: Gaussian blobs, rotated about the slice axis, each
+# given as (slice, ray, depth, sigma, weight) relative to the tilt axis
+_BLOBS = [(20, 0, 0, 3, 1.0), (28, 0, 0, 2, 0.8), (24, 6, -4, 2, 0.3)]
+_SHAPE = (48, 96)
+
+
+def _projection(angle, axis):
+    theta = np.deg2rad(angle)
+    s = np.arange(_SHAPE[0])[:, None]
+    x = np.arange(_SHAPE[1])[None, :]
+    projection = np.zeros(_SHAPE)
+    for (s0, x0, z0, sigma, weight) in _BLOBS:
+        center = axis + x0 * np.cos(theta) - z0 * np.sin(theta)
+        projection += weight * np.exp(
+            -((s - s0)**2 + (x - center)**2) / (2 * sigma**2))
+    return projection
+
+
+def _session(count, offset, seed=0):
+    """The projections of a session, jittered and off axis by offset, and
+    the centered ones"""
+    angles = np.linspace(-70, 70, count)
+    jitter = np.random.default_rng(seed).integers(-4, 5, size=(count, 2))
+    axis = _SHAPE[1] // 2
+    observed, centered = [], []
+    for angle, (ds, dr) in zip(angles, jitter):
+        projection = _projection(angle, axis + offset)
+        observed.append(np.roll(np.roll(projection, ds, axis=0), dr, axis=1))
+        centered.append(_projection(angle, axis))
+    return angles, jitter, observed, np.dstack(centered)
+
+
+class _NpyLogger(logger.Logger):
+    """Reads projections saved as angle_index.npy"""
+
+    def read_projection_image(self, fname):
+        angle = float(os.path.basename(fname).split('_')[0])
+        return (np.load(fname), angle)
+
+
+def test_xcor_session(tmp_path):
+    offset = 6
+    angles, jitter, observed, centered = _session(200, offset)
+
+    tomoLogger = logger.Logger(str(tmp_path), 'npy', 'xcor', False)
+    for projection, angle in zip(observed, angles):
+        tomoLogger.append_projection(projection, angle)
+
+    assert tomoLogger.logTiltSeries.shape == _SHAPE + (200,)
+    assert np.allclose(tomoLogger.logTiltAngles, angles)
+
+    # Every projection is aligned to the first, which the tilt axis shift
+    # then centers along the rays
+    assert tomoLogger.tiltAxis.shift(_SHAPE[1]) == -(offset + jitter[0][1])
+    expected = np.roll(centered, jitter[0][0], axis=0)
+    assert np.allclose(tomoLogger.logTiltSeries, expected, atol=1e-4)
+
+
+def test_constant_cost_per_projection(tmp_path, monkeypatch):
+    angles, _, observed, _ = _session(200, 0)
+
+    calls = []
+    fft2 = np.fft.fft2
+
+    def counted_fft2(*args, **kwargs):
+        calls.append(1)
+        return fft2(*args, **kwargs)
+
+    monkeypatch.setattr(np.fft, 'fft2', counted_fft2)
+
+    tomoLogger = logger.Logger(str(tmp_path), 'npy', 'xcor', False)
+    counts = []
+    for projection, angle in zip(observed, angles):
+        calls.clear()
+        tomoLogger.append_projection(projection, angle)
+        counts.append(len(calls))
+
+    # Only the new projection and its neighbour are transformed
+    assert counts[0] == 0
+    assert all(count == 2 for count in counts[1:])
+
+
+def test_watcher_reports_complete_files(tmp_path):
+    (tmp_path / 'before.npy').write_bytes(b'0' * 16)
+    (tmp_path / 'ignored.txt').write_bytes(b'0' * 16)
+
+    # Without inotify, a file is reported once its size held still over a
+    # poll interval longer than the waits below
+    watcher = DirectoryWatcher(str(tmp_path), 'npy', poll_interval=0.5)
+    try:
+        assert watcher.wait(1) == ['before.npy']
+
+        with open(tmp_path / 'partial.npy', 'wb') as f:
+            f.write(b'0' * 16)
+            f.flush()
+            assert watcher.wait(0.1) == []
+            f.write(b'0' * 16)
+        assert watcher.wait(2) == ['partial.npy']
+
+        (tmp_path / 'moved.tmp').write_bytes(b'0' * 16)
+        os.replace(tmp_path / 'moved.tmp', tmp_path / 'moved.npy')
+        assert watcher.wait(2) == ['moved.npy']
+
+        assert watcher.wait(0.1) == []
+    finally:
+        watcher.close()
+
+
+def test_monitor_session(tmp_path):
+    angles, _, observed, _ = _session(20, 0)
+
+    def acquire():
+        # Written elsewhere and moved in, as the microscope software does
+        for i, (projection, angle) in enumerate(zip(observed, angles)):
+            name = '{:+07.2f}_{:03d}'.format(angle, i)
+            with open(tmp_path / (name + '.tmp'), 'wb') as f:
+                np.save(f, projection)
+            os.replace(tmp_path / (name + '.tmp'), tmp_path / (name + '.npy'))
+            time.sleep(0.01)
+
+    tomoLogger = _NpyLogger(str(tmp_path), 'npy', 'CoM', False)
+    acquisition = threading.Thread(target=acquire)
+    acquisition.start()
+
+    deadline = time.monotonic() + 30
+    while len(tomoLogger.logFiles) < len(angles) and \
+            time.monotonic() < deadline:
+        tomoLogger.monitor()
+    acquisition.join()
+
+    assert len(tomoLogger.logFiles) == len(angles)
+    assert tomoLogger.logTiltSeries.shape == _SHAPE + (len(angles),)
+    assert np.allclose(np.sort(tomoLogger.logTiltAngles), angles)
+    assert not tomoLogger.monitor(0)
+
+
+class _Tomography:
+    def set_tilt_series(self, *args):
+        self.args = args
+
+
+def test_load_tilt_series(tmp_path, monkeypatch):
+    offset = 6
+    angles, _, observed, _ = _session(40, offset)
+
+    tomoLogger = logger.Logger(str(tmp_path), 'npy', 'xcor', False)
+    for projection, angle in zip(observed[:20], angles[:20]):
+        tomoLogger.append_projection(projection, angle)
+
+    rolls = []
+    roll = np.roll
+
+    def counted_roll(*args, **kwargs):
+        rolls.append(1)
+        return roll(*args, **kwargs)
+
+    monkeypatch.setattr(np, 'roll', counted_roll)
+
+    # The sinograms of the slices, projection after projection, from a
+    # series that is re-centered once
+    tomo = _Tomography()
+    tomoLogger.load_tilt_series(tomo, 'SIRT')
+    series = tomoLogger.logTiltSeries
+    recentered = int(tomoLogger.tiltAxis.shift(_SHAPE[1]) != 0)
+    assert len(rolls) == recentered
+    (b,) = tomo.args
+    assert b.shape == (_SHAPE[0], _SHAPE[1] * 20)
+    for s in (0, 24, _SHAPE[0] - 1):
+        assert np.array_equal(b[s], series[s].transpose().ravel())
+
+    tomoLogger.load_tilt_series(tomo, 'WBP')
+    assert tomo.args[0] is series
+    assert len(rolls) == recentered
+
+    # Appending a projection re-centers the series on the next load
+    monkeypatch.setattr(np, 'roll', roll)
+    tomoLogger.append_projection(observed[20], angles[20])
+    tomoLogger.load_tilt_series(tomo, 'WBP')
+    assert tomo.args[0].shape == _SHAPE + (21,)
+    assert np.allclose(tomo.args[1], angles[:21])
@@ -0,0 +1,214 @@
+import contextlib
+import sys
+from unittest.mock import patch
+
+import numpy as np
+import pytest
+
+from utils import load_operator_module
+
+from tomviz import registration
+from tomviz.external_dataset import Dataset
+
+
+def _blobs(shape, seed=0):
+    rng = np.random.RandomState(seed)
+    coords = np.indices(shape)
+    image = np.zeros(shape)
+    for _ in range(30):
+        center = rng.uniform(0.15, 0.85, len(shape)) * shape
+        r = rng.uniform(3, 10)
+        distance = sum((c - x)**2 for (c, x) in zip(coords, center))
+        image += rng.uniform(0.5, 1) * np.exp(-distance / (2 * r**2))
+    return image.astype(np.float32)
+
+
+def _stack(native, image, matrices):
+    # warp_images() with the inverse transforms moves the image by matrices
+    inverses = np.linalg.inv(matrices)
+    stack = np.repeat(image[:, :, np.newaxis], len(matrices), axis=2)
+    return native.warp_images(np.asfortranarray(stack), inverses)
+
+
+def _translation(tx, ty):
+    return np.array([[1, 0, tx], [0, 1, ty], [0, 0, 1]], dtype=float)
+
+
+def _capture_spreadsheet(tables):
+    def make_spreadsheet(column_names, table):
+        tables['alignments'] = (column_names, np.asarray(table))
+        return tables['alignments']
+    return patch('tomviz.utils.make_spreadsheet', make_spreadsheet)
+
+
+@pytest.mark.parametrize('metric', ['ncc', 'phase'])
+def test_translations(metric, native):
+    image = _blobs((128, 96))
+    shifts = [(0, 0), (5.5, -3.2), (-12.3, 7.7), (2.1, 9.4)]
+    matrices = np.array([_translation(*s) for s in shifts])
+    stack = _stack(native, image, matrices)
+
+    pairs = np.array([(i, 0) for i in range(1, len(shifts))])
+    result = native.register_pairs(stack, pairs, model='translation',
+                                   metric=metric)
+    np.testing.assert_allclose(result, matrices[1:], atol=0.05)
+
+
+@pytest.mark.parametrize('model', ['rigid', 'affine'])
+def test_rigid_and_affine(model, native):
+    image = _blobs((128, 128), seed=1)
+    angle = np.radians(3)
+    c, s = np.cos(angle), np.sin(angle)
+    if model == 'rigid':
+        matrix = np.array([[c, -s, 4.2], [s, c, -2.5], [0, 0, 1]])
+    else:
+        matrix = np.array([[1.02, 0.03, -3.1], [-0.02, 0.98, 1.7], [0, 0, 1]])
+    stack = _stack(native, image, np.array([np.eye(3), matrix]))
+
+    result = native.register_pairs(stack, np.array([(1, 0)]), model=model)
+    np.testing.assert_allclose(result[0, :2, :2], matrix[:2, :2], atol=2e-3)
+    np.testing.assert_allclose(result[0, :2, 2], matrix[:2, 2], atol=0.1)
+
+
+def test_registration_pairs():
+    pairs = registration.registration_pairs(4, 'previous')
+    assert pairs.tolist() == [[1, 0], [2, 1], [3, 2]]
+    pairs = registration.registration_pairs(4, 'slice_index', 2)
+    assert pairs.tolist() == [[0, 2], [1, 2], [3, 2]]
+    pairs = registration.registration_pairs(3, 'mean')
+    assert pairs.tolist() == [[0, 3], [1, 3], [2, 3]]
+
+    # Chained transforms compose back to the first image
+    matrices = np.array([_translation(1, 2), _translation(3, -1),
+                         _translation(-2, 0)])
+    transforms = registration.compose_transforms(
+        matrices, registration.registration_pairs(4, 'previous'), 4,
+        'previous')
+    np.testing.assert_allclose(transforms[3], _translation(2, 1))
+
+
+def test_translation_offsets(tmp_path):
+    offsets = np.array([(3, -2), (0, 0), (-4.4, 5.6)])
+    transforms = registration.translations(offsets)
+    assert registration.is_translation(transforms)
+    np.testing.assert_allclose(registration.offsets(transforms), offsets)
+
+    # The manual image alignment shifts the images by the offsets
+    np.testing.assert_allclose(transforms[0], _translation(-3, 2))
+
+    alignments_file = tmp_path / 'alignments.json'
+    registration.save_alignments(alignments_file, transforms)
+    assert alignments_file.read_text() == '[[3, -2], [0, 0], [-4, 6]]'
+
+    tables = {}
+    with _capture_spreadsheet(tables):
+        registration.alignments_table(transforms)
+    column_names, table = tables['alignments']
+    assert column_names == ['X Offset', 'Y Offset']
+    np.testing.assert_allclose(table, offsets)
+
+    affine = transforms.copy()
+    affine[:, 0, 1] = 0.1
+    assert not registration.is_translation(affine)
+    with _capture_spreadsheet(tables):
+        registration.alignments_table(affine)
+    column_names, table = tables['alignments']
+    assert column_names == ['XX', 'XY', 'X Offset', 'YX', 'YY', 'Y Offset']
+    np.testing.assert_allclose(table, affine[:, :2, :].reshape(-1, 6))
+
+
+def test_register_stack(native):
+    image = _blobs((96, 80), seed=2)
+    shifts = [(3, -2), (0, 0), (-4, 5), (6, 1)]
+    stack = _stack(native, image,
+                   np.array([_translation(*s) for s in shifts]))
+
+    transforms = registration.register_stack(stack, reference='slice_index',
+                                              ref_slice_index=1)
+    np.testing.assert_allclose(registration.offsets(transforms),
+                               -np.array(shifts), atol=0.05)
+
+    # The images line up with the reference, away from the edges
+    dataset = Dataset({'tilts': stack, 'copy': stack.copy(order='F')})
+    registration.apply_transforms(dataset, transforms)
+    for name in ('tilts', 'copy'):
+        aligned = dataset.scalars(name)
+        for i in range(len(shifts)):
+            np.testing.assert_allclose(aligned[10:-10, 10:-10, i],
+                                       image[10:-10, 10:-10], atol=0.02)
+
+
+def test_stackreg_matrices(native):
+    pystackreg = pytest.importorskip('pystackreg')
+    image = _blobs((96, 80), seed=3)
+    stack = _stack(native, image,
+                   np.array([np.eye(3), _translation(4.5, -2.5)]))
+
+    sr = pystackreg.StackReg(pystackreg.StackReg.TRANSLATION)
+    tmats = sr.register_stack(stack, axis=2, reference='first')
+    transforms = registration.register_stack(stack, reference='first')
+    np.testing.assert_allclose(registration.from_stackreg(tmats), transforms,
+                               atol=0.1)
+    np.testing.assert_allclose(registration.to_stackreg(transforms), tmats,
+                               atol=0.1)
+
+
+def test_pystackreg_matches_python(native, fallback):
+    pytest.importorskip('pystackreg')
+    module = load_operator_module('PyStackRegImageAlignment')
+    image = _blobs((96, 80), seed=4)
+    shifts = [(0, 0), (2.5, -1.5), (-3, 4), (1, 2)]
+    stack = _stack(native, image,
+                   np.array([_translation(*s) for s in shifts]))
+
+    results = []
+    for context in (fallback(module, registration), contextlib.nullcontext()):
+        dataset = Dataset({'tilts': stack.copy(order='F')})
+        with context, patch.object(module, 'in_application', lambda: True):
+            tables = {}
+            with _capture_spreadsheet(tables):
+                module.transform(dataset, padding=10, reference='first')
+        results.append((dataset.active_scalars, tables['alignments']))
+
+    ((python, python_table), (result, table)) = results
+    assert result.shape == python.shape
+    np.testing.assert_allclose(result[10:-10, 10:-10], python[10:-10, 10:-10],
+                               atol=0.05)
+    assert table[0] == python_table[0] == ['X Offset', 'Y Offset']
+    np.testing.assert_allclose(table[1], -np.array(shifts), atol=0.1)
+    np.testing.assert_allclose(table[1], python_table[1], atol=0.1)
+
+
+def _elastix_transform(module, moving_dataset, fixed_dataset,
+                       disable_rotation=True):
+    module.transform(moving_dataset, fixed_dataset, max_num_iterations=256,
+                     num_resolutions=4, disable_rotation=disable_rotation,
+                     interpolator='LinearInterpolator',
+                     bspline_interpolation_order=3,
+                     resample_interpolator='FinalLinearInterpolator',
+                     resample_bspline_interpolation_order=3,
+                     lower_threshold=-1000, upper_threshold=1000,
+                     show_elastix_console_output=False)
+
+
+def test_elastix_translation_without_elastix(native):
+    module = load_operator_module('ElastixRegistration')
+    fixed = _blobs((48, 40, 32), seed=6)
+    moving = np.roll(fixed, (3, -2, 4), axis=(0, 1, 2))
+    moving_dataset = Dataset({'moving': np.asfortranarray(moving)})
+    fixed_dataset = Dataset({'fixed': np.asfortranarray(fixed)})
+
+    # Elastix is used whenever it can be imported, so hide it
+    with patch.dict(sys.modules, {'itk': None}):
+        _elastix_transform(module, moving_dataset, fixed_dataset)
+
+    result = moving_dataset.active_scalars
+    assert result.shape == fixed.shape
+    np.testing.assert_allclose(result[6:-6, 6:-6, 6:-6],
+                               fixed[6:-6, 6:-6, 6:-6], atol=0.05)
+
+    # Rotations still need elastix
+    with patch.dict(sys.modules, {'itk': None}):
+        with pytest.raises(ImportError):
+            _elastix_transform(module, moving_dataset, fixed_dataset,
+                               disable_rotation=False)
@@ -0,0 +1,234 @@
+import sys
+from unittest.mock import patch
+
+import numpy as np
+import pytest
+
+from utils import load_operator_class, load_operator_module
+
+from tomviz.executor import OperatorWrapper
+from tomviz.external_dataset import Dataset
+
+
+def _distance(shape, center):
+    grid = np.indices(shape, dtype=np.float64)
+    return np.sqrt(sum((g - c)**2 for g, c in zip(grid, center)))
+
+
+def _particle(seed=0):
+    """A noisy particle of radius 15 with two pores of radius 4"""
+    shape = (40, 40, 40)
+    volume = np.where(_distance(shape, (20, 20, 20)) < 15, 100.0, 0.0)
+    for center in [(13, 20, 20), (27, 20, 20)]:
+        volume[_distance(shape, center) < 4] = 0.0
+    rng = np.random.RandomState(seed)
+    volume += rng.normal(0, 5, shape)
+    return np.asfortranarray(volume, dtype=np.float32)
+
+
+def _run_operator(name, volume, operator=None, with_itk=False, **kwargs):
+    """The dataset and the result of the operator. The native port runs with
+    ITK hidden, since ITK's filters are used whenever it can be imported."""
+    dataset = Dataset({'data': volume.copy(order='F')}, 'data')
+    dataset.spacing = [1.0, 1.0, 1.0]
+    if operator is None:
+        operator = load_operator_class(load_operator_module(name))
+    if with_itk:
+        return dataset, operator.transform(dataset, **kwargs)
+    with patch.dict(sys.modules, {'itk': None}):
+        return dataset, operator.transform(dataset, **kwargs)
+
+
+def test_otsu_thresholds(native):
+    rng = np.random.RandomState(0)
+    volume = np.concatenate([rng.uniform(0, 1, 500),
+                             rng.uniform(10, 11, 500),
+                             rng.uniform(20, 21, 500)]).astype(np.float32)
+    volume = np.asfortranarray(volume.reshape((10, 15, 10)))
+
+    thresholds, labels = native.otsu_thresholds(volume, 2)
+    assert len(thresholds) == 2
+    assert 1 <= thresholds[0] <= 10
+    assert 11 <= thresholds[1] <= 20
+    assert labels.dtype == np.uint8
+    np.testing.assert_array_equal(labels, np.digitize(volume, thresholds,
+                                                      right=True))
+
+    with pytest.raises(ValueError):
+        native.otsu_thresholds(volume, 0)
+
+
+def test_otsu_operator(native):
+    volume = _particle()
+    _, result = _run_operator('OtsuMultipleThreshold', volume)
+    label_map = result['label_map'].active_scalars
+    assert label_map.dtype == np.uint8
+    np.testing.assert_array_equal(label_map, volume > 50)
+
+
+def test_otsu_operator_matches_itk(native):
+    pytest.importorskip('itk')
+    volume = _particle()
+    _, reference = _run_operator('OtsuMultipleThreshold', volume,
+                                 with_itk=True, number_of_thresholds=2)
+    _, result = _run_operator('OtsuMultipleThreshold', volume,
+                              number_of_thresholds=2)
+    np.testing.assert_array_equal(result['label_map'].active_scalars,
+                                  reference['label_map'].active_scalars)
+
+
+def test_binary_min_max_curvature_flow(native):
+    volume = np.asfortranarray(
+        np.where(_distance((24, 24, 24), (12, 12, 12)) < 7, 100.0, 0.0),
+        dtype=np.float32)
+    original = volume.copy()
+    result = native.binary_min_max_curvature_flow(volume, [1, 1, 1], 2, 10,
+                                                  50.0)
+    # The input is left as it was, and the flow stays in its range
+    np.testing.assert_array_equal(volume, original)
+    assert result.min() >= 0 and result.max() <= 100
+
+    constant = np.full((8, 8, 8), 3.0, dtype=np.float32, order='F')
+    np.testing.assert_array_equal(
+        native.binary_min_max_curvature_flow(constant, [1, 1, 1], 2, 5, 1.0),
+        constant)
+
+
+def test_binary_min_max_curvature_flow_matches_itk(native):
+    itk = pytest.importorskip('itk')
+    # A small noisy sphere, the flow both raises and lowers voxels
+    rng = np.random.RandomState(1)
+    volume = np.where(_distance((16, 14, 12), (8, 7, 6)) < 5, 100.0, 0.0)
+    volume = (volume + rng.normal(0, 20, volume.shape)).astype(np.float32)
+
+    image_type = itk.Image[itk.F, 3]
+    smoothing_filter = itk.BinaryMinMaxCurvatureFlowImageFilter[
+        image_type, image_type].New()
+    smoothing_filter.SetInput(itk.GetImageFromArray(volume))
+    smoothing_filter.SetThreshold(50.0)
+    smoothing_filter.SetStencilRadius(2)
+    smoothing_filter.SetNumberOfIterations(5)
+    smoothing_filter.SetTimeStep(0.0625)
+    smoothing_filter.Update()
+    reference = itk.GetArrayFromImage(smoothing_filter.GetOutput())
+
+    # ITK's axes are reversed, which the flow does not depend on
+    result = native.binary_min_max_curvature_flow(
+        np.asfortranarray(volume), [1, 1, 1], 2, 5, 50.0)
+    assert not np.allclose(reference, volume)
+    # ITK computes in float, the native flow in double
+    np.testing.assert_allclose(result, reference, atol=1e-2)
+
+
+def test_binary_min_max_curvature_flow_progress_and_cancel(native):
+    volume = np.asfortranarray(
+        np.where(_distance((24, 24, 24), (12, 12, 12)) < 7, 100.0, 0.0),
+        dtype=np.float32)
+    module = load_operator_module('BinaryMinMaxCurvatureFlow')
+
+    class Wrapper(OperatorWrapper):
+        def __init__(self, cancel_at):
+            self.values = []
+            self.cancel_at = cancel_at
+
+        @property
+        def progress_value(self):
+            return self.values[-1]
+
+        @progress_value.setter
+        def progress_value(self, value):
+            self.values.append(value)
+            self.canceled = value == self.cancel_at
+
+    def run(cancel_at):
+        operator = load_operator_class(module)
+        operator._operator_wrapper = Wrapper(cancel_at)
+        dataset, _ = _run_operator('BinaryMinMaxCurvatureFlow', volume,
+                                   operator, iterations=4)
+        return dataset.active_scalars, operator._operator_wrapper.values
+
+    # Progress is reported after every iteration
+    result, values = run(None)
+    assert values == [0, 25, 50, 75, 100]
+    np.testing.assert_array_equal(
+        result, native.binary_min_max_curvature_flow(volume, [1, 1, 1], 2, 4,
+                                                     50.0))
+
+    # and a canceled run leaves the input
+    result, values = run(50)
+    assert values == [0, 25, 50]
+    np.testing.assert_array_equal(result, volume)
+
+    assert native.binary_min_max_curvature_flow(
+        volume, [1, 1, 1], 2, 4, 50.0, progress=lambda fraction: True) is None
+
+
+def test_segment_particles(native):
+    volume = _particle()
+    particles = native.segment_particles(volume, 2)
+    assert particles.dtype == np.uint8
+    assert set(np.unique(particles)) == {0, 1}
+    # The pores are filled in
+    assert particles[20, 20, 20] == 1
+    assert particles[13, 20, 20] == 1
+    assert particles[27, 20, 20] == 1
+    assert particles[2, 2, 2] == 0
+
+    canceled = native.segment_particles(volume, 2, lambda fraction: True)
+    assert canceled is None
+
+
+def test_segment_pores(native):
+    volume = _particle()
+    pores = native.segment_pores(volume, [1, 1, 1], 1.0, 6.0)
+    assert pores.dtype == np.uint32
+
+    # Exactly the two pores are labeled
+    first, second = pores[13, 20, 20], pores[27, 20, 20]
+    assert first != 0 and second != 0 and first != second
+    assert set(np.unique(pores)) == {0, first, second}
+    assert pores[20, 20, 20] == 0
+    assert pores[2, 2, 2] == 0
+
+    fractions = []
+    native.segment_pores(volume, [1, 1, 1], 1.0, 6.0,
+                         lambda fraction: fractions.append(fraction))
+    assert fractions == sorted(fractions) and fractions[-1] == 1.0
+
+    with pytest.raises(ValueError):
+        native.segment_pores(volume, [1, 1, 1], 6.0, 1.0)
+
+
+def test_segment_particles_matches_itk(native):
+    pytest.importorskip('itk')
+    volume = _particle()
+    _, reference = _run_operator('SegmentParticles', volume, with_itk=True,
+                                 minimum_radius=2)
+    _, result = _run_operator('SegmentParticles', volume, minimum_radius=2)
+    reference = reference['label_map'].active_scalars
+    result = result['label_map'].active_scalars
+    assert result.shape == reference.shape
+    # The filters may break ties differently on the surface of the particle
+    assert np.mean((result != 0) != (reference != 0)) < 0.01
+
+
+def test_segment_pores_operator(native):
+    _, result = _run_operator('SegmentPores', _particle(), minimum_radius=1.0,
+                              maximum_radius=6.0)
+    pores = result['label_map'].active_scalars
+    assert pores.dtype == np.uint16
+    assert len(np.unique(pores)) == 3
+
+
+def test_segment_pores_matches_itk(native):
+    pytest.importorskip('itk')
+    volume = _particle()
+    kwargs = {'minimum_radius': 1.0, 'maximum_radius': 6.0}
+    _, reference = _run_operator('SegmentPores', volume, with_itk=True,
+                                 **kwargs)
+    _, result = _run_operator('SegmentPores', volume, **kwargs)
+    reference = reference['label_map'].active_scalars
+    result = result['label_map'].active_scalars
+    # The same pores, whatever their labels
+    assert len(np.unique(result)) == len(np.unique(reference))
+    assert np.mean((result != 0) != (reference != 0)) < 0.01
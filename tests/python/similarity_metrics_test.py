@@ -0,0 +1,76 @@
+from unittest.mock import patch
+
+import numpy as np
+import pytest
+
+from utils import load_operator_class, load_operator_module
+
+from tomviz.external_dataset import Dataset
+import tomviz.metrics
+
+
+def _pair(shape, seed=0):
+    rng = np.random.RandomState(seed)
+    reference = rng.uniform(0, 1, shape).cumsum(axis=0)
+    image = 0.9 * reference + rng.normal(0, 0.5, shape)
+    return (np.asfortranarray(reference, dtype=np.float32),
+            np.asfortranarray(image, dtype=np.float32))
+
+
+@pytest.mark.parametrize('normalize', [False, True])
+def test_volume_metrics(normalize, native):
+    pytest.importorskip('skimage')
+    reference, image = _pair((31, 27, 19))
+    result = native.similarity_metrics(reference, image, normalize=normalize)
+    expected = tomviz.metrics._compare(reference, image, None, 64, 7,
+                                       normalize)
+    for name in tomviz.metrics.METRICS:
+        assert result[name] == pytest.approx(expected[name], rel=1e-5), name
+
+
+def test_slice_metrics(native):
+    pytest.importorskip('skimage')
+    reference, image = _pair((31, 27, 5), seed=1)
+    result = tomviz.metrics.compare_slices(reference, image, axis=1,
+                                           data_range=1.0, normalize=True)
+    for i in range(reference.shape[1]):
+        expected = tomviz.metrics._compare(reference[:, i], image[:, i], 1.0,
+                                           64, 7, True)
+        for name in tomviz.metrics.METRICS:
+            assert result[name][i] == pytest.approx(expected[name],
+                                                    rel=1e-5), name
+
+
+def test_identical(native):
+    reference, _ = _pair((16, 16, 16))
+    result = native.similarity_metrics(reference, reference)
+    assert result['mse'] == 0
+    assert result['psnr'] == np.inf
+    assert result['ncc'] == pytest.approx(1)
+    assert result['ssim'] == pytest.approx(1)
+
+
+def test_operator_columns(native):
+    pytest.importorskip('skimage')
+    reference, image = _pair((24, 20, 12), seed=2)
+    dataset = Dataset({'data': image}, 'data')
+    reference_dataset = Dataset({'data': reference}, 'data')
+
+    tables = []
+
+    def capture(column_names, table_data, *args):
+        tables.append((column_names, table_data))
+
+    operator = load_operator_class(load_operator_module('SimilarityMetrics'))
+    with patch('tomviz.utils.make_spreadsheet', capture):
+        operator.transform(dataset, reference_dataset=reference_dataset,
+                           axis=2)
+
+    column_names, table_data = tables[0]
+    assert column_names == ['x', 'data MSE', 'data SSIM', 'data PSNR',
+                            'data NCC', 'data MI']
+    for i in range(reference.shape[2]):
+        expected = tomviz.metrics._compare(reference[:, :, i],
+                                           image[:, :, i], 1.0, 64, 7, True)
+        assert table_data[i, 1] == pytest.approx(expected['mse'], rel=1e-5)
+        assert table_data[i, 2] == pytest.approx(expected['ssim'], rel=1e-5)
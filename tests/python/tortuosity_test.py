@@ -0,0 +1,79 @@
+from unittest.mock import patch
+
+import numpy as np
+import pytest
+
+from utils import load_operator_class, load_operator_module
+
+from tomviz.external_dataset import Dataset
+
+
+def _make_dataset():
+    # A porous phase (1) in a solid (0), with a few unreachable pockets
+    rng = np.random.RandomState(0)
+    volume = (rng.rand(14, 11, 9) < 0.6).astype(np.uint8)
+    dataset = Dataset({'phases': np.asfortranarray(volume)})
+    dataset.spacing = [1.0, 1.0, 1.0]
+    return dataset
+
+
+def _python_distance_map(module, volume, method, direction):
+    _, inv_node_map, _, edges, aux_edges = module.volume_to_graph(
+        volume, 1, method)
+    csgraph = module.edges_to_sparse_matrix(
+        edges, aux_edges, direction.value, len(inv_node_map), volume.ndim)
+    dist_matrix = module.dijkstra(csgraph, directed=False,
+                                  indices=direction.value)
+    return module.distance_matrix_to_volume(inv_node_map, dist_matrix,
+                                            volume.shape)
+
+
+@pytest.mark.parametrize('method', [0, 1, 2])
+def test_native_distance_map_matches_graph(method, native):
+    module = load_operator_module('Tortuosity')
+    volume = _make_dataset().active_scalars
+    method = module.DistanceMethod(method)
+    connectivity, euclidean = module.native_connectivity(method)
+    mask = np.asfortranarray(volume == 1).view(np.uint8)
+
+    for direction in module.PropagationDirection:
+        expected = _python_distance_map(module, volume, method, direction)
+        result = module.geodesic_distance(mask, direction.value,
+                                          connectivity, euclidean)
+        assert result.dtype == np.float32
+        np.testing.assert_allclose(result, expected, rtol=1e-5, atol=1e-5)
+
+
+def test_native_tables_match_graph(fallback):
+    module = load_operator_module('Tortuosity')
+
+    def run():
+        tables = {}
+
+        def capture_spreadsheet(column_names, table_data, *args, **kwargs):
+            table = {
+                'column_names': list(column_names),
+                'data': table_data.copy(),
+            }
+            tables[len(tables)] = table
+            return table
+
+        dataset = _make_dataset()
+        operator = load_operator_class(module)
+        with patch('tomviz.utils.make_spreadsheet', capture_spreadsheet):
+            results = operator.transform(dataset, phase=1,
+                                         propagation_direction=2)
+        return dataset.active_scalars, results
+
+    native_scalars, native_results = run()
+    with fallback(module):
+        python_scalars, python_results = run()
+
+    np.testing.assert_allclose(native_scalars, python_scalars, rtol=1e-5,
+                               atol=1e-5)
+    assert native_results.keys() == python_results.keys()
+    for name, table in python_results.items():
+        native_table = native_results[name]
+        assert native_table['column_names'] == table['column_names']
+        np.testing.assert_allclose(native_table['data'], table['data'],
+                                   rtol=1e-5, atol=1e-5)
@@ -42,9 +42,23 @@ namespace tomviz {
 AddPythonTransformReaction::AddPythonTransformReaction(
   QAction* parentObject, const QString& l, const QString& s, bool rts, bool rv,
   bool rf, const QString& json)
-  : pqReaction(parentObject), jsonSource(json), scriptLabel(l), scriptSource(s),
-    interactive(false), requiresTiltSeries(rts), requiresVolume(rv),
-    requiresFib(rf)
+  : AddPythonTransformReaction(parentObject, l, rts, rv, rf)
+{
+  jsonSource = json;
+  scriptSource = s;
+  parseJson();
+
+  OperatorFactory::instance().registerPythonOperator(l, s, rts, rv, rf, json);
+
+  updateEnableState();
+}
+
+AddPythonTransformReaction::AddPythonTransformReaction(QAction* parentObject,
+                                                       const QString& l,
+                                                       bool rts, bool rv,
+                                                       bool rf)
+  : pqReaction(parentObject), scriptLabel(l), interactive(false),
+    requiresTiltSeries(rts), requiresVolume(rv), requiresFib(rf)
 {
   connect(&ActiveObjects::instance(),
           static_cast<void (ActiveObjects::*)(DataSource*)>(
@@ -52,27 +66,58 @@ AddPythonTransformReaction::AddPythonTransformReaction(
           this, &AddPythonTransformReaction::updateEnableState);
   connect(&PipelineManager::instance(), &PipelineManager::executionModeUpdated,
           this, &AddPythonTransformReaction::updateEnableState);
+}
+
+AddPythonTransformReaction* AddPythonTransformReaction::fromScript(
+  QAction* parentObject, const QString& l, const QString& name, bool rts,
+  bool rv, bool rf, bool json)
+{
+  auto reaction = new AddPythonTransformReaction(parentObject, l, rts, rv, rf);
+  reaction->scriptName = name;
+  reaction->hasJson = json;
+  reaction->loaded = false;
+
+  OperatorFactory::instance().registerPythonOperatorScript(l, name, rts, rv,
+                                                           rf, json);
+
+  reaction->updateEnableState();
+  return reaction;
+}
+
+void AddPythonTransformReaction::ensureLoaded()
+{
+  if (loaded) {
+    return;
+  }
+  loaded = true;
 
+  scriptSource = readInPythonScript(scriptName);
+  if (hasJson) {
+    jsonSource = readInJSONDescription(scriptName);
+  }
+  parseJson();
+}
+
+void AddPythonTransformReaction::parseJson()
+{
   // If we have JSON, check whether the operator is compatible with being run
   // in an external pipeline.
-  if (!json.isEmpty()) {
-    auto document = QJsonDocument::fromJson(json.toLatin1());
-    if (!document.isObject()) {
-      qCritical() << "Failed to parse operator JSON";
-      qCritical() << json;
-      return;
-    } else {
-      QJsonObject root = document.object();
-      QJsonValueRef externalNode = root["externalCompatible"];
-      if (!externalNode.isUndefined() && !externalNode.isNull()) {
-        this->externalCompatible = externalNode.toBool();
-      }
-    }
+  if (jsonSource.isEmpty()) {
+    return;
   }
 
-  OperatorFactory::instance().registerPythonOperator(l, s, rts, rv, rf, json);
+  auto document = QJsonDocument::fromJson(jsonSource.toLatin1());
+  if (!document.isObject()) {
+    qCritical() << "Failed to parse operator JSON";
+    qCritical() << jsonSource;
+    return;
+  }
 
-  updateEnableState();
+  QJsonObject root = document.object();
+  QJsonValueRef externalNode = root["externalCompatible"];
+  if (!externalNode.isUndefined() && !externalNode.isNull()) {
+    this->externalCompatible = externalNode.toBool();
+  }
 }
 
 void AddPythonTransformReaction::updateEnableState()
@@ -83,6 +128,12 @@ void AddPythonTransformReaction::updateEnableState()
   if (enable) {
     auto dataSource = pipeline->transformedDataSource();
 
+    // The external pipeline compatibility comes from the JSON description.
+    if (PipelineManager::instance().executionMode() ==
+        Pipeline::ExecutionMode::Docker) {
+      ensureLoaded();
+    }
+
     auto executionModeCompatible =
       ((PipelineManager::instance().executionMode() ==
           Pipeline::ExecutionMode::Docker &&
@@ -106,6 +157,8 @@ void AddPythonTransformReaction::updateEnableState()
 
 OperatorPython* AddPythonTransformReaction::addExpression(DataSource* source)
 {
+  ensureLoaded();
+
   source = source ? source : ActiveObjects::instance().activeParentDataSource();
   if (!source) {
     return nullptr;
@@ -22,6 +22,14 @@ public:
                              bool requiresFib = false,
                              const QString& json = QString());
 
+  /// Create a reaction for one of the bundled operator scripts. The script
+  /// and, if hasJson is true, its JSON description are only read from disk
+  /// the first time they are needed rather than while building the menus.
+  static AddPythonTransformReaction* fromScript(
+    QAction* parent, const QString& label, const QString& scriptName,
+    bool requiresTiltSeries = false, bool requiresVolume = false,
+    bool requiresFib = false, bool hasJson = false);
+
   OperatorPython* addExpression(DataSource* source = nullptr);
 
   void setInteractive(bool isInteractive) { interactive = isInteractive; }
@@ -61,9 +69,20 @@ private slots:
 private:
   Q_DISABLE_COPY(AddPythonTransformReaction)
 
+  AddPythonTransformReaction(QAction* parent, const QString& label,
+                             bool requiresTiltSeries, bool requiresVolume,
+                             bool requiresFib);
+
+  /// Read the script and JSON description if they were deferred.
+  void ensureLoaded();
+  void parseJson();
+
   QString jsonSource;
   QString scriptLabel;
   QString scriptSource;
+  QString scriptName;
+  bool hasJson = false;
+  bool loaded = true;
 
   bool interactive;
   bool requiresTiltSeries;
@@ -9,6 +9,7 @@
 #include "ManualManipulationWidget.h"
 #include "MoveActiveObject.h"
 #include "OperatorPython.h"
+#include "RenderStatistics.h"
 #include "RotateAlignWidget.h"
 #include "TimeSeriesLabel.h"
 #include "ViewFrameActions.h"
@@ -88,6 +89,9 @@ Behaviors::Behaviors(QMainWindow* mainWindow) : QObject(mainWindow)
 
   new tomviz::AddRenderViewContextMenuBehavior(this);
 
+  // Start collecting render statistics before the first view is created
+  RenderStatistics::instance();
+
   m_moveActiveBehavior.reset(new tomviz::MoveActiveObject(this));
   m_timeSeriesLabel.reset(new tomviz::TimeSeriesLabel(this));
 
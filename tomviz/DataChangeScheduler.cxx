@@ -0,0 +1,81 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "DataChangeScheduler.h"
+
+#include "ActiveObjects.h"
+#include "DataSource.h"
+#include "Pipeline.h"
+
+namespace tomviz {
+
+DataChangeScheduler::DataChangeScheduler()
+{
+  // One frame at 60 Hz. The timer is not restarted by new requests, so a
+  // continuous stream of updates is throttled rather than starved.
+  m_timer.setSingleShot(true);
+  m_timer.setInterval(16);
+  connect(&m_timer, &QTimer::timeout, this, &DataChangeScheduler::flush);
+}
+
+DataChangeScheduler& DataChangeScheduler::instance()
+{
+  static DataChangeScheduler theInstance;
+  return theInstance;
+}
+
+void DataChangeScheduler::schedule(DataSource* source, bool propertiesChanged,
+                                   bool executePipeline)
+{
+  if (!source) {
+    return;
+  }
+
+  bool merged = false;
+  for (auto& pending : m_pending) {
+    if (pending.source == source) {
+      pending.propertiesChanged |= propertiesChanged;
+      pending.executePipeline |= executePipeline;
+      merged = true;
+      break;
+    }
+  }
+  if (!merged) {
+    m_pending.append({ source, propertiesChanged, executePipeline });
+  }
+
+  if (!m_timer.isActive()) {
+    m_timer.start();
+  }
+}
+
+void DataChangeScheduler::flush()
+{
+  m_timer.stop();
+  if (m_pending.isEmpty()) {
+    return;
+  }
+
+  // Slots may schedule further changes, those go out on the next frame.
+  QList<Pending> pending;
+  pending.swap(m_pending);
+  for (auto& p : pending) {
+    if (!p.source) {
+      // Deleted while the notification was pending
+      continue;
+    }
+    // Emits dataChanged()
+    p.source->dataModified();
+    if (p.propertiesChanged) {
+      emit p.source->dataPropertiesChanged();
+    }
+    // Notify, then execute, as the direct updates do
+    if (p.executePipeline && p.source->pipeline()) {
+      p.source->pipeline()->execute()->deleteWhenFinished();
+    }
+  }
+
+  ActiveObjects::instance().renderAllViews();
+}
+
+} // namespace tomviz
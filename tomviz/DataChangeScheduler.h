@@ -0,0 +1,58 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizDataChangeScheduler_h
+#define tomvizDataChangeScheduler_h
+
+#include <QObject>
+
+#include <QList>
+#include <QPointer>
+#include <QTimer>
+
+namespace tomviz {
+class DataSource;
+
+/// Coalesces data change notifications so that data sources that are updated
+/// many times per second (live acquisition, progress.data from a running
+/// operator) only run DataSource::dataModified(), which updates the producer
+/// and notifies their modules, histograms and panels, once per frame,
+/// followed by a single render of all views.
+class DataChangeScheduler : public QObject
+{
+  Q_OBJECT
+
+public:
+  static DataChangeScheduler& instance();
+
+  /// Queue DataSource::dataModified() (and dataPropertiesChanged() when
+  /// propertiesChanged is true) for the next frame, then the execution of
+  /// the source's pipeline when executePipeline is true. Requests made for
+  /// the same data source before then are merged into one notification.
+  void schedule(DataSource* source, bool propertiesChanged = true,
+                bool executePipeline = false);
+
+  /// Deliver any pending notifications now.
+  void flush();
+
+  /// The minimum time in milliseconds between notifications.
+  void setInterval(int msec) { m_timer.setInterval(msec); }
+  int interval() const { return m_timer.interval(); }
+
+private:
+  DataChangeScheduler();
+  Q_DISABLE_COPY(DataChangeScheduler)
+
+  struct Pending
+  {
+    QPointer<DataSource> source;
+    bool propertiesChanged;
+    bool executePipeline;
+  };
+
+  QList<Pending> m_pending;
+  QTimer m_timer;
+};
+} // namespace tomviz
+
+#endif
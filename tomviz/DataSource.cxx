@@ -7,6 +7,7 @@
 
 #include "ActiveObjects.h"
 #include "ColorMap.h"
+#include "DataChangeScheduler.h"
 #include "DataExchangeFormat.h"
 #include "EmdFormat.h"
 #include "GenericHDF5Format.h"
@@ -17,6 +18,7 @@
 #include "Pipeline.h"
 #include "TimeSeriesStep.h"
 #include "Utilities.h"
+#include "VolumeProbe.h"
 
 #include <iostream>
 
@@ -113,6 +115,7 @@ public:
   QMap<QString, QString> CurrentToOriginal;
   QList<TimeSeriesStep> timeSeriesSteps;
   int currentTimeStep = 0;
+  VolumeProbe Probe;
 
   // Checks if the tilt angles data array exists on the given VTK data
   // and creates it if it does not exist.
@@ -263,9 +266,10 @@ bool DataSource::appendSlice(vtkImageData* slice)
           data, slice, static_cast<VTK_TT*>(data->GetScalarPointer())));
       }
 
-      emit dataChanged();
-      emit dataPropertiesChanged();
-      pipeline()->execute()->deleteWhenFinished();
+      // Slices can arrive faster than the modules can update, so the
+      // notification and the pipeline execution that follows it are
+      // coalesced per frame
+      DataChangeScheduler::instance().schedule(this, true, true);
     }
   }
   return true;
@@ -1275,7 +1279,7 @@ void DataSource::setData(vtkDataObject* newData)
   dataModified();
 }
 
-void DataSource::copyData(vtkDataObject* newData)
+void DataSource::copyData(vtkDataObject* newData, bool modified)
 {
   auto tp = producer();
   Q_ASSERT(tp);
@@ -1284,7 +1288,9 @@ void DataSource::copyData(vtkDataObject* newData)
 
   oldData->DeepCopy(newData);
 
-  dataModified();
+  if (modified) {
+    dataModified();
+  }
 
   emit activeScalarsChanged();
 }
@@ -1601,6 +1607,12 @@ vtkImageData* DataSource::imageData() const
   return vtkImageData::SafeDownCast(dataObject());
 }
 
+const VolumeProbe& DataSource::probe() const
+{
+  this->Internals->Probe.update(imageData());
+  return this->Internals->Probe;
+}
+
 vtkDataArray* DataSource::scalars() const
 {
   return getScalarsArray(activeScalars());
@@ -30,6 +30,7 @@ class DataSourceBase;
 class Operator;
 class Pipeline;
 struct TimeSeriesStep;
+class VolumeProbe;
 
 using MetadataType = std::map<std::string, Variant>;
 
@@ -91,6 +92,10 @@ public:
   /// Returns the image data associated with the proxy.
   vtkImageData* imageData() const;
 
+  /// A probe of the image data, its geometry and scalars cached until they
+  /// change. Only to be used from the main thread.
+  const VolumeProbe& probe() const;
+
   /// Get the active scalars array
   vtkDataArray* scalars() const;
 
@@ -362,8 +367,9 @@ public:
   /// producer takes over ownership of the data object.
   void setData(vtkDataObject* newData);
 
-  /// Copy data from a data object to the existing data.
-  void copyData(vtkDataObject* newData);
+  /// Copy data from a data object to the existing data. Without
+  /// modified, dataModified() is left to the caller.
+  void copyData(vtkDataObject* newData, bool modified = true);
 
   bool unitsModified();
 
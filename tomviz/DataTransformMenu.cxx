@@ -24,13 +24,28 @@ DataTransformMenu::DataTransformMenu(QMainWindow* mainWindow, QMenu* transform,
   : QObject(mainWindow), m_transformMenu(transform), m_segmentationMenu(seg),
     m_mainWindow(mainWindow)
 {
-  // Build the menu now
+  // The menus are built the first time they are shown, or by build()
+  connect(m_transformMenu, &QMenu::aboutToShow, this,
+          &DataTransformMenu::buildTransforms);
+  connect(m_segmentationMenu, &QMenu::aboutToShow, this,
+          &DataTransformMenu::buildSegmentation);
+}
+
+void DataTransformMenu::build()
+{
   buildTransforms();
   buildSegmentation();
 }
 
 void DataTransformMenu::buildTransforms()
 {
+  if (m_transformsBuilt) {
+    return;
+  }
+  m_transformsBuilt = true;
+  disconnect(m_transformMenu, &QMenu::aboutToShow, this,
+             &DataTransformMenu::buildTransforms);
+
   QMainWindow* mainWindow = m_mainWindow;
   QMenu* menu = m_transformMenu;
   menu->clear();
@@ -96,119 +111,106 @@ void DataTransformMenu::buildTransforms()
   new ConvertToFloatReaction(convertDataAction);
   new ArrayWranglerReaction(arrayWranglerAction, mainWindow);
   new TransposeDataReaction(transposeDataAction, mainWindow);
-  new AddPythonTransformReaction(
-    removeArraysAction, "Remove Arrays",
-    readInPythonScript("RemoveArrays"), false, false, false,
-    readInJSONDescription("RemoveArrays"));
-  new AddPythonTransformReaction(
-    reinterpretSignedToUnignedAction, "Reinterpret Signed to Unsigned",
-    readInPythonScript("ReinterpretSignedToUnsigned"));
+  AddPythonTransformReaction::fromScript(removeArraysAction, "Remove Arrays",
+                                         "RemoveArrays", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(reinterpretSignedToUnignedAction,
+                                         "Reinterpret Signed to Unsigned",
+                                         "ReinterpretSignedToUnsigned");
 
-  new AddPythonTransformReaction(
-    manualManipulationAction, "Manual Manipulation",
-    readInPythonScript("ManualManipulation"), false, false, false,
-    readInJSONDescription("ManualManipulation"));
-  new AddPythonTransformReaction(
-    shiftUniformAction, "Shift Volume",
-    readInPythonScript("Shift_Stack_Uniformly"), false, false, false,
-    readInJSONDescription("Shift_Stack_Uniformly"));
-  new AddPythonTransformReaction(deleteSliceAction, "Delete Slices",
-                                 readInPythonScript("DeleteSlices"),
-                                 false, false, false,
-                                 readInJSONDescription("DeleteSlices"));
-  new AddPythonTransformReaction(padVolumeAction, "Pad Volume",
-                                 readInPythonScript("Pad_Data"), false, false,
-                                 false, readInJSONDescription("Pad_Data"));
-  new AddPythonTransformReaction(downsampleByTwoAction, "Bin Volume x2",
-                                 readInPythonScript("BinVolumeByTwo"));
-  new AddPythonTransformReaction(resampleAction, "Resample",
-                                 readInPythonScript("Resample"), false, false,
-                                 false, readInJSONDescription("Resample"));
-  new AddPythonTransformReaction(rotateAction, "Rotate",
-                                 readInPythonScript("Rotate3D"), false, false,
-                                 false, readInJSONDescription("Rotate3D"));
-  new AddPythonTransformReaction(clearAction, "Clear Volume",
-                                 readInPythonScript("ClearVolume"));
-  new AddPythonTransformReaction(swapAction, "Swap Axes",
-                                 readInPythonScript("SwapAxes"), false, false,
-                                 false, readInJSONDescription("SwapAxes"));
-  new AddPythonTransformReaction(registrationAction, "Registration",
-                                 readInPythonScript("ElastixRegistration"),
-                                 false, false, false,
-                                 readInJSONDescription("ElastixRegistration"));
-  new AddPythonTransformReaction(setNegativeVoxelsToZeroAction,
-                                 "Set Negative Voxels to Zero",
-                                 readInPythonScript("SetNegativeVoxelsToZero"));
-  new AddPythonTransformReaction(
-    addConstantAction, "Add a Constant", readInPythonScript("AddConstant"),
-    false, false, false, readInJSONDescription("AddConstant"));
-  new AddPythonTransformReaction(invertDataAction, "Invert Data",
-                                 readInPythonScript("InvertData"));
-  new AddPythonTransformReaction(squareRootAction, "Square Root Data",
-                                 readInPythonScript("Square_Root_Data"));
-  new AddPythonTransformReaction(cropEdgesAction, "Clip Edges",
-                                 readInPythonScript("ClipEdges"), false, true,
-                                 false, readInJSONDescription("ClipEdges"));
-  new AddPythonTransformReaction(hannWindowAction, "Hann Window",
-                                 readInPythonScript("HannWindow3D"));
-  new AddPythonTransformReaction(fftAbsLogAction, "FFT (ABS LOG)",
-                                 readInPythonScript("FFT_AbsLog"));
-  new AddPythonTransformReaction(gradientMagnitudeSobelAction,
-                                 "Gradient Magnitude",
-                                 readInPythonScript("GradientMagnitude_Sobel"));
-  new AddPythonTransformReaction(
-    unsharpMaskAction, "Unsharp Mask", readInPythonScript("UnsharpMask"), false,
-    false, false, readInJSONDescription("UnsharpMask"));
-  new AddPythonTransformReaction(laplaceFilterAction, "Laplace Sharpen",
-                                 readInPythonScript("LaplaceFilter"));
-  new AddPythonTransformReaction(
-    wienerAction, "Wiener Filter", readInPythonScript("WienerFilter"), false,
-    false, false, readInJSONDescription("WienerFilter"));
-  new AddPythonTransformReaction(TVminAction, "TV_Filter",
-                                 readInPythonScript("TV_Filter"), false, false,
-                                 false, readInJSONDescription("TV_Filter"));
-  new AddPythonTransformReaction(
-    gaussianFilterAction, "Gaussian Blur", readInPythonScript("GaussianFilter"),
-    false, false, false, readInJSONDescription("GaussianFilter"));
-  new AddPythonTransformReaction(
-    peronaMalikeAnisotropicDiffusionAction,
-    "Perona-Malik Anisotropic Diffusion",
-    readInPythonScript("PeronaMalikAnisotropicDiffusion"), false, false, false,
-    readInJSONDescription("PeronaMalikAnisotropicDiffusion"));
-  new AddPythonTransformReaction(
-    medianFilterAction, "Median Filter", readInPythonScript("MedianFilter"),
-    false, false, false, readInJSONDescription("MedianFilter"));
-  new AddPythonTransformReaction(circleMaskAction, "Circle Mask",
-                                 readInPythonScript("CircleMask"), false, false,
-                                 false, readInJSONDescription("CircleMask"));
-  new AddPythonTransformReaction(
-    moleculeAction, "Add Molecule", readInPythonScript("DummyMolecule"), false,
-    false, false, readInJSONDescription("DummyMolecule"));
+  AddPythonTransformReaction::fromScript(manualManipulationAction,
+                                         "Manual Manipulation",
+                                         "ManualManipulation", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(shiftUniformAction, "Shift Volume",
+                                         "Shift_Stack_Uniformly", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(deleteSliceAction, "Delete Slices",
+                                         "DeleteSlices", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(padVolumeAction, "Pad Volume",
+                                         "Pad_Data", false, false, false, true);
+  AddPythonTransformReaction::fromScript(downsampleByTwoAction, "Bin Volume x2",
+                                         "BinVolumeByTwo");
+  AddPythonTransformReaction::fromScript(resampleAction, "Resample", "Resample",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(rotateAction, "Rotate", "Rotate3D",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(clearAction, "Clear Volume",
+                                         "ClearVolume");
+  AddPythonTransformReaction::fromScript(swapAction, "Swap Axes", "SwapAxes",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(registrationAction, "Registration",
+                                         "ElastixRegistration", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(setNegativeVoxelsToZeroAction,
+                                         "Set Negative Voxels to Zero",
+                                         "SetNegativeVoxelsToZero");
+  AddPythonTransformReaction::fromScript(addConstantAction, "Add a Constant",
+                                         "AddConstant", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(invertDataAction, "Invert Data",
+                                         "InvertData");
+  AddPythonTransformReaction::fromScript(squareRootAction, "Square Root Data",
+                                         "Square_Root_Data");
+  AddPythonTransformReaction::fromScript(cropEdgesAction, "Clip Edges",
+                                         "ClipEdges", false, true, false, true);
+  AddPythonTransformReaction::fromScript(hannWindowAction, "Hann Window",
+                                         "HannWindow3D");
+  AddPythonTransformReaction::fromScript(fftAbsLogAction, "FFT (ABS LOG)",
+                                         "FFT_AbsLog");
+  AddPythonTransformReaction::fromScript(gradientMagnitudeSobelAction,
+                                         "Gradient Magnitude",
+                                         "GradientMagnitude_Sobel");
+  AddPythonTransformReaction::fromScript(unsharpMaskAction, "Unsharp Mask",
+                                         "UnsharpMask", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(laplaceFilterAction, "Laplace Sharpen",
+                                         "LaplaceFilter");
+  AddPythonTransformReaction::fromScript(wienerAction, "Wiener Filter",
+                                         "WienerFilter", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(TVminAction, "TV_Filter", "TV_Filter",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(gaussianFilterAction, "Gaussian Blur",
+                                         "GaussianFilter", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(peronaMalikeAnisotropicDiffusionAction,
+                                         "Perona-Malik Anisotropic Diffusion",
+                                         "PeronaMalikAnisotropicDiffusion",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(medianFilterAction, "Median Filter",
+                                         "MedianFilter", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(circleMaskAction, "Circle Mask",
+                                         "CircleMask", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(moleculeAction, "Add Molecule",
+                                         "DummyMolecule", false, false, false,
+                                         true);
 
-  new AddPythonTransformReaction(
-    tortuosityAction, "Tortuosity", readInPythonScript("Tortuosity"), false,
-    false, false, readInJSONDescription("Tortuosity"));
-  new AddPythonTransformReaction(
-    poreSizeAction, "Pore Size Distribution",
-    readInPythonScript("PoreSizeDistribution"), false, false, false,
-    readInJSONDescription("PoreSizeDistribution"));
+  AddPythonTransformReaction::fromScript(tortuosityAction, "Tortuosity",
+                                         "Tortuosity", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(poreSizeAction,
+                                         "Pore Size Distribution",
+                                         "PoreSizeDistribution", false, false,
+                                         false, true);
 
-  new AddPythonTransformReaction(
-    psdAction, "Power Spectrum Density",
-    readInPythonScript("PowerSpectrumDensity"), false, false, false,
-    readInJSONDescription("PowerSpectrumDensity"));
-  new AddPythonTransformReaction(
-    fscAction, "Fourier Shell Correlation",
-    readInPythonScript("FourierShellCorrelation"), false, false, false,
-    readInJSONDescription("FourierShellCorrelation"));
-  new AddPythonTransformReaction(
-    deconvolutionDenoiseAction, "Deconvolution Denoise",
-    readInPythonScript("DeconvolutionDenoise"), true, false, false,
-    readInJSONDescription("DeconvolutionDenoise"));
-  new AddPythonTransformReaction(
-    similarityMetricsAction, "Similarity Metrics",
-    readInPythonScript("SimilarityMetrics"), false, false, false,
-    readInJSONDescription("SimilarityMetrics"));
+  AddPythonTransformReaction::fromScript(psdAction, "Power Spectrum Density",
+                                         "PowerSpectrumDensity", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(fscAction, "Fourier Shell Correlation",
+                                         "FourierShellCorrelation", false,
+                                         false, false, true);
+  AddPythonTransformReaction::fromScript(deconvolutionDenoiseAction,
+                                         "Deconvolution Denoise",
+                                         "DeconvolutionDenoise", true, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(similarityMetricsAction,
+                                         "Similarity Metrics",
+                                         "SimilarityMetrics", false, false,
+                                         false, true);
 
   new CloneDataReaction(cloneAction);
   new DeleteDataReaction(deleteDataAction);
@@ -220,6 +222,13 @@ void DataTransformMenu::buildTransforms()
 
 void DataTransformMenu::buildSegmentation()
 {
+  if (m_segmentationBuilt) {
+    return;
+  }
+  m_segmentationBuilt = true;
+  disconnect(m_segmentationMenu, &QMenu::aboutToShow, this,
+             &DataTransformMenu::buildSegmentation);
+
   QMenu* menu = m_segmentationMenu;
   menu->clear();
 
@@ -246,55 +255,53 @@ void DataTransformMenu::buildSegmentation()
   auto segmentPoresAction = menu->addAction("Segment Pores");
 
   new AddExpressionReaction(customPythonITKAction);
-  new AddPythonTransformReaction(binaryThresholdAction, "Binary Threshold",
-                                 readInPythonScript("BinaryThreshold"), false,
-                                 false, false,
-                                 readInJSONDescription("BinaryThreshold"));
-  new AddPythonTransformReaction(
-    otsuMultipleThresholdAction, "Otsu Multiple Threshold",
-    readInPythonScript("OtsuMultipleThreshold"), false, false, false,
-    readInJSONDescription("OtsuMultipleThreshold"));
-  new AddPythonTransformReaction(
-    connectedComponentsAction, "Connected Components",
-    readInPythonScript("ConnectedComponents"), false, false, false,
-    readInJSONDescription("ConnectedComponents"));
-  new AddPythonTransformReaction(
-    binaryDilateAction, "Binary Dilate", readInPythonScript("BinaryDilate"),
-    false, false, false, readInJSONDescription("BinaryDilate"));
-  new AddPythonTransformReaction(
-    binaryErodeAction, "Binary Erode", readInPythonScript("BinaryErode"), false,
-    false, false, readInJSONDescription("BinaryErode"));
-  new AddPythonTransformReaction(binaryOpenAction, "Binary Open",
-                                 readInPythonScript("BinaryOpen"), false, false,
-                                 false, readInJSONDescription("BinaryOpen"));
-  new AddPythonTransformReaction(
-    binaryCloseAction, "Binary Close", readInPythonScript("BinaryClose"), false,
-    false, false, readInJSONDescription("BinaryClose"));
-  new AddPythonTransformReaction(
-    binaryMinMaxCurvatureFlowAction, "Binary MinMax Curvature Flow",
-    readInPythonScript("BinaryMinMaxCurvatureFlow"), false, false, false,
-    readInJSONDescription("BinaryMinMaxCurvatureFlow"));
+  AddPythonTransformReaction::fromScript(binaryThresholdAction,
+                                         "Binary Threshold", "BinaryThreshold",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(otsuMultipleThresholdAction,
+                                         "Otsu Multiple Threshold",
+                                         "OtsuMultipleThreshold", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(connectedComponentsAction,
+                                         "Connected Components",
+                                         "ConnectedComponents", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(binaryDilateAction, "Binary Dilate",
+                                         "BinaryDilate", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(binaryErodeAction, "Binary Erode",
+                                         "BinaryErode", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(binaryOpenAction, "Binary Open",
+                                         "BinaryOpen", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(binaryCloseAction, "Binary Close",
+                                         "BinaryClose", false, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(binaryMinMaxCurvatureFlowAction,
+                                         "Binary MinMax Curvature Flow",
+                                         "BinaryMinMaxCurvatureFlow", false,
+                                         false, false, true);
 
-  new AddPythonTransformReaction(
-    labelObjectAttributesAction, "Label Object Attributes",
-    readInPythonScript("LabelObjectAttributes"), false, false, false,
-    readInJSONDescription("LabelObjectAttributes"));
-  new AddPythonTransformReaction(
-    labelObjectPrincipalAxesAction, "Label Object Principal Axes",
-    readInPythonScript("LabelObjectPrincipalAxes"), false, false, false,
-    readInJSONDescription("LabelObjectPrincipalAxes"));
-  new AddPythonTransformReaction(
+  AddPythonTransformReaction::fromScript(labelObjectAttributesAction,
+                                         "Label Object Attributes",
+                                         "LabelObjectAttributes", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(labelObjectPrincipalAxesAction,
+                                         "Label Object Principal Axes",
+                                         "LabelObjectPrincipalAxes", false,
+                                         false, false, true);
+  AddPythonTransformReaction::fromScript(
     distanceFromAxisAction, "Label Object Distance From Principal Axis",
-    readInPythonScript("LabelObjectDistanceFromPrincipalAxis"), false, false,
-    false, readInJSONDescription("LabelObjectDistanceFromPrincipalAxis"));
+    "LabelObjectDistanceFromPrincipalAxis", false, false, false, true);
 
-  new AddPythonTransformReaction(segmentParticlesAction, "Segment Particles",
-                                 readInPythonScript("SegmentParticles"), false,
-                                 false, false,
-                                 readInJSONDescription("SegmentParticles"));
-  new AddPythonTransformReaction(
-    segmentPoresAction, "Segment Pores", readInPythonScript("SegmentPores"),
-    false, false, false, readInJSONDescription("SegmentPores"));
+  AddPythonTransformReaction::fromScript(segmentParticlesAction,
+                                         "Segment Particles",
+                                         "SegmentParticles", false, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(segmentPoresAction, "Segment Pores",
+                                         "SegmentPores", false, false, false,
+                                         true);
 }
 
 void DataTransformMenu::updateActions() {}
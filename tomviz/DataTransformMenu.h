@@ -16,7 +16,8 @@ namespace tomviz {
 
 // DataTransformMenu is the manager for the Data Transform menu.
 // It is responsible for enabling and disabling Data Transforms based
-// on properties of the DataSource.
+// on properties of the DataSource. The menus are only populated when they
+// are first shown, or when build() is called.
 class DataTransformMenu : public QObject
 {
   Q_OBJECT
@@ -24,6 +25,9 @@ class DataTransformMenu : public QObject
 public:
   DataTransformMenu(QMainWindow* mainWindow, QMenu* transform, QMenu* seg);
 
+  // Populate any menu that has not been shown yet
+  void build();
+
 private slots:
   void updateActions();
 
@@ -37,6 +41,8 @@ private:
   QMenu* m_transformMenu;
   QMenu* m_segmentationMenu;
   QMainWindow* m_mainWindow;
+  bool m_transformsBuilt = false;
+  bool m_segmentationBuilt = false;
 };
 } // namespace tomviz
 
@@ -2,6 +2,7 @@
    It is released under the 3-Clause BSD License, see "LICENSE". */
 
 #include "FileFormatManager.h"
+#include "MicroscopyFormat.h"
 #include "PythonReader.h"
 #include "PythonUtilities.h"
 #include "PythonWriter.h"
@@ -18,6 +19,13 @@ FileFormatManager& FileFormatManager::instance()
   return theInstance;
 }
 
+FileFormatManager::FileFormatManager()
+{
+  registerNativeReader("Digital Micrograph files", { "dm3", "dm4" },
+                       &DmFormat::read);
+  registerNativeReader("SER files", { "ser" }, &SerFormat::read);
+}
+
 namespace {
 
 template <typename T>
@@ -166,4 +174,28 @@ PythonWriterFactory* FileFormatManager::pythonWriterFactory(const QString& ext)
   return m_pythonExtWriterMap.value(ext, nullptr);
 }
 
+void FileFormatManager::registerNativeReader(const QString& description,
+                                             const QStringList& extensions,
+                                             NativeReader reader)
+{
+  QStringList filterExt;
+  foreach (auto ext, extensions) {
+    filterExt << QString("*.%1").arg(ext);
+    m_nativeExtReaderMap[ext] = reader;
+  }
+  m_nativeReaderFilters
+    << QString("%1 (%2)").arg(description).arg(filterExt.join(QString(" ")));
+}
+
+QStringList FileFormatManager::nativeReaderFilters() const
+{
+  return m_nativeReaderFilters;
+}
+
+FileFormatManager::NativeReader FileFormatManager::nativeReader(
+  const QString& ext) const
+{
+  return m_nativeExtReaderMap.value(ext);
+}
+
 } // namespace tomviz
@@ -7,6 +7,12 @@
 #include <QList>
 #include <QMap>
 #include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <string>
+
+class vtkImageData;
 
 namespace tomviz {
 
@@ -39,11 +45,26 @@ public:
   PythonReaderFactory* pythonReaderFactory(const QString& ext);
   PythonWriterFactory* pythonWriterFactory(const QString& ext);
 
+  // The readers implemented in C++, which read a file into an image
+  using NativeReader = std::function<bool(const std::string&, vtkImageData*)>;
+
+  // The file dialog filters of the native readers
+  QStringList nativeReaderFilters() const;
+
+  NativeReader nativeReader(const QString& ext) const;
+
 private:
+  FileFormatManager();
+  void registerNativeReader(const QString& description,
+                            const QStringList& extensions,
+                            NativeReader reader);
+
   void setPythonReadersMap(QMap<QString, PythonReaderFactory*> factories);
   void setPythonWritersMap(QMap<QString, PythonWriterFactory*> factories);
   QMap<QString, PythonReaderFactory*> m_pythonExtReaderMap;
   QMap<QString, PythonWriterFactory*> m_pythonExtWriterMap;
+  QMap<QString, NativeReader> m_nativeExtReaderMap;
+  QStringList m_nativeReaderFilters;
 };
 } // namespace tomviz
 
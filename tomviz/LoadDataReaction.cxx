@@ -20,6 +20,7 @@
 #include "PythonReader.h"
 #include "PythonUtilities.h"
 #include "RAWFileReaderDialog.h"
+#include "RawFormat.h"
 #include "RecentFilesMenu.h"
 #include "TimeSeriesStep.h"
 #include "Utilities.h"
@@ -53,6 +54,7 @@
 #include <QDebug>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QInputDialog>
 #include <QJsonArray>
 #include <QMessageBox>
 
@@ -96,6 +98,35 @@ bool hasData(vtkSMProxy* reader)
   }
   return true;
 }
+
+// Ask for the resolution level of a pyramidal OME-TIFF, offering the
+// coarsest first so that the volume can be previewed quickly. -1 if the
+// user cancelled.
+int pickResolutionLevel(tomviz::vtkOMETiffReader* reader)
+{
+  QStringList items;
+  for (int i = 0; i < reader->GetNumberOfResolutionLevels(); ++i) {
+    int dims[3];
+    reader->GetResolutionLevelDimensions(i, dims);
+    items << QString("Level %1: %2 x %3 x %4")
+               .arg(i)
+               .arg(dims[0])
+               .arg(dims[1])
+               .arg(dims[2]);
+  }
+
+  bool userOkayed;
+  QString selection =
+    QInputDialog::getItem(tomviz::mainWidget(), "Resolution Level",
+                          "Select the resolution level to open", items,
+                          /*current=*/items.size() - 1,
+                          /*editable=*/false,
+                          /*ok*/ &userOkayed);
+  if (!userOkayed) {
+    return -1;
+  }
+  return items.indexOf(selection);
+}
 } // namespace
 
 namespace tomviz {
@@ -131,6 +162,8 @@ QList<DataSource*> LoadDataReaction::loadData(bool isTimeSeries)
           << "Molecule files (*.xyz)"
           << "Text files (*.txt)";
 
+  filters << FileFormatManager::instance().nativeReaderFilters();
+
   foreach (auto reader, FileFormatManager::instance().pythonReaderFactories()) {
     filters << reader->getFileDialogFilter();
   }
@@ -324,13 +357,38 @@ DataSource* LoadDataReaction::loadData(const QStringList& fileNames,
     loadWithParaview = false;
     vtkNew<vtkOMETiffReader> reader;
     reader->SetFileName(fileName.toLocal8Bit().constData());
+
+    // Reloaded states keep the level they were saved with
+    int level = 0;
+    auto savedProperties = options["reader"].toObject();
+    if (savedProperties.contains("resolutionLevel")) {
+      level = savedProperties["resolutionLevel"].toInt();
+    } else {
+      reader->UpdateInformation();
+      if (reader->GetNumberOfResolutionLevels() > 1) {
+        level = pickResolutionLevel(reader);
+        if (level < 0) {
+          return nullptr;
+        }
+      }
+    }
+    reader->SetResolutionLevel(level);
     reader->Update();
     auto* imageData = reader->GetOutput();
 
     dataSource = new DataSource(imageData);
     QJsonObject readerProperties;
     readerProperties["name"] = "OMETIFFReader";
+    readerProperties["resolutionLevel"] = level;
     dataSource->setReaderProperties(readerProperties.toVariantMap());
+  } else if (auto nativeReader = FileFormatManager::instance().nativeReader(
+               info.suffix().toLower())) {
+    loadWithParaview = false;
+    vtkNew<vtkImageData> imageData;
+    if (!nativeReader(fileName.toStdString(), imageData)) {
+      return nullptr;
+    }
+    dataSource = new DataSource(imageData);
   } else if (FileFormatManager::instance().pythonReaderFactory(
                info.suffix().toLower()) != nullptr) {
     loadWithParaview = false;
@@ -353,8 +411,8 @@ DataSource* LoadDataReaction::loadData(const QStringList& fileNames,
 
     // We'll add it to the pipeline on our own later, if needed
     bool addToThePipeline = false;
-    dataSource = LoadDataReaction::createDataSource(reader, defaultModules,
-                                                    child, addToThePipeline);
+    dataSource = LoadDataReaction::createDataSource(
+      reader, defaultModules, child, addToThePipeline, options);
     if (dataSource == nullptr) {
       return nullptr;
     }
@@ -420,7 +478,8 @@ DataSource* LoadDataReaction::loadData(const QStringList& fileNames,
 
 DataSource* LoadDataReaction::createDataSource(vtkSMProxy* reader,
                                                bool defaultModules, bool child,
-                                               bool addToPipeline)
+                                               bool addToPipeline,
+                                               const QJsonObject& options)
 {
   // Prompt user for reader configuration, unless it is TIFF.
   QScopedPointer<QDialog> dialog(new pqProxyWidgetDialog(reader));
@@ -441,6 +500,30 @@ DataSource* LoadDataReaction::createDataSource(vtkSMProxy* reader,
   if (QString(reader->GetXMLName()) == "TIFFSeriesReader" ||
       hasVisibleWidgets == false || dialog->exec() == QDialog::Accepted) {
 
+    if (QString(reader->GetXMLName()) == "TVRawImageReader" &&
+        RawFormat::canRead(reader)) {
+      // Map the file rather than streaming it through vtkImageReader
+      QVariantMap rawOptions;
+      if (options.contains("subsampleSettings")) {
+        rawOptions["subsampleStrides"] =
+          options["subsampleSettings"].toObject()["strides"].toVariant();
+        rawOptions["subsampleVolumeBounds"] =
+          options["subsampleSettings"].toObject()["volumeBounds"].toVariant();
+        rawOptions["askForSubsample"] = false;
+      }
+      vtkNew<vtkImageData> image;
+      if (!RawFormat::read(reader, image, rawOptions)) {
+        qCritical() << "Error: failed to load file!";
+        return nullptr;
+      }
+
+      auto dataSource = new DataSource(image, DataSource::Volume);
+      if (addToPipeline) {
+        LoadDataReaction::dataSourceAdded(dataSource, defaultModules, child);
+      }
+      return dataSource;
+    }
+
     if (!hasData(reader)) {
       qCritical() << "Error: failed to load file!";
       return nullptr;
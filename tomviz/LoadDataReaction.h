@@ -62,11 +62,11 @@ public:
                               bool createCameraOrbit = true);
 
 protected:
-  /// Create a raw data source from the reader.
-  static DataSource* createDataSource(vtkSMProxy* reader,
-                                      bool defaultModules = true,
-                                      bool child = false,
-                                      bool addToPipeline = true);
+  /// Create a raw data source from the reader. The options may hold the
+  /// subsample settings of a raw volume.
+  static DataSource* createDataSource(
+    vtkSMProxy* reader, bool defaultModules = true, bool child = false,
+    bool addToPipeline = true, const QJsonObject& options = QJsonObject());
 
   /// Called when the action is triggered.
   void onTriggered() override;
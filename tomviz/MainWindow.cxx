@@ -64,6 +64,7 @@
 #include "SetDataTypeReaction.h"
 #include "SetTiltAnglesOperator.h"
 #include "SetTiltAnglesReaction.h"
+#include "StartupProfiler.h"
 #include "Utilities.h"
 #include "ViewMenuManager.h"
 #include "VolumeManager.h"
@@ -259,7 +260,8 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags)
           &PtychoRunner::start);
 
   // Build Data Transforms menu
-  new DataTransformMenu(this, m_ui->menuData, m_ui->menuSegmentation);
+  m_dataTransformMenu =
+    new DataTransformMenu(this, m_ui->menuData, m_ui->menuSegmentation);
 
   // Create the custom transforms menu
   m_customTransformsMenu = new QMenu("Custom Transforms", this);
@@ -278,202 +280,10 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags)
   OperatorProxyFactory::registerWithFactory();
   PipelineProxyFactory::registerWithFactory();
 
-  // Build Tomography menu
-  // ################################################################
-  QAction* setVolumeDataTypeAction =
-    m_ui->menuTomography->addAction("Set Data Type");
-  QAction* setTiltDataTypeAction =
-    m_ui->menuTomography->addAction("Set Data Type");
-  // QAction* setFibDataTypeAction =
-  //   m_ui->menuTomography->addAction("Set Data Type");
-  m_ui->menuTomography->addSeparator();
-
-  QAction* setTiltAnglesAction =
-    m_ui->menuTomography->addAction("Set Tilt Angles");
-  m_ui->menuTomography->addSeparator();
-
-  QAction* dataProcessingLabel =
-    m_ui->menuTomography->addAction("Pre-processing:");
-  dataProcessingLabel->setEnabled(false);
-  QAction* downsampleByTwoAction =
-    m_ui->menuTomography->addAction("Bin Tilt Images x2");
-  QAction* removeBadPixelsAction =
-    m_ui->menuTomography->addAction("Remove Bad Pixels");
-  QAction* gaussianFilterAction =
-    m_ui->menuTomography->addAction("Gaussian Filter");
-  QAction* autoSubtractBackgroundAction =
-    m_ui->menuTomography->addAction("Background Subtraction (Auto)");
-  QAction* subtractBackgroundAction =
-    m_ui->menuTomography->addAction("Background Subtraction (Manual)");
-  QAction* normalizationAction =
-    m_ui->menuTomography->addAction("Normalize Average Image Intensity");
-  QAction* gradientMagnitude2DSobelAction =
-    m_ui->menuTomography->addAction("2D Gradient Magnitude");
-  QAction* ctfCorrectAction = m_ui->menuTomography->addAction("CTF Correction");
-
-  m_ui->menuTomography->addSeparator();
-  QAction* alignmentLabel = m_ui->menuTomography->addAction("Alignment:");
-  alignmentLabel->setEnabled(false);
-  QAction* autoAlignCCAction = m_ui->menuTomography->addAction(
-    "Image Alignment (Auto: Cross Correlation)");
-  QAction* autoAlignCOMAction =
-    m_ui->menuTomography->addAction("Image Alignment (Auto: Center of Mass)");
-  QAction* autoAlignPyStackRegAction =
-    m_ui->menuTomography->addAction("Image Alignment (Auto: PyStackReg)");
-  QAction* alignAction =
-    m_ui->menuTomography->addAction("Image Alignment (Manual)");
-  QAction* autoRotateAlignAction =
-    m_ui->menuTomography->addAction("Tilt Axis Rotation Alignment (Auto)");
-  QAction* autoRotateAlignShiftAction =
-    m_ui->menuTomography->addAction("Tilt Axis Shift Alignment (Auto)");
-  QAction* rotateAlignAction =
-    m_ui->menuTomography->addAction("Tilt Axis Alignment (Manual)");
-  QAction* shiftRotationCenterAction =
-    m_ui->menuTomography->addAction("Shift Rotation Center (Manual)");
-  m_ui->menuTomography->addSeparator();
-
-  QAction* reconLabel = m_ui->menuTomography->addAction("Reconstruction:");
-  reconLabel->setEnabled(false);
-  QAction* reconDFMAction =
-    m_ui->menuTomography->addAction("Direct Fourier Method");
-  QAction* reconWBPAction =
-    m_ui->menuTomography->addAction("Weighted Back Projection");
-  QAction* reconWBP_CAction =
-    m_ui->menuTomography->addAction("Simple Back Projection (C++)");
-  QAction* reconARTAction =
-    m_ui->menuTomography->addAction("Algebraic Reconstruction Technique (ART)");
-  QAction* reconSIRTAction = m_ui->menuTomography->addAction(
-    "Simultaneous Iterative Recon. Technique (SIRT)");
-  QAction* reconDFMConstraintAction =
-    m_ui->menuTomography->addAction("Constraint-based Direct Fourier Method");
-  QAction* reconTVMinimizationAction =
-    m_ui->menuTomography->addAction("TV Minimization Method");
-  QAction* reconTomoPyGridRecAction =
-    m_ui->menuTomography->addAction("TomoPy Reconstruction");
-  m_ui->menuTomography->addSeparator();
-
-  QAction* simulationLabel =
-    m_ui->menuTomography->addAction("Simulation and Demonstrations:");
-  simulationLabel->setEnabled(false);
-  QAction* generateTiltSeriesAction =
-    m_ui->menuTomography->addAction("Project Tilt Series from Volume");
-
-  QAction* randomShiftsAction =
-    m_ui->menuTomography->addAction("Shift Tilt Series Randomly");
-  QAction* reconRealTimeAction =
-    m_ui->menuTomography->addAction("Initialize Real-Time Tomography");
-  QAction* addPoissonNoiseAction =
-    m_ui->menuTomography->addAction("Add Poisson Noise");
-
-  // Set up reactions for Tomography Menu
-  //#################################################################
-  new SetDataTypeReaction(setVolumeDataTypeAction, this, DataSource::Volume);
-  new SetDataTypeReaction(setTiltDataTypeAction, this, DataSource::TiltSeries);
-  // new SetDataTypeReaction(setFibDataTypeAction, this, DataSource::FIB);
-  new SetTiltAnglesReaction(setTiltAnglesAction, this);
-
-  new AddPythonTransformReaction(
-    generateTiltSeriesAction, "Generate Tilt Series",
-    readInPythonScript("GenerateTiltSeries"), false, true, false,
-    readInJSONDescription("GenerateTiltSeries"));
-
-  new AddAlignReaction(alignAction);
-  new AddPythonTransformReaction(downsampleByTwoAction, "Bin Tilt Image x2",
-                                 readInPythonScript("BinTiltSeriesByTwo"),
-                                 false, false, false);
-  new AddPythonTransformReaction(
-    removeBadPixelsAction, "Remove Bad Pixels",
-    readInPythonScript("RemoveBadPixelsTiltSeries"), false, false, false);
-  new AddPythonTransformReaction(
-    gaussianFilterAction, "Gaussian Filter Tilt Series",
-    readInPythonScript("GaussianFilterTiltSeries"), false, false, false,
-    readInJSONDescription("GaussianFilterTiltSeries"));
-  new AddPythonTransformReaction(
-    autoSubtractBackgroundAction, "Background Subtraction (Auto)",
-    readInPythonScript("Subtract_TiltSer_Background_Auto"), false, false,
-    false);
-  new AddPythonTransformReaction(
-    subtractBackgroundAction, "Background Subtraction (Manual)",
-    readInPythonScript("Subtract_TiltSer_Background"), false, false, false);
-  new AddPythonTransformReaction(normalizationAction, "Normalize Tilt Series",
-                                 readInPythonScript("NormalizeTiltSeries"),
-                                 false, false, false);
-  new AddPythonTransformReaction(
-    gradientMagnitude2DSobelAction, "Gradient Magnitude 2D",
-    readInPythonScript("GradientMagnitude2D_Sobel"), false, false, false);
-  new AddPythonTransformReaction(ctfCorrectAction, "CTF Correction",
-                                 readInPythonScript("ctf_correct"), true, false,
-                                 false, readInJSONDescription("ctf_correct"));
-  new AddPythonTransformReaction(
-    rotateAlignAction, "Tilt Axis Alignment (manual)",
-    readInPythonScript("RotationAlign"), true, false, false,
-    readInJSONDescription("RotationAlign"));
-  new AddPythonTransformReaction(
-    autoRotateAlignAction, "Auto Tilt Axis Align",
-    readInPythonScript("AutoTiltAxisRotationAlignment"), true, false, false,
-    readInJSONDescription("AutoTiltAxisRotationAlignment"));
-  new AddPythonTransformReaction(
-    autoRotateAlignShiftAction, "Auto Tilt Axis Shift Align",
-    readInPythonScript("AutoTiltAxisShiftAlignment"), true, false, false,
-    readInJSONDescription("AutoTiltAxisShiftAlignment"));
-
-  new AddPythonTransformReaction(
-    autoAlignCCAction, "Auto Tilt Image Align (XCORR)",
-    readInPythonScript("AutoCrossCorrelationTiltImageAlignment"), false, false,
-    false, readInJSONDescription("AutoCrossCorrelationTiltImageAlignment"));
-  new AddPythonTransformReaction(
-    autoAlignCOMAction, "Auto Tilt Image Align (CoM)",
-    readInPythonScript("AutoCenterOfMassTiltImageAlignment"), false, false,
-    false, readInJSONDescription("AutoCenterOfMassTiltImageAlignment"));
-  new AddPythonTransformReaction(
-    autoAlignPyStackRegAction, "Auto Tilt Image Align (PyStackReg)",
-    readInPythonScript("PyStackRegImageAlignment"), false, false,
-    false, readInJSONDescription("PyStackRegImageAlignment"));
-  new AddPythonTransformReaction(
-    shiftRotationCenterAction, "Shift Rotation Center",
-    readInPythonScript("ShiftRotationCenter_tomopy"), true, false, false,
-    readInJSONDescription("ShiftRotationCenter_tomopy"));
-
-  new AddPythonTransformReaction(reconDFMAction, "Reconstruct (Direct Fourier)",
-                                 readInPythonScript("Recon_DFT"), true, false,
-                                 false, readInJSONDescription("Recon_DFT"));
-  new AddPythonTransformReaction(reconWBPAction,
-                                 "Reconstruct (Back Projection)",
-                                 readInPythonScript("Recon_WBP"), true, false,
-                                 false, readInJSONDescription("Recon_WBP"));
-  new AddPythonTransformReaction(reconARTAction, "Reconstruct (ART)",
-                                 readInPythonScript("Recon_ART"), true, false,
-                                 false, readInJSONDescription("Recon_ART"));
-  new AddPythonTransformReaction(reconSIRTAction, "Reconstruct (SIRT)",
-                                 readInPythonScript("Recon_SIRT"), true, false,
-                                 false, readInJSONDescription("Recon_SIRT"));
-  new AddPythonTransformReaction(
-    reconDFMConstraintAction, "Reconstruct (Constraint-based Direct Fourier)",
-    readInPythonScript("Recon_DFT_constraint"), true, false, false,
-    readInJSONDescription("Recon_DFT_constraint"));
-  new AddPythonTransformReaction(
-    reconTVMinimizationAction, "Reconstruct (TV Minimization)",
-    readInPythonScript("Recon_TV_minimization"), true, false, false,
-    readInJSONDescription("Recon_TV_minimization"));
-  new AddPythonTransformReaction(
-    reconTomoPyGridRecAction, "Reconstruct (TomoPy)",
-    readInPythonScript("Recon_tomopy"), true, false, false,
-    readInJSONDescription("Recon_tomopy"));
-
-  new ReconstructionReaction(reconWBP_CAction);
-
-  new AddPythonTransformReaction(
-    randomShiftsAction, "Shift Tilt Series Randomly",
-    readInPythonScript("ShiftTiltSeriesRandomly"), true, false, false,
-    readInJSONDescription("ShiftTiltSeriesRandomly"));
-  new AddPythonTransformReaction(
-    reconRealTimeAction, "Initialize Real-Time Tomography",
-    readInPythonScript("Recon_real_time_tomography"), true, false, false,
-    readInJSONDescription("Recon_real_time_tomography"));
-  new AddPythonTransformReaction(addPoissonNoiseAction, "Add Poisson Noise",
-                                 readInPythonScript("AddPoissonNoise"), true,
-                                 false, false,
-                                 readInJSONDescription("AddPoissonNoise"));
+  // The Tomography menu is populated when it is first shown, or once Python
+  // has been initialized
+  connect(m_ui->menuTomography, &QMenu::aboutToShow, this,
+          &MainWindow::buildTomographyMenu);
 
   //#################################################################
   new ModuleMenu(m_ui->modulesToolbar, m_ui->menuModules, this);
@@ -571,14 +381,18 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags)
   FileFormatManager::instance().prepopulatePythonReaders();
   FileFormatManager::instance().prepopulatePythonWriters();
 
-  // Async initialize python
-  statusBar()->showMessage("Initializing python...");
+  // Python is initialized asynchronously once the window has been shown, see
+  // initializePython().
   auto pythonWatcher = new QFutureWatcher<std::vector<OperatorDescription>>;
+  m_pythonWatcher = pythonWatcher;
   connect(pythonWatcher, &QFutureWatcherBase::finished, this,
           [this, pyXRFRunner, ptychoRunner, pythonWatcher, dataBrokerSaveReaction]() {
             m_ui->actionAcquisition->setEnabled(true);
             m_ui->actionPassiveAcquisition->setEnabled(true);
             registerCustomOperators(pythonWatcher->result());
+            // Register the bundled operators for the Python pipelines
+            m_dataTransformMenu->build();
+            buildTomographyMenu();
             // Check if we have DataBroker and enable menu if we do
             auto dataBroker = new DataBroker(this);
             m_ui->actionImportFromDataBroker->setEnabled(
@@ -610,12 +424,16 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags flags)
               m_ui->actionPtychoWorkflow->setToolTip(tooltip);
             }
 
+            m_pythonWatcher = nullptr;
             delete pythonWatcher;
             statusBar()->showMessage("Initialization complete", 1500);
-          });
+            StartupProfiler::finish();
 
-  auto pythonFuture = QtConcurrent::run(initPython);
-  pythonWatcher->setFuture(pythonFuture);
+            if (!m_pendingFile.isEmpty()) {
+              openFile(m_pendingFile);
+              m_pendingFile.clear();
+            }
+          });
 
   // Add plugin dock widgets when a plugin is loaded
   new pqPluginDockWidgetsBehavior(this);
@@ -630,14 +448,237 @@ MainWindow::~MainWindow()
   }
 }
 
+void MainWindow::buildTomographyMenu()
+{
+  if (m_tomographyMenuBuilt) {
+    return;
+  }
+  m_tomographyMenuBuilt = true;
+  disconnect(m_ui->menuTomography, &QMenu::aboutToShow, this,
+             &MainWindow::buildTomographyMenu);
+
+  // ################################################################
+  QAction* setVolumeDataTypeAction =
+    m_ui->menuTomography->addAction("Set Data Type");
+  QAction* setTiltDataTypeAction =
+    m_ui->menuTomography->addAction("Set Data Type");
+  // QAction* setFibDataTypeAction =
+  //   m_ui->menuTomography->addAction("Set Data Type");
+  m_ui->menuTomography->addSeparator();
+
+  QAction* setTiltAnglesAction =
+    m_ui->menuTomography->addAction("Set Tilt Angles");
+  m_ui->menuTomography->addSeparator();
+
+  QAction* dataProcessingLabel =
+    m_ui->menuTomography->addAction("Pre-processing:");
+  dataProcessingLabel->setEnabled(false);
+  QAction* downsampleByTwoAction =
+    m_ui->menuTomography->addAction("Bin Tilt Images x2");
+  QAction* removeBadPixelsAction =
+    m_ui->menuTomography->addAction("Remove Bad Pixels");
+  QAction* gaussianFilterAction =
+    m_ui->menuTomography->addAction("Gaussian Filter");
+  QAction* autoSubtractBackgroundAction =
+    m_ui->menuTomography->addAction("Background Subtraction (Auto)");
+  QAction* subtractBackgroundAction =
+    m_ui->menuTomography->addAction("Background Subtraction (Manual)");
+  QAction* normalizationAction =
+    m_ui->menuTomography->addAction("Normalize Average Image Intensity");
+  QAction* gradientMagnitude2DSobelAction =
+    m_ui->menuTomography->addAction("2D Gradient Magnitude");
+  QAction* ctfCorrectAction = m_ui->menuTomography->addAction("CTF Correction");
+
+  m_ui->menuTomography->addSeparator();
+  QAction* alignmentLabel = m_ui->menuTomography->addAction("Alignment:");
+  alignmentLabel->setEnabled(false);
+  QAction* autoAlignCCAction = m_ui->menuTomography->addAction(
+    "Image Alignment (Auto: Cross Correlation)");
+  QAction* autoAlignCOMAction =
+    m_ui->menuTomography->addAction("Image Alignment (Auto: Center of Mass)");
+  QAction* autoAlignPyStackRegAction =
+    m_ui->menuTomography->addAction("Image Alignment (Auto: PyStackReg)");
+  QAction* alignAction =
+    m_ui->menuTomography->addAction("Image Alignment (Manual)");
+  QAction* autoRotateAlignAction =
+    m_ui->menuTomography->addAction("Tilt Axis Rotation Alignment (Auto)");
+  QAction* autoRotateAlignShiftAction =
+    m_ui->menuTomography->addAction("Tilt Axis Shift Alignment (Auto)");
+  QAction* rotateAlignAction =
+    m_ui->menuTomography->addAction("Tilt Axis Alignment (Manual)");
+  QAction* shiftRotationCenterAction =
+    m_ui->menuTomography->addAction("Shift Rotation Center (Manual)");
+  m_ui->menuTomography->addSeparator();
+
+  QAction* reconLabel = m_ui->menuTomography->addAction("Reconstruction:");
+  reconLabel->setEnabled(false);
+  QAction* reconDFMAction =
+    m_ui->menuTomography->addAction("Direct Fourier Method");
+  QAction* reconWBPAction =
+    m_ui->menuTomography->addAction("Weighted Back Projection");
+  QAction* reconWBP_CAction =
+    m_ui->menuTomography->addAction("Simple Back Projection (C++)");
+  QAction* reconARTAction =
+    m_ui->menuTomography->addAction("Algebraic Reconstruction Technique (ART)");
+  QAction* reconSIRTAction = m_ui->menuTomography->addAction(
+    "Simultaneous Iterative Recon. Technique (SIRT)");
+  QAction* reconDFMConstraintAction =
+    m_ui->menuTomography->addAction("Constraint-based Direct Fourier Method");
+  QAction* reconTVMinimizationAction =
+    m_ui->menuTomography->addAction("TV Minimization Method");
+  QAction* reconTomoPyGridRecAction =
+    m_ui->menuTomography->addAction("TomoPy Reconstruction");
+  m_ui->menuTomography->addSeparator();
+
+  QAction* simulationLabel =
+    m_ui->menuTomography->addAction("Simulation and Demonstrations:");
+  simulationLabel->setEnabled(false);
+  QAction* generateTiltSeriesAction =
+    m_ui->menuTomography->addAction("Project Tilt Series from Volume");
+
+  QAction* randomShiftsAction =
+    m_ui->menuTomography->addAction("Shift Tilt Series Randomly");
+  QAction* reconRealTimeAction =
+    m_ui->menuTomography->addAction("Initialize Real-Time Tomography");
+  QAction* addPoissonNoiseAction =
+    m_ui->menuTomography->addAction("Add Poisson Noise");
+
+  // Set up reactions for Tomography Menu
+  //#################################################################
+  new SetDataTypeReaction(setVolumeDataTypeAction, this, DataSource::Volume);
+  new SetDataTypeReaction(setTiltDataTypeAction, this, DataSource::TiltSeries);
+  // new SetDataTypeReaction(setFibDataTypeAction, this, DataSource::FIB);
+  new SetTiltAnglesReaction(setTiltAnglesAction, this);
+
+  AddPythonTransformReaction::fromScript(generateTiltSeriesAction,
+                                         "Generate Tilt Series",
+                                         "GenerateTiltSeries", false, true,
+                                         false, true);
+
+  new AddAlignReaction(alignAction);
+  AddPythonTransformReaction::fromScript(downsampleByTwoAction,
+                                         "Bin Tilt Image x2",
+                                         "BinTiltSeriesByTwo");
+  AddPythonTransformReaction::fromScript(removeBadPixelsAction,
+                                         "Remove Bad Pixels",
+                                         "RemoveBadPixelsTiltSeries");
+  AddPythonTransformReaction::fromScript(gaussianFilterAction,
+                                         "Gaussian Filter Tilt Series",
+                                         "GaussianFilterTiltSeries", false,
+                                         false, false, true);
+  AddPythonTransformReaction::fromScript(autoSubtractBackgroundAction,
+                                         "Background Subtraction (Auto)",
+                                         "Subtract_TiltSer_Background_Auto");
+  AddPythonTransformReaction::fromScript(subtractBackgroundAction,
+                                         "Background Subtraction (Manual)",
+                                         "Subtract_TiltSer_Background");
+  AddPythonTransformReaction::fromScript(normalizationAction,
+                                         "Normalize Tilt Series",
+                                         "NormalizeTiltSeries");
+  AddPythonTransformReaction::fromScript(gradientMagnitude2DSobelAction,
+                                         "Gradient Magnitude 2D",
+                                         "GradientMagnitude2D_Sobel");
+  AddPythonTransformReaction::fromScript(ctfCorrectAction, "CTF Correction",
+                                         "ctf_correct", true, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(rotateAlignAction,
+                                         "Tilt Axis Alignment (manual)",
+                                         "RotationAlign", true, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(autoRotateAlignAction,
+                                         "Auto Tilt Axis Align",
+                                         "AutoTiltAxisRotationAlignment", true,
+                                         false, false, true);
+  AddPythonTransformReaction::fromScript(autoRotateAlignShiftAction,
+                                         "Auto Tilt Axis Shift Align",
+                                         "AutoTiltAxisShiftAlignment", true,
+                                         false, false, true);
+
+  AddPythonTransformReaction::fromScript(
+    autoAlignCCAction, "Auto Tilt Image Align (XCORR)",
+    "AutoCrossCorrelationTiltImageAlignment", false, false, false, true);
+  AddPythonTransformReaction::fromScript(autoAlignCOMAction,
+                                         "Auto Tilt Image Align (CoM)",
+                                         "AutoCenterOfMassTiltImageAlignment",
+                                         false, false, false, true);
+  AddPythonTransformReaction::fromScript(autoAlignPyStackRegAction,
+                                         "Auto Tilt Image Align (PyStackReg)",
+                                         "PyStackRegImageAlignment", false,
+                                         false, false, true);
+  AddPythonTransformReaction::fromScript(shiftRotationCenterAction,
+                                         "Shift Rotation Center",
+                                         "ShiftRotationCenter_tomopy", true,
+                                         false, false, true);
+
+  AddPythonTransformReaction::fromScript(reconDFMAction,
+                                         "Reconstruct (Direct Fourier)",
+                                         "Recon_DFT", true, false, false, true);
+  AddPythonTransformReaction::fromScript(reconWBPAction,
+                                         "Reconstruct (Back Projection)",
+                                         "Recon_WBP", true, false, false, true);
+  AddPythonTransformReaction::fromScript(reconARTAction, "Reconstruct (ART)",
+                                         "Recon_ART", true, false, false, true);
+  AddPythonTransformReaction::fromScript(reconSIRTAction, "Reconstruct (SIRT)",
+                                         "Recon_SIRT", true, false, false,
+                                         true);
+  AddPythonTransformReaction::fromScript(
+    reconDFMConstraintAction, "Reconstruct (Constraint-based Direct Fourier)",
+    "Recon_DFT_constraint", true, false, false, true);
+  AddPythonTransformReaction::fromScript(reconTVMinimizationAction,
+                                         "Reconstruct (TV Minimization)",
+                                         "Recon_TV_minimization", true, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(reconTomoPyGridRecAction,
+                                         "Reconstruct (TomoPy)", "Recon_tomopy",
+                                         true, false, false, true);
+
+  new ReconstructionReaction(reconWBP_CAction);
+
+  AddPythonTransformReaction::fromScript(randomShiftsAction,
+                                         "Shift Tilt Series Randomly",
+                                         "ShiftTiltSeriesRandomly", true, false,
+                                         false, true);
+  AddPythonTransformReaction::fromScript(reconRealTimeAction,
+                                         "Initialize Real-Time Tomography",
+                                         "Recon_real_time_tomography", true,
+                                         false, false, true);
+  AddPythonTransformReaction::fromScript(addPoissonNoiseAction,
+                                         "Add Poisson Noise", "AddPoissonNoise",
+                                         true, false, false, true);
+}
+
+void MainWindow::initializePython()
+{
+  if (m_pythonInitStarted) {
+    return;
+  }
+  m_pythonInitStarted = true;
+
+  statusBar()->showMessage("Initializing python...");
+  m_pythonWatcher->setFuture(QtConcurrent::run(initPython));
+}
+
 std::vector<OperatorDescription> MainWindow::initPython()
 {
-  Python::initialize();
-  Connection::registerType();
-  RegexGroupSubstitution::registerType();
-  auto operators = findCustomOperators();
-  FileFormatManager::instance().registerPythonReaders();
-  FileFormatManager::instance().registerPythonWriters();
+  {
+    StartupProfiler::Phase phase("python interpreter");
+    Python::initialize();
+  }
+  std::vector<OperatorDescription> operators;
+  {
+    StartupProfiler::Phase phase("python type registration");
+    Connection::registerType();
+    RegexGroupSubstitution::registerType();
+  }
+  {
+    StartupProfiler::Phase phase("custom operator discovery");
+    operators = findCustomOperators();
+  }
+  {
+    StartupProfiler::Phase phase("python readers and writers");
+    FileFormatManager::instance().registerPythonReaders();
+    FileFormatManager::instance().registerPythonWriters();
+  }
 
   return operators;
 }
@@ -658,6 +699,16 @@ void MainWindow::openFiles(int argc, char** argv)
   }
 
   QString path(argv[argc - 1]);
+  if (m_pythonWatcher) {
+    // Readers and state files may need Python, wait for it
+    m_pendingFile = path;
+    return;
+  }
+  openFile(path);
+}
+
+void MainWindow::openFile(const QString& path)
+{
   QFileInfo info(path);
   if (!info.exists()) {
     return;
@@ -839,6 +890,7 @@ void MainWindow::showEvent(QShowEvent* e)
   QMainWindow::showEvent(e);
   if (m_isFirstShow) {
     m_isFirstShow = false;
+    StartupProfiler::mark("first show event");
     QTimer::singleShot(1, this, &MainWindow::onFirstWindowShow);
   }
 }
@@ -11,6 +11,8 @@
 #include <QScopedPointer>
 
 class QMenu;
+template <typename T>
+class QFutureWatcher;
 class vtkVector3i;
 
 namespace Ui {
@@ -22,6 +24,7 @@ namespace tomviz {
 class AboutDialog;
 class DataPropertiesPanel;
 class DataSource;
+class DataTransformMenu;
 class MoleculeSource;
 class Module;
 class Operator;
@@ -36,8 +39,17 @@ class MainWindow : public QMainWindow
 public:
   MainWindow(QWidget* parent = nullptr, Qt::WindowFlags flags = Qt::WindowFlags());
   ~MainWindow() override;
+
+  /// Open the file or image stack directory given as the last argument, once
+  /// Python has been initialized.
   void openFiles(int argc, char** argv);
 
+  /// Initialize the Python interpreter, import the Python modules, discover
+  /// custom operators and register the Python readers/writers, all in the
+  /// background. This is deferred until after the window is shown so that it
+  /// does not delay the first paint, and never blocks the event loop.
+  void initializePython();
+
 protected:
   void showEvent(QShowEvent* event) override;
   void closeEvent(QCloseEvent* event) override;
@@ -92,6 +104,9 @@ private slots:
 
   void setImageViewerMode(bool enabled);
 
+  /// Populate the Tomography menu, on first use
+  void buildTomographyMenu();
+
 private:
   Q_DISABLE_COPY(MainWindow)
 
@@ -99,6 +114,7 @@ private:
   static std::vector<OperatorDescription> findCustomOperators();
   void registerCustomOperators(std::vector<OperatorDescription> operators);
   static std::vector<OperatorDescription> initPython();
+  void openFile(const QString& path);
   void syncPythonToApp();
   void updateSaveStateEnableState();
   QString mostRecentStateFile() const;
@@ -106,7 +122,13 @@ private:
   QScopedPointer<Ui::MainWindow> m_ui;
   QMenu* m_customTransformsMenu = nullptr;
   QMenu* m_pipelineTemplates = nullptr;
+  DataTransformMenu* m_dataTransformMenu = nullptr;
+  bool m_tomographyMenuBuilt = false;
   QTimer* m_timer = nullptr;
+  QFutureWatcher<std::vector<OperatorDescription>>* m_pythonWatcher = nullptr;
+  bool m_pythonInitStarted = false;
+  // The file to open once Python has been initialized
+  QString m_pendingFile;
   bool m_isFirstShow = true;
 
   // Lazily loaded dialogs
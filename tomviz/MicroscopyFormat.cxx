@@ -0,0 +1,133 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "MicroscopyFormat.h"
+
+#include "pybind11/native/MicroscopyFiles.h"
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+using tomviz::native::MicroscopyFile;
+using tomviz::native::ScalarType;
+
+namespace tomviz {
+
+namespace {
+
+int vtkScalarType(ScalarType type)
+{
+  switch (type) {
+    case ScalarType::Int8:
+      return VTK_SIGNED_CHAR;
+    case ScalarType::UInt8:
+      return VTK_UNSIGNED_CHAR;
+    case ScalarType::Int16:
+      return VTK_SHORT;
+    case ScalarType::UInt16:
+      return VTK_UNSIGNED_SHORT;
+    case ScalarType::Int32:
+      return VTK_INT;
+    case ScalarType::UInt32:
+      return VTK_UNSIGNED_INT;
+    case ScalarType::Int64:
+      return VTK_LONG_LONG;
+    case ScalarType::UInt64:
+      return VTK_UNSIGNED_LONG_LONG;
+    case ScalarType::Float32:
+      return VTK_FLOAT;
+    case ScalarType::Float64:
+      return VTK_DOUBLE;
+    default:
+      return -1;
+  }
+}
+
+// The first dataset of file, the axes past z folded into it, its frames
+// copied straight from the mapping into the scalars in parallel
+bool readDataset(const MicroscopyFile& file, vtkImageData* image)
+{
+  if (file.datasets().empty()) {
+    std::cerr << "The file has no images" << std::endl;
+    return false;
+  }
+  const auto& dataset = file.datasets()[0];
+  int type = vtkScalarType(dataset.type);
+  if (type < 0) {
+    std::cerr << "Complex images are not supported" << std::endl;
+    return false;
+  }
+
+  int dims[3] = { 1, 1, 1 };
+  double spacing[3] = { 1.0, 1.0, 1.0 };
+  double origin[3] = { 0.0, 0.0, 0.0 };
+  for (std::size_t i = 0; i < dataset.dims.size(); ++i) {
+    auto axis = std::min<std::size_t>(i, 2);
+    const int64_t size = dataset.dims[i];
+    if (size < 1 || dims[axis] > std::numeric_limits<int>::max() / size) {
+      std::cerr << "Invalid image dimensions" << std::endl;
+      return false;
+    }
+    dims[axis] *= static_cast<int>(size);
+    if (i == axis) {
+      if (dataset.scale[i] > 0.0) {
+        spacing[axis] = dataset.scale[i];
+      }
+      origin[axis] = dataset.origin[i];
+    }
+  }
+
+  auto scalars = vtkSmartPointer<vtkDataArray>::Take(
+    vtkDataArray::CreateDataArray(type));
+  scalars->SetName("ImageScalars");
+  scalars->SetNumberOfTuples(static_cast<vtkIdType>(dims[0]) * dims[1] *
+                             dims[2]);
+  auto* out = static_cast<unsigned char*>(scalars->GetVoidPointer(0));
+  const vtkIdType frameBytes = dataset.frameSize() * scalars->GetDataTypeSize();
+  vtkSMPTools::For(0, dataset.frameCount(),
+                   [&](vtkIdType first, vtkIdType last) {
+                     file.readFrames(0, first, last, out + first * frameBytes);
+                   });
+
+  image->SetDimensions(dims);
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->GetPointData()->SetScalars(scalars);
+  return true;
+}
+
+} // namespace
+
+bool DmFormat::read(const std::string& fileName, vtkImageData* image)
+{
+  try {
+    native::DmFile file(fileName);
+    return readDataset(file, image);
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to read " << fileName << ": " << e.what()
+              << std::endl;
+    return false;
+  }
+}
+
+bool SerFormat::read(const std::string& fileName, vtkImageData* image)
+{
+  try {
+    native::SerFile file(fileName);
+    return readDataset(file, image);
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to read " << fileName << ": " << e.what()
+              << std::endl;
+    return false;
+  }
+}
+
+} // namespace tomviz
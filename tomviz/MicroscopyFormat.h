@@ -0,0 +1,37 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizMicroscopyFormat_h
+#define tomvizMicroscopyFormat_h
+
+#include <string>
+
+class vtkImageData;
+
+namespace tomviz {
+
+/**
+ * Reads the first image of a Gatan DM3 or DM4 file, skipping the thumbnail,
+ * as dm.py reads it. The file is memory mapped and its frames are copied
+ * into the image in parallel.
+ */
+class DmFormat
+{
+public:
+  static bool read(const std::string& fileName, vtkImageData* data);
+};
+
+/**
+ * Reads a FEI TIA SER series, its images or spectra stacked along z, as
+ * ser.py reads it. The file is memory mapped and its frames are copied into
+ * the image in parallel.
+ */
+class SerFormat
+{
+public:
+  static bool read(const std::string& fileName, vtkImageData* data);
+};
+
+} // namespace tomviz
+
+#endif // tomvizMicroscopyFormat_h
@@ -0,0 +1,487 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "MoleculeSpatialIndex.h"
+
+#include <vtkMolecule.h>
+#include <vtkNew.h>
+#include <vtkPeriodicTable.h>
+#include <vtkPoints.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+#include <vtkUnsignedShortArray.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tomviz {
+
+namespace {
+
+// The bits of each coordinate in the Morton codes
+const int mortonBits = 21;
+
+// Spreads the 21 low bits of v so that there are two zero bits between each
+uint64_t spreadBits(uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | v << 32) & 0x1f00000000ffff;
+  v = (v | v << 16) & 0x1f0000ff0000ff;
+  v = (v | v << 8) & 0x100f00f00f00f00f;
+  v = (v | v << 4) & 0x10c30c30c30c30c3;
+  v = (v | v << 2) & 0x1249249249249249;
+  return v;
+}
+
+// The squared distance from p to the nearest point of the box
+double distance2(const double bounds[6], const double p[3])
+{
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    double d =
+      std::max({ bounds[2 * i] - p[i], 0.0, p[i] - bounds[2 * i + 1] });
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// The squared distance from p to the furthest corner of the box
+double furthest2(const double bounds[6], const double p[3])
+{
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    double d = std::max(std::abs(p[i] - bounds[2 * i]),
+                        std::abs(p[i] - bounds[2 * i + 1]));
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// Whether the box is entirely behind one of the planes of the frustum
+bool outside(const double bounds[6], const double planes[24])
+{
+  for (int i = 0; i < 6; ++i) {
+    const double* plane = planes + 4 * i;
+    // The corner furthest along the normal of the plane
+    double value = plane[3];
+    for (int j = 0; j < 3; ++j) {
+      value += plane[j] * (plane[j] > 0 ? bounds[2 * j + 1] : bounds[2 * j]);
+    }
+    if (value < 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<double> positions(vtkPoints* points)
+{
+  const vtkIdType count = points->GetNumberOfPoints();
+  std::vector<double> xyz(3 * count);
+  vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i) {
+      points->GetPoint(i, &xyz[3 * i]);
+    }
+  });
+  return xyz;
+}
+
+} // namespace
+
+void MoleculeOctree::clear()
+{
+  m_nodes.clear();
+  m_order.clear();
+}
+
+void MoleculeOctree::build(vtkPoints* points, vtkIdType leafSize)
+{
+  clear();
+  if (!points || points->GetNumberOfPoints() == 0) {
+    return;
+  }
+
+  const vtkIdType count = points->GetNumberOfPoints();
+  const auto xyz = positions(points);
+  double bounds[6];
+  points->GetBounds(bounds);
+  double scale[3];
+  for (int i = 0; i < 3; ++i) {
+    double extent = bounds[2 * i + 1] - bounds[2 * i];
+    scale[i] = extent > 0 ? ((1 << mortonBits) - 1) / extent : 0.0;
+  }
+
+  // Sort the points along the Morton curve
+  std::vector<std::pair<uint64_t, vtkIdType>> sorted(count);
+  vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i) {
+      uint64_t code = 0;
+      for (int j = 0; j < 3; ++j) {
+        auto q = static_cast<uint64_t>((xyz[3 * i + j] - bounds[2 * j]) *
+                                       scale[j]);
+        code |= spreadBits(q) << j;
+      }
+      sorted[i] = { code, i };
+    }
+  });
+  vtkSMPTools::Sort(sorted.begin(), sorted.end());
+
+  std::vector<uint64_t> codes(count);
+  m_order.resize(count);
+  for (vtkIdType i = 0; i < count; ++i) {
+    codes[i] = sorted[i].first;
+    m_order[i] = sorted[i].second;
+  }
+  sorted = std::vector<std::pair<uint64_t, vtkIdType>>();
+
+  Node root;
+  root.begin = 0;
+  root.end = count;
+  m_nodes.push_back(root);
+  split(0, 0, codes, std::max(leafSize, vtkIdType(1)));
+
+  // The tight bounds of the leaves, then of their parents, which always come
+  // before their children
+  vtkSMPTools::For(0, static_cast<vtkIdType>(m_nodes.size()),
+                   [&](vtkIdType begin, vtkIdType end) {
+                     for (vtkIdType n = begin; n < end; ++n) {
+                       if (m_nodes[n].childCount == 0) {
+                         leafBounds(m_nodes[n], xyz);
+                       }
+                     }
+                   });
+  for (auto n = m_nodes.size(); n-- > 0;) {
+    Node& node = m_nodes[n];
+    if (node.childCount == 0) {
+      continue;
+    }
+    std::copy(m_nodes[node.firstChild].bounds,
+              m_nodes[node.firstChild].bounds + 6, node.bounds);
+    for (int c = 1; c < node.childCount; ++c) {
+      const Node& child = m_nodes[node.firstChild + c];
+      for (int j = 0; j < 3; ++j) {
+        node.bounds[2 * j] = std::min(node.bounds[2 * j], child.bounds[2 * j]);
+        node.bounds[2 * j + 1] =
+          std::max(node.bounds[2 * j + 1], child.bounds[2 * j + 1]);
+      }
+    }
+  }
+}
+
+void MoleculeOctree::leafBounds(Node& node,
+                                const std::vector<double>& xyz) const
+{
+  for (int j = 0; j < 3; ++j) {
+    node.bounds[2 * j] = VTK_DOUBLE_MAX;
+    node.bounds[2 * j + 1] = VTK_DOUBLE_MIN;
+  }
+  for (vtkIdType i = node.begin; i < node.end; ++i) {
+    const double* p = &xyz[3 * m_order[i]];
+    for (int j = 0; j < 3; ++j) {
+      node.bounds[2 * j] = std::min(node.bounds[2 * j], p[j]);
+      node.bounds[2 * j + 1] = std::max(node.bounds[2 * j + 1], p[j]);
+    }
+  }
+}
+
+void MoleculeOctree::split(int node, int level,
+                           const std::vector<uint64_t>& codes,
+                           vtkIdType leafSize)
+{
+  const vtkIdType begin = m_nodes[node].begin;
+  const vtkIdType end = m_nodes[node].end;
+  if (end - begin <= leafSize || level == mortonBits) {
+    return;
+  }
+
+  // The points of a node share the bits of the codes above this octant
+  const int shift = 3 * (mortonBits - 1 - level);
+  const int first = static_cast<int>(m_nodes.size());
+  vtkIdType childBegin = begin;
+  for (uint64_t octant = 0; octant < 8 && childBegin < end; ++octant) {
+    auto childEnd = std::partition_point(
+      codes.begin() + childBegin, codes.begin() + end,
+      [&](uint64_t code) { return ((code >> shift) & 7) <= octant; });
+    vtkIdType last = childEnd - codes.begin();
+    if (last > childBegin) {
+      Node child;
+      child.begin = childBegin;
+      child.end = last;
+      m_nodes.push_back(child);
+      childBegin = last;
+    }
+  }
+  const int childCount = static_cast<int>(m_nodes.size()) - first;
+  m_nodes[node].firstChild = first;
+  m_nodes[node].childCount = childCount;
+  for (int c = first; c < first + childCount; ++c) {
+    split(c, level + 1, codes, leafSize);
+  }
+}
+
+vtkIdType MoleculeOctree::visit(const double planes[24], const double eye[3],
+                                double detailDistance,
+                                std::vector<vtkIdType>* ids) const
+{
+  vtkIdType count = 0;
+  std::vector<int> stack = { 0 };
+  while (!stack.empty()) {
+    const Node& node = m_nodes[stack.back()];
+    stack.pop_back();
+    if (outside(node.bounds, planes)) {
+      continue;
+    }
+    if (node.childCount > 0) {
+      for (int c = 0; c < node.childCount; ++c) {
+        stack.push_back(node.firstChild + c);
+      }
+      continue;
+    }
+
+    // Keep every stride-th point, the points of a leaf are spread along the
+    // Morton curve
+    const vtkIdType size = node.end - node.begin;
+    const double d2 = distance2(node.bounds, eye);
+    const double detail2 = detailDistance * detailDistance;
+    vtkIdType stride = 1;
+    if (d2 > detail2) {
+      stride = detail2 > 0 ? static_cast<vtkIdType>(std::ceil(
+                               std::min(d2 / detail2, double(size))))
+                           : size;
+    }
+    count += (size + stride - 1) / stride;
+    if (ids) {
+      for (vtkIdType i = node.begin; i < node.end; i += stride) {
+        ids->push_back(m_order[i]);
+      }
+    }
+  }
+  return count;
+}
+
+void MoleculeOctree::select(const double planes[24], const double eye[3],
+                            double detailDistance, vtkIdType budget,
+                            std::vector<vtkIdType>& ids) const
+{
+  ids.clear();
+  if (m_nodes.empty()) {
+    return;
+  }
+
+  // Beyond the detail distance the number of points falls with the square
+  // of the distance, shrink it accordingly until they fit in the budget.
+  detailDistance =
+    std::min(detailDistance, std::sqrt(furthest2(m_nodes[0].bounds, eye)));
+  vtkIdType count = visit(planes, eye, detailDistance, nullptr);
+  for (int i = 0; i < 16 && count > budget && detailDistance > 0; ++i) {
+    detailDistance *= 0.95 * std::sqrt(double(budget) / count);
+    count = visit(planes, eye, detailDistance, nullptr);
+  }
+  ids.reserve(count);
+  visit(planes, eye, detailDistance, &ids);
+}
+
+vtkIdType MoleculeOctree::nearest(vtkPoints* points,
+                                  const double point[3]) const
+{
+  vtkIdType best = -1;
+  double best2 = VTK_DOUBLE_MAX;
+  std::vector<int> stack;
+  if (!m_nodes.empty() && points) {
+    stack.push_back(0);
+  }
+  while (!stack.empty()) {
+    const Node& node = m_nodes[stack.back()];
+    stack.pop_back();
+    if (distance2(node.bounds, point) >= best2) {
+      continue;
+    }
+    if (node.childCount > 0) {
+      // Visit the nearest child first, it is pushed last
+      std::pair<double, int> children[8];
+      for (int c = 0; c < node.childCount; ++c) {
+        const int child = node.firstChild + c;
+        children[c] = { distance2(m_nodes[child].bounds, point), child };
+      }
+      std::sort(children, children + node.childCount);
+      for (int c = node.childCount; c-- > 0;) {
+        stack.push_back(children[c].second);
+      }
+      continue;
+    }
+    for (vtkIdType i = node.begin; i < node.end; ++i) {
+      double p[3];
+      points->GetPoint(m_order[i], p);
+      double d2 = 0.0;
+      for (int j = 0; j < 3; ++j) {
+        d2 += (p[j] - point[j]) * (p[j] - point[j]);
+      }
+      if (d2 < best2) {
+        best2 = d2;
+        best = m_order[i];
+      }
+    }
+  }
+  return best;
+}
+
+void MoleculeOctree::withinRadius(vtkPoints* points, const double point[3],
+                                  double radius,
+                                  std::vector<vtkIdType>& ids) const
+{
+  ids.clear();
+  if (m_nodes.empty() || !points || radius < 0) {
+    return;
+  }
+
+  const double radius2 = radius * radius;
+  std::vector<int> stack = { 0 };
+  while (!stack.empty()) {
+    const Node& node = m_nodes[stack.back()];
+    stack.pop_back();
+    if (distance2(node.bounds, point) > radius2) {
+      continue;
+    }
+    if (node.childCount > 0) {
+      for (int c = 0; c < node.childCount; ++c) {
+        stack.push_back(node.firstChild + c);
+      }
+      continue;
+    }
+    for (vtkIdType i = node.begin; i < node.end; ++i) {
+      double p[3];
+      points->GetPoint(m_order[i], p);
+      double d2 = 0.0;
+      for (int j = 0; j < 3; ++j) {
+        d2 += (p[j] - point[j]) * (p[j] - point[j]);
+      }
+      if (d2 <= radius2) {
+        ids.push_back(m_order[i]);
+      }
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+}
+
+std::vector<std::pair<vtkIdType, vtkIdType>> perceiveBonds(
+  vtkMolecule* molecule, double tolerance)
+{
+  std::vector<std::pair<vtkIdType, vtkIdType>> bonds;
+  const vtkIdType count = molecule ? molecule->GetNumberOfAtoms() : 0;
+  if (count < 2) {
+    return bonds;
+  }
+
+  const auto xyz = positions(molecule->GetAtomicPositionArray());
+  auto numbers = molecule->GetAtomicNumberArray();
+
+  // The covalent radii of the elements present
+  vtkNew<vtkPeriodicTable> table;
+  std::vector<double> radii(table->GetNumberOfElements() + 1, -1.0);
+  std::vector<double> radius(count);
+  double maxRadius = 0.0;
+  for (vtkIdType i = 0; i < count; ++i) {
+    auto number = std::min(numbers->GetValue(i),
+                           static_cast<unsigned short>(radii.size() - 1));
+    if (radii[number] < 0) {
+      radii[number] = table->GetCovalentRadius(number);
+      maxRadius = std::max(maxRadius, radii[number]);
+    }
+    radius[i] = radii[number];
+  }
+
+  // Cells at least as large as the longest bond, so that the atoms bonded to
+  // an atom are all in the 27 cells around its own. They are made larger for
+  // sparse molecules, so that there are not more cells than atoms.
+  double bounds[6];
+  molecule->GetAtomicPositionArray()->GetBounds(bounds);
+  double size = std::max(2 * maxRadius + tolerance, 1e-6);
+  vtkIdType dims[3];
+  while (true) {
+    for (int i = 0; i < 3; ++i) {
+      dims[i] = static_cast<vtkIdType>(
+                  std::floor((bounds[2 * i + 1] - bounds[2 * i]) / size)) +
+                1;
+    }
+    if (dims[0] * dims[1] * dims[2] <= 2 * count) {
+      break;
+    }
+    size *= 1.25;
+  }
+
+  // Sort the atoms by cell
+  const vtkIdType cellCount = dims[0] * dims[1] * dims[2];
+  std::vector<vtkIdType> cellOf(count);
+  vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i) {
+      vtkIdType c[3];
+      for (int j = 0; j < 3; ++j) {
+        c[j] = std::min(static_cast<vtkIdType>(
+                          (xyz[3 * i + j] - bounds[2 * j]) / size),
+                        dims[j] - 1);
+      }
+      cellOf[i] = c[0] + dims[0] * (c[1] + dims[1] * c[2]);
+    }
+  });
+  std::vector<vtkIdType> offsets(cellCount + 1, 0);
+  for (vtkIdType i = 0; i < count; ++i) {
+    ++offsets[cellOf[i] + 1];
+  }
+  for (vtkIdType c = 0; c < cellCount; ++c) {
+    offsets[c + 1] += offsets[c];
+  }
+  std::vector<vtkIdType> atoms(count);
+  {
+    std::vector<vtkIdType> next(offsets.begin(), offsets.end() - 1);
+    for (vtkIdType i = 0; i < count; ++i) {
+      atoms[next[cellOf[i]]++] = i;
+    }
+  }
+
+  vtkSMPThreadLocal<std::vector<std::pair<vtkIdType, vtkIdType>>> found;
+  vtkSMPTools::For(0, cellCount, [&](vtkIdType begin, vtkIdType end) {
+    auto& local = found.Local();
+    for (vtkIdType c = begin; c < end; ++c) {
+      const vtkIdType cx = c % dims[0];
+      const vtkIdType cy = (c / dims[0]) % dims[1];
+      const vtkIdType cz = c / (dims[0] * dims[1]);
+      for (vtkIdType a = offsets[c]; a < offsets[c + 1]; ++a) {
+        const vtkIdType i = atoms[a];
+        const double* p = &xyz[3 * i];
+        for (vtkIdType z = std::max(cz - 1, vtkIdType(0));
+             z <= std::min(cz + 1, dims[2] - 1); ++z) {
+          for (vtkIdType y = std::max(cy - 1, vtkIdType(0));
+               y <= std::min(cy + 1, dims[1] - 1); ++y) {
+            for (vtkIdType x = std::max(cx - 1, vtkIdType(0));
+                 x <= std::min(cx + 1, dims[0] - 1); ++x) {
+              const vtkIdType n = x + dims[0] * (y + dims[1] * z);
+              for (vtkIdType b = offsets[n]; b < offsets[n + 1]; ++b) {
+                const vtkIdType j = atoms[b];
+                if (j <= i) {
+                  continue;
+                }
+                const double* q = &xyz[3 * j];
+                double d2 = 0.0;
+                for (int k = 0; k < 3; ++k) {
+                  d2 += (p[k] - q[k]) * (p[k] - q[k]);
+                }
+                const double cutoff = radius[i] + radius[j] + tolerance;
+                if (d2 <= cutoff * cutoff) {
+                  local.emplace_back(i, j);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+
+  for (auto& local : found) {
+    bonds.insert(bonds.end(), local.begin(), local.end());
+  }
+  std::sort(bonds.begin(), bonds.end());
+  return bonds;
+}
+
+} // namespace tomviz
@@ -0,0 +1,98 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizMoleculeSpatialIndex_h
+#define tomvizMoleculeSpatialIndex_h
+
+#include <vtkType.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class vtkMolecule;
+class vtkPoints;
+
+namespace tomviz {
+
+/**
+ * An octree over the positions of the atoms of a molecule, to draw only the
+ * atoms in view, and fewer of them the further they are from the camera. The
+ * atoms are sorted along a Morton curve, so that every node holds a
+ * contiguous range of them.
+ */
+class MoleculeOctree
+{
+public:
+  /**
+   * Builds the octree over points, in parallel. Leaves hold at most leafSize
+   * points.
+   */
+  void build(vtkPoints* points, vtkIdType leafSize = 4096);
+
+  /** Releases the octree. */
+  void clear();
+
+  vtkIdType numberOfPoints() const
+  {
+    return static_cast<vtkIdType>(m_order.size());
+  }
+
+  /**
+   * Sets ids to the points of the leaves inside the frustum, given by the 24
+   * plane coefficients vtkCamera::GetFrustumPlanes() returns. Every point of
+   * the leaves within detailDistance of the eye is kept, and a fraction
+   * (detailDistance / distance)^2 of them beyond. At most budget points are
+   * kept: detailDistance is reduced until they fit.
+   */
+  void select(const double planes[24], const double eye[3],
+              double detailDistance, vtkIdType budget,
+              std::vector<vtkIdType>& ids) const;
+
+  /**
+   * The id of the point of points nearest to point, or -1 without points.
+   * points are the points the octree was built over.
+   */
+  vtkIdType nearest(vtkPoints* points, const double point[3]) const;
+
+  /**
+   * Sets ids to the sorted ids of the points of points within radius of
+   * point. points are the points the octree was built over.
+   */
+  void withinRadius(vtkPoints* points, const double point[3], double radius,
+                    std::vector<vtkIdType>& ids) const;
+
+private:
+  struct Node
+  {
+    double bounds[6];
+    vtkIdType begin = 0;
+    vtkIdType end = 0;
+    // The children are contiguous, none for a leaf
+    int firstChild = -1;
+    int childCount = 0;
+  };
+
+  void split(int node, int level, const std::vector<uint64_t>& codes,
+             vtkIdType leafSize);
+  void leafBounds(Node& node, const std::vector<double>& xyz) const;
+  vtkIdType visit(const double planes[24], const double eye[3],
+                  double detailDistance, std::vector<vtkIdType>* ids) const;
+
+  std::vector<Node> m_nodes;
+  std::vector<vtkIdType> m_order;
+};
+
+/**
+ * The bonds between the atoms of molecule closer than the sum of their
+ * covalent radii plus tolerance, as vtkSimpleBondPerceiver defines them. The
+ * neighbours are searched in a grid of cells as large as the longest bond,
+ * in parallel over the cells. The bonds are sorted, and the first atom of a
+ * bond is the lowest.
+ */
+std::vector<std::pair<vtkIdType, vtkIdType>> perceiveBonds(
+  vtkMolecule* molecule, double tolerance = 0.45);
+
+} // namespace tomviz
+
+#endif
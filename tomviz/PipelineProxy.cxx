@@ -13,6 +13,7 @@
 #include "OperatorFactory.h"
 #include "OperatorPython.h"
 #include "PipelineManager.h"
+#include "RenderStatistics.h"
 
 #include <vtkSMSaveScreenshotProxy.h>
 #include <vtkSMViewProxy.h>
@@ -771,6 +772,31 @@ bool PipelineProxy::pipelinePaused(const std::string& dataSourcePath)
   return ds->pipeline()->paused();
 }
 
+std::string PipelineProxy::renderStatistics(int viewId)
+{
+  // A negative id selects the active view
+  vtkSMViewProxy* view = nullptr;
+  if (viewId < 0) {
+    view = ActiveObjects::instance().activeView();
+  } else {
+    auto model = pqApplicationCore::instance()->getServerManagerModel();
+    foreach (pqView* v, model->findItems<pqView*>()) {
+      if (v->getProxy()->GetGlobalID() == static_cast<vtkTypeUInt32>(viewId)) {
+        view = v->getViewProxy();
+        break;
+      }
+    }
+  }
+
+  if (view == nullptr) {
+    qCritical() << "Failed to find view.";
+    return "{}";
+  }
+
+  auto stats = RenderStatistics::instance().statistics(view);
+  return QJsonDocument(stats).toJson().toStdString();
+}
+
 PipelineProxyBase* PipelineProxyFactory::create()
 {
   return new PipelineProxy();
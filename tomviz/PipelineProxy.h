@@ -52,6 +52,7 @@ public:
   void resumePipeline(const std::string& dataSourcePath) override;
   void executePipeline(const std::string& dataSourcePath) override;
   bool pipelinePaused(const std::string& dataSourcePath) override;
+  std::string renderStatistics(int viewId) override;
 
   void syncViewsToPython() override;
 
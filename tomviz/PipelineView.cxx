@@ -297,6 +297,7 @@ void PipelineView::contextMenuEvent(QContextMenuEvent* e)
   QAction* showInterfaceAction = nullptr;
   QAction* exportTableResultAction = nullptr;
   QAction* exportTableCsvAction = nullptr;
+  QAction* exportTableHdf5Action = nullptr;
   QAction* reloadAndResampleAction = nullptr;
   bool allowReExecute = false;
   CloneDataReaction* cloneReaction;
@@ -305,6 +306,7 @@ void PipelineView::contextMenuEvent(QContextMenuEvent* e)
     if (vtkTable::SafeDownCast(result->dataObject())) {
       exportTableResultAction = contextMenu.addAction("Save as JSON");
       exportTableCsvAction = contextMenu.addAction("Save as CSV");
+      exportTableHdf5Action = contextMenu.addAction("Save as HDF5");
     } else {
       return;
     }
@@ -483,6 +485,8 @@ void PipelineView::contextMenuEvent(QContextMenuEvent* e)
     exportTableAsJson(vtkTable::SafeDownCast(result->dataObject()));
   } else if (selectedItem == exportTableCsvAction) {
     exportTableAsCsv(vtkTable::SafeDownCast(result->dataObject()));
+  } else if (selectedItem == exportTableHdf5Action) {
+    exportTableAsHdf5(vtkTable::SafeDownCast(result->dataObject()));
   } else if (selectedItem == reloadAndResampleAction) {
     dataSource->reloadAndResample();
   }
@@ -490,14 +494,17 @@ void PipelineView::contextMenuEvent(QContextMenuEvent* e)
 
 void PipelineView::exportTableAsJson(vtkTable* table)
 {
-  auto json = tableToJson(table);
-  jsonToFile(json);
+  tableToFile(table, "json");
 }
 
 void PipelineView::exportTableAsCsv(vtkTable* table)
 {
-  auto csv = tableToCsv(table);
-  csvToFile(csv);
+  tableToFile(table, "csv");
+}
+
+void PipelineView::exportTableAsHdf5(vtkTable* table)
+{
+  tableToFile(table, "h5");
 }
 
 void PipelineView::deleteItems(const QModelIndexList& idxs)
@@ -62,6 +62,7 @@ private slots:
   void setModuleVisibility(const QModelIndexList& idxs, bool visible);
   void exportTableAsJson(vtkTable*);
   void exportTableAsCsv(vtkTable*);
+  void exportTableAsHdf5(vtkTable*);
 };
 } // namespace tomviz
 
@@ -0,0 +1,142 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "PlotDecimation.h"
+
+#include <vtkDataArray.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace tomviz {
+
+namespace {
+
+template <typename T>
+bool ascending(const T* values, vtkIdType count, int components)
+{
+  for (vtkIdType i = 1; i < count; ++i) {
+    if (values[i * components] < values[(i - 1) * components]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The first, lowest, highest and last rows of each bucket, -1 where a bucket
+// is empty
+template <typename T>
+void extremes(const T* values, int components, vtkIdType begin, vtkIdType end,
+              vtkIdType buckets, std::vector<vtkIdType>& rows)
+{
+  const vtkIdType count = end - begin;
+  vtkSMPTools::For(0, buckets, [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType b = first; b < last; ++b) {
+      const vtkIdType from = begin + b * count / buckets;
+      const vtkIdType to = begin + (b + 1) * count / buckets;
+      vtkIdType* kept = &rows[4 * b];
+      if (from >= to) {
+        std::fill(kept, kept + 4, -1);
+        continue;
+      }
+      vtkIdType low = from;
+      vtkIdType high = from;
+      for (vtkIdType i = from + 1; i < to; ++i) {
+        const T value = values[i * components];
+        if (value < values[low * components]) {
+          low = i;
+        } else if (value > values[high * components]) {
+          high = i;
+        }
+      }
+      kept[0] = from;
+      kept[1] = std::min(low, high);
+      kept[2] = std::max(low, high);
+      kept[3] = to - 1;
+    }
+  });
+}
+
+} // namespace
+
+bool isAscending(vtkDataArray* x)
+{
+  if (!x) {
+    return false;
+  }
+  switch (x->GetDataType()) {
+    vtkTemplateMacro(
+      return ascending(reinterpret_cast<VTK_TT*>(x->GetVoidPointer(0)),
+                       x->GetNumberOfTuples(), x->GetNumberOfComponents()));
+    default:
+      return false;
+  }
+}
+
+std::vector<vtkIdType> decimatePlot(vtkDataArray* x, vtkDataArray* y,
+                                    const double range[2], bool ascending,
+                                    int buckets)
+{
+  std::vector<vtkIdType> rows;
+  if (!x || !y || buckets < 1) {
+    return rows;
+  }
+
+  vtkIdType begin = 0;
+  vtkIdType end = std::min(x->GetNumberOfTuples(), y->GetNumberOfTuples());
+  if (ascending) {
+    // The rows in range, and the one on either side so that the line reaches
+    // the edges of the view
+    auto value = [x](vtkIdType i) { return x->GetComponent(i, 0); };
+    vtkIdType low = 0;
+    vtkIdType high = end;
+    while (low < high) {
+      vtkIdType mid = low + (high - low) / 2;
+      if (value(mid) < range[0]) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    begin = std::max(low - 1, vtkIdType(0));
+    high = end;
+    while (low < high) {
+      vtkIdType mid = low + (high - low) / 2;
+      if (value(mid) <= range[1]) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    end = std::min(low + 1, end);
+  }
+
+  if (end - begin <= 4 * static_cast<vtkIdType>(buckets)) {
+    for (vtkIdType i = begin; i < end; ++i) {
+      rows.push_back(i);
+    }
+    return rows;
+  }
+
+  std::vector<vtkIdType> kept(4 * static_cast<size_t>(buckets));
+  switch (y->GetDataType()) {
+    vtkTemplateMacro(extremes(reinterpret_cast<VTK_TT*>(y->GetVoidPointer(0)),
+                              y->GetNumberOfComponents(), begin, end, buckets,
+                              kept));
+    default:
+      std::cerr << "decimatePlot: Unknown data type" << std::endl;
+      return rows;
+  }
+
+  // The rows in order, once each
+  rows.reserve(kept.size());
+  for (auto row : kept) {
+    if (row >= 0 && (rows.empty() || row != rows.back())) {
+      rows.push_back(row);
+    }
+  }
+  return rows;
+}
+
+} // namespace tomviz
@@ -0,0 +1,32 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizPlotDecimation_h
+#define tomvizPlotDecimation_h
+
+#include <vtkType.h>
+
+#include <vector>
+
+class vtkDataArray;
+
+namespace tomviz {
+
+/** Whether the values of x never decrease. */
+bool isAscending(vtkDataArray* x);
+
+/**
+ * The rows of a line plot of y against x to draw in place of all of them.
+ * The rows in the range of x are split in buckets runs of consecutive rows,
+ * and the first, lowest, highest and last rows of each are kept, in order, so
+ * that the line still reaches every peak and trough. When x is ascending only
+ * the rows within range, and the one on either side, are kept; otherwise the
+ * range is ignored. The buckets are searched in parallel.
+ */
+std::vector<vtkIdType> decimatePlot(vtkDataArray* x, vtkDataArray* y,
+                                    const double range[2], bool ascending,
+                                    int buckets);
+
+} // namespace tomviz
+
+#endif
@@ -25,8 +25,95 @@
 #include <pybind11/pybind11.h>
 #pragma pop_macro("slots")
 
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 namespace py = pybind11;
 
+namespace {
+
+// Py_Finalize() hangs at exit unless it runs on the thread that initialized
+// the interpreter. The interpreter is initialized, and finalized, on a thread
+// of its own so that no caller has to block the GUI thread to be that thread.
+class InterpreterThread
+{
+public:
+  static InterpreterThread& instance()
+  {
+    // Never destroyed, shutdown() joins the thread instead
+    static auto* thread = new InterpreterThread;
+    return *thread;
+  }
+
+  // Run task on the interpreter thread and wait for it. Tasks run from the
+  // interpreter thread itself, or once it is shut down, run inline.
+  void run(std::function<void()> task)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stopped || std::this_thread::get_id() == m_thread.get_id()) {
+      lock.unlock();
+      task();
+      return;
+    }
+    bool done = false;
+    m_tasks.push_back([&task, &done, this]() {
+      task();
+      std::lock_guard<std::mutex> taskLock(m_mutex);
+      done = true;
+      m_condition.notify_all();
+    });
+    m_condition.notify_all();
+    m_condition.wait(lock, [&done]() { return done; });
+  }
+
+  // Run the queued tasks, then stop the thread and join it
+  void shutdown()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_stopped) {
+        return;
+      }
+      m_stopped = true;
+      m_condition.notify_all();
+    }
+    m_thread.join();
+  }
+
+private:
+  InterpreterThread() : m_thread([this]() { loop(); }) {}
+
+  void loop()
+  {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock,
+                         [this]() { return m_stopped || !m_tasks.empty(); });
+        if (m_tasks.empty()) {
+          return;
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::function<void()>> m_tasks;
+  bool m_stopped = false;
+  std::thread m_thread;
+};
+
+} // namespace
+
 namespace tomviz {
 
 Python::Capsule::Capsule(const void* ptr)
@@ -508,10 +595,34 @@ vtkObjectBase* Python::VTK::convertToDataObject(Python::Object obj)
 
 void Python::initialize()
 {
-  vtkPythonInterpreter::Initialize();
+  static std::once_flag initialized;
+  std::call_once(initialized, []() {
+    InterpreterThread::instance().run(
+      []() { vtkPythonInterpreter::Initialize(); });
+    // In case the application does not finalize it
+    std::atexit(finalize);
+  });
 }
 
-Python::Python() : m_ensurer(new vtkPythonScopeGilEnsurer(true)) {}
+void Python::finalize()
+{
+  static std::once_flag finalized;
+  std::call_once(finalized, []() {
+    auto& thread = InterpreterThread::instance();
+    thread.run([]() {
+      if (vtkPythonInterpreter::IsInitialized()) {
+        vtkPythonInterpreter::Finalize();
+      }
+    });
+    thread.shutdown();
+  });
+}
+
+Python::Python()
+{
+  initialize();
+  m_ensurer = new vtkPythonScopeGilEnsurer(true);
+}
 
 Python::~Python()
 {
@@ -176,7 +176,15 @@ public:
     static vtkObjectBase* convertToDataObject(Object obj);
   };
 
+  /// Initialize the interpreter, this may be called from any thread. The
+  /// first call does the work on a dedicated thread, which also finalizes
+  /// the interpreter, and any concurrent calls wait for it.
   static void initialize();
+
+  /// Finalize the interpreter on the thread that initialized it, and join
+  /// that thread. Nothing may run Python code anymore: the application calls
+  /// it once its background tasks are done, and it runs at exit otherwise.
+  static void finalize();
   Python();
   ~Python();
   Module import(const QString& name);
@@ -0,0 +1,253 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "RawFormat.h"
+
+#include "DataSource.h"
+#include "Hdf5SubsampleWidget.h"
+#include "Utilities.h"
+#include "pybind11/native/RawVolume.h"
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <vtkSMPropertyHelper.h>
+#include <vtkSMProxy.h>
+#include <vtkSmartPointer.h>
+
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using tomviz::native::RawLayout;
+using tomviz::native::RawRegion;
+using tomviz::native::RawVolume;
+using tomviz::native::ScalarType;
+
+namespace tomviz {
+
+namespace {
+
+bool scalarType(int vtkType, ScalarType& type)
+{
+  switch (vtkType) {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+      type = ScalarType::Int8;
+      return true;
+    case VTK_UNSIGNED_CHAR:
+      type = ScalarType::UInt8;
+      return true;
+    case VTK_SHORT:
+      type = ScalarType::Int16;
+      return true;
+    case VTK_UNSIGNED_SHORT:
+      type = ScalarType::UInt16;
+      return true;
+    case VTK_INT:
+      type = ScalarType::Int32;
+      return true;
+    case VTK_UNSIGNED_INT:
+      type = ScalarType::UInt32;
+      return true;
+    case VTK_LONG:
+      type = sizeof(long) == 8 ? ScalarType::Int64 : ScalarType::Int32;
+      return true;
+    case VTK_UNSIGNED_LONG:
+      type = sizeof(long) == 8 ? ScalarType::UInt64 : ScalarType::UInt32;
+      return true;
+    case VTK_LONG_LONG:
+      type = ScalarType::Int64;
+      return true;
+    case VTK_UNSIGNED_LONG_LONG:
+      type = ScalarType::UInt64;
+      return true;
+    case VTK_FLOAT:
+      type = ScalarType::Float32;
+      return true;
+    case VTK_DOUBLE:
+      type = ScalarType::Float64;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The subsample from the options, or picked by the user for large volumes,
+// false if the user cancelled
+bool subsample(const RawLayout& layout, const QVariantMap& options,
+               vtkImageData* image, int bs[6], int strides[3])
+{
+  int dims[3];
+  for (int i = 0; i < 3; ++i) {
+    dims[i] = static_cast<int>(layout.dims[i]);
+    bs[i * 2] = 0;
+    bs[i * 2 + 1] = dims[i];
+    strides[i] = 1;
+  }
+
+  if (options.contains("subsampleVolumeBounds")) {
+    QVariantList list = options["subsampleVolumeBounds"].toList();
+    for (int i = 0; i < list.size() && i < 6; ++i) {
+      bs[i] = list[i].toInt();
+    }
+  }
+  if (options.contains("subsampleStrides")) {
+    QVariantList list = options["subsampleStrides"].toList();
+    for (int i = 0; i < list.size() && i < 3; ++i) {
+      strides[i] = std::max(list[i].toInt(), 1);
+    }
+  }
+
+  bool askForSubsample = false;
+  if (options.contains("askForSubsample")) {
+    askForSubsample = options["askForSubsample"].toBool();
+  } else {
+    int subsampleDimOverride = 1200;
+    if (options.contains("subsampleDimOverride")) {
+      subsampleDimOverride = options["subsampleDimOverride"].toInt();
+    }
+    askForSubsample =
+      std::any_of(dims, dims + 3, [subsampleDimOverride](int i) {
+        return i >= subsampleDimOverride;
+      });
+  }
+
+  if (askForSubsample) {
+    QDialog dialog;
+    dialog.setWindowTitle("Pick Subsample");
+    QVBoxLayout dialogLayout;
+    dialog.setLayout(&dialogLayout);
+
+    Hdf5SubsampleWidget widget(dims, static_cast<int>(layout.voxelSize()));
+    widget.setStrides(strides);
+    widget.setBounds(bs);
+    dialogLayout.addWidget(&widget);
+
+    QDialogButtonBox buttons(QDialogButtonBox::Ok | QDialogButtonBox::Cancel |
+                             QDialogButtonBox::Help);
+    dialogLayout.addWidget(&buttons);
+    QObject::connect(&buttons, &QDialogButtonBox::accepted, &dialog,
+                     &QDialog::accept);
+    QObject::connect(&buttons, &QDialogButtonBox::rejected, &dialog,
+                     &QDialog::reject);
+    QObject::connect(&buttons, &QDialogButtonBox::helpRequested,
+                     []() { openHelpUrl("data/#hdf5-subsampling"); });
+
+    if (!dialog.exec()) {
+      return false;
+    }
+
+    widget.bounds(bs);
+    widget.strides(strides);
+  }
+
+  bool subsampled = false;
+  for (int i = 0; i < 3; ++i) {
+    subsampled |=
+      strides[i] != 1 || bs[i * 2] != 0 || bs[i * 2 + 1] != dims[i];
+  }
+  if (subsampled) {
+    DataSource::setWasSubsampled(image, true);
+    DataSource::setSubsampleStrides(image, strides);
+    DataSource::setSubsampleVolumeBounds(image, bs);
+  }
+  return true;
+}
+
+} // namespace
+
+bool RawFormat::canRead(vtkSMProxy* reader)
+{
+  // Slices spread over several files are left to vtkImageReader
+  std::string pattern =
+    vtkSMPropertyHelper(reader, "FilePattern").GetAsString();
+  return vtkSMPropertyHelper(reader, "FileDimensionality").GetAsInt() == 3 &&
+         pattern == "%s";
+}
+
+bool RawFormat::read(vtkSMProxy* reader, vtkImageData* image,
+                     const QVariantMap& options)
+{
+  std::string fileName =
+    vtkSMPropertyHelper(reader, "FilePrefix").GetAsString();
+  int vtkType = vtkSMPropertyHelper(reader, "DataScalarType").GetAsInt();
+
+  RawLayout layout;
+  if (!scalarType(vtkType, layout.type)) {
+    std::cerr << "Unsupported raw data type " << vtkType << std::endl;
+    return false;
+  }
+  layout.components =
+    vtkSMPropertyHelper(reader, "NumberOfScalarComponents").GetAsInt();
+  // The DataByteOrder property is 0 for big endian
+  layout.bigEndian =
+    vtkSMPropertyHelper(reader, "DataByteOrder").GetAsInt() == 0;
+  layout.flipY = vtkSMPropertyHelper(reader, "FileLowerLeft").GetAsInt() == 0;
+  int extent[6];
+  vtkSMPropertyHelper(reader, "DataExtent").Get(extent, 6);
+  for (int i = 0; i < 3; ++i) {
+    layout.dims[i] = extent[i * 2 + 1] - extent[i * 2] + 1;
+  }
+
+  int bs[6];
+  int strides[3];
+  if (!subsample(layout, options, image, bs, strides)) {
+    return false;
+  }
+
+  try {
+    RawVolume volume(fileName, layout);
+    RawRegion region =
+      volume.region({ { bs[0], bs[2], bs[4] } }, { { bs[1], bs[3], bs[5] } },
+                    { { strides[0], strides[1], strides[2] } });
+    auto dims = region.dims();
+    if (region.rowCount() == 0) {
+      std::cerr << "The subsample of " << fileName << " is empty"
+                << std::endl;
+      return false;
+    }
+
+    auto scalars = vtkSmartPointer<vtkDataArray>::Take(
+      vtkDataArray::CreateDataArray(vtkType));
+    scalars->SetName(
+      vtkSMPropertyHelper(reader, "ScalarArrayName").GetAsString());
+    scalars->SetNumberOfComponents(layout.components);
+    scalars->SetNumberOfTuples(dims[0] * dims[1] * dims[2]);
+    auto* out = static_cast<unsigned char*>(scalars->GetVoidPointer(0));
+    const vtkIdType rowBytes = dims[0] * layout.voxelSize();
+    vtkSMPTools::For(0, region.rowCount(),
+                     [&](vtkIdType first, vtkIdType last) {
+                       volume.readRows(region, first, last,
+                                       out + first * rowBytes);
+                     });
+
+    double spacing[3];
+    double origin[3];
+    vtkSMPropertyHelper(reader, "DataSpacing").Get(spacing, 3);
+    vtkSMPropertyHelper(reader, "DataOrigin").Get(origin, 3);
+    for (int i = 0; i < 3; ++i) {
+      origin[i] += (extent[i * 2] + region.begin[i]) * spacing[i];
+      spacing[i] *= region.strides[i];
+    }
+
+    image->SetDimensions(static_cast<int>(dims[0]), static_cast<int>(dims[1]),
+                         static_cast<int>(dims[2]));
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->GetPointData()->SetScalars(scalars);
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to read " << fileName << ": " << e.what()
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace tomviz
@@ -0,0 +1,34 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizRawFormat_h
+#define tomvizRawFormat_h
+
+#include <QVariantMap>
+
+class vtkImageData;
+class vtkSMProxy;
+
+namespace tomviz {
+
+/**
+ * Reads the volume a TVRawImageReader proxy describes, as the
+ * vtkImageReader it configures would, but through a memory mapping. The
+ * rows are copied and byte swapped in parallel, and a subsample only
+ * touches the parts of the file it needs. The options are the subsample
+ * options of GenericHDF5Format, and large volumes ask for a subsample the
+ * same way.
+ */
+class RawFormat
+{
+public:
+  /** Whether the proxy describes a single file holding a 3D volume. */
+  static bool canRead(vtkSMProxy* reader);
+
+  static bool read(vtkSMProxy* reader, vtkImageData* data,
+                   const QVariantMap& options = QVariantMap());
+};
+
+} // namespace tomviz
+
+#endif // tomvizRawFormat_h
@@ -0,0 +1,334 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "RenderStatistics.h"
+
+#include "DataSource.h"
+#include "Module.h"
+#include "ModuleManager.h"
+
+#include <pqApplicationCore.h>
+#include <pqRenderView.h>
+#include <pqServerManagerModel.h>
+#include <pqSettings.h>
+#include <vtkCommand.h>
+#include <vtkNew.h>
+#include <vtkPVRenderView.h>
+#include <vtkRenderer.h>
+#include <vtkSMRenderViewProxy.h>
+#include <vtkTextActor.h>
+#include <vtkTextProperty.h>
+#include <vtkWeakPointer.h>
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace tomviz {
+
+namespace {
+const char* frameBudgetKey = "RenderSettings.FrameBudget";
+const char* targetFpsKey = "RenderSettings.TargetFPS";
+
+// Quality never drops below this, whatever the frame time
+const double minimumQuality = 0.1;
+
+QString humanCount(vtkIdType count)
+{
+  if (count >= 1000000) {
+    return QString("%1M").arg(count / 1.0e6, 0, 'f', 1);
+  } else if (count >= 1000) {
+    return QString("%1k").arg(count / 1.0e3, 0, 'f', 1);
+  }
+  return QString::number(count);
+}
+} // namespace
+
+struct RenderStatistics::ViewState
+{
+  vtkWeakPointer<vtkSMViewProxy> proxy;
+  unsigned long startObserver = 0;
+  unsigned long endObserver = 0;
+  QElapsedTimer timer;
+  bool interactive = false;
+  // Seconds
+  double frameTime = 0.0;
+  double averageFrameTime = 0.0;
+  // The quality the frame budget settled on, and the one set on the modules
+  double quality = 1.0;
+  double appliedQuality = 1.0;
+  vtkNew<vtkTextActor> overlay;
+  vtkWeakPointer<vtkRenderer> renderer;
+};
+
+RenderStatistics::RenderStatistics()
+{
+  auto core = pqApplicationCore::instance();
+  auto settings = core->settings();
+  m_frameBudget = settings->value(frameBudgetKey, false).toBool();
+  m_targetFps = settings->value(targetFpsKey, 15.0).toDouble();
+
+  auto smModel = core->getServerManagerModel();
+  connect(smModel, &pqServerManagerModel::viewAdded, this,
+          &RenderStatistics::viewAdded);
+  connect(smModel, &pqServerManagerModel::preViewRemoved, this,
+          &RenderStatistics::viewRemoved);
+  foreach (pqRenderView* view, smModel->findItems<pqRenderView*>()) {
+    viewAdded(view);
+  }
+}
+
+RenderStatistics::~RenderStatistics()
+{
+  for (auto& view : m_views) {
+    auto& state = view.second;
+    if (state->proxy) {
+      state->proxy->RemoveObserver(state->startObserver);
+      state->proxy->RemoveObserver(state->endObserver);
+    }
+    if (state->renderer) {
+      state->renderer->RemoveActor(state->overlay);
+    }
+  }
+}
+
+RenderStatistics& RenderStatistics::instance()
+{
+  static RenderStatistics theInstance;
+  return theInstance;
+}
+
+void RenderStatistics::viewAdded(pqView* view)
+{
+  auto proxy = vtkSMRenderViewProxy::SafeDownCast(view->getProxy());
+  if (!proxy || m_views.count(proxy)) {
+    return;
+  }
+
+  std::unique_ptr<ViewState> state(new ViewState);
+  state->proxy = proxy;
+  // The view proxy brackets every still and interactive render with these,
+  // the call data says whether the render is interactive.
+  state->startObserver = proxy->AddObserver(vtkCommand::StartEvent, this,
+                                            &RenderStatistics::onStartRender);
+  state->endObserver = proxy->AddObserver(vtkCommand::EndEvent, this,
+                                          &RenderStatistics::onEndRender);
+
+  auto renderView = vtkPVRenderView::SafeDownCast(proxy->GetClientSideObject());
+  if (renderView) {
+    state->renderer = renderView->GetNonCompositedRenderer();
+    state->overlay->SetDisplayPosition(10, 10);
+    state->overlay->GetTextProperty()->SetFontSize(12);
+    state->overlay->GetTextProperty()->SetFontFamilyToCourier();
+    state->overlay->SetVisibility(m_overlayVisible);
+    state->renderer->AddActor(state->overlay);
+  }
+  m_views[proxy] = std::move(state);
+}
+
+void RenderStatistics::viewRemoved(pqView* view)
+{
+  auto it = m_views.find(vtkSMViewProxy::SafeDownCast(view->getProxy()));
+  if (it == m_views.end()) {
+    return;
+  }
+  auto& state = it->second;
+  if (state->proxy) {
+    state->proxy->RemoveObserver(state->startObserver);
+    state->proxy->RemoveObserver(state->endObserver);
+  }
+  if (state->renderer) {
+    state->renderer->RemoveActor(state->overlay);
+  }
+  m_views.erase(it);
+}
+
+RenderStatistics::ViewState* RenderStatistics::findState(vtkObject* view) const
+{
+  auto it = m_views.find(vtkSMViewProxy::SafeDownCast(view));
+  return it == m_views.end() ? nullptr : it->second.get();
+}
+
+void RenderStatistics::onStartRender(vtkObject* caller, unsigned long,
+                                     void* callData)
+{
+  auto state = findState(caller);
+  if (!state) {
+    return;
+  }
+
+  state->interactive = callData && *static_cast<int*>(callData) != 0;
+  // Still renders are always drawn at the quality chosen by the user
+  applyQuality(*state, state->interactive && m_frameBudget ? state->quality
+                                                           : 1.0);
+  if (m_overlayVisible) {
+    // Shows the previous frame, updating the text must not cause a render
+    updateOverlay(*state);
+  }
+  state->timer.start();
+}
+
+void RenderStatistics::onEndRender(vtkObject* caller, unsigned long, void*)
+{
+  auto state = findState(caller);
+  if (!state || !state->timer.isValid()) {
+    return;
+  }
+
+  recordFrame(*state, state->timer.nsecsElapsed() * 1.0e-9);
+}
+
+void RenderStatistics::recordFrame(vtkSMViewProxy* view, bool interactive,
+                                   double frameTime)
+{
+  auto state = findState(view);
+  if (!state) {
+    return;
+  }
+
+  state->interactive = interactive;
+  recordFrame(*state, frameTime);
+}
+
+void RenderStatistics::recordFrame(ViewState& state, double frameTime)
+{
+  state.frameTime = frameTime;
+  state.averageFrameTime =
+    state.averageFrameTime > 0.0
+      ? 0.9 * state.averageFrameTime + 0.1 * state.frameTime
+      : state.frameTime;
+
+  if (!state.interactive || !m_frameBudget || m_targetFps <= 0.0) {
+    return;
+  }
+
+  // Scale the quality with the overshoot, so that one slow frame is enough to
+  // bring the next ones in budget. Recover more gently, to avoid oscillating.
+  double budget = 1.0 / m_targetFps;
+  if (state.frameTime > 1.1 * budget) {
+    state.quality =
+      std::max(minimumQuality, state.quality * budget / state.frameTime);
+  } else if (state.frameTime < 0.5 * budget) {
+    state.quality = std::min(1.0, state.quality * 1.25);
+  }
+}
+
+void RenderStatistics::applyQuality(ViewState& state, double quality)
+{
+  if (quality == state.appliedQuality) {
+    return;
+  }
+  state.appliedQuality = quality;
+  foreach (Module* module,
+           ModuleManager::instance().modulesInView(state.proxy)) {
+    module->setRenderQuality(quality);
+  }
+}
+
+void RenderStatistics::updateOverlay(ViewState& state)
+{
+  QStringList lines;
+  double fps = state.frameTime > 0.0 ? 1.0 / state.frameTime : 0.0;
+  lines << QString("Frame %1 ms (%2 fps)%3")
+             .arg(state.frameTime * 1000.0, 0, 'f', 1)
+             .arg(fps, 0, 'f', 1)
+             .arg(state.interactive ? ", interactive" : "");
+  foreach (Module* module,
+           ModuleManager::instance().modulesInView(state.proxy)) {
+    auto stats = module->renderStatistics();
+    QString line = QString("%1: %2 ms")
+                     .arg(module->label())
+                     .arg(stats.renderTime * 1000.0, 0, 'f', 1);
+    if (stats.triangles > 0) {
+      line += QString(", %1 triangles").arg(humanCount(stats.triangles));
+    }
+    if (stats.voxels > 0) {
+      line += QString(", %1 voxels").arg(humanCount(stats.voxels));
+    }
+    lines << line;
+  }
+  if (m_frameBudget) {
+    lines << QString("Quality %1 (budget %2 fps)")
+               .arg(state.appliedQuality, 0, 'f', 2)
+               .arg(m_targetFps, 0, 'f', 0);
+  }
+  state.overlay->SetInput(lines.join("\n").toUtf8().constData());
+}
+
+QJsonObject RenderStatistics::statistics(vtkSMViewProxy* view) const
+{
+  QJsonObject json;
+  auto state = findState(view);
+  if (!state) {
+    return json;
+  }
+
+  double moduleTime = 0.0;
+  vtkIdType triangles = 0;
+  vtkIdType voxels = 0;
+  QJsonArray modules;
+  foreach (Module* module, ModuleManager::instance().modulesInView(view)) {
+    auto stats = module->renderStatistics();
+    QJsonObject moduleJson;
+    moduleJson["label"] = module->label();
+    moduleJson["data_source"] =
+      module->dataSource() ? module->dataSource()->label() : QString();
+    moduleJson["render_time"] = stats.renderTime;
+    moduleJson["triangles"] = static_cast<double>(stats.triangles);
+    moduleJson["voxels"] = static_cast<double>(stats.voxels);
+    modules.append(moduleJson);
+    moduleTime += stats.renderTime;
+    triangles += stats.triangles;
+    voxels += stats.voxels;
+  }
+
+  json["frame_time"] = state->frameTime;
+  json["average_frame_time"] = state->averageFrameTime;
+  json["frames_per_second"] =
+    state->frameTime > 0.0 ? 1.0 / state->frameTime : 0.0;
+  // The rest of the frame time is spent outside the modules: the pipeline
+  // update, other props, compositing and the Qt side of the frame.
+  json["module_time"] = moduleTime;
+  json["interactive"] = state->interactive;
+  json["quality"] = state->appliedQuality;
+  json["budget_quality"] = state->quality;
+  json["triangles"] = static_cast<double>(triangles);
+  json["voxels"] = static_cast<double>(voxels);
+  json["modules"] = modules;
+  return json;
+}
+
+void RenderStatistics::setOverlayVisible(bool visible)
+{
+  if (visible == m_overlayVisible) {
+    return;
+  }
+  m_overlayVisible = visible;
+  for (auto& view : m_views) {
+    if (visible) {
+      updateOverlay(*view.second);
+    }
+    view.second->overlay->SetVisibility(visible);
+  }
+}
+
+void RenderStatistics::setFrameBudgetEnabled(bool enabled)
+{
+  m_frameBudget = enabled;
+  pqApplicationCore::instance()->settings()->setValue(frameBudgetKey, enabled);
+  for (auto& view : m_views) {
+    view.second->quality = 1.0;
+    applyQuality(*view.second, 1.0);
+  }
+}
+
+void RenderStatistics::setTargetFramesPerSecond(double fps)
+{
+  m_targetFps = std::max(1.0, fps);
+  pqApplicationCore::instance()->settings()->setValue(targetFpsKey,
+                                                       m_targetFps);
+}
+
+} // namespace tomviz
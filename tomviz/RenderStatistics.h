@@ -0,0 +1,82 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizRenderStatistics_h
+#define tomvizRenderStatistics_h
+
+#include <QObject>
+
+#include <QJsonObject>
+
+#include <map>
+#include <memory>
+
+class pqView;
+class vtkObject;
+class vtkSMViewProxy;
+
+namespace tomviz {
+
+/// Collects render statistics for every render view: the time of the last
+/// frame, the time each module reported for drawing itself, and the triangles
+/// and voxels it drew. The statistics can be shown in an overlay in the view,
+/// and are available from Python as View.render_statistics.
+///
+/// When the frame budget is enabled, the render quality of the modules in a
+/// view is lowered during interaction until frames take no longer than the
+/// target frame rate allows, and restored for the final still render.
+class RenderStatistics : public QObject
+{
+  Q_OBJECT
+
+public:
+  static RenderStatistics& instance();
+  ~RenderStatistics() override;
+
+  /// Statistics for the last frame rendered in view, with the keys
+  /// frame_time, average_frame_time and module_time (in seconds),
+  /// frames_per_second, interactive, quality, budget_quality (the quality
+  /// the frame budget chose for the next interactive frames), triangles,
+  /// voxels and modules, a list of {label, data_source, render_time,
+  /// triangles, voxels}.
+  QJsonObject statistics(vtkSMViewProxy* view) const;
+
+  /// Account for a frame of view that took frameTime seconds, in the
+  /// statistics and the frame budget. Every render of view ends with it.
+  void recordFrame(vtkSMViewProxy* view, bool interactive, double frameTime);
+
+  void setOverlayVisible(bool visible);
+  bool overlayVisible() const { return m_overlayVisible; }
+
+  void setFrameBudgetEnabled(bool enabled);
+  bool frameBudgetEnabled() const { return m_frameBudget; }
+
+  /// The frame rate the frame budget tries to hold during interaction.
+  void setTargetFramesPerSecond(double fps);
+  double targetFramesPerSecond() const { return m_targetFps; }
+
+private slots:
+  void viewAdded(pqView* view);
+  void viewRemoved(pqView* view);
+
+private:
+  RenderStatistics();
+  Q_DISABLE_COPY(RenderStatistics)
+
+  struct ViewState;
+
+  void onStartRender(vtkObject* caller, unsigned long, void* callData);
+  void onEndRender(vtkObject* caller, unsigned long, void* callData);
+  void recordFrame(ViewState& state, double frameTime);
+  void applyQuality(ViewState& state, double quality);
+  void updateOverlay(ViewState& state);
+  ViewState* findState(vtkObject* view) const;
+
+  std::map<vtkSMViewProxy*, std::unique_ptr<ViewState>> m_views;
+  bool m_overlayVisible = false;
+  bool m_frameBudget = false;
+  double m_targetFps = 15.0;
+};
+} // namespace tomviz
+
+#endif
@@ -38,6 +38,7 @@
 #include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkScalarsToColors.h>
 #include <vtkTransform.h>
 #include <vtkTrivialProducer.h>
@@ -59,6 +60,7 @@
 
 #include <algorithm>
 #include <array>
+#include <vector>
 
 #define PI 3.14159265359
 
@@ -95,7 +97,8 @@ public:
   int m_slice2;
   int m_orientation;
 
-  bool m_summedImageInitialized = false;
+  // The version of the tilt series the summed image was computed from
+  vtkMTimeType m_summedImageVersion = 0;
 
   RAWInternal()
   {
@@ -202,95 +205,116 @@ public:
 
   void updateDirtyReconSlices()
   {
+    std::vector<int> dirty;
     for (int i = 0; i < 3; ++i) {
       if (m_reconSliceDirty[i]) {
-        this->updateReconSlice(i);
+        dirty.push_back(i);
         m_reconSliceDirty[i] = false;
       }
     }
+    this->updateReconSlices(dirty);
   }
 
-  void updateReconSlice(int i)
+  void updateReconSlices(const std::vector<int>& indices)
   {
     vtkImageData* imageData = m_image;
-    if (imageData) {
-      int extent[6];
-      imageData->GetExtent(extent);
-      int dims[3] = { extent[1] - extent[0] + 1, extent[3] - extent[2] + 1,
-                      extent[5] - extent[4] + 1 };
-
-      int sliceNumbers[] = { m_slice0, m_slice1, m_slice2 };
-      int sliceNum = sliceNumbers[i];
+    if (!imageData || indices.empty()) {
+      return;
+    }
 
-      int Nray = 256; // Size of 2D reconstruction. Fixed for all tilt series
-      std::vector<float> sinogram(Nray * dims[2]);
+    int extent[6];
+    imageData->GetExtent(extent);
+    int dims[3] = { extent[1] - extent[0] + 1, extent[3] - extent[2] + 1,
+                    extent[5] - extent[4] + 1 };
+
+    int Nray = 256; // Size of 2D reconstruction. Fixed for all tilt series
+    int sliceNumbers[] = { m_slice0, m_slice1, m_slice2 };
+
+    // Extract the sinograms of all the slices in one pass over the tilts
+    int count = static_cast<int>(indices.size());
+    std::vector<int> slices(count);
+    std::vector<double> shifts(count);
+    std::vector<std::vector<float>> sinograms(count);
+    std::vector<float*> sinogramPtrs(count);
+    for (int s = 0; s < count; ++s) {
+      slices[s] = sliceNumbers[indices[s]];
       // Approximate in-plance rotation as a shift in y-direction
-      double shift =
+      shifts[s] =
         this->m_shiftRotation +
-        sin(-this->m_tiltRotation * PI / 180) * (sliceNum - dims[0] / 2);
-
-      TomographyTiltSeries::getSinogram(
-        imageData, sliceNum, &sinogram[0], Nray, shift,
-        m_orientation); // Get a sinogram from tilt series
-
-      this->reconImage[i]->SetExtent(0, Nray - 1, 0, Nray - 1, 0, 0);
-      this->reconImage[i]->AllocateScalars(VTK_FLOAT, 1);
-      vtkDataArray* reconArray =
-        this->reconImage[i]->GetPointData()->GetScalars();
-      float* reconPtr = static_cast<float*>(reconArray->GetVoidPointer(0));
-
-      vtkDataArray* tiltAnglesArray =
-        imageData->GetFieldData()->GetArray("tilt_angles");
-      double* tiltAngles =
-        static_cast<double*>(tiltAnglesArray->GetVoidPointer(0));
-
-      TomographyReconstruction::unweightedBackProjection2(
-        &sinogram[0], tiltAngles, reconPtr, dims[2], Nray);
-      this->reconSliceMapper[i]->SetInputData(this->reconImage[i].GetPointer());
-      this->reconSliceMapper[i]->SetSliceNumber(0);
-      this->reconSliceMapper[i]->Update();
-
-      double range[2] = {DBL_MAX, -DBL_MAX};
-
-      // Get the range of the inscribed circle only
-      auto radius = static_cast<double>(Nray) / 2;
-
-      // The max distance for what we will keep is the radius multiplied by
-      // some reduction factor in order to exclude edge pixels. The images come
-      // out better if we exclude edge pixels since the pixel values tend to
-      // drop fast near the edges. So this factor is a magic number.
-      auto maxDistance = radius * 0.97;
-      for (int j = 0; j < Nray; ++j) {
-        for (int k = 0; k < Nray; ++k) {
-          auto distance = std::sqrt(std::pow(radius - j, 2) + std::pow(radius - k, 2));
-          if (distance > maxDistance) {
-            // Not in the inscribed circle (or is an edge pixel). Continue.
-            continue;
-          }
-
-          auto idx = j * Nray + k;
-          auto val = reconArray->GetTuple1(idx);
-          if (val < range[0]) {
-            range[0] = val;
-          }
-          if (val > range[1]) {
-            range[1] = val;
-          }
+        sin(-this->m_tiltRotation * PI / 180) * (slices[s] - dims[0] / 2);
+      sinograms[s].resize(static_cast<size_t>(Nray) * dims[2]);
+      sinogramPtrs[s] = sinograms[s].data();
+    }
+    TomographyTiltSeries::getSinograms(imageData, count, slices.data(),
+                                       shifts.data(), sinogramPtrs.data(),
+                                       Nray, m_orientation);
+
+    vtkDataArray* tiltAnglesArray =
+      imageData->GetFieldData()->GetArray("tilt_angles");
+    double* tiltAngles =
+      static_cast<double*>(tiltAnglesArray->GetVoidPointer(0));
+
+    for (int s = 0; s < count; ++s) {
+      this->reconstructSlice(indices[s], sinograms[s].data(), tiltAngles,
+                             dims[2], Nray);
+    }
+  }
+
+  void reconstructSlice(int i, float* sinogram, double* tiltAngles,
+                        int numberOfTilts, int Nray)
+  {
+    this->reconImage[i]->SetExtent(0, Nray - 1, 0, Nray - 1, 0, 0);
+    this->reconImage[i]->AllocateScalars(VTK_FLOAT, 1);
+    vtkDataArray* reconArray =
+      this->reconImage[i]->GetPointData()->GetScalars();
+    float* reconPtr = static_cast<float*>(reconArray->GetVoidPointer(0));
+
+    TomographyReconstruction::unweightedBackProjection2(
+      sinogram, tiltAngles, reconPtr, numberOfTilts, Nray);
+    this->reconSliceMapper[i]->SetInputData(this->reconImage[i].GetPointer());
+    this->reconSliceMapper[i]->SetSliceNumber(0);
+    this->reconSliceMapper[i]->Update();
+
+    double range[2] = {DBL_MAX, -DBL_MAX};
+
+    // Get the range of the inscribed circle only
+    auto radius = static_cast<double>(Nray) / 2;
+
+    // The max distance for what we will keep is the radius multiplied by
+    // some reduction factor in order to exclude edge pixels. The images come
+    // out better if we exclude edge pixels since the pixel values tend to
+    // drop fast near the edges. So this factor is a magic number.
+    auto maxDistance = radius * 0.97;
+    for (int j = 0; j < Nray; ++j) {
+      for (int k = 0; k < Nray; ++k) {
+        auto distance =
+          std::sqrt(std::pow(radius - j, 2) + std::pow(radius - k, 2));
+        if (distance > maxDistance) {
+          // Not in the inscribed circle (or is an edge pixel). Continue.
+          continue;
+        }
+
+        auto val = reconPtr[j * Nray + k];
+        if (val < range[0]) {
+          range[0] = val;
+        }
+        if (val > range[1]) {
+          range[1] = val;
         }
       }
+    }
 
-      vtkSMTransferFunctionProxy::RescaleTransferFunction(
-        this->ReconColorMap[i], range);
-      this->reconSlice[i]->GetProperty()->SetLookupTable(
-        vtkScalarsToColors::SafeDownCast(
-          this->ReconColorMap[i]->GetClientSideObject()));
+    vtkSMTransferFunctionProxy::RescaleTransferFunction(
+      this->ReconColorMap[i], range);
+    this->reconSlice[i]->GetProperty()->SetLookupTable(
+      vtkScalarsToColors::SafeDownCast(
+        this->ReconColorMap[i]->GetClientSideObject()));
 
-      tomviz::QVTKGLWidget* sliceView[] = { this->Ui.sliceView_1,
-                                            this->Ui.sliceView_2,
-                                            this->Ui.sliceView_3 };
+    tomviz::QVTKGLWidget* sliceView[] = { this->Ui.sliceView_1,
+                                          this->Ui.sliceView_2,
+                                          this->Ui.sliceView_3 };
 
-      sliceView[i]->renderWindow()->Render();
-    }
+    sliceView[i]->renderWindow()->Render();
   }
 
   void updateSliceLines()
@@ -346,12 +370,14 @@ public:
 
   void initializeSummedImage()
   {
-    if (m_summedImageInitialized) {
-      // Already initialized. This data is static and does not change.
+    auto image = m_image;
+    auto imageArray = image->GetPointData()->GetScalars();
+    auto version = std::max(image->GetMTime(), imageArray->GetMTime());
+    if (version == m_summedImageVersion) {
+      // Already summed this version of the tilt series.
       return;
     }
 
-    auto image = m_image;
     auto summedImage = m_summedImage.Get();
 
     const auto* dims = image->GetDimensions();
@@ -362,28 +388,11 @@ public:
     summedImage->SetSpacing(image->GetSpacing());
     summedImage->AllocateScalars(VTK_DOUBLE, 1);
 
-    auto imageArray = image->GetPointData()->GetScalars();
     auto summedImageArray = summedImage->GetPointData()->GetScalars();
-
-    // Initialize values to zero
-    for (int i = 0; i < summedImageArray->GetNumberOfTuples(); ++i) {
-      summedImageArray->SetTuple1(i, 0);
-    }
+    auto* summed = static_cast<double*>(summedImageArray->GetVoidPointer(0));
 
     // Now sum the values in the image data
-    // Fortran ordering
-    for (int k = 0; k < dims[2]; ++k) {
-      for (int j = 0; j < dims[1]; ++j) {
-        for (int i = 0; i < dims[0]; ++i) {
-          auto summedIdx = static_cast<size_t>(j) * dims[0] + i;
-          auto imgIdx = (static_cast<size_t>(k) * dims[1] + j) * dims[0] + i;
-          auto prevValue = summedImageArray->GetTuple1(summedIdx);
-          auto newValue = prevValue + imageArray->GetTuple1(imgIdx);
-          summedImageArray->SetTuple1(summedIdx, newValue);
-        }
-      }
-    }
-
+    TomographyTiltSeries::sumTiltSeries(image, summed);
     summedImageArray->Modified();
 
     // Rescale the data range to the original range
@@ -393,21 +402,24 @@ public:
     // exactly the same image as rescaling the color range to be in the
     // new range.
     const auto* newRange = imageArray->GetRange();
-    const auto* oldRange = summedImageArray->GetRange();
+    double oldRange[2];
+    summedImageArray->GetRange(oldRange);
 
     const double newSpread = newRange[1] - newRange[0];
     const double oldSpread = oldRange[1] - oldRange[0];
-    const double multiplier = newSpread / oldSpread;
+    const double multiplier = oldSpread != 0 ? newSpread / oldSpread : 0;
 
-    for (int i = 0; i < summedImageArray->GetNumberOfTuples(); ++i) {
-      double oldVal = summedImageArray->GetTuple1(i);
-      double newVal = (oldVal - oldRange[0]) * multiplier + newRange[0];
-      summedImageArray->SetTuple1(i, newVal);
-    }
+    vtkSMPTools::For(0, summedImageArray->GetNumberOfTuples(),
+                     [&](vtkIdType first, vtkIdType last) {
+                       for (vtkIdType i = first; i < last; ++i) {
+                         summed[i] =
+                           (summed[i] - oldRange[0]) * multiplier + newRange[0];
+                       }
+                     });
 
     summedImageArray->Modified();
 
-    m_summedImageInitialized = true;
+    m_summedImageVersion = version;
   }
 };
 
@@ -586,9 +598,7 @@ RotateAlignWidget::RotateAlignWidget(Operator* op,
 
   // We have to do this here since we need the output to exist so the camera
   // can be initialized below
-  this->Internals->updateReconSlice(0);
-  this->Internals->updateReconSlice(1);
-  this->Internals->updateReconSlice(2);
+  this->Internals->updateReconSlices({ 0, 1, 2 });
 
   this->Internals->setupCameras();
   this->Internals->setupRotationAxisLine();
@@ -736,8 +746,7 @@ void RotateAlignWidget::onOrientationChanged(int val)
   this->updateControls();
   this->Internals->updateSliceLines();
   this->Internals->moveRotationAxisLine();
-  for (int i = 0; i < 3; ++i)
-    this->Internals->updateReconSlice(i);
+  this->Internals->updateReconSlices({ 0, 1, 2 });
 }
 
 void RotateAlignWidget::onReconSliceChanged(int idx, int val)
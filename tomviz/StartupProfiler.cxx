@@ -0,0 +1,133 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "StartupProfiler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QVector>
+
+namespace tomviz {
+
+namespace {
+
+struct PhaseRecord
+{
+  QString name;
+  QString thread;
+  qint64 start;
+  qint64 end;
+};
+
+struct ProfilerState
+{
+  QMutex mutex;
+  QElapsedTimer timer;
+  QVector<PhaseRecord> phases;
+  bool finished = false;
+};
+
+ProfilerState& state()
+{
+  static ProfilerState s;
+  return s;
+}
+
+QString currentThreadName()
+{
+  auto app = QCoreApplication::instance();
+  if (!app || QThread::currentThread() == app->thread()) {
+    return QStringLiteral("main");
+  }
+  return QStringLiteral("worker");
+}
+
+} // namespace
+
+StartupProfiler::Phase::Phase(const QString& name)
+  : m_name(name), m_start(StartupProfiler::elapsed())
+{
+}
+
+StartupProfiler::Phase::~Phase()
+{
+  StartupProfiler::record(m_name, m_start);
+}
+
+void StartupProfiler::start()
+{
+  auto& s = state();
+  QMutexLocker lock(&s.mutex);
+  if (!s.timer.isValid()) {
+    s.timer.start();
+  }
+}
+
+qint64 StartupProfiler::elapsed()
+{
+  auto& s = state();
+  QMutexLocker lock(&s.mutex);
+  if (!s.timer.isValid()) {
+    s.timer.start();
+  }
+  return s.timer.elapsed();
+}
+
+void StartupProfiler::record(const QString& name, qint64 startMs)
+{
+  auto end = elapsed();
+  auto& s = state();
+  QMutexLocker lock(&s.mutex);
+  s.phases.append({ name, currentThreadName(), startMs, end });
+}
+
+void StartupProfiler::mark(const QString& name)
+{
+  record(name, elapsed());
+}
+
+QString StartupProfiler::report()
+{
+  auto& s = state();
+  QMutexLocker lock(&s.mutex);
+  QString text = QString("%1 %2 %3 %4\n")
+                   .arg("phase", -40)
+                   .arg("thread", -8)
+                   .arg("start ms", 10)
+                   .arg("took ms", 10);
+  for (auto& phase : s.phases) {
+    text += QString("%1 %2 %3 %4\n")
+              .arg(phase.name, -40)
+              .arg(phase.thread, -8)
+              .arg(phase.start, 10)
+              .arg(phase.end - phase.start, 10);
+  }
+  return text;
+}
+
+void StartupProfiler::finish()
+{
+  {
+    auto& s = state();
+    QMutexLocker lock(&s.mutex);
+    if (s.finished) {
+      return;
+    }
+    s.finished = true;
+  }
+  mark("startup complete");
+  if (enabled()) {
+    qInfo().noquote() << "Startup profile:\n" << report();
+  }
+}
+
+bool StartupProfiler::enabled()
+{
+  return qEnvironmentVariableIsSet("TOMVIZ_PROFILE_STARTUP");
+}
+
+} // namespace tomviz
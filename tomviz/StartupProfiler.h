@@ -0,0 +1,54 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizStartupProfiler_h
+#define tomvizStartupProfiler_h
+
+#include <QString>
+
+namespace tomviz {
+
+/// Records how long each phase of application startup takes. Phases may be
+/// recorded from any thread, times are measured from the call to start().
+/// Set the TOMVIZ_PROFILE_STARTUP environment variable to have the report
+/// printed once startup has finished.
+class StartupProfiler
+{
+public:
+  /// Times the enclosing scope and records it as a phase when destroyed.
+  class Phase
+  {
+  public:
+    explicit Phase(const QString& name);
+    ~Phase();
+
+  private:
+    Q_DISABLE_COPY(Phase)
+
+    QString m_name;
+    qint64 m_start;
+  };
+
+  /// Start the clock, this should be the first thing main() does.
+  static void start();
+
+  /// Milliseconds elapsed since start().
+  static qint64 elapsed();
+
+  /// Record a phase that ran from startMs to now.
+  static void record(const QString& name, qint64 startMs);
+
+  /// Record an instantaneous event, e.g. "window shown".
+  static void mark(const QString& name);
+
+  /// Returns a human readable table of the recorded phases.
+  static QString report();
+
+  /// Startup is complete, print the report if profiling was requested.
+  static void finish();
+
+  static bool enabled();
+};
+} // namespace tomviz
+
+#endif
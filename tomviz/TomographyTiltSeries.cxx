@@ -9,10 +9,14 @@
 #define PI 3.14159265359
 #include "vtkFloatArray.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
 #include <QDebug>
 
+#include <algorithm>
+#include <vector>
+
 namespace {
 
 // conversion code
@@ -39,6 +43,86 @@ vtkSmartPointer<vtkFloatArray> convertToFloat(vtkImageData* image)
   }
   return array;
 }
+
+// The rays of a sinogram, each interpolated between two rows of the tilts
+struct RayWeights
+{
+  RayWeights(int Nray, int tiltAxDim, double axisPosition)
+    : index1(Nray), index2(Nray), weight1(Nray), weight2(Nray)
+  {
+    // Rows outside of the tilts are marked with -1 and do not contribute
+    auto row = [tiltAxDim](int i) { return i >= 0 && i < tiltAxDim ? i : -1; };
+    double rayWidth = (double)tiltAxDim / (double)Nray;
+    for (int r = 0; r < Nray; ++r) {
+      double rayCoord = (double)(r - Nray / 2) * rayWidth + axisPosition;
+      int first = floor(rayCoord) + tiltAxDim / 2;
+      index1[r] = row(first);
+      index2[r] = row(first + 1);
+      weight1[r] = fabs(rayCoord - floor(rayCoord));
+      weight2[r] = 1 - weight1[r];
+    }
+  }
+
+  std::vector<int> index1;
+  std::vector<int> index2;
+  std::vector<float> weight1;
+  std::vector<float> weight2;
+};
+
+template <typename T>
+void getSinogramsT(const T* data, const int dims[3], int count,
+                   const int* sliceNumbers,
+                   const std::vector<RayWeights>& weights,
+                   float* const* sinograms, int Nray, int tiltAxis)
+{
+  const size_t xDim = dims[0];
+  const size_t tiltSize = xDim * dims[1];
+  // Each tilt fills one row of every sinogram
+  vtkSMPTools::For(0, dims[2], [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType z = first; z < last; ++z) {
+      const T* tilt = data + z * tiltSize;
+      for (int s = 0; s < count; ++s) {
+        const auto& w = weights[s];
+        // Offset of the slice, and the stride between rows along the rays
+        const size_t slice =
+          tiltAxis == 0 ? sliceNumbers[s] : sliceNumbers[s] * xDim;
+        const size_t stride = tiltAxis == 0 ? xDim : 1;
+        float* row = sinograms[s] + z * Nray;
+        for (int r = 0; r < Nray; ++r) {
+          row[r] = 0;
+          if (w.index1[r] >= 0) {
+            row[r] += static_cast<float>(tilt[slice + w.index1[r] * stride]) *
+                      w.weight1[r];
+          }
+          if (w.index2[r] >= 0) {
+            row[r] += static_cast<float>(tilt[slice + w.index2[r] * stride]) *
+                      w.weight2[r];
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename T>
+void sumTiltSeriesT(const T* data, const int dims[3], double* sum)
+{
+  const size_t xDim = dims[0];
+  const size_t tiltSize = xDim * dims[1];
+  // Each row of the sum is accumulated over the tilts by one thread
+  vtkSMPTools::For(0, dims[1], [&](vtkIdType first, vtkIdType last) {
+    for (vtkIdType y = first; y < last; ++y) {
+      double* row = sum + y * xDim;
+      std::fill(row, row + xDim, 0.0);
+      for (int z = 0; z < dims[2]; ++z) {
+        const T* tiltRow = data + z * tiltSize + y * xDim;
+        for (size_t x = 0; x < xDim; ++x) {
+          row[x] += static_cast<double>(tiltRow[x]);
+        }
+      }
+    }
+  });
+}
 } // end of namespace
 
 namespace tomviz {
@@ -72,62 +156,34 @@ void getSinogram(vtkImageData* tiltSeries, int sliceNumber, float* sinogram)
 // Extract sinograms from tilt series
 void getSinogram(vtkImageData* tiltSeries, int sliceNumber, float* sinogram,
                  int Nray, double axisPosition, int tiltAxis)
+{
+  getSinograms(tiltSeries, 1, &sliceNumber, &axisPosition, &sinogram, Nray,
+               tiltAxis);
+}
+
+void getSinograms(vtkImageData* tiltSeries, int count, const int* sliceNumbers,
+                  const double* axisPositions, float* const* sinograms,
+                  int Nray, int tiltAxis)
 {
   int extents[6];
   tiltSeries->GetExtent(extents);
-  int xDim = extents[1] - extents[0] + 1; // number of slices
-  int yDim = extents[3] - extents[2] + 1; // number of rays in tilt series
-  int zDim = extents[5] - extents[4] + 1; // number of tilts
+  int dims[3] = { extents[1] - extents[0] + 1, // number of slices
+                  extents[3] - extents[2] + 1, // number of rays in tilt series
+                  extents[5] - extents[4] + 1 }; // number of tilts
 
   // Note that the meaning of x and y flip if the tiltAxis is flipped
-  int tiltAxDim;
-  if (tiltAxis == 0)
-    tiltAxDim = yDim;
-  else
-    tiltAxDim = xDim;
-
-  // Convert tiltSeries type to float
-  vtkSmartPointer<vtkFloatArray> dataAsFloats = convertToFloat(tiltSeries);
-  float* dataPtr = static_cast<float*>(dataAsFloats->GetVoidPointer(
-    0)); // Get pointer to tilt series (of type float)
-
-  double rayWidth = (double)tiltAxDim / (double)Nray;
-  std::vector<float> weight1(Nray); // Store weights for linear interpolation
-  std::vector<float> weight2(Nray); // Store weights for linear interpolation
-  std::vector<int> index1(Nray);    // Store indices for linear interpolation
-  std::vector<int> index2(Nray);    // Store indices for linear interpolation
-
-  // Extract sinograms from tilt series. Make a deep copy
-  for (int z = 0; z < zDim; ++z) // Loop through tilts (z-direction)
-  {
-    for (int r = 0; r < Nray; ++r) // Loop through rays (y-direction)
-    {
-      if (z == 0) { // Initialize weights and indices
-        double rayCoord = (double)(r - Nray / 2) * rayWidth + axisPosition;
-        index1[r] = floor(rayCoord) + tiltAxDim / 2;
-        index2[r] = index1[r] + 1;
-        weight1[r] = fabs(rayCoord - floor(rayCoord));
-        weight2[r] = 1 - weight1[r];
-      }
-      sinogram[z * Nray + r] = 0;
-      size_t dataInd;
-      if (index1[r] >= 0 && index1[r] < tiltAxDim) {
-        if (tiltAxis == 0)
-          dataInd = z * xDim * yDim + index1[r] * xDim + sliceNumber;
-        else
-          dataInd = z * xDim * yDim + sliceNumber * xDim + index1[r];
-
-        sinogram[z * Nray + r] += dataPtr[dataInd] * weight1[r];
-      }
-      if (index2[r] >= 0 && index2[r] < tiltAxDim) {
-        if (tiltAxis == 0)
-          dataInd = z * xDim * yDim + index2[r] * xDim + sliceNumber;
-        else
-          dataInd = z * xDim * yDim + sliceNumber * xDim + index2[r];
+  int tiltAxDim = tiltAxis == 0 ? dims[1] : dims[0];
+  std::vector<RayWeights> weights;
+  weights.reserve(count);
+  for (int s = 0; s < count; ++s) {
+    weights.emplace_back(Nray, tiltAxDim, axisPositions[s]);
+  }
 
-        sinogram[z * Nray + r] += dataPtr[dataInd] * weight2[r];
-      }
-    }
+  vtkDataArray* scalars = tiltSeries->GetPointData()->GetScalars();
+  switch (scalars->GetDataType()) {
+    vtkTemplateMacro(getSinogramsT(
+      static_cast<VTK_TT*>(scalars->GetVoidPointer(0)), dims, count,
+      sliceNumbers, weights, sinograms, Nray, tiltAxis));
   }
 }
 
@@ -159,5 +215,17 @@ void averageTiltSeries(vtkImageData* tiltSeries, float* average)
   }
 }
 
+void sumTiltSeries(vtkImageData* tiltSeries, double* sum)
+{
+  int dims[3];
+  tiltSeries->GetDimensions(dims);
+
+  vtkDataArray* scalars = tiltSeries->GetPointData()->GetScalars();
+  switch (scalars->GetDataType()) {
+    vtkTemplateMacro(sumTiltSeriesT(
+      static_cast<VTK_TT*>(scalars->GetVoidPointer(0)), dims, sum));
+  }
+}
+
 } // end of namespace TomographyTiltSeries
 } // end of namespace tomviz
@@ -26,6 +26,14 @@ void getSinogram(vtkImageData* tiltSeries, int, float* sinogram);
 void getSinogram(vtkImageData* tiltSeries, int, float* sinogram, int Nray,
                  double axisPosition = 0, int tiltAxis = 0);
 
+/// Interpolate the sinograms of several slices in one parallel pass over the
+/// tilts, reading the scalars in their own type and only the rows that are
+/// sampled. Slice sliceNumbers[i] is interpolated about axisPositions[i] into
+/// sinograms[i], which should have room for Nray * (number of tilts) floats.
+void getSinograms(vtkImageData* tiltSeries, int count, const int* sliceNumbers,
+                  const double* axisPositions, float* const* sinograms,
+                  int Nray, int tiltAxis = 0);
+
 // void getSinogram(vtkImageData *tiltSeries, int, float* sinogram,  int Nray,
 // double axisPosition = 0, double axisAngle = 0);
 
@@ -34,6 +42,10 @@ void getSinogram(vtkImageData* tiltSeries, int, float* sinogram, int Nray,
 
 void averageTiltSeries(vtkImageData* tiltSeries,
                        float* average); // Average all tilts
+
+/// Sum all tilts in parallel. The output is stored in the sum pointer, which
+/// should be a pointer to an array with dimensions [x, y].
+void sumTiltSeries(vtkImageData* tiltSeries, double* sum);
 } // namespace TomographyTiltSeries
 } // namespace tomviz
 
@@ -0,0 +1,197 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "TransferFunction2DRaster.h"
+
+#include <vtkColorTransferFunction.h>
+#include <vtkFloatArray.h>
+#include <vtkImageData.h>
+#include <vtkPiecewiseFunction.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace tomviz {
+
+void TransferFunction2DRaster::Rect::unite(const Rect& other)
+{
+  if (other.isEmpty()) {
+    return;
+  }
+  if (isEmpty()) {
+    *this = other;
+    return;
+  }
+  x0 = std::min(x0, other.x0);
+  y0 = std::min(y0, other.y0);
+  x1 = std::max(x1, other.x1);
+  y1 = std::max(y1, other.y1);
+}
+
+void TransferFunction2DRaster::setHistogram(vtkImageData* histogram2D)
+{
+  if (!histogram2D) {
+    std::cerr << "Invalid histogram" << std::endl;
+    return;
+  }
+
+  int bins[3];
+  histogram2D->GetDimensions(bins);
+  double spacing[3];
+  histogram2D->GetSpacing(spacing);
+  if (bins[0] != m_dims[0] || bins[1] != m_dims[1] ||
+      spacing[0] != m_spacing[0] || spacing[1] != m_spacing[1]) {
+    m_dims[0] = bins[0];
+    m_dims[1] = bins[1];
+    m_spacing[0] = spacing[0];
+    m_spacing[1] = spacing[1];
+    m_dirty.unite(Rect{ 0, 0, m_dims[0], m_dims[1] });
+  }
+}
+
+void TransferFunction2DRaster::setBox(int id, const vtkRectd& box,
+                                      vtkColorTransferFunction* colorFunc,
+                                      vtkPiecewiseFunction* opacFunc)
+{
+  if (!opacFunc || !colorFunc) {
+    std::cerr << "Invalid transfer functions!" << std::endl;
+    return;
+  }
+
+  auto& layer = m_layers[id];
+  m_dirty.unite(layer.rect);
+  layer.rect = Rect();
+
+  const int width = static_cast<int>(box.GetWidth() / m_spacing[0]);
+  const int height = static_cast<int>(box.GetHeight() / m_spacing[1]);
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  // Every row of the box has the same colors, look them up again only when
+  // they changed.
+  if (layer.row.size() != static_cast<size_t>(4 * width) ||
+      layer.colorFunc != colorFunc || layer.opacFunc != opacFunc ||
+      layer.colorTime != colorFunc->GetMTime() ||
+      layer.opacTime != opacFunc->GetMTime()) {
+    // Assume color and opacity share the same data range
+    double range[2];
+    colorFunc->GetRange(range);
+
+    std::vector<double> rgb(3 * width);
+    colorFunc->GetTable(range[0], range[1], width, rgb.data());
+    std::vector<double> alpha(width);
+    opacFunc->GetTable(range[0], range[1], width, alpha.data());
+
+    layer.row.resize(4 * width);
+    for (int i = 0; i < width; ++i) {
+      layer.row[4 * i] = static_cast<float>(rgb[3 * i]);
+      layer.row[4 * i + 1] = static_cast<float>(rgb[3 * i + 1]);
+      layer.row[4 * i + 2] = static_cast<float>(rgb[3 * i + 2]);
+      layer.row[4 * i + 3] = static_cast<float>(alpha[i]);
+    }
+    layer.colorFunc = colorFunc;
+    layer.opacFunc = opacFunc;
+    layer.colorTime = colorFunc->GetMTime();
+    layer.opacTime = opacFunc->GetMTime();
+  }
+
+  const int x0 = static_cast<int>(box.GetX() / m_spacing[0]);
+  const int y0 = static_cast<int>(box.GetY() / m_spacing[1]);
+  layer.rect.x0 = std::max(x0, 0);
+  layer.rect.y0 = std::max(y0, 0);
+  layer.rect.x1 = std::min(x0 + width, m_dims[0]);
+  layer.rect.y1 = std::min(y0 + height, m_dims[1]);
+  layer.offset = layer.rect.x0 - x0;
+  m_dirty.unite(layer.rect);
+}
+
+void TransferFunction2DRaster::removeBox(int id)
+{
+  auto it = m_layers.find(id);
+  if (it != m_layers.end()) {
+    m_dirty.unite(it->second.rect);
+    m_layers.erase(it);
+  }
+}
+
+void TransferFunction2DRaster::clear()
+{
+  for (const auto& layer : m_layers) {
+    m_dirty.unite(layer.second.rect);
+  }
+  m_layers.clear();
+}
+
+void TransferFunction2DRaster::update(vtkImageData* transferFunction)
+{
+  if (!transferFunction) {
+    std::cerr << "Invalid output image" << std::endl;
+    return;
+  }
+  if (m_dims[0] <= 0 || m_dims[1] <= 0) {
+    return;
+  }
+
+  const Rect whole{ 0, 0, m_dims[0], m_dims[1] };
+  Rect rect = m_dirty;
+  rect.x0 = std::max(rect.x0, 0);
+  rect.y0 = std::max(rect.y0, 0);
+  rect.x1 = std::min(rect.x1, m_dims[0]);
+  rect.y1 = std::min(rect.y1, m_dims[1]);
+
+  int dims[3];
+  transferFunction->GetDimensions(dims);
+  auto transfer =
+    vtkFloatArray::SafeDownCast(transferFunction->GetPointData()->GetScalars());
+  if (dims[0] != m_dims[0] || dims[1] != m_dims[1] || dims[2] != 1 ||
+      !transfer || transfer->GetNumberOfComponents() != 4) {
+    transferFunction->SetDimensions(m_dims[0], m_dims[1], 1);
+    transferFunction->AllocateScalars(VTK_FLOAT, 4);
+    transfer = vtkFloatArray::SafeDownCast(
+      transferFunction->GetPointData()->GetScalars());
+    rect = whole;
+  } else if (transferFunction != m_image ||
+             transfer->GetMTime() != m_imageTime) {
+    // Someone else drew into the image since the last update
+    rect = whole;
+  }
+
+  if (!rect.isEmpty()) {
+    composite(transfer->GetPointer(0), rect);
+    transfer->Modified();
+  }
+
+  m_image = transferFunction;
+  m_imageTime = transfer->GetMTime();
+  m_dirty = Rect();
+}
+
+void TransferFunction2DRaster::composite(float* image, const Rect& rect) const
+{
+  const vtkIdType stride = m_dims[0];
+  vtkSMPTools::For(rect.y0, rect.y1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType y = begin; y < end; ++y) {
+      float* line = image + 4 * (y * stride + rect.x0);
+      std::fill(line, line + 4 * (rect.x1 - rect.x0), 0.0f);
+      for (const auto& it : m_layers) {
+        const Layer& layer = it.second;
+        if (y < layer.rect.y0 || y >= layer.rect.y1) {
+          continue;
+        }
+        const int x0 = std::max(rect.x0, layer.rect.x0);
+        const int x1 = std::min(rect.x1, layer.rect.x1);
+        if (x0 >= x1) {
+          continue;
+        }
+        const float* source =
+          layer.row.data() + 4 * (layer.offset + x0 - layer.rect.x0);
+        std::copy(source, source + 4 * (x1 - x0),
+                  image + 4 * (y * stride + x0));
+      }
+    }
+  });
+}
+} // namespace tomviz
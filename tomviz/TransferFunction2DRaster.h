@@ -0,0 +1,95 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizTransferFunction2DRaster_h
+#define tomvizTransferFunction2DRaster_h
+
+#include <vtkRect.h>
+#include <vtkType.h>
+
+#include <map>
+#include <vector>
+
+class vtkColorTransferFunction;
+class vtkImageData;
+class vtkPiecewiseFunction;
+
+namespace tomviz {
+
+/**
+ * Rasters the boxes of a 2D transfer function into its float RGBA image
+ * incrementally. Each box keeps its own layer: its rectangle in the bins of
+ * the 2D histogram and the one row of colors that every row of the box
+ * repeats. When a box moves, only the rectangle it left and the one it now
+ * covers are redrawn, row by row across threads, by compositing the layers in
+ * the order of their ids (later boxes on top, as when each box is rastered
+ * over the previous ones).
+ */
+class TransferFunction2DRaster
+{
+public:
+  /**
+   * Sets the 2D histogram whose bins the transfer function covers. Everything
+   * is redrawn if its size changed.
+   */
+  void setHistogram(vtkImageData* histogram2D);
+
+  /**
+   * Sets the box of the layer id, in the coordinates of the histogram. The
+   * colors of the layer are only looked up again when the width of the box or
+   * the transfer functions changed.
+   */
+  void setBox(int id, const vtkRectd& box, vtkColorTransferFunction* colorFunc,
+              vtkPiecewiseFunction* opacFunc);
+
+  /** Removes the layer id. */
+  void removeBox(int id);
+
+  /** Removes every layer. */
+  void clear();
+
+  /**
+   * Redraws the rectangle changed since the last update into
+   * transferFunction. It is (re)allocated, and redrawn entirely, if its size
+   * differs from the histogram's, or if it is not the image of the last update
+   * or was modified since.
+   */
+  void update(vtkImageData* transferFunction);
+
+private:
+  struct Rect
+  {
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = 0;
+    int y1 = 0;
+
+    bool isEmpty() const { return x0 >= x1 || y0 >= y1; }
+    void unite(const Rect& other);
+  };
+
+  struct Layer
+  {
+    Rect rect;
+    // The offset of rect.x0 in row, when the box starts left of the image
+    int offset = 0;
+    // The RGBA colors of the unclipped width of the box
+    std::vector<float> row;
+    vtkColorTransferFunction* colorFunc = nullptr;
+    vtkPiecewiseFunction* opacFunc = nullptr;
+    vtkMTimeType colorTime = 0;
+    vtkMTimeType opacTime = 0;
+  };
+
+  void composite(float* image, const Rect& rect) const;
+
+  std::map<int, Layer> m_layers;
+  int m_dims[2] = { 0, 0 };
+  double m_spacing[2] = { 1.0, 1.0 };
+  Rect m_dirty;
+  vtkImageData* m_image = nullptr;
+  vtkMTimeType m_imageTime = 0;
+};
+} // namespace tomviz
+
+#endif
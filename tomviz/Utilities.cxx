@@ -5,8 +5,12 @@
 
 #include "ActiveObjects.h"
 #include "DataSource.h"
+#include "VolumeProbe.h"
 #include "tomvizConfig.h"
 
+#include <h5cpp/h5readwrite.h>
+#include <h5cpp/h5vtktypemaps.h>
+
 #include <pqAnimationCue.h>
 #include <pqAnimationManager.h>
 #include <pqAnimationScene.h>
@@ -33,6 +37,8 @@
 #include <vtkCamera.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkCubeAxesActor.h>
+#include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
 #include <vtkImageData.h>
 #include <vtkImageSliceMapper.h>
 #include <vtkMolecule.h>
@@ -43,6 +49,7 @@
 #include <vtkPoints.h>
 #include <vtkProperty.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
 #include <vtkSmartPointer.h>
 #include <vtkStringArray.h>
 #include <vtkStringList.h>
@@ -52,17 +59,22 @@
 #include <vtkTuple.h>
 #include <vtkVariantArray.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <sstream>
 #include <vector>
 
 #include <QApplication>
+#include <QBuffer>
 #include <QDebug>
 #include <QDesktopServices>
 #include <QDir>
+#include <QFile>
 #include <QFileDialog>
 #include <QJsonArray>
 #include <QLayout>
+#include <QLocale>
 #include <QMessageBox>
 #include <QStandardPaths>
 #include <QString>
@@ -1126,26 +1138,238 @@ QJsonDocument tableToJson(vtkTable* table)
 
 QString tableToCsv(vtkTable* table)
 {
-  QStringList lines;
-  QStringList headers;
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  writeTableCsv(table, &buffer);
+  return QString::fromUtf8(buffer.data());
+}
+
+namespace {
+
+// The rows formatted across threads before each write, in chunks of rows
+const vtkIdType tableBlockRows = 1 << 16;
+const vtkIdType tableChunkRows = 1 << 12;
+
+// The numeric single component columns of a table, null for the others
+std::vector<vtkDataArray*> numericColumns(vtkTable* table)
+{
+  std::vector<vtkDataArray*> columns;
   for (vtkIdType j = 0; j < table->GetNumberOfColumns(); ++j) {
-    headers << QString(table->GetColumnName(j));
+    auto array = vtkDataArray::SafeDownCast(table->GetColumn(j));
+    if (array && array->GetNumberOfComponents() != 1) {
+      array = nullptr;
+    }
+    columns.push_back(array);
   }
-  lines << headers.join(",");
-  for (vtkIdType i = 0; i < table->GetNumberOfRows(); ++i) {
-    auto row = table->GetRow(i);
-    QStringList fields;
-    for (vtkIdType j = 0; j < row->GetSize(); ++j) {
-      auto value = row->GetValue(j);
-      if (value.IsNumeric()) {
-        fields << QString::number(value.ToDouble());
-      } else {
-        fields << QString();
+  return columns;
+}
+
+void appendValue(QByteArray& buffer, vtkDataArray* array, vtkIdType row,
+                 const char* nonFinite)
+{
+  const double value = array->GetComponent(row, 0);
+  const int type = array->GetDataType();
+  if (type != VTK_FLOAT && type != VTK_DOUBLE) {
+    buffer += QByteArray::number(static_cast<qlonglong>(value));
+  } else if (!std::isfinite(value)) {
+    buffer += nonFinite ? QByteArray(nonFinite) : QByteArray::number(value);
+  } else {
+    // The shortest representation that reads back as the same value
+    buffer += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+  }
+}
+
+// Writes every row of table to device, formatting a block of them at a time
+// in parallel so that the whole text is never held in memory.
+template <typename FormatRow>
+bool writeRows(vtkTable* table, QIODevice* device, const FormatRow& formatRow)
+{
+  const vtkIdType rows = table->GetNumberOfRows();
+  for (vtkIdType block = 0; block < rows; block += tableBlockRows) {
+    const vtkIdType end = std::min(block + tableBlockRows, rows);
+    const vtkIdType chunks =
+      (end - block + tableChunkRows - 1) / tableChunkRows;
+    std::vector<QByteArray> buffers(chunks);
+    vtkSMPTools::For(0, chunks, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType c = first; c < last; ++c) {
+        const vtkIdType from = block + c * tableChunkRows;
+        const vtkIdType to = std::min(from + tableChunkRows, end);
+        for (vtkIdType i = from; i < to; ++i) {
+          formatRow(i, buffers[c]);
+        }
+      }
+    });
+    for (const auto& buffer : buffers) {
+      if (device->write(buffer) != buffer.size()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool writeTableCsv(vtkTable* table, QIODevice* device)
+{
+  if (!table || !device) {
+    return false;
+  }
+
+  QByteArray header;
+  for (vtkIdType j = 0; j < table->GetNumberOfColumns(); ++j) {
+    if (j > 0) {
+      header += ',';
+    }
+    header += table->GetColumnName(j);
+  }
+  if (device->write(header) != header.size()) {
+    return false;
+  }
+
+  // Other columns are left empty
+  const auto columns = numericColumns(table);
+  return writeRows(table, device, [&columns](vtkIdType i, QByteArray& buffer) {
+    buffer += '\n';
+    for (size_t j = 0; j < columns.size(); ++j) {
+      if (j > 0) {
+        buffer += ',';
+      }
+      if (columns[j]) {
+        appendValue(buffer, columns[j], i, nullptr);
       }
     }
-    lines << fields.join(",");
+  });
+}
+
+bool writeTableJson(vtkTable* table, QIODevice* device)
+{
+  if (!table || !device) {
+    return false;
   }
-  return lines.join("\n");
+
+  // An array of rows, as tableToJson, without the other columns
+  const auto columns = numericColumns(table);
+  auto formatRow = [&columns](vtkIdType i, QByteArray& buffer) {
+    buffer += i > 0 ? ",[" : "[";
+    bool first = true;
+    for (auto column : columns) {
+      if (column) {
+        if (!first) {
+          buffer += ',';
+        }
+        appendValue(buffer, column, i, "null");
+        first = false;
+      }
+    }
+    buffer += ']';
+  };
+  return device->write("[") == 1 && writeRows(table, device, formatRow) &&
+         device->write("]") == 1;
+}
+
+bool writeTableHdf5(vtkTable* table, const QString& fileName)
+{
+  if (!table) {
+    return false;
+  }
+
+  using h5::H5ReadWrite;
+  H5ReadWrite writer(fileName.toStdString(), H5ReadWrite::OpenMode::WriteOnly);
+  const std::string group = "/table";
+  if (!writer.createGroup(group)) {
+    return false;
+  }
+
+  // One dataset per numeric column, straight from the memory of the column
+  QStringList names;
+  for (vtkIdType j = 0; j < table->GetNumberOfColumns(); ++j) {
+    vtkSmartPointer<vtkDataArray> array =
+      vtkDataArray::SafeDownCast(table->GetColumn(j));
+    if (!array) {
+      continue;
+    }
+    QString name = table->GetColumnName(j);
+    name.replace('/', '_');
+    if (name.isEmpty() || names.contains(name)) {
+      name = QString("column_%1").arg(j);
+    }
+
+    bool supported = false;
+    for (const auto& type : h5::DataTypeToVtk) {
+      supported = supported || type.second == array->GetDataType();
+    }
+    if (!supported) {
+      auto copy = vtkSmartPointer<vtkDoubleArray>::New();
+      copy->DeepCopy(array);
+      array = copy;
+    }
+
+    std::vector<int> dims = { static_cast<int>(array->GetNumberOfTuples()) };
+    if (array->GetNumberOfComponents() > 1) {
+      dims.push_back(array->GetNumberOfComponents());
+    }
+    auto type = h5::H5VtkTypeMaps::VtkToDataType(array->GetDataType());
+    if (!writer.writeData(group, name.toStdString(), dims, type,
+                          array->GetVoidPointer(0))) {
+      return false;
+    }
+    names << name;
+  }
+
+  // The order of the columns, which HDF5 does not keep
+  return writer.setAttribute(group, "columns",
+                             names.join(",").toStdString().c_str());
+}
+
+bool tableToFile(vtkTable* table, const QString& suffix)
+{
+  if (table == nullptr) {
+    return false;
+  }
+
+  QStringList filters;
+  if (suffix == "csv") {
+    filters << "CSV Files (*.csv)";
+  } else if (suffix == "json") {
+    filters << "JSON Files (*.json)";
+  } else if (suffix == "h5") {
+    filters << "HDF5 Files (*.h5)";
+  } else {
+    qCritical() << "Unknown table format:" << suffix;
+    return false;
+  }
+  QFileDialog dialog;
+  dialog.setFileMode(QFileDialog::AnyFile);
+  dialog.setNameFilters(filters);
+  dialog.setAcceptMode(QFileDialog::AcceptSave);
+  QString fileName = dialogToFileName(&dialog);
+  if (fileName.isEmpty()) {
+    return false;
+  }
+  if (!fileName.endsWith("." + suffix)) {
+    fileName = QString("%1.%2").arg(fileName).arg(suffix);
+  }
+
+  if (suffix == "h5") {
+    if (!writeTableHdf5(table, fileName)) {
+      qCritical() << QString("Error writing file: %1").arg(fileName);
+      return false;
+    }
+    return true;
+  }
+
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qCritical() << QString("Error opening file for writing: %1").arg(fileName);
+    return false;
+  }
+  bool written = suffix == "csv" ? writeTableCsv(table, &file)
+                                 : writeTableJson(table, &file);
+  if (!written) {
+    qCritical() << QString("Error writing file: %1").arg(fileName);
+  }
+  return written;
 }
 
 bool csvToFile(const QString& csv)
@@ -1384,30 +1608,13 @@ void rescaleLut(vtkColorTransferFunction* lut, double rangeMin, double rangeMax)
   }
 }
 
-double getVoxelValue(vtkImageData* data, const vtkVector3d& point,
+double getVoxelValue(DataSource* source, const vtkVector3d& point,
                      vtkVector3i& indices, bool& ok)
 {
-  vtkVector3d p(point.GetData());
-  auto pointId = data->FindPoint(p.GetData());
-  if (pointId < 0) {
-    ok = false;
-    return 0;
-  }
-
-  vtkVector3d origin;
-  data->GetOrigin(origin.GetData());
-
-  vtkVector3d spacing;
-  data->GetSpacing(spacing.GetData());
-
-  for (int i = 0; i < 3; ++i) {
-    indices[i] = round((point[i] - origin[i]) / spacing[i]);
-  }
-
-  double scalar = data->GetScalarComponentAsDouble(
-    indices[0], indices[1], indices[2], 0);
-  ok = true;
-  return scalar;
+  double scalar = 0;
+  const VolumeProbe& probe = source->probe();
+  ok = probe.voxelValue(point.GetData(), indices.GetData(), scalar);
+  return ok ? scalar : 0;
 }
 
 QString userDataPath() {
@@ -40,6 +40,7 @@ class vtkPiecewiseFunction;
 class vtkTable;
 
 class QDir;
+class QIODevice;
 class QLayout;
 class QUrl;
 
@@ -241,6 +242,16 @@ QJsonDocument vectorToJson(const QVector<vtkVector2i> vector);
 QString tableToCsv(vtkTable* table);
 bool csvToFile(const QString& csv);
 
+/// Stream a vtkTable to a device as csv, or as a json array of rows, a block
+/// of rows at a time, without building the whole text in memory
+bool writeTableCsv(vtkTable* table, QIODevice* device);
+bool writeTableJson(vtkTable* table, QIODevice* device);
+/// Write each column of a vtkTable as a dataset of the /table group of an
+/// HDF5 file
+bool writeTableHdf5(vtkTable* table, const QString& fileName);
+/// Ask for a file name and write a vtkTable to it, suffix is csv, json or h5
+bool tableToFile(vtkTable* table, const QString& suffix);
+
 /// Write a vtkMolecule to json file
 bool moleculeToFile(vtkMolecule* molecule);
 extern double offWhite[3];
@@ -261,8 +272,9 @@ bool vtkRescaleControlPoints(std::vector<vtkTuple<double, 4>>& cntrlPoints,
 void rescaleLut(vtkColorTransferFunction* lut, double rangeMin,
                 double rangeMax);
 
-/// Get the value of a voxel at the given world coordinates
-double getVoxelValue(vtkImageData* data, const vtkVector3d& point,
+/// Get the value of a voxel of the data source at the given world
+/// coordinates, through its cached probe
+double getVoxelValue(DataSource* source, const vtkVector3d& point,
                      vtkVector3i& ijk, bool& ok);
 
 template <typename T>
@@ -36,6 +36,7 @@
 #include "DataSource.h"
 #include "ModuleManager.h"
 #include "ModuleSlice.h"
+#include "RenderStatistics.h"
 #include "SliceViewDialog.h"
 #include "Utilities.h"
 
@@ -117,6 +118,23 @@ ViewMenuManager::ViewMenuManager(QMainWindow* mainWindow, QMenu* menu)
 
   Menu->addSeparator();
 
+  auto& renderStatistics = RenderStatistics::instance();
+  m_showRenderStatisticsAction = Menu->addAction("Show Render Statistics");
+  m_showRenderStatisticsAction->setCheckable(true);
+  m_showRenderStatisticsAction->setChecked(renderStatistics.overlayVisible());
+  connect(m_showRenderStatisticsAction, &QAction::triggered, this,
+          &ViewMenuManager::setShowRenderStatistics);
+  m_frameBudgetAction = Menu->addAction("Frame Budget Mode");
+  m_frameBudgetAction->setToolTip(
+    "Lower the render quality while interacting to hold the target frame "
+    "rate");
+  m_frameBudgetAction->setCheckable(true);
+  m_frameBudgetAction->setChecked(renderStatistics.frameBudgetEnabled());
+  connect(m_frameBudgetAction, &QAction::triggered, this,
+          &ViewMenuManager::setFrameBudget);
+
+  Menu->addSeparator();
+
   m_imageViewerModeAction = Menu->addAction("Image Viewer Mode");
   m_imageViewerModeAction->setCheckable(true);
   m_imageViewerModeAction->setChecked(false);
@@ -277,6 +295,17 @@ void ViewMenuManager::setShowOrientationAxes(bool show)
   render();
 }
 
+void ViewMenuManager::setShowRenderStatistics(bool show)
+{
+  RenderStatistics::instance().setOverlayVisible(show);
+  ActiveObjects::instance().renderAllViews();
+}
+
+void ViewMenuManager::setFrameBudget(bool enable)
+{
+  RenderStatistics::instance().setFrameBudgetEnabled(enable);
+}
+
 int ViewMenuManager::interactionMode() const
 {
   auto* renderView = ActiveObjects::instance().activePqRenderView();
@@ -48,6 +48,8 @@ private slots:
 
   void setShowCenterAxes(bool show);
   void setShowOrientationAxes(bool show);
+  void setShowRenderStatistics(bool show);
+  void setFrameBudget(bool enable);
   void setImageViewerMode(bool b);
 
   void showDarkWhiteData();
@@ -69,6 +71,8 @@ private:
   QPointer<QAction> m_orthographicProjectionAction;
   QPointer<QAction> m_showCenterAxesAction;
   QPointer<QAction> m_showOrientationAxesAction;
+  QPointer<QAction> m_showRenderStatisticsAction;
+  QPointer<QAction> m_frameBudgetAction;
   QPointer<QAction> m_imageViewerModeAction;
   QPointer<QAction> m_showDarkWhiteDataAction;
 
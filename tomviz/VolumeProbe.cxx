@@ -0,0 +1,254 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "VolumeProbe.h"
+
+#include <vtkDataArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <vtkTable.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace tomviz {
+
+namespace {
+
+// How far outside of the extent, in voxels, a point still samples the edge
+const double tolerance = 1e-3;
+
+// The components of the scalars through the virtual accessors
+struct ArrayValues
+{
+  explicit ArrayValues(vtkDataArray* a) : array(a) {}
+  double operator()(vtkIdType point, int component) const
+  {
+    return array->GetComponent(point, component);
+  }
+  vtkDataArray* array;
+};
+
+// The components of scalars with the standard layout, straight from memory
+template <typename T>
+struct PointerValues
+{
+  PointerValues(void* d, int c)
+    : data(static_cast<const T*>(d)), components(c)
+  {
+  }
+  double operator()(vtkIdType point, int component) const
+  {
+    return static_cast<double>(data[point * components + component]);
+  }
+  const T* data;
+  int components;
+};
+
+template <typename Function>
+void dispatch(vtkDataArray* scalars, void* data, int components,
+              Function&& function)
+{
+  if (data) {
+    switch (scalars->GetDataType()) {
+      vtkTemplateMacro(
+        return function(PointerValues<VTK_TT>(data, components)));
+    }
+  }
+  function(ArrayValues(scalars));
+}
+
+vtkIdType pointId(const int extent[6], int i, int j, int k)
+{
+  const vtkIdType nx = extent[1] - extent[0] + 1;
+  const vtkIdType ny = extent[3] - extent[2] + 1;
+  return (i - extent[0]) + (j - extent[2]) * nx + (k - extent[4]) * nx * ny;
+}
+
+template <typename Values>
+double trilinear(const Values& values, const int extent[6],
+                 const double ijk[3], int component)
+{
+  int lo[3];
+  int hi[3];
+  double t[3];
+  for (int i = 0; i < 3; ++i) {
+    lo[i] = static_cast<int>(std::floor(ijk[i]));
+    lo[i] = std::min(std::max(lo[i], extent[i * 2]), extent[i * 2 + 1]);
+    hi[i] = std::min(lo[i] + 1, extent[i * 2 + 1]);
+    t[i] = hi[i] == lo[i] ? 0.0 : ijk[i] - lo[i];
+  }
+
+  double result = 0.0;
+  for (int corner = 0; corner < 8; ++corner) {
+    double weight = 1.0;
+    int c[3];
+    for (int i = 0; i < 3; ++i) {
+      bool upper = (corner >> i) & 1;
+      c[i] = upper ? hi[i] : lo[i];
+      weight *= upper ? t[i] : 1.0 - t[i];
+    }
+    if (weight != 0.0) {
+      result +=
+        weight * values(pointId(extent, c[0], c[1], c[2]), component);
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+VolumeProbe::VolumeProbe(vtkImageData* image)
+{
+  update(image);
+}
+
+void VolumeProbe::update(vtkImageData* image)
+{
+  auto* scalars = image ? image->GetPointData()->GetScalars() : nullptr;
+  if (!scalars) {
+    m_image = nullptr;
+    m_scalars = nullptr;
+    m_data = nullptr;
+    m_components = 0;
+    return;
+  }
+
+  auto modified = std::max(image->GetMTime(), scalars->GetMTime());
+  if (image == m_image && scalars == m_scalars && modified == m_modified) {
+    return;
+  }
+
+  m_image = image;
+  m_scalars = scalars;
+  m_modified = modified;
+  m_components = scalars->GetNumberOfComponents();
+  m_data =
+    scalars->HasStandardMemoryLayout() ? scalars->GetVoidPointer(0) : nullptr;
+  image->GetExtent(m_extent);
+  image->GetOrigin(m_origin);
+  image->GetSpacing(m_spacing);
+}
+
+bool VolumeProbe::index(const double point[3], double ijk[3]) const
+{
+  for (int i = 0; i < 3; ++i) {
+    ijk[i] = m_spacing[i] != 0.0 ? (point[i] - m_origin[i]) / m_spacing[i]
+                                 : m_extent[i * 2];
+    if (ijk[i] < m_extent[i * 2] - tolerance ||
+        ijk[i] > m_extent[i * 2 + 1] + tolerance) {
+      return false;
+    }
+    ijk[i] = std::min<double>(std::max<double>(ijk[i], m_extent[i * 2]),
+                              m_extent[i * 2 + 1]);
+  }
+  return true;
+}
+
+bool VolumeProbe::voxelValue(const double point[3], int ijk[3], double& value,
+                             int component) const
+{
+  double continuous[3];
+  if (!isValid() || component < 0 || component >= m_components ||
+      !index(point, continuous)) {
+    return false;
+  }
+  for (int i = 0; i < 3; ++i) {
+    ijk[i] = static_cast<int>(std::lround(continuous[i]));
+  }
+  const auto id = pointId(m_extent, ijk[0], ijk[1], ijk[2]);
+  dispatch(m_scalars, m_data, m_components,
+           [&](const auto& values) { value = values(id, component); });
+  return true;
+}
+
+bool VolumeProbe::sample(const double point[3], double& value,
+                         int component) const
+{
+  double ijk[3];
+  if (!isValid() || component < 0 || component >= m_components ||
+      !index(point, ijk)) {
+    return false;
+  }
+  dispatch(m_scalars, m_data, m_components, [&](const auto& values) {
+    value = trilinear(values, m_extent, ijk, component);
+  });
+  return true;
+}
+
+vtkSmartPointer<vtkTable> VolumeProbe::lineProfile(const double point1[3],
+                                                   const double point2[3],
+                                                   int samples) const
+{
+  auto table = vtkSmartPointer<vtkTable>::New();
+  if (!isValid()) {
+    return table;
+  }
+
+  double delta[3];
+  double length = 0.0;
+  double voxels = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    delta[i] = point2[i] - point1[i];
+    length += delta[i] * delta[i];
+    if (m_spacing[i] != 0.0) {
+      voxels = std::max(voxels, std::abs(delta[i] / m_spacing[i]));
+    }
+  }
+  length = std::sqrt(length);
+  if (samples < 2) {
+    samples = std::max(2, static_cast<int>(std::ceil(voxels)) + 1);
+  }
+
+  vtkNew<vtkDoubleArray> distance;
+  distance->SetName("Distance");
+  distance->SetNumberOfTuples(samples);
+  table->AddColumn(distance);
+
+  std::string name = m_scalars->GetName() ? m_scalars->GetName() : "Scalars";
+  std::vector<double*> columns;
+  for (int c = 0; c < m_components; ++c) {
+    vtkNew<vtkDoubleArray> column;
+    if (m_components == 1) {
+      column->SetName(name.c_str());
+    } else if (m_scalars->GetComponentName(c)) {
+      column->SetName(m_scalars->GetComponentName(c));
+    } else {
+      column->SetName((name + " " + std::to_string(c)).c_str());
+    }
+    column->SetNumberOfTuples(samples);
+    columns.push_back(column->GetPointer(0));
+    table->AddColumn(column);
+  }
+
+  auto* distances = distance->GetPointer(0);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  dispatch(m_scalars, m_data, m_components, [&](const auto& values) {
+    vtkSMPTools::For(0, samples, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType s = first; s < last; ++s) {
+        const double t = static_cast<double>(s) / (samples - 1);
+        double point[3];
+        for (int i = 0; i < 3; ++i) {
+          point[i] = point1[i] + t * delta[i];
+        }
+        distances[s] = t * length;
+
+        double ijk[3];
+        const bool inside = index(point, ijk);
+        for (int c = 0; c < m_components; ++c) {
+          columns[c][s] =
+            inside ? trilinear(values, m_extent, ijk, c) : nan;
+        }
+      }
+    });
+  });
+  return table;
+}
+
+} // namespace tomviz
@@ -0,0 +1,83 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizVolumeProbe_h
+#define tomvizVolumeProbe_h
+
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+#include <vtkWeakPointer.h>
+
+class vtkDataArray;
+class vtkImageData;
+class vtkTable;
+
+namespace tomviz {
+
+/**
+ * Samples the scalars of an image at world coordinates without going
+ * through vtkImageData::FindPoint or the virtual tuple accessors. The
+ * extent, origin, spacing and the pointer to the scalars are cached, so
+ * probing an image that has not changed since the last update does not
+ * touch the pipeline. Components are read straight from memory for arrays
+ * with the standard layout.
+ */
+class VolumeProbe
+{
+public:
+  VolumeProbe() = default;
+  explicit VolumeProbe(vtkImageData* image);
+
+  /**
+   * Cache the geometry and point scalars of image. Nothing is done when
+   * neither has been modified since the last update.
+   */
+  void update(vtkImageData* image);
+
+  /** Whether there are scalars to sample. */
+  bool isValid() const { return m_scalars != nullptr; }
+
+  int numberOfComponents() const { return m_components; }
+
+  /**
+   * The value of the voxel nearest to a world point, and its structured
+   * coordinates. False when the point is outside of the image.
+   */
+  bool voxelValue(const double point[3], int ijk[3], double& value,
+                  int component = 0) const;
+
+  /**
+   * The trilinear interpolation of the voxels around a world point. False
+   * when the point is outside of the image.
+   */
+  bool sample(const double point[3], double& value, int component = 0) const;
+
+  /**
+   * Sample the line from point1 to point2, both included, in parallel. The
+   * table has the distance along the line in its first column, as the
+   * tables operators return for plotting, and the trilinear samples of each
+   * component in the others, NaN outside of the image. With no count the
+   * line is sampled about once per voxel.
+   */
+  vtkSmartPointer<vtkTable> lineProfile(const double point1[3],
+                                        const double point2[3],
+                                        int samples = 0) const;
+
+private:
+  // The continuous structured coordinates of a world point, false outside
+  bool index(const double point[3], double ijk[3]) const;
+
+  vtkWeakPointer<vtkImageData> m_image;
+  vtkSmartPointer<vtkDataArray> m_scalars;
+  vtkMTimeType m_modified = 0;
+  // Null when the scalars do not have the standard memory layout
+  void* m_data = nullptr;
+  int m_components = 0;
+  int m_extent[6] = { 0, -1, 0, -1, 0, -1 };
+  double m_origin[3] = { 0, 0, 0 };
+  double m_spacing[3] = { 1, 1, 1 };
+};
+
+} // namespace tomviz
+
+#endif
@@ -56,6 +56,7 @@ public:
   virtual void resumePipeline(const std::string& dataSourcePath) = 0;
   virtual void executePipeline(const std::string& dataSourcePath) = 0;
   virtual bool pipelinePaused(const std::string& dataSourcePath) = 0;
+  virtual std::string renderStatistics(int viewId) = 0;
 };
 
 class PipelineProxyBaseFactory
@@ -5,6 +5,7 @@
 
 #include <QSplashScreen>
 #include <QSurfaceFormat>
+#include <QThreadPool>
 
 #include <QDebug>
 
@@ -17,6 +18,7 @@
 #include "loguru.hpp"
 #include "MainWindow.h"
 #include "PythonUtilities.h"
+#include "StartupProfiler.h"
 #include "tomvizConfig.h"
 #include "tomvizPythonConfig.h"
 
@@ -24,6 +26,8 @@
 
 int main(int argc, char** argv)
 {
+  tomviz::StartupProfiler::start();
+
   // Set up loguru, for printing stack traces on crashes
   loguru::g_stderr_verbosity = loguru::Verbosity_ERROR;
   loguru::init(argc, argv);
@@ -37,11 +41,13 @@ int main(int argc, char** argv)
   tomviz::InitializePythonEnvironment(argc, argv);
 
   QApplication app(argc, argv);
+  tomviz::StartupProfiler::mark("QApplication created");
 
   QPixmap pixmap(":/icons/tomvizfull.png");
   QSplashScreen splash(pixmap);
   splash.show();
   app.processEvents();
+  tomviz::StartupProfiler::mark("splash shown");
 
   std::string exeDir = QApplication::applicationDirPath().toLatin1().data();
   if (tomviz::isApplicationBundle(exeDir)) {
@@ -55,16 +61,33 @@ int main(int argc, char** argv)
   // modules.
   qputenv("TOMVIZ_APPLICATION", "1");
 
-  // If we don't initialize Python here, the application freezes when exiting
-  // at the very end, during Py_Finalize().
-  tomviz::Python::initialize();
-
   setlocale(LC_NUMERIC, "C");
+  auto appCoreStart = tomviz::StartupProfiler::elapsed();
   pqPVApplicationCore appCore(argc, argv);
-  tomviz::MainWindow window;
-  window.show();
-  splash.finish(&window);
-  window.openFiles(argc, argv);
+  tomviz::StartupProfiler::record("ParaView application core", appCoreStart);
+
+  int status = 0;
+  {
+    auto windowStart = tomviz::StartupProfiler::elapsed();
+    tomviz::MainWindow window;
+    tomviz::StartupProfiler::record("main window constructed", windowStart);
+    window.show();
+    splash.finish(&window);
+    app.processEvents();
+    tomviz::StartupProfiler::mark("main window shown");
+
+    // Python is initialized in the background once the window is on screen,
+    // followed by the module imports and operator discovery. The files are
+    // opened once it is ready.
+    window.initializePython();
+    window.openFiles(argc, argv);
+
+    status = app.exec();
+
+    // Operators canceled on exit may still be running Python code
+    QThreadPool::globalInstance()->waitForDone();
+  }
+  tomviz::Python::finalize();
 
-  return app.exec();
+  return status;
 }
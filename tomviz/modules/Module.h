@@ -11,6 +11,7 @@
 #include <QScopedPointer>
 
 #include <vtkRect.h>
+#include <vtkType.h>
 #include <vtkWeakPointer.h>
 
 class QWidget;
@@ -27,6 +28,16 @@ class DataSource;
 class MoleculeSource;
 class OperatorResult;
 
+/// What a module drew in the most recent frame of its view.
+struct ModuleRenderStatistics
+{
+  /// Seconds spent in the module's mappers, as reported by VTK, and in the
+  /// pipeline updates the module times itself.
+  double renderTime = 0.0;
+  vtkIdType triangles = 0;
+  vtkIdType voxels = 0;
+};
+
 /// Abstract parent class for all Modules in tomviz.
 class Module : public QObject
 {
@@ -112,6 +123,16 @@ public:
   /// Returns the data to export for this visualization module.
   virtual vtkDataObject* dataToExport();
 
+  /// Statistics for the most recent frame, shown by the render statistics
+  /// overlay. Modules that do not override this report nothing.
+  virtual ModuleRenderStatistics renderStatistics() const { return {}; }
+
+  /// Lower the cost of rendering this module while the user interacts with the
+  /// view. 1.0 is the quality chosen by the user, smaller values are cheaper.
+  /// The frame budget mode calls this to hold its target frame rate, and
+  /// restores 1.0 when the interaction ends.
+  virtual void setRenderQuality(double quality) { Q_UNUSED(quality); }
+
   /// Returns the active scalars of the module
   int activeScalars() const { return m_activeScalars; }
   QString activeScalarsName() const;
@@ -13,8 +13,10 @@
 #include "vtkFlyingEdges3D.h"
 #include "vtkPVRenderView.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
 #include "vtkProbeFilter.h"
 #include "vtkProperty.h"
+#include "vtkQuadricClustering.h"
 #include "vtkSMViewProxy.h"
 
 #include <QJsonObject>
@@ -405,6 +407,47 @@ void ModuleContour::dataSourceRotated(double newX, double newY, double newZ)
   m_actor->SetOrientation(newX, newY, newZ);
 }
 
+ModuleRenderStatistics ModuleContour::renderStatistics() const
+{
+  ModuleRenderStatistics stats;
+  if (!visibility()) {
+    return stats;
+  }
+  auto* mapper = m_actor->GetMapper();
+  stats.renderTime = mapper->GetTimeToDraw();
+  auto* surface = vtkPolyData::SafeDownCast(mapper->GetInputDataObject(0, 0));
+  if (surface) {
+    stats.triangles = surface->GetNumberOfPolys();
+  }
+  return stats;
+}
+
+void ModuleContour::setRenderQuality(double quality)
+{
+  if (quality >= 0.5) {
+    if (m_actor->GetMapper() != m_mapper) {
+      m_actor->SetMapper(m_mapper);
+    }
+    return;
+  }
+
+  // Bin the surface into a coarser grid the lower the quality is. The input
+  // is whatever the full resolution mapper draws, with or without the probe.
+  // The coloring is copied from the full resolution mapper once, when the
+  // interaction switches to the decimated surface, and not at every frame.
+  if (m_actor->GetMapper() != m_lodMapper) {
+    m_lod->SetInputConnection(m_mapper->GetInputConnection(0, 0));
+    m_lodMapper->ShallowCopy(m_mapper);
+    m_lodMapper->SetInputConnection(m_lod->GetOutputPort());
+    m_actor->SetMapper(m_lodMapper);
+  }
+  int divisions = quality < 0.25 ? 32 : 64;
+  if (divisions != m_lodDivisions) {
+    m_lodDivisions = divisions;
+    m_lod->SetNumberOfDivisions(divisions, divisions, divisions);
+  }
+}
+
 vtkDataObject* ModuleContour::dataToExport()
 {
   return m_flyingEdges->GetOutputDataObject(0);
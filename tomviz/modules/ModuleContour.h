@@ -14,6 +14,7 @@ class vtkFlyingEdges3D;
 class vtkProbeFilter;
 class vtkProperty;
 class vtkPVRenderView;
+class vtkQuadricClustering;
 
 namespace tomviz {
 
@@ -65,6 +66,9 @@ public:
   QString colorByArrayName() const;
   bool updateClippingPlane(vtkPlane* plane, bool newFilter) override;
 
+  ModuleRenderStatistics renderStatistics() const override;
+  void setRenderQuality(double quality) override;
+
 protected:
   void updatePanel();
   void updateColorMap() override;
@@ -81,6 +85,10 @@ protected:
   vtkNew<vtkProperty> m_property;
   vtkNew<vtkFlyingEdges3D> m_flyingEdges;
   vtkNew<vtkProbeFilter> m_probeFilter;
+  // Decimated surface drawn instead of the full one at low render quality
+  vtkNew<vtkQuadricClustering> m_lod;
+  vtkNew<vtkDataSetMapper> m_lodMapper;
+  int m_lodDivisions = 0;
   vtkWeakPointer<vtkPVRenderView> m_view;
 
   class Private;
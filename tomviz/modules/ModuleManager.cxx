@@ -596,6 +596,17 @@ QList<Module*> ModuleManager::findModulesGeneric(
   return modules;
 }
 
+QList<Module*> ModuleManager::modulesInView(const vtkSMViewProxy* view)
+{
+  QList<Module*> modules;
+  foreach (Module* module, d->Modules) {
+    if (module && module->view() == view) {
+      modules.push_back(module);
+    }
+  }
+  return modules;
+}
+
 QJsonArray jsonArrayFromXml(pugi::xml_node node)
 {
   // Simple function, just iterates through the elements and fills the array.
@@ -79,6 +79,9 @@ public:
   QList<Module*> findModulesGeneric(const MoleculeSource* dataSource,
                                     const vtkSMViewProxy* view);
 
+  /// Returns every module, of any data or molecule source, shown in the view.
+  QList<Module*> modulesInView(const vtkSMViewProxy* view);
+
   /// Save the application state as JSON, use stateDir as the base for relative
   /// paths.
   bool serialize(QJsonObject& doc, const QDir& stateDir,
@@ -10,10 +10,21 @@
 #include "Utilities.h"
 
 #include <vtkActor.h>
+#include <vtkCamera.h>
+#include <vtkCommand.h>
+#include <vtkFloatArray.h>
 #include <vtkMolecule.h>
 #include <vtkMoleculeMapper.h>
 #include <vtkNew.h>
+#include <vtkPeriodicTable.h>
+#include <vtkPointData.h>
+#include <vtkPointGaussianMapper.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
 #include <vtkRenderer.h>
+#include <vtkSMPTools.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkUnsignedShortArray.h>
 
 #include <vtkPVRenderView.h>
 #include <vtkSMViewProxy.h>
@@ -23,10 +34,45 @@
 #include <QDebug>
 #include <QFormLayout>
 
+#include <algorithm>
+#include <cmath>
+
 namespace tomviz {
 
+namespace {
+
+// Larger molecules are drawn as impostors by default
+const vtkIdType impostorThreshold = 500000;
+
+// The most atoms drawn as impostors in a frame
+const vtkIdType impostorBudget = 2000000;
+
+// Shades the point sprites as spheres
+const char* sphereShader = "//VTK::Color::Impl\n"
+                           "float dist = dot(offsetVCVSOutput.xy, "
+                           "offsetVCVSOutput.xy);\n"
+                           "if (dist > 1.0) {\n"
+                           "  discard;\n"
+                           "} else {\n"
+                           "  float scale = (1.0 - dist);\n"
+                           "  ambientColor *= scale;\n"
+                           "  diffuseColor *= scale;\n"
+                           "}\n";
+} // namespace
+
 ModuleMolecule::ModuleMolecule(QObject* parentObject) : Module(parentObject)
 {
+  // The same radii as the balls of vtkMoleculeMapper, scaled van der Waals
+  // radii
+  m_impostorMapper->SetInputData(m_visibleAtoms);
+  m_impostorMapper->SetScaleArray("radius");
+  m_impostorMapper->SetScaleFactor(
+    m_moleculeMapper->GetAtomicRadiusScaleFactor());
+  m_impostorMapper->SetColorModeToDirectScalars();
+  m_impostorMapper->SetScalarModeToUsePointData();
+  m_impostorMapper->EmissiveOff();
+  m_impostorMapper->SetSplatShaderCode(sphereShader);
+  m_impostorActor->SetMapper(m_impostorMapper);
 }
 
 ModuleMolecule::~ModuleMolecule()
@@ -83,28 +129,171 @@ void ModuleMolecule::addMoleculeToView(vtkSMViewProxy* view)
   m_moleculeActor->SetMapper(m_moleculeMapper);
 
   m_view = vtkPVRenderView::SafeDownCast(view->GetClientSideView());
-  m_view->GetRenderer()->AddActor(m_moleculeActor);
+  auto renderer = m_view->GetRenderer();
+  renderer->AddActor(m_moleculeActor);
+  renderer->AddActor(m_impostorActor);
+  // Select the atoms drawn as impostors for the camera of each frame
+  m_startObserver = renderer->AddObserver(vtkCommand::StartEvent, this,
+                                          &ModuleMolecule::updateImpostors);
+
+  setRenderMode(m_molecule->GetNumberOfAtoms() > impostorThreshold
+                  ? RenderMode::Impostors
+                  : RenderMode::BallAndStick);
   m_view->Update();
 }
 
 bool ModuleMolecule::finalize()
 {
   if (m_view) {
-    m_view->GetRenderer()->RemoveActor(m_moleculeActor);
+    auto renderer = m_view->GetRenderer();
+    renderer->RemoveActor(m_moleculeActor);
+    renderer->RemoveActor(m_impostorActor);
+    renderer->RemoveObserver(m_startObserver);
   }
+  m_octree.clear();
   return true;
 }
 
 bool ModuleMolecule::setVisibility(bool val)
 {
-  m_moleculeActor->SetVisibility(val);
+  m_visible = val;
+  m_moleculeActor->SetVisibility(val &&
+                                 m_renderMode == RenderMode::BallAndStick);
+  m_impostorActor->SetVisibility(val && m_renderMode == RenderMode::Impostors);
   Module::setVisibility(val);
   return true;
 }
 
 bool ModuleMolecule::visibility() const
 {
-  return m_moleculeActor->GetVisibility();
+  return m_visible;
+}
+
+void ModuleMolecule::setRenderMode(RenderMode mode)
+{
+  m_renderMode = mode;
+  if (mode == RenderMode::Impostors) {
+    buildImpostors();
+    // Select the atoms again at the next render
+    m_cameraTime = 0;
+  } else {
+    updateBonds();
+  }
+  setVisibility(m_visible);
+}
+
+void ModuleMolecule::updateBonds()
+{
+  if (!m_molecule) {
+    return;
+  }
+  if (!m_perceiveBonds || m_molecule->GetNumberOfBonds() > 0) {
+    m_bondedMolecule = nullptr;
+    m_moleculeMapper->SetInputData(m_molecule);
+    return;
+  }
+  if (!m_bondedMolecule) {
+    m_bondedMolecule = vtkSmartPointer<vtkMolecule>::New();
+    m_bondedMolecule->DeepCopyStructure(m_molecule);
+    for (const auto& bond : perceiveBonds(m_molecule)) {
+      m_bondedMolecule->AppendBond(bond.first, bond.second, 1);
+    }
+  }
+  m_moleculeMapper->SetInputData(m_bondedMolecule);
+}
+
+void ModuleMolecule::buildImpostors()
+{
+  if (!m_molecule) {
+    return;
+  }
+  auto points = m_molecule->GetAtomicPositionArray();
+  if (m_octree.numberOfPoints() == m_molecule->GetNumberOfAtoms()) {
+    return;
+  }
+  m_octree.build(points);
+
+  vtkNew<vtkPeriodicTable> table;
+  const int elements = table->GetNumberOfElements() + 1;
+  m_elementRadii.resize(elements);
+  m_elementColors.resize(3 * elements);
+  for (int i = 0; i < elements; ++i) {
+    m_elementRadii[i] = table->GetVDWRadius(i);
+    float rgb[3];
+    table->GetDefaultRGBTuple(i, rgb);
+    for (int j = 0; j < 3; ++j) {
+      m_elementColors[3 * i + j] = static_cast<unsigned char>(rgb[j] * 255);
+    }
+  }
+
+  // Every atom of the leaves within a quarter of the size of the molecule
+  // from the camera is drawn
+  double bounds[6];
+  points->GetBounds(bounds);
+  double diagonal2 = 0.0;
+  for (int i = 0; i < 3; ++i) {
+    diagonal2 += (bounds[2 * i + 1] - bounds[2 * i]) *
+                 (bounds[2 * i + 1] - bounds[2 * i]);
+  }
+  m_detailDistance = std::sqrt(diagonal2) / 4;
+}
+
+void ModuleMolecule::updateImpostors(vtkObject*, unsigned long, void*)
+{
+  if (m_renderMode != RenderMode::Impostors || !m_visible || !m_view ||
+      !m_molecule) {
+    return;
+  }
+  auto renderer = m_view->GetRenderer();
+  auto camera = renderer->GetActiveCamera();
+  const double aspect = renderer->GetTiledAspectRatio();
+  if (camera->GetMTime() == m_cameraTime && aspect == m_aspect) {
+    return;
+  }
+  m_cameraTime = camera->GetMTime();
+  m_aspect = aspect;
+
+  double planes[24];
+  camera->GetFrustumPlanes(aspect, planes);
+  std::vector<vtkIdType> ids;
+  m_octree.select(planes, camera->GetPosition(), m_detailDistance,
+                  impostorBudget, ids);
+
+  auto atoms = m_molecule->GetAtomicPositionArray();
+  auto numbers = m_molecule->GetAtomicNumberArray();
+  const auto count = static_cast<vtkIdType>(ids.size());
+  const auto maxNumber = static_cast<unsigned short>(m_elementRadii.size() - 1);
+  vtkNew<vtkPoints> points;
+  points->SetDataType(atoms->GetDataType());
+  points->SetNumberOfPoints(count);
+  vtkNew<vtkFloatArray> radii;
+  radii->SetName("radius");
+  radii->SetNumberOfValues(count);
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("colors");
+  colors->SetNumberOfComponents(3);
+  colors->SetNumberOfTuples(count);
+  vtkSMPTools::For(0, count, [&](vtkIdType begin, vtkIdType end) {
+    double xyz[3];
+    for (vtkIdType i = begin; i < end; ++i) {
+      atoms->GetPoint(ids[i], xyz);
+      points->SetPoint(i, xyz);
+      auto number = std::min(numbers->GetValue(ids[i]), maxNumber);
+      radii->SetValue(i, m_elementRadii[number]);
+      colors->SetTypedTuple(i, &m_elementColors[3 * number]);
+    }
+  });
+
+  m_visibleAtoms->SetPoints(points);
+  m_visibleAtoms->GetPointData()->SetScalars(colors);
+  m_visibleAtoms->GetPointData()->AddArray(radii);
+}
+
+void ModuleMolecule::render()
+{
+  if (m_view) {
+    m_view->GetRenderer()->Render();
+  }
 }
 
 void ModuleMolecule::addToPanel(QWidget* panel)
@@ -127,8 +316,45 @@ void ModuleMolecule::addToPanel(QWidget* panel)
   stickSlider->setValue(m_moleculeMapper->GetBondRadius());
   layout->addRow("Stick Radius", stickSlider);
 
+  auto modeCombo = new QComboBox;
+  modeCombo->addItem("Ball and Stick",
+                     static_cast<int>(RenderMode::BallAndStick));
+  modeCombo->addItem("Impostors", static_cast<int>(RenderMode::Impostors));
+  modeCombo->setCurrentIndex(
+    modeCombo->findData(static_cast<int>(m_renderMode)));
+  modeCombo->setToolTip("Impostors draws the atoms in view as spheres, fewer "
+                        "of them far from the camera, without bonds.");
+  layout->addRow("Render Mode", modeCombo);
+
+  auto perceiveCheck = new QCheckBox;
+  perceiveCheck->setChecked(m_perceiveBonds);
+  perceiveCheck->setToolTip("Bond the atoms closer than the sum of their "
+                            "covalent radii, in ball and stick.");
+  layout->addRow("Perceive Bonds", perceiveCheck);
+
   panel->setLayout(layout);
 
+  // Bonds are only drawn in ball and stick, and only molecules without bonds
+  // of their own need them perceived
+  auto updateEnabled = [stickSlider, perceiveCheck, this]() {
+    stickSlider->setEnabled(m_renderMode == RenderMode::BallAndStick);
+    perceiveCheck->setEnabled(m_renderMode == RenderMode::BallAndStick &&
+                              m_molecule &&
+                              m_molecule->GetNumberOfBonds() == 0);
+  };
+  updateEnabled();
+
+  connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          [this, modeCombo, updateEnabled](int index) {
+            setRenderMode(
+              static_cast<RenderMode>(modeCombo->itemData(index).toInt()));
+            updateEnabled();
+            render();
+          });
+
+  connect(perceiveCheck, &QCheckBox::toggled, this,
+          &ModuleMolecule::perceiveBondsChanged);
+
   connect(ballSlider, &DoubleSliderWidget::valueEdited, this,
           &ModuleMolecule::ballRadiusChanged);
 
@@ -139,16 +365,22 @@ void ModuleMolecule::addToPanel(QWidget* panel)
 void ModuleMolecule::ballRadiusChanged(double val)
 {
   m_moleculeMapper->SetAtomicRadiusScaleFactor(val);
-  if (m_view) {
-    m_view->GetRenderer()->Render();
-  }
+  m_impostorMapper->SetScaleFactor(val);
+  render();
 }
 
 void ModuleMolecule::bondRadiusChanged(double val)
 {
   m_moleculeMapper->SetBondRadius(val);
-  if (m_view) {
-    m_view->GetRenderer()->Render();
+  render();
+}
+
+void ModuleMolecule::perceiveBondsChanged(bool perceive)
+{
+  m_perceiveBonds = perceive;
+  if (m_renderMode == RenderMode::BallAndStick) {
+    updateBonds();
+    render();
   }
 }
 
@@ -159,6 +391,8 @@ QJsonObject ModuleMolecule::serialize() const
 
   props["ballRadius"] = m_moleculeMapper->GetAtomicRadiusScaleFactor();
   props["stickRadius"] = m_moleculeMapper->GetBondRadius();
+  props["renderMode"] = static_cast<int>(m_renderMode);
+  props["perceiveBonds"] = m_perceiveBonds;
 
   json["properties"] = props;
   return json;
@@ -173,6 +407,12 @@ bool ModuleMolecule::deserialize(const QJsonObject& json)
     auto props = json["properties"].toObject();
     ballRadiusChanged(props["ballRadius"].toDouble());
     bondRadiusChanged(props["stickRadius"].toDouble());
+    m_perceiveBonds = props["perceiveBonds"].toBool(false);
+    if (props.contains("renderMode")) {
+      setRenderMode(static_cast<RenderMode>(props["renderMode"].toInt()));
+    } else {
+      setRenderMode(m_renderMode);
+    }
     return true;
   }
   return false;
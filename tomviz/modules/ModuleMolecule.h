@@ -6,11 +6,21 @@
 
 #include "Module.h"
 
+#include "MoleculeSpatialIndex.h"
+
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+
+#include <vector>
+
 class QCheckBox;
 
 class vtkActor;
 class vtkMolecule;
 class vtkMoleculeMapper;
+class vtkObject;
+class vtkPointGaussianMapper;
+class vtkPolyData;
 
 class vtkPVRenderView;
 
@@ -24,6 +34,17 @@ class ModuleMolecule : public Module
   Q_OBJECT
 
 public:
+  /**
+   * Ball and stick draws every atom and bond as geometry. Impostors draws the
+   * atoms in view as shaded point sprites, fewer of them far from the camera,
+   * and no bonds, for molecules too large for ball and stick.
+   */
+  enum class RenderMode
+  {
+    BallAndStick,
+    Impostors
+  };
+
   ModuleMolecule(QObject* parent = nullptr);
   ~ModuleMolecule() override;
 
@@ -48,17 +69,45 @@ public:
   void dataSourceMoved(double newX, double newY, double newZ) override;
   void dataSourceRotated(double newX, double newY, double newZ) override;
 
+  RenderMode renderMode() const { return m_renderMode; }
+  void setRenderMode(RenderMode mode);
+
 private slots:
   void ballRadiusChanged(double val);
   void bondRadiusChanged(double val);
+  void perceiveBondsChanged(bool perceive);
 
 private:
   Q_DISABLE_COPY(ModuleMolecule)
   void addMoleculeToView(vtkSMViewProxy* view);
+  void updateBonds();
+  void buildImpostors();
+  void updateImpostors(vtkObject*, unsigned long, void*);
+  void render();
+
   vtkWeakPointer<vtkPVRenderView> m_view;
-  vtkMolecule* m_molecule;
+  vtkMolecule* m_molecule = nullptr;
   vtkNew<vtkMoleculeMapper> m_moleculeMapper;
   vtkNew<vtkActor> m_moleculeActor;
+  bool m_visible = true;
+  RenderMode m_renderMode = RenderMode::BallAndStick;
+
+  // A copy of the molecule with the bonds perceived from the distances
+  // between the atoms, when it has none of its own
+  bool m_perceiveBonds = false;
+  vtkSmartPointer<vtkMolecule> m_bondedMolecule;
+
+  // The atoms selected in the octree as the camera moves
+  MoleculeOctree m_octree;
+  std::vector<float> m_elementRadii;
+  std::vector<unsigned char> m_elementColors;
+  double m_detailDistance = 0.0;
+  vtkNew<vtkPolyData> m_visibleAtoms;
+  vtkNew<vtkPointGaussianMapper> m_impostorMapper;
+  vtkNew<vtkActor> m_impostorActor;
+  unsigned long m_startObserver = 0;
+  vtkMTimeType m_cameraTime = 0;
+  double m_aspect = 0.0;
 };
 } // namespace tomviz
 #endif
@@ -4,12 +4,14 @@
 #include "ModulePlot.h"
 
 #include "OperatorResult.h"
+#include "PlotDecimation.h"
 #include "Utilities.h"
 
 #include <vtkAxis.h>
 #include <vtkCallbackCommand.h>
 #include <vtkChartXY.h>
 #include <vtkContextView.h>
+#include <vtkDataArray.h>
 #include <vtkFieldData.h>
 #include <vtkPlot.h>
 #include <vtkPlotLine.h>
@@ -25,10 +27,22 @@
 #include <QFormLayout>
 #include <QLineEdit>
 #include <QJsonObject>
+#include <QTimer>
 #include <QWidget>
 
+#include <limits>
+
 namespace tomviz {
 
+namespace {
+
+// The runs of rows of the x range of the view each decimated plot keeps the
+// first, lowest, highest and last rows of. Tables with fewer than four times
+// as many rows are drawn whole.
+const int plotBuckets = 2048;
+
+} // namespace
+
 ModulePlot::ModulePlot(QObject* parentObject)
   : Module(parentObject)
   , m_visible(true)
@@ -91,6 +105,10 @@ bool ModulePlot::initialize(OperatorResult* result, vtkSMViewProxy* view)
   // Detect when the result dataobject changes, i.e. when the pipeline re-runs
   m_producer->AddObserver(vtkCommand::ModifiedEvent, m_result_modified_cb);
 
+  // Decimate the plots again when the x axis is zoomed or panned
+  m_rangeObserver = m_chart->GetAxis(vtkAxis::BOTTOM)->AddObserver(
+    vtkChart::UpdateRange, this, &ModulePlot::onRangeChanged);
+
   addAllPlots();
 
   return true;
@@ -101,6 +119,10 @@ bool ModulePlot::finalize()
   if (m_producer) {
     m_producer->RemoveObserver(m_result_modified_cb);
   }
+  if (m_chart && m_rangeObserver) {
+    m_chart->GetAxis(vtkAxis::BOTTOM)->RemoveObserver(m_rangeObserver);
+    m_rangeObserver = 0;
+  }
 
   removeAllPlots();
 
@@ -142,18 +164,103 @@ void ModulePlot::addAllPlots()
   // so that multiple modules sharing a view get distinct colors.
   int colorOffset = m_chart->GetNumberOfPlots();
 
+  // Long tables are drawn through copies of their rows in view, decimated
+  auto xColumn = vtkDataArray::SafeDownCast(m_table->GetColumn(0));
+  const bool decimate =
+    xColumn && m_table->GetNumberOfRows() > 4 * plotBuckets;
+  m_xAscending = decimate && isAscending(xColumn);
+
   for (vtkIdType col = 1; col < num_cols; col++) {
     auto line = vtkSmartPointer<vtkPlotLine>::New();
     int idx = colorOffset + col - 1;
     // Golden angle spacing in hue for maximum color separation
     int hue = (idx * 137) % 360;
     QColor color = QColor::fromHsv(hue, 200, 200);
-    line->SetInputData(m_table, 0, col);
+    auto yColumn = vtkDataArray::SafeDownCast(m_table->GetColumn(col));
+    if (decimate && yColumn) {
+      auto decimated = vtkSmartPointer<vtkTable>::New();
+      vtkSmartPointer<vtkDataArray> x;
+      x.TakeReference(xColumn->NewInstance());
+      x->SetName(xColumn->GetName());
+      vtkSmartPointer<vtkDataArray> y;
+      y.TakeReference(yColumn->NewInstance());
+      y->SetName(yColumn->GetName());
+      decimated->AddColumn(x);
+      decimated->AddColumn(y);
+      line->SetInputData(decimated, 0, 1);
+      m_decimated.append(decimated);
+    } else {
+      line->SetInputData(m_table, 0, col);
+      m_decimated.append(nullptr);
+    }
     line->SetColor(color.red(), color.green(), color.blue(), 255);
     line->SetWidth(3.0);
     m_chart->AddPlot(line);
     m_plots.append(line);
   }
+
+  // Start from the whole plot, so that the axes fit all of it
+  const double whole[2] = { -std::numeric_limits<double>::infinity(),
+                            std::numeric_limits<double>::infinity() };
+  updateDecimation(whole);
+}
+
+void ModulePlot::updateDecimation(const double range[2])
+{
+  m_decimatedRange[0] = range[0];
+  m_decimatedRange[1] = range[1];
+  if (m_table == nullptr) {
+    return;
+  }
+
+  auto xColumn = vtkDataArray::SafeDownCast(m_table->GetColumn(0));
+  for (int i = 0; i < m_decimated.size(); ++i) {
+    auto decimated = m_decimated[i];
+    if (decimated == nullptr) {
+      continue;
+    }
+    auto yColumn = vtkDataArray::SafeDownCast(m_table->GetColumn(i + 1));
+    auto rows =
+      decimatePlot(xColumn, yColumn, range, m_xAscending, plotBuckets);
+
+    auto x = decimated->GetColumn(0);
+    auto y = decimated->GetColumn(1);
+    const auto count = static_cast<vtkIdType>(rows.size());
+    x->SetNumberOfTuples(count);
+    y->SetNumberOfTuples(count);
+    for (vtkIdType row = 0; row < count; ++row) {
+      x->SetTuple(row, rows[row], xColumn);
+      y->SetTuple(row, rows[row], yColumn);
+    }
+    x->Modified();
+    y->Modified();
+    decimated->Modified();
+  }
+}
+
+void ModulePlot::onRangeChanged(vtkObject*, unsigned long, void*)
+{
+  // Only the rows of plots with an ascending x depend on the range. The axis
+  // changes many times while it is dragged, and while the chart is painted,
+  // decimate once it settles.
+  if (!m_xAscending || m_decimationPending) {
+    return;
+  }
+  m_decimationPending = true;
+  QTimer::singleShot(0, this, [this]() {
+    m_decimationPending = false;
+    if (m_chart == nullptr) {
+      return;
+    }
+    auto axis = m_chart->GetAxis(vtkAxis::BOTTOM);
+    const double range[2] = { axis->GetUnscaledMinimum(),
+                              axis->GetUnscaledMaximum() };
+    if (range[0] == m_decimatedRange[0] && range[1] == m_decimatedRange[1]) {
+      return;
+    }
+    updateDecimation(range);
+    emit renderNeeded();
+  });
 }
 
 void ModulePlot::removeAllPlots()
@@ -167,6 +274,7 @@ void ModulePlot::removeAllPlots()
   }
 
   m_plots.clear();
+  m_decimated.clear();
 }
 
 bool ModulePlot::setVisibility(bool val)
@@ -8,6 +8,7 @@
 
 class vtkCallbackCommand;
 class vtkChartXY;
+class vtkObject;
 class vtkPlot;
 class vtkPVContextView;
 class vtkTable;
@@ -59,6 +60,8 @@ private:
   static void onResultModified(vtkObject* caller, long unsigned int eventId, void* clientData, void*callData);
   void addAllPlots();
   void removeAllPlots();
+  void onRangeChanged(vtkObject*, unsigned long, void*);
+  void updateDecimation(const double range[2]);
 
   Q_DISABLE_COPY(ModulePlot)
   bool m_visible;
@@ -68,6 +71,13 @@ private:
   vtkWeakPointer<vtkChartXY> m_chart;
   vtkWeakPointer<vtkTrivialProducer> m_producer;
   QList<vtkSmartPointer<vtkPlot>> m_plots;
+  // The rows of each plot drawn for the range of the x axis, null for the
+  // plots of short tables, which draw every row
+  QList<vtkSmartPointer<vtkTable>> m_decimated;
+  bool m_xAscending = false;
+  double m_decimatedRange[2] = { 0.0, 0.0 };
+  bool m_decimationPending = false;
+  unsigned long m_rangeObserver = 0;
   QPointer<QCheckBox> m_xLogCheckBox;
   QPointer<QCheckBox> m_yLogCheckBox;
   QPointer<QLineEdit> m_xLabelEdit;
@@ -6,6 +6,7 @@
 #include "ActiveObjects.h"
 #include "DataSource.h"
 #include "Utilities.h"
+#include "VolumeProbe.h"
 
 #include <pqLinePropertyWidget.h>
 #include <pqView.h>
@@ -16,6 +17,7 @@
 #include <vtkNew.h>
 #include <vtkPointData.h>
 #include <vtkRulerSourceRepresentation.h>
+#include <vtkTable.h>
 #include <vtkTrivialProducer.h>
 
 #include <vtkSMParaViewPipelineControllerWithRendering.h>
@@ -26,6 +28,7 @@
 
 #include <QJsonArray>
 #include <QLabel>
+#include <QPushButton>
 #include <QVBoxLayout>
 #include <QWidget>
 
@@ -71,6 +74,10 @@ bool ModuleRuler::initialize(DataSource* data, vtkSMViewProxy* view)
   updateUnits();
 
   connect(data, &DataSource::dataChanged, this, &ModuleRuler::updateUnits);
+  connect(data, &DataSource::dataChanged, this,
+          &ModuleRuler::endPointsUpdated);
+  connect(data, &DataSource::timeStepChanged, this,
+          &ModuleRuler::endPointsUpdated);
 
   return m_representation && m_rulerSource;
 }
@@ -118,6 +125,16 @@ void ModuleRuler::addToPanel(QWidget* panel)
           });
   layout->addWidget(label0);
   layout->addWidget(label1);
+
+  auto* saveProfile = new QPushButton("Save Line Profile...");
+  saveProfile->setEnabled(m_profile != nullptr);
+  connect(this, &ModuleRuler::newLineProfile, saveProfile,
+          [saveProfile](vtkTable* profile) {
+            saveProfile->setEnabled(profile != nullptr);
+          });
+  connect(saveProfile, &QPushButton::clicked, this,
+          &ModuleRuler::saveLineProfile);
+  layout->addWidget(saveProfile);
   panel->setLayout(layout);
 }
 
@@ -217,30 +234,34 @@ void ModuleRuler::updateShowLine(bool show)
 
 void ModuleRuler::endPointsUpdated()
 {
+  if (!m_rulerSource) {
+    return;
+  }
   double point1[3];
   double point2[3];
   vtkSMPropertyHelper(m_rulerSource, "Point1").Get(point1, 3);
   vtkSMPropertyHelper(m_rulerSource, "Point2").Get(point2, 3);
-  DataSource* source = dataSource();
-  auto* algo =
-    vtkAlgorithm::SafeDownCast(source->proxy()->GetClientSideObject());
-  if (!algo) {
-    return;
-  }
-  vtkImageData* img =
-    vtkImageData::SafeDownCast(algo->GetOutputDataObject(0));
-  if (!img) {
-    return;
-  }
-  vtkDataArray* scalars = img->GetPointData()->GetScalars();
-  if (!scalars) {
-    return;
-  }
-  vtkIdType p1 = img->FindPoint(point1);
-  vtkIdType p2 = img->FindPoint(point2);
-  double v1 = scalars->GetTuple1(p1);
-  double v2 = scalars->GetTuple1(p2);
+
+  // The probe keeps the image geometry and scalars between calls, so moving
+  // the ruler does not look anything up in the pipeline
+  const VolumeProbe& probe = dataSource()->probe();
+  // The values of end points outside of the data are left at 0
+  int ijk[3];
+  double v1 = 0;
+  double v2 = 0;
+  probe.voxelValue(point1, ijk, v1);
+  probe.voxelValue(point2, ijk, v2);
+  m_profile = probe.isValid() ? probe.lineProfile(point1, point2) : nullptr;
+
   emit newEndpointData(v1, v2);
+  emit newLineProfile(m_profile);
   renderNeeded();
 }
+
+void ModuleRuler::saveLineProfile()
+{
+  if (m_profile) {
+    tableToFile(m_profile, "csv");
+  }
+}
 } // namespace tomviz
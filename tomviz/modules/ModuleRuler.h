@@ -10,6 +10,7 @@
 
 class vtkSMSourceProxy;
 class vtkSMProxy;
+class vtkTable;
 
 class pqLinePropertyWidget;
 
@@ -39,13 +40,19 @@ public:
   void dataSourceMoved(double, double, double) override {}
   void dataSourceRotated(double, double, double) override {}
 
+  /// The values along the ruler, the distance from point 1 in the first
+  /// column and a column per component, as operators return tables to plot
+  vtkTable* lineProfile() const { return m_profile; }
+
 protected slots:
   void updateUnits();
   void updateShowLine(bool show);
   void endPointsUpdated();
+  void saveLineProfile();
 
 signals:
   void newEndpointData(double val1, double val2);
+  void newLineProfile(vtkTable* profile);
 
 protected:
   void updateColorMap() override {}
@@ -53,6 +60,7 @@ protected:
   vtkSmartPointer<vtkSMSourceProxy> m_rulerSource;
   vtkSmartPointer<vtkSMProxy> m_representation;
   QPointer<pqLinePropertyWidget> m_widget;
+  vtkSmartPointer<vtkTable> m_profile;
 
 private:
   Q_DISABLE_COPY(ModuleRuler)
@@ -14,7 +14,10 @@
 #include <vtkCamera.h>
 #include <vtkCommand.h>
 #include <vtkDataObject.h>
+#include <vtkActor.h>
 #include <vtkImageData.h>
+#include <vtkImageReslice.h>
+#include <vtkMapper.h>
 #include <vtkNew.h>
 #include <vtkNonOrthoImagePlaneWidget.h>
 #include <vtkPlane.h>
@@ -74,6 +77,10 @@ bool ModuleSlice::initialize(DataSource* data, vtkSMViewProxy* vtkView)
     onTextureInterpolateChanged(m_interpolate);
     pqCoreUtilities::connect(m_widget, vtkCommand::InteractionEvent, this,
                              SLOT(onPlaneChanged()));
+    pqCoreUtilities::connect(m_widget->GetReslice(), vtkCommand::StartEvent,
+                             this, SLOT(onResliceStarted()));
+    pqCoreUtilities::connect(m_widget->GetReslice(), vtkCommand::EndEvent,
+                             this, SLOT(onResliceFinished()));
     connect(data, &DataSource::dataChanged, this, &ModuleSlice::dataChanged);
     connect(data, &DataSource::activeScalarsChanged, this,
             &ModuleSlice::onScalarArrayChanged);
@@ -94,8 +101,14 @@ bool ModuleSlice::setupWidget(vtkSMViewProxy* vtkView)
   }
 
   m_widget = vtkSmartPointer<vtkNonOrthoImagePlaneWidget>::New();
-  m_widget->SetVoxelValueFn(
-    [this](const vtkVector3i& ijk, double v) { emit mouseOverVoxel(ijk, v); });
+  m_widget->SetVoxelValueFn([this](const vtkVector3d& point) {
+    bool ok;
+    vtkVector3i ijk;
+    double v = getVoxelValue(dataSource(), point, ijk, ok);
+    if (ok) {
+      emit mouseOverVoxel(ijk, v);
+    }
+  });
 
   // Set the interactor on the widget to be what the current
   // render window is using.
@@ -619,6 +632,50 @@ vtkDataObject* ModuleSlice::dataToExport()
   return m_widget->GetResliceOutput();
 }
 
+ModuleRenderStatistics ModuleSlice::renderStatistics() const
+{
+  ModuleRenderStatistics stats;
+  if (!visibility()) {
+    return stats;
+  }
+  // The reslice only runs again when the plane or the data change. Its last
+  // time is added to the draw time of every frame.
+  stats.renderTime = m_resliceTime;
+  if (auto* mapper = m_widget->GetTexturePlaneActor()->GetMapper()) {
+    stats.renderTime += mapper->GetTimeToDraw();
+  }
+  if (auto* slice = m_widget->GetResliceOutput()) {
+    stats.voxels = slice->GetNumberOfPoints();
+  }
+  return stats;
+}
+
+void ModuleSlice::onResliceStarted()
+{
+  m_resliceTimer.start();
+}
+
+void ModuleSlice::onResliceFinished()
+{
+  if (m_resliceTimer.isValid()) {
+    m_resliceTime = m_resliceTimer.nsecsElapsed() * 1.0e-9;
+  }
+}
+
+void ModuleSlice::setRenderQuality(double quality)
+{
+  if (!m_widget || !m_interpolate) {
+    return;
+  }
+  // Nearest neighbour sampling is cheaper to reslice while interacting, the
+  // user's interpolation setting is restored at full quality.
+  int val = quality < 0.75 ? 0 : 1;
+  if (m_widget->GetTextureInterpolate() != val) {
+    m_widget->SetTextureInterpolate(val);
+    m_widget->SetResliceInterpolate(val);
+  }
+}
+
 bool ModuleSlice::areScalarsMapped() const
 {
   return m_widget->GetMapScalars() != 0;
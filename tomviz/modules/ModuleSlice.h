@@ -9,6 +9,8 @@
 #include <vtkNew.h>
 #include <vtkSmartPointer.h>
 
+#include <QElapsedTimer>
+
 class QCheckBox;
 class QComboBox;
 class QSpinBox;
@@ -53,6 +55,9 @@ public:
 
   vtkDataObject* dataToExport() override;
 
+  ModuleRenderStatistics renderStatistics() const override;
+  void setRenderQuality(double quality) override;
+
   enum Direction
   {
     XY = 0,
@@ -123,6 +128,9 @@ private slots:
 
   void setNormalToView();
 
+  void onResliceStarted();
+  void onResliceFinished();
+
 private:
   bool setupWidget(vtkSMViewProxy* view);
 
@@ -157,6 +165,10 @@ private:
   QPointer<pqLineEdit> m_normalInputs[3];
 
   vtkNew<vtkActiveScalarsProducer> m_producer;
+
+  // Times the reslice, which the texture plane's mapper does not include
+  QElapsedTimer m_resliceTimer;
+  double m_resliceTime = 0.0;
 };
 } // namespace tomviz
 
@@ -8,11 +8,11 @@
 #include "HistogramManager.h"
 #include "ScalarsComboBox.h"
 #include "VolumeManager.h"
-#include "vtkTransferFunctionBoxItem.h"
 #include "vtkTriangleBar.h"
 
 #include <vtkColorTransferFunction.h>
 #include <vtkDataArray.h>
+#include <vtkFixedPointVolumeRayCastMapper.h>
 #include <vtkGPUVolumeRayCastMapper.h>
 #include <vtkImageClip.h>
 #include <vtkImageData.h>
@@ -37,6 +37,7 @@
 #include <QSignalBlocker>
 #include <QVBoxLayout>
 
+#include <algorithm>
 #include <cmath>
 
 namespace tomviz {
@@ -53,6 +54,50 @@ public:
   void UseJitteringOff() { GetGPUMapper()->UseJitteringOff(); }
   vtkTypeBool GetUseJittering() { return GetGPUMapper()->GetUseJittering(); }
   void SetUseJittering(vtkTypeBool b) { GetGPUMapper()->SetUseJittering(b); }
+
+  // The smart mapper delegates to one of its internal mappers, which is the
+  // one that times the draw.
+  double GetRenderTime()
+  {
+    if (GetLastUsedRenderMode() == vtkSmartVolumeMapper::GPURenderMode) {
+      return GetGPUMapper()->GetTimeToDraw();
+    }
+    return RayCastMapper ? RayCastMapper->GetTimeToDraw() : 0.0;
+  }
+
+  // Trade image quality for speed, used by the frame budget mode. Quality 1
+  // restores the settings the mapper had before.
+  void SetRenderQuality(double quality, double spacing)
+  {
+    if (quality >= 1.0) {
+      if (Reduced) {
+        SetAutoAdjustSampleDistances(SavedAutoAdjust);
+        SetSampleDistance(SavedSampleDistance);
+        GetGPUMapper()->SetImageSampleDistance(SavedImageSampleDistance);
+        Reduced = false;
+      }
+      return;
+    }
+
+    if (!Reduced) {
+      SavedAutoAdjust = GetAutoAdjustSampleDistances();
+      SavedSampleDistance = GetSampleDistance();
+      SavedImageSampleDistance = GetGPUMapper()->GetImageSampleDistance();
+      Reduced = true;
+    }
+    // Split the reduction between fewer rays and fewer samples per ray
+    auto factor = 1.0 / std::sqrt(quality);
+    SetAutoAdjustSampleDistances(0);
+    SetSampleDistance(static_cast<float>(0.5 * spacing * factor));
+    GetGPUMapper()->SetImageSampleDistance(
+      static_cast<float>(std::min(factor, 4.0)));
+  }
+
+private:
+  bool Reduced = false;
+  vtkTypeBool SavedAutoAdjust = 1;
+  float SavedSampleDistance = 1.0f;
+  float SavedImageSampleDistance = 1.0f;
 };
 
 vtkStandardNewMacro(SmartVolumeMapper)
@@ -70,13 +115,7 @@ vtkStandardNewMacro(SmartVolumeMapper)
             // Force the transfer function 2D to update.
             if (image ==
                 vtkImageData::SafeDownCast(dataSource()->dataObject())) {
-              auto colorMap = vtkColorTransferFunction::SafeDownCast(
-                this->colorMap()->GetClientSideObject());
-              auto opacityMap = vtkPiecewiseFunction::SafeDownCast(
-                this->opacityMap()->GetClientSideObject());
-              vtkTransferFunctionBoxItem::rasterTransferFunction2DBox(
-                histogram2D, *this->transferFunction2DBox(),
-                transferFunction2D(), colorMap, opacityMap);
+              this->rasterTransferFunction2D(histogram2D);
             }
             // Update the volume mapper.
             this->updateColorMap();
@@ -406,13 +445,7 @@ void ModuleVolume::updateColorMap()
         // function.
         if (auto histogram2D =
               HistogramManager::instance().getHistogram2D(image)) {
-          auto colorMap = vtkColorTransferFunction::SafeDownCast(
-            this->colorMap()->GetClientSideObject());
-          auto opacityMap = vtkPiecewiseFunction::SafeDownCast(
-            this->opacityMap()->GetClientSideObject());
-          vtkTransferFunctionBoxItem::rasterTransferFunction2DBox(
-            histogram2D, *this->transferFunction2DBox(), transferFunction2D(),
-            colorMap, opacityMap);
+          rasterTransferFunction2D(histogram2D);
           propertyMode = vtkVolumeProperty::TF_2D;
           m_volumeProperty->SetTransferFunction2D(transferFunction2D());
         }
@@ -430,6 +463,17 @@ void ModuleVolume::updateColorMap()
   vtkObject::SafeDownCast(colorMap()->GetClientSideObject())->Modified();
 }
 
+void ModuleVolume::rasterTransferFunction2D(vtkImageData* histogram2D)
+{
+  auto colorMap = vtkColorTransferFunction::SafeDownCast(
+    this->colorMap()->GetClientSideObject());
+  auto opacityMap = vtkPiecewiseFunction::SafeDownCast(
+    this->opacityMap()->GetClientSideObject());
+  m_transfer2DRaster.setHistogram(histogram2D);
+  m_transfer2DRaster.setBox(0, *transferFunction2DBox(), colorMap, opacityMap);
+  m_transfer2DRaster.update(transferFunction2D());
+}
+
 bool ModuleVolume::finalize()
 {
   if (m_view) {
@@ -455,6 +499,40 @@ bool ModuleVolume::visibility() const
   return m_volume->GetVisibility() != 0;
 }
 
+ModuleRenderStatistics ModuleVolume::renderStatistics() const
+{
+  ModuleRenderStatistics stats;
+  if (!visibility()) {
+    return stats;
+  }
+
+  stats.renderTime = m_volumeMapper->GetRenderTime();
+  auto image =
+    vtkImageData::SafeDownCast(m_volumeMapper->GetInputDataObject(0, 0));
+  if (image) {
+    stats.voxels = image->GetNumberOfPoints();
+  }
+  return stats;
+}
+
+void ModuleVolume::setRenderQuality(double quality)
+{
+  quality = std::max(0.1, std::min(quality, 1.0));
+  if (quality == m_renderQuality) {
+    return;
+  }
+  m_renderQuality = quality;
+
+  double spacing = 1.0;
+  auto image =
+    vtkImageData::SafeDownCast(m_volumeMapper->GetInputDataObject(0, 0));
+  if (image) {
+    auto* s = image->GetSpacing();
+    spacing = std::min(s[0], std::min(s[1], s[2]));
+  }
+  m_volumeMapper->SetRenderQuality(quality, spacing);
+}
+
 QJsonObject ModuleVolume::serialize() const
 {
   auto json = Module::serialize();
@@ -5,6 +5,7 @@
 #define tomvizModuleVolume_h
 
 #include "Module.h"
+#include "TransferFunction2DRaster.h"
 
 #include <vtkNew.h>
 #include <vtkWeakPointer.h>
@@ -70,6 +71,9 @@ public:
 
   bool updateClippingPlane(vtkPlane* plane, bool newFilter) override;
 
+  ModuleRenderStatistics renderStatistics() const override;
+  void setRenderQuality(double quality) override;
+
   double solidity() const;
 
   vtkVolume* getVolume();
@@ -90,6 +94,7 @@ private:
   std::array<double, 2>& rangeForComponent(const QString& component);
   std::vector<std::array<double, 2>> activeRgbaRanges();
   void resetComponentNames();
+  void rasterTransferFunction2D(vtkImageData* histogram2D);
 
   vtkWeakPointer<vtkPVRenderView> m_view;
   vtkNew<vtkVolume> m_volume;
@@ -100,10 +105,14 @@ private:
   QPointer<ModuleVolumeWidget> m_controllers;
   QPointer<ScalarsComboBox> m_scalarsCombo;
 
+  // The layer of the 2D transfer function box, redrawn where it moved
+  TransferFunction2DRaster m_transfer2DRaster;
+
   // Data object used for mapping 3-components to Rgba
   vtkNew<vtkImageData> m_rgbaDataObject;
 
   bool m_useRgbaMapping = false;
+  double m_renderQuality = 1.0;
   bool m_rgbaMappingCombineComponents = true;
   QString m_rgbaMappingComponent;
 
@@ -13,6 +13,7 @@
 #include "SnapshotOperator.h"
 #include "TranslateAlignOperator.h"
 #include "TransposeDataOperator.h"
+#include "Utilities.h"
 #include <QDebug>
 #include <QThread>
 
@@ -132,11 +133,38 @@ void OperatorFactory::registerPythonOperator(
   info.requiresFib = requiresFib;
   info.json = json;
 
+  QMutexLocker lock(&m_pythonOperatorsMutex);
   m_pythonOperators.append(info);
 }
 
-const QList<PythonOperatorInfo>& OperatorFactory::registeredPythonOperators()
+void OperatorFactory::registerPythonOperatorScript(
+  const QString& label, const QString& scriptName, bool requiresTiltSeries,
+  bool requiresVolume, bool requiresFib, bool hasJson)
 {
+  PythonOperatorInfo info;
+  info.label = label;
+  info.scriptName = scriptName;
+  info.requiresTiltSeries = requiresTiltSeries;
+  info.requiresVolume = requiresVolume;
+  info.requiresFib = requiresFib;
+  info.hasJson = hasJson;
+
+  QMutexLocker lock(&m_pythonOperatorsMutex);
+  m_pythonOperators.append(info);
+}
+
+QList<PythonOperatorInfo> OperatorFactory::registeredPythonOperators()
+{
+  QMutexLocker lock(&m_pythonOperatorsMutex);
+  // Read any scripts that were registered by name
+  for (auto& info : m_pythonOperators) {
+    if (!info.scriptName.isEmpty() && info.source.isEmpty()) {
+      info.source = readInPythonScript(info.scriptName);
+      if (info.hasJson) {
+        info.json = readInJSONDescription(info.scriptName);
+      }
+    }
+  }
   return m_pythonOperators;
 }
 
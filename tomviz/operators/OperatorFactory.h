@@ -4,6 +4,7 @@
 #ifndef tomvizOperatorFactory_h
 #define tomvizOperatorFactory_h
 
+#include <QMutex>
 #include <QObject>
 
 #include "DataSource.h"
@@ -19,6 +20,9 @@ struct PythonOperatorInfo
   bool requiresVolume;
   bool requiresFib;
   QString json;
+  // Name of a bundled script whose source and JSON are read on demand
+  QString scriptName;
+  bool hasJson = false;
 };
 
 class OperatorFactory
@@ -45,14 +49,26 @@ public:
                               bool requiresTiltSeries, bool requiresVolume,
                               bool requiresFib, const QString& json);
 
-  /// Returns the list of register Python operators
-  const QList<PythonOperatorInfo>& registeredPythonOperators();
+  /// Register a bundled Python operator by script name, its source and JSON
+  /// description are only read when registeredPythonOperators() is called.
+  void registerPythonOperatorScript(const QString& label,
+                                    const QString& scriptName,
+                                    bool requiresTiltSeries,
+                                    bool requiresVolume, bool requiresFib,
+                                    bool hasJson);
+
+  /// Returns the list of register Python operators. This may be called from
+  /// any thread, the scripts registered by name are read once.
+  QList<PythonOperatorInfo> registeredPythonOperators();
 
 private:
   OperatorFactory();
   ~OperatorFactory();
   Q_DISABLE_COPY(OperatorFactory)
 
+  // Guards m_pythonOperators, which is registered on the GUI thread and may
+  // be read from the pipeline threads
+  QMutex m_pythonOperatorsMutex;
   QList<PythonOperatorInfo> m_pythonOperators;
 };
 } // namespace tomviz
@@ -14,6 +14,7 @@
 
 #include "ActiveObjects.h"
 #include "CustomPythonOperatorWidget.h"
+#include "DataChangeScheduler.h"
 #include "DataSource.h"
 #include "EditOperatorWidget.h"
 #include "ModuleManager.h"
@@ -845,10 +846,11 @@ void OperatorPython::updateChildDataSource(vtkSmartPointer<vtkDataObject> data)
   }
 
   // Now deep copy the new data to the child source data if needed
-  dataSource->copyData(data);
-  emit dataSource->dataChanged();
-  emit dataSource->dataPropertiesChanged();
-  ActiveObjects::instance().renderAllViews();
+  dataSource->copyData(data, false);
+
+  // Operators may push data many times per second, so the data source is only
+  // marked modified (and the views rendered) once per frame.
+  DataChangeScheduler::instance().schedule(dataSource);
 }
 
 void OperatorPython::setOperatorResult(const QString& name,
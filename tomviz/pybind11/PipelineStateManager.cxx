@@ -155,3 +155,8 @@ bool PipelineStateManager::pipelinePaused(const std::string& dataSourcePath)
 {
   return m_proxy->pipelinePaused(dataSourcePath);
 }
+
+std::string PipelineStateManager::renderStatistics(int viewId)
+{
+  return m_proxy->renderStatistics(viewId);
+}
@@ -51,6 +51,7 @@ public:
   void resumePipeline(const std::string& dataSourcePath);
   void executePipeline(const std::string& dataSourcePath);
   bool pipelinePaused(const std::string& dataSourcePath);
+  std::string renderStatistics(int viewId = -1);
 
 private:
   tomviz::PipelineProxyBase* m_proxy = nullptr;
@@ -78,6 +78,8 @@ PYBIND11_MODULE(_wrapping, m)
     .def("pause_pipeline", &PipelineStateManager::pausePipeline)
     .def("resume_pipeline", &PipelineStateManager::resumePipeline)
     .def("execute_pipeline", &PipelineStateManager::executePipeline)
-    .def("pipeline_paused", &PipelineStateManager::pipelinePaused);
+    .def("pipeline_paused", &PipelineStateManager::pipelinePaused)
+    .def("render_statistics", &PipelineStateManager::renderStatistics,
+         py::arg("view_id") = -1);
 
 }
@@ -0,0 +1,362 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "ArrayOps.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+// An element moved as a whole
+template <int Size>
+struct Element
+{
+  unsigned char bytes[Size];
+};
+
+// Call f with a null pointer to elements of elementSize bytes
+template <typename Function>
+void dispatchSize(int elementSize, Function&& f)
+{
+  switch (elementSize) {
+    case 1:
+      f(static_cast<Element<1>*>(nullptr));
+      break;
+    case 2:
+      f(static_cast<Element<2>*>(nullptr));
+      break;
+    case 4:
+      f(static_cast<Element<4>*>(nullptr));
+      break;
+    case 8:
+      f(static_cast<Element<8>*>(nullptr));
+      break;
+    case 16:
+      f(static_cast<Element<16>*>(nullptr));
+      break;
+    default:
+      throw std::invalid_argument("Unsupported element size");
+  }
+}
+
+// The source index along an axis of each padded index, -1 for zeros
+std::vector<int> padIndices(int size, int before, int after, PadMode mode)
+{
+  std::vector<int> indices(static_cast<size_t>(size) + before + after);
+  for (int i = 0; i < static_cast<int>(indices.size()); ++i) {
+    int j = i - before;
+    if (j < 0 || j >= size) {
+      switch (mode) {
+        case PadMode::Constant:
+          j = -1;
+          break;
+        case PadMode::Edge:
+          j = std::min(std::max(j, 0), size - 1);
+          break;
+        case PadMode::Wrap:
+          j = (j % size + size) % size;
+          break;
+      }
+    }
+    indices[i] = j;
+  }
+  return indices;
+}
+
+template <typename E>
+void pad(const E* volume, const int dims[3], const int before[3],
+         const int after[3], PadMode mode, E* result)
+{
+  std::vector<int> indices[3];
+  for (int i = 0; i < 3; ++i) {
+    indices[i] = padIndices(dims[i], before[i], after[i], mode);
+  }
+  const int nx = static_cast<int>(indices[0].size());
+  const int ny = static_cast<int>(indices[1].size());
+  const int nz = static_cast<int>(indices[2].size());
+  const E zero{};
+  tbb::parallel_for(0, nz, [&](int z) {
+    for (int y = 0; y < ny; ++y) {
+      E* out = result + nx * (y + static_cast<int64_t>(ny) * z);
+      int sy = indices[1][y];
+      int sz = indices[2][z];
+      if (sy < 0 || sz < 0) {
+        std::fill(out, out + nx, zero);
+        continue;
+      }
+      const E* line =
+        volume + dims[0] * (sy + static_cast<int64_t>(dims[1]) * sz);
+      std::memcpy(out + before[0], line, sizeof(E) * dims[0]);
+      for (int x = 0; x < before[0]; ++x) {
+        int sx = indices[0][x];
+        out[x] = sx < 0 ? zero : line[sx];
+      }
+      for (int x = before[0] + dims[0]; x < nx; ++x) {
+        int sx = indices[0][x];
+        out[x] = sx < 0 ? zero : line[sx];
+      }
+    }
+  });
+}
+
+template <typename E>
+void removeSlices(const E* volume, const int dims[3], int axis, int first,
+                  int last, E* result)
+{
+  const int removed = last - first + 1;
+  int out[3] = { dims[0], dims[1], dims[2] };
+  out[axis] -= removed;
+  auto source = [&](int i) { return i < first ? i : i + removed; };
+  tbb::parallel_for(0, out[2], [&](int z) {
+    int sz = axis == 2 ? source(z) : z;
+    for (int y = 0; y < out[1]; ++y) {
+      int sy = axis == 1 ? source(y) : y;
+      const E* line =
+        volume + dims[0] * (sy + static_cast<int64_t>(dims[1]) * sz);
+      E* outLine = result + out[0] * (y + static_cast<int64_t>(out[1]) * z);
+      if (axis == 0) {
+        std::memcpy(outLine, line, sizeof(E) * first);
+        std::memcpy(outLine + first, line + last + 1,
+                    sizeof(E) * (dims[0] - last - 1));
+      } else {
+        std::memcpy(outLine, line, sizeof(E) * dims[0]);
+      }
+    }
+  });
+}
+
+template <typename E>
+void swap(const E* volume, const int dims[3], int axis1, int axis2,
+          E* result)
+{
+  // The axis of the volume along each axis of the result, and its stride
+  int axes[3] = { 0, 1, 2 };
+  std::swap(axes[axis1], axes[axis2]);
+  const int64_t volumeStrides[3] = { 1, dims[0],
+                                     static_cast<int64_t>(dims[0]) * dims[1] };
+  int out[3];
+  int64_t strides[3];
+  for (int i = 0; i < 3; ++i) {
+    out[i] = dims[axes[i]];
+    strides[i] = volumeStrides[axes[i]];
+  }
+  const int64_t plane = static_cast<int64_t>(out[0]) * out[1];
+
+  if (axes[0] == 0) {
+    // Lines along x are moved whole
+    tbb::parallel_for(0, out[2], [&](int z) {
+      for (int y = 0; y < out[1]; ++y) {
+        std::memcpy(result + out[0] * y + plane * z,
+                    volume + strides[1] * y + strides[2] * z,
+                    sizeof(E) * out[0]);
+      }
+    });
+    return;
+  }
+
+  // The axis of the result along x of the volume, and the other one. Tiles
+  // of both x axes are transposed, so that reads and writes stay in cache.
+  const int m = axes[1] == 0 ? 1 : 2;
+  const int r = 3 - m;
+  const int64_t outStrides[3] = { 1, out[0], plane };
+  const int tile = 32;
+  tbb::parallel_for(0, out[r], [&](int k) {
+    const E* in = volume + strides[r] * k;
+    E* o = result + outStrides[r] * k;
+    for (int j0 = 0; j0 < out[m]; j0 += tile) {
+      const int j1 = std::min(j0 + tile, out[m]);
+      for (int i0 = 0; i0 < out[0]; i0 += tile) {
+        const int i1 = std::min(i0 + tile, out[0]);
+        for (int j = j0; j < j1; ++j) {
+          for (int i = i0; i < i1; ++i) {
+            o[i + outStrides[m] * j] = in[strides[0] * i + j];
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename U>
+void flip(U* values, int64_t size)
+{
+  const U bit = static_cast<U>(U(1) << (8 * sizeof(U) - 1));
+  tbb::parallel_for(tbb::blocked_range<int64_t>(0, size),
+                    [&](const tbb::blocked_range<int64_t>& r) {
+                      for (auto i = r.begin(); i != r.end(); ++i) {
+                        values[i] ^= bit;
+                      }
+                    });
+}
+
+std::vector<double> hann(int size)
+{
+  std::vector<double> window(size, 1.0);
+  for (int i = 0; size > 1 && i < size; ++i) {
+    window[i] = 0.5 - 0.5 * std::cos(2.0 * pi * i / (size - 1));
+  }
+  return window;
+}
+
+} // namespace
+
+template <typename T>
+void maskOutsideCircle(T* volume, const int dims[3], int axis,
+                       const double center[2], double radius, T value)
+{
+  const int a1 = axis == 0 ? 1 : 0;
+  const int a2 = axis == 2 ? 1 : 2;
+  const int n1 = dims[a1];
+  const int n2 = dims[a2];
+  std::vector<unsigned char> outside(static_cast<size_t>(n1) * n2, 1);
+  if (radius > 0.0) {
+    for (int j = 0; j < n2; ++j) {
+      for (int i = 0; i < n1; ++i) {
+        double d1 = i - center[0];
+        double d2 = j - center[1];
+        outside[i + static_cast<size_t>(n1) * j] =
+          d1 * d1 + d2 * d2 >= radius * radius;
+      }
+    }
+  }
+
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    int index[3];
+    index[2] = z;
+    for (int y = 0; y < dims[1]; ++y) {
+      index[1] = y;
+      T* line = volume + plane * z + static_cast<int64_t>(dims[0]) * y;
+      for (int x = 0; x < dims[0]; ++x) {
+        index[0] = x;
+        if (outside[index[a1] + static_cast<size_t>(n1) * index[a2]]) {
+          line[x] = value;
+        }
+      }
+    }
+  });
+}
+
+template <typename T>
+T minimum(const T* values, int64_t size)
+{
+  return tbb::parallel_reduce(
+    tbb::blocked_range<int64_t>(0, size), values[0],
+    [&](const tbb::blocked_range<int64_t>& r, T value) {
+      for (auto i = r.begin(); i != r.end(); ++i) {
+        value = std::min(value, values[i]);
+      }
+      return value;
+    },
+    [](T a, T b) { return std::min(a, b); });
+}
+
+template <typename T>
+void hannWindow(T* volume, const int dims[3])
+{
+  const std::vector<double> wx = hann(dims[0]);
+  const std::vector<double> wy = hann(dims[1]);
+  const std::vector<double> wz = hann(dims[2]);
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    for (int y = 0; y < dims[1]; ++y) {
+      T* line = volume + plane * z + static_cast<int64_t>(dims[0]) * y;
+      for (int x = 0; x < dims[0]; ++x) {
+        // Each product is rounded to single precision, as the float32
+        // array is multiplied by each window in turn
+        float v = static_cast<float>(line[x]);
+        v = static_cast<float>(v * wx[x]);
+        v = static_cast<float>(v * wy[y]);
+        v = static_cast<float>(v * wz[z]);
+        line[x] = static_cast<T>(v);
+      }
+    }
+  });
+}
+
+void padVolume(const void* volume, const int dims[3], int elementSize,
+               const int before[3], const int after[3], PadMode mode,
+               void* result)
+{
+  dispatchSize(elementSize, [&](auto* tag) {
+    using E = std::remove_pointer_t<decltype(tag)>;
+    pad(static_cast<const E*>(volume), dims, before, after, mode,
+        static_cast<E*>(result));
+  });
+}
+
+void deleteSlices(const void* volume, const int dims[3], int elementSize,
+                  int axis, int first, int last, void* result)
+{
+  dispatchSize(elementSize, [&](auto* tag) {
+    using E = std::remove_pointer_t<decltype(tag)>;
+    removeSlices(static_cast<const E*>(volume), dims, axis, first, last,
+                 static_cast<E*>(result));
+  });
+}
+
+void swapAxes(const void* volume, const int dims[3], int elementSize,
+              int axis1, int axis2, void* result)
+{
+  dispatchSize(elementSize, [&](auto* tag) {
+    using E = std::remove_pointer_t<decltype(tag)>;
+    swap(static_cast<const E*>(volume), dims, axis1, axis2,
+         static_cast<E*>(result));
+  });
+}
+
+void flipSignBits(void* values, int64_t size, int elementSize)
+{
+  switch (elementSize) {
+    case 1:
+      flip(static_cast<uint8_t*>(values), size);
+      break;
+    case 2:
+      flip(static_cast<uint16_t*>(values), size);
+      break;
+    case 4:
+      flip(static_cast<uint32_t*>(values), size);
+      break;
+    case 8:
+      flip(static_cast<uint64_t*>(values), size);
+      break;
+    default:
+      throw std::invalid_argument("Unsupported integer size");
+  }
+}
+
+#define TOMVIZ_ARRAY_OPS_INSTANTIATE(T)                                       \
+  template void maskOutsideCircle<T>(T*, const int[3], int, const double[2], \
+                                     double, T);                             \
+  template T minimum<T>(const T*, int64_t);                                  \
+  template void hannWindow<T>(T*, const int[3]);
+
+TOMVIZ_ARRAY_OPS_INSTANTIATE(int8_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(uint8_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(int16_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(uint16_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(int32_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(uint32_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(int64_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(uint64_t)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(float)
+TOMVIZ_ARRAY_OPS_INSTANTIATE(double)
+
+#undef TOMVIZ_ARRAY_OPS_INSTANTIATE
+
+} // namespace native
+} // namespace tomviz
@@ -0,0 +1,67 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeArrayOps_h
+#define tomvizNativeArrayOps_h
+
+#include <cstdint>
+
+namespace tomviz {
+namespace native {
+
+// The volumes are Fortran ordered dims[0] x dims[1] x dims[2] arrays. The
+// element-wise operations work in place and are instantiated for the integral
+// types of 1 to 8 bytes, float and double. The operations that change the
+// shape only move elements, of 1, 2, 4, 8 or 16 bytes, with one copy into the
+// result.
+
+/// Set the voxels outside a cylinder along axis to value, in place. The
+/// center is along the other two axes, in increasing order, and the voxels at
+/// a distance of at least radius from it are set, all of them if radius is
+/// not positive.
+template <typename T>
+void maskOutsideCircle(T* volume, const int dims[3], int axis,
+                       const double center[2], double radius, T value);
+
+/// The minimum of size values, in parallel.
+template <typename T>
+T minimum(const T* values, int64_t size);
+
+/// Multiply the volume by a separable 3D Hann window in place, in single
+/// precision and along x, then y, then z as HannWindow3D.py does.
+template <typename T>
+void hannWindow(T* volume, const int dims[3]);
+
+enum class PadMode
+{
+  // Zeros
+  Constant,
+  // The nearest edge value
+  Edge,
+  // The volume repeated periodically
+  Wrap
+};
+
+/// Pad the volume by before[i] and after[i] elements along each axis, as
+/// numpy.pad() does, into a result of (dims[i] + before[i] + after[i]).
+void padVolume(const void* volume, const int dims[3], int elementSize,
+               const int before[3], const int after[3], PadMode mode,
+               void* result);
+
+/// Copy the volume without its slices first to last (inclusive) along axis.
+void deleteSlices(const void* volume, const int dims[3], int elementSize,
+                  int axis, int first, int last, void* result);
+
+/// Copy the volume with two of its axes swapped, in cache sized tiles when
+/// the axis along x is one of them.
+void swapAxes(const void* volume, const int dims[3], int elementSize,
+              int axis1, int axis2, void* result);
+
+/// Flip the sign bit of size integers of elementSize bytes in place, so that
+/// signed values read as unsigned ones offset by half of their range.
+void flipSignBits(void* values, int64_t size, int elementSize);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
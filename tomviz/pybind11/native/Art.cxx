@@ -0,0 +1,95 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Art.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace tomviz {
+namespace native {
+
+ArtReconstruction::ArtReconstruction(const float* tiltSeries, int nslice,
+                                     int nray,
+                                     const std::vector<double>& angles)
+  : m_nslice(nslice), m_nray(nray), m_rays(nray, angles, nray)
+{
+  const int64_t rows = m_rays.numberOfRows();
+  const int64_t pixels = static_cast<int64_t>(nray) * nray;
+  m_measured.resize(nslice * rows);
+  m_recon.assign(nslice * pixels, 0.0f);
+
+  // Row p * nray + r of a slice measures ray r of projection p
+  tbb::parallel_for(0, nslice, [&](int s) {
+    float* b = m_measured.data() + s * rows;
+    for (int64_t p = 0; p < m_rays.numberOfAngles(); ++p) {
+      for (int64_t r = 0; r < nray; ++r) {
+        b[p * nray + r] = tiltSeries[s + nslice * (r + nray * p)];
+      }
+    }
+  });
+}
+
+void ArtReconstruction::iterate(float beta, int first, int last,
+                                const int64_t* order)
+{
+  const int64_t rows = m_rays.numberOfRows();
+  const int64_t pixels = static_cast<int64_t>(m_nray) * m_nray;
+  std::vector<int64_t> sequential;
+  if (!order) {
+    sequential.resize(rows);
+    std::iota(sequential.begin(), sequential.end(), 0);
+    order = sequential.data();
+  }
+
+  first = std::max(first, 0);
+  last = std::min(last, m_nslice);
+  tbb::parallel_for(first, last, [&](int s) {
+    const float* b = m_measured.data() + s * rows;
+    float* f = m_recon.data() + s * pixels;
+    for (int64_t i = 0; i < rows; ++i) {
+      const int64_t j = order[i];
+      float norm = m_rays.normSquared(j);
+      if (norm <= 0.0f) {
+        continue;
+      }
+      float a = beta * (b[j] - m_rays.project(j, f)) / norm;
+      const int32_t* p = m_rays.pixels(j);
+      const float* l = m_rays.lengths(j);
+      for (int64_t k = 0, n = m_rays.size(j); k < n; ++k) {
+        f[p[k]] += a * l[k];
+      }
+    }
+  });
+}
+
+void ArtReconstruction::positivity()
+{
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, m_recon.size()),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (auto i = r.begin(); i != r.end(); ++i) {
+                        m_recon[i] = std::max(m_recon[i], 0.0f);
+                      }
+                    });
+}
+
+void ArtReconstruction::reconstruction(float* volume) const
+{
+  const int64_t n = m_nray;
+  const int64_t nslice = m_nslice;
+  // Pixel (row, column) of slice s is voxel (s, row, column)
+  tbb::parallel_for(int64_t(0), n, [&](int64_t column) {
+    for (int64_t row = 0; row < n; ++row) {
+      float* out = volume + nslice * (row + n * column);
+      for (int64_t s = 0; s < nslice; ++s) {
+        out[s] = m_recon[s * n * n + row * n + column];
+      }
+    }
+  });
+}
+
+} // namespace native
+} // namespace tomviz
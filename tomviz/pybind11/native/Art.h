@@ -0,0 +1,58 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeArt_h
+#define tomvizNativeArt_h
+
+#include "ParallelRays.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+/// Algebraic Reconstruction Technique (Kaczmarz) for a parallel beam tilt
+/// series tilted about the x axis. Every slice along x is reconstructed
+/// independently, so the slices are updated in parallel, each one ray at a
+/// time in the order Recon_ART.py chooses.
+class ArtReconstruction
+{
+public:
+  /// tiltSeries is a Fortran ordered nslice x nray x nproj volume, and
+  /// angles holds the nproj tilt angles in degrees.
+  ArtReconstruction(const float* tiltSeries, int nslice, int nray,
+                    const std::vector<double>& angles);
+
+  int nslice() const { return m_nslice; }
+  int nray() const { return m_nray; }
+  /// The number of rays, row p * nray + r measuring ray r of projection p
+  int64_t numberOfRows() const { return m_rays.numberOfRows(); }
+
+  /// Run one pass over all the rays for slices [first, last), in row order
+  /// or, if order is given, in the order of its numberOfRows() rows. The
+  /// same order is used for every slice.
+  void iterate(float beta, int first, int last,
+               const int64_t* order = nullptr);
+
+  /// Set the negative voxels to zero
+  void positivity();
+
+  /// Copy the reconstruction into a Fortran ordered nslice x nray x nray
+  /// volume.
+  void reconstruction(float* volume) const;
+
+private:
+  int m_nslice;
+  int m_nray;
+  ParallelRays m_rays;
+  // Per slice, in ray order
+  std::vector<float> m_measured;
+  // Per slice, row major nray x nray images
+  std::vector<float> m_recon;
+};
+
+} // namespace native
+} // namespace tomviz
+
+#endif
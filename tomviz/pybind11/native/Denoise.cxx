@@ -0,0 +1,353 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Denoise.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+// Sum function(z) over the z slabs of a volume, in parallel
+template <typename Function>
+double sumOverSlabs(int nz, Function function)
+{
+  return tbb::parallel_reduce(
+    tbb::blocked_range<int>(0, nz), 0.0,
+    [&](const tbb::blocked_range<int>& r, double sum) {
+      for (int z = r.begin(); z != r.end(); ++z) {
+        sum += function(z);
+      }
+      return sum;
+    },
+    std::plus<double>());
+}
+
+// TVDerivative() of TV_Filter.py at row y of a nx x ny slice, before its
+// normalization. Returns the sum of the squares.
+double sliceVariationDerivative(const double* f, int nx, int ny, int y,
+                                double* derivative)
+{
+  // The slice is zero outside of its bounds, as np.pad() makes it
+  auto at = [&](int x, int yy) {
+    return x < 0 || x >= nx || yy < 0 || yy >= ny ? 0.0 : f[x + nx * yy];
+  };
+  double sum = 0.0;
+  for (int x = 0; x < nx; ++x) {
+    const double c = f[x + static_cast<int64_t>(nx) * y];
+    const double nextX = at(x + 1, y);
+    const double nextY = at(x, y + 1);
+    const double previousX = at(x - 1, y);
+    const double previousY = at(x, y - 1);
+    const double v1 = (2 * (c - nextY) + 2 * (c - nextX)) /
+                      std::sqrt(1e-8 + (c - nextY) * (c - nextY) +
+                                (c - nextX) * (c - nextX));
+    const double a = previousY - at(x + 1, y - 1);
+    const double v2 =
+      2 * (previousY - c) /
+      std::sqrt(1e-8 + (previousY - c) * (previousY - c) + a * a);
+    const double b = previousX - at(x - 1, y + 1);
+    const double v3 =
+      2 * (previousX - c) /
+      std::sqrt(1e-8 + (previousX - c) * (previousX - c) + b * b);
+    derivative[x] = v1 - v2 - v3;
+    sum += derivative[x] * derivative[x];
+  }
+  return sum;
+}
+
+} // namespace
+
+void descendSliceVariation(double* volume, const int dims[3],
+                           const double* stepSizes, int steps)
+{
+  const int nx = dims[0];
+  const int ny = dims[1];
+  const int64_t plane = static_cast<int64_t>(nx) * ny;
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    double* f = volume + z * plane;
+    std::vector<double> derivative(plane);
+    for (int step = 0; step < steps; ++step) {
+      const double sum = tbb::parallel_reduce(
+        tbb::blocked_range<int>(0, ny), 0.0,
+        [&](const tbb::blocked_range<int>& r, double partial) {
+          for (int y = r.begin(); y != r.end(); ++y) {
+            partial += sliceVariationDerivative(
+              f, nx, ny, y, derivative.data() + static_cast<int64_t>(nx) * y);
+          }
+          return partial;
+        },
+        std::plus<double>());
+      if (!(sum > 0.0)) {
+        return;
+      }
+      const double norm = std::sqrt(sum);
+      const double stepSize = stepSizes[z];
+      tbb::parallel_for(int64_t(0), plane, [&](int64_t i) {
+        f[i] -= stepSize * (derivative[i] / norm);
+      });
+    }
+  });
+}
+
+TotalVariationDenoise::TotalVariationDenoise(const float* volume,
+                                             const int dims[3], float weight,
+                                             double eps)
+  : m_weight(weight), m_eps(eps)
+{
+  std::copy(dims, dims + 3, m_dims);
+  const size_t size = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+  m_input.assign(volume, volume + size);
+  m_output = m_input;
+  for (auto& dual : m_dual) {
+    dual.assign(size, 0.0f);
+  }
+}
+
+int TotalVariationDenoise::iterate(int iterations)
+{
+  const double size = static_cast<double>(m_input.size());
+  for (int i = 0; i < iterations; ++i) {
+    if (m_converged) {
+      return i;
+    }
+
+    double divergence = m_iteration > 0 ? updateVolume() : 0.0;
+    double variation = updateDual();
+    double energy = (divergence + m_weight * variation) / size;
+
+    if (m_iteration == 0) {
+      m_initialEnergy = m_previousEnergy = energy;
+    } else if (std::abs(m_previousEnergy - energy) < m_eps * m_initialEnergy) {
+      m_converged = true;
+    } else {
+      m_previousEnergy = energy;
+    }
+    ++m_iteration;
+  }
+  return iterations;
+}
+
+void TotalVariationDenoise::result(float* volume) const
+{
+  std::copy(m_output.begin(), m_output.end(), volume);
+}
+
+// The volume is the input minus the divergence of the dual field, computed
+// with backward differences. Returns the sum of the squared divergence.
+double TotalVariationDenoise::updateVolume()
+{
+  const int nx = m_dims[0];
+  const int ny = m_dims[1];
+  const int64_t plane = static_cast<int64_t>(nx) * ny;
+  return sumOverSlabs(m_dims[2], [&](int z) {
+    double sum = 0.0;
+    for (int y = 0; y < ny; ++y) {
+      const int64_t first = z * plane + static_cast<int64_t>(nx) * y;
+      const float* px = m_dual[0].data() + first;
+      const float* py = m_dual[1].data() + first;
+      const float* pz = m_dual[2].data() + first;
+      const float* f = m_input.data() + first;
+      float* u = m_output.data() + first;
+      for (int x = 0; x < nx; ++x) {
+        float d = -(px[x] + py[x] + pz[x]);
+        d += x > 0 ? px[x - 1] : 0.0f;
+        d += y > 0 ? py[x - nx] : 0.0f;
+        d += z > 0 ? pz[x - plane] : 0.0f;
+        u[x] = f[x] + d;
+        sum += d * d;
+      }
+    }
+    return sum;
+  });
+}
+
+// Take a projected gradient step on the dual field, with the forward
+// differences of the volume. Returns the total variation of the volume.
+double TotalVariationDenoise::updateDual()
+{
+  const int nx = m_dims[0];
+  const int ny = m_dims[1];
+  const int nz = m_dims[2];
+  const int64_t plane = static_cast<int64_t>(nx) * ny;
+  const float tau = 1.0f / 6.0f;
+  const float step = tau / m_weight;
+  return sumOverSlabs(nz, [&](int z) {
+    double sum = 0.0;
+    for (int y = 0; y < ny; ++y) {
+      const int64_t first = z * plane + static_cast<int64_t>(nx) * y;
+      const float* u = m_output.data() + first;
+      float* px = m_dual[0].data() + first;
+      float* py = m_dual[1].data() + first;
+      float* pz = m_dual[2].data() + first;
+      const bool lastY = y == ny - 1;
+      const bool lastZ = z == nz - 1;
+      for (int x = 0; x < nx; ++x) {
+        float gx = x < nx - 1 ? u[x + 1] - u[x] : 0.0f;
+        float gy = lastY ? 0.0f : u[x + nx] - u[x];
+        float gz = lastZ ? 0.0f : u[x + plane] - u[x];
+        float norm = std::sqrt(gx * gx + gy * gy + gz * gz);
+        sum += norm;
+        float scale = 1.0f / (1.0f + step * norm);
+        px[x] = (px[x] - tau * gx) * scale;
+        py[x] = (py[x] - tau * gy) * scale;
+        pz[x] = (pz[x] - tau * gz) * scale;
+      }
+    }
+    return sum;
+  });
+}
+
+PeronaMalikDiffusion::PeronaMalikDiffusion(const float* volume,
+                                           const int dims[3],
+                                           const double spacing[3],
+                                           double conductance,
+                                           double timeStep)
+  : m_conductance(conductance), m_timeStep(static_cast<float>(timeStep))
+{
+  std::copy(dims, dims + 3, m_dims);
+  for (int i = 0; i < 3; ++i) {
+    m_scale[i] = static_cast<float>(1.0 / spacing[i]);
+  }
+  const size_t size = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+  m_volume.assign(volume, volume + size);
+  m_next.resize(size);
+}
+
+void PeronaMalikDiffusion::result(float* volume) const
+{
+  std::copy(m_volume.begin(), m_volume.end(), volume);
+}
+
+// The mean over the voxels of the squared central difference gradient
+double PeronaMalikDiffusion::averageGradientMagnitudeSquared() const
+{
+  const int nx = m_dims[0];
+  const int ny = m_dims[1];
+  const int nz = m_dims[2];
+  const int64_t plane = static_cast<int64_t>(nx) * ny;
+  double total = sumOverSlabs(nz, [&](int z) {
+    double sum = 0.0;
+    const float* slab = m_volume.data() + z * plane;
+    for (int y = 0; y < ny; ++y) {
+      const float* c = slab + int64_t(nx) * y;
+      const float* ym = slab + int64_t(nx) * std::max(y - 1, 0);
+      const float* yp = slab + int64_t(nx) * std::min(y + 1, ny - 1);
+      const float* zm = c - (z > 0 ? plane : 0);
+      const float* zp = c + (z < nz - 1 ? plane : 0);
+      for (int x = 0; x < nx; ++x) {
+        const int xm = std::max(x - 1, 0);
+        const int xp = std::min(x + 1, nx - 1);
+        float dx = 0.5f * (c[xp] - c[xm]) * m_scale[0];
+        float dy = 0.5f * (yp[x] - ym[x]) * m_scale[1];
+        float dz = 0.5f * (zp[x] - zm[x]) * m_scale[2];
+        sum += dx * dx + dy * dy + dz * dz;
+      }
+    }
+    return sum;
+  });
+  return total / static_cast<double>(m_volume.size());
+}
+
+void PeronaMalikDiffusion::iterate(int iterations)
+{
+  const int nx = m_dims[0];
+  const int ny = m_dims[1];
+  const int nz = m_dims[2];
+  const int64_t plane = static_cast<int64_t>(nx) * ny;
+  const float sx = m_scale[0];
+  const float sy = m_scale[1];
+  const float sz = m_scale[2];
+
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    const double k = averageGradientMagnitudeSquared() * m_conductance *
+                     m_conductance * -2.0;
+    if (k == 0.0) {
+      // The conductance is zero everywhere, so nothing diffuses
+      continue;
+    }
+    const float invK = static_cast<float>(1.0 / k);
+    tbb::parallel_for(0, nz, [&](int z) {
+      // l[j][i] is the line at y + j - 1 and z + i - 1, clamped to the volume
+      // for zero flux boundaries
+      const int zs[3] = { std::max(z - 1, 0), z, std::min(z + 1, nz - 1) };
+      for (int y = 0; y < ny; ++y) {
+        const int ys[3] = { std::max(y - 1, 0), y, std::min(y + 1, ny - 1) };
+        const float* l[3][3];
+        for (int j = 0; j < 3; ++j) {
+          for (int i = 0; i < 3; ++i) {
+            l[j][i] = m_volume.data() + zs[i] * plane + int64_t(nx) * ys[j];
+          }
+        }
+        float* out = m_next.data() + z * plane + int64_t(nx) * y;
+        const float* c = l[1][1];
+
+        // The voxel at x, with its neighbours along x at xm and xp
+        auto update = [&](int x, int xm, int xp) {
+          const float center = c[x];
+          // Central differences
+          const float dx = 0.5f * (c[xp] - c[xm]) * sx;
+          const float dy = 0.5f * (l[2][1][x] - l[0][1][x]) * sy;
+          const float dz = 0.5f * (l[1][2][x] - l[1][0][x]) * sz;
+
+          float delta = 0.0f;
+          auto flux = [&](float forward, float backward, float augmented,
+                          float diminished) {
+            float cForward = std::exp((forward * forward + augmented) * invK);
+            float cBackward =
+              std::exp((backward * backward + diminished) * invK);
+            delta += forward * cForward - backward * cBackward;
+          };
+          auto term = [](float d, float other) {
+            return 0.25f * (d + other) * (d + other);
+          };
+
+          // Along x, with the y and z differences half a voxel away
+          flux((c[xp] - center) * sx, (center - c[xm]) * sx,
+               term(dy, 0.5f * (l[2][1][xp] - l[0][1][xp]) * sy) +
+                 term(dz, 0.5f * (l[1][2][xp] - l[1][0][xp]) * sz),
+               term(dy, 0.5f * (l[2][1][xm] - l[0][1][xm]) * sy) +
+                 term(dz, 0.5f * (l[1][2][xm] - l[1][0][xm]) * sz));
+          // Along y
+          flux((l[2][1][x] - center) * sy, (center - l[0][1][x]) * sy,
+               term(dx, 0.5f * (l[2][1][xp] - l[2][1][xm]) * sx) +
+                 term(dz, 0.5f * (l[2][2][x] - l[2][0][x]) * sz),
+               term(dx, 0.5f * (l[0][1][xp] - l[0][1][xm]) * sx) +
+                 term(dz, 0.5f * (l[0][2][x] - l[0][0][x]) * sz));
+          // Along z
+          flux((l[1][2][x] - center) * sz, (center - l[1][0][x]) * sz,
+               term(dx, 0.5f * (l[1][2][xp] - l[1][2][xm]) * sx) +
+                 term(dy, 0.5f * (l[2][2][x] - l[0][2][x]) * sy),
+               term(dx, 0.5f * (l[1][0][xp] - l[1][0][xm]) * sx) +
+                 term(dy, 0.5f * (l[2][0][x] - l[0][0][x]) * sy));
+
+          out[x] = center + m_timeStep * delta;
+        };
+
+        // Only the ends of the line need clamping, which keeps the loop
+        // over the interior free of branches.
+        update(0, 0, std::min(1, nx - 1));
+        for (int x = 1; x < nx - 1; ++x) {
+          update(x, x - 1, x + 1);
+        }
+        if (nx > 1) {
+          update(nx - 1, nx - 2, nx - 1);
+        }
+      }
+    });
+    std::swap(m_volume, m_next);
+  }
+}
+
+} // namespace native
+} // namespace tomviz
@@ -0,0 +1,100 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeDenoise_h
+#define tomvizNativeDenoise_h
+
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+/// Chambolle's projection algorithm for total variation denoising, as
+/// skimage.restoration.denoise_tv_chambolle() runs it on a 3D volume. Each
+/// iteration takes two passes over the volume, one to update the denoised
+/// volume from the dual field and one to update the dual field from its
+/// gradient, parallel over z slabs.
+///
+/// The iterations run in batches so that the intermediate results can be
+/// shown, and stop once the energy changes less than eps times its initial
+/// value.
+class TotalVariationDenoise
+{
+public:
+  /// volume is a Fortran ordered dims[0] x dims[1] x dims[2] volume. The
+  /// larger weight, the more denoising.
+  TotalVariationDenoise(const float* volume, const int dims[3], float weight,
+                        double eps = 2e-4);
+
+  /// Run up to iterations iterations. Returns the number run, which is
+  /// smaller once converged.
+  int iterate(int iterations);
+
+  bool converged() const { return m_converged; }
+  int dimension(int i) const { return m_dims[i]; }
+
+  /// Copy the denoised volume
+  void result(float* volume) const;
+
+private:
+  double updateVolume();
+  double updateDual();
+
+  int m_dims[3];
+  float m_weight;
+  double m_eps;
+  int m_iteration = 0;
+  bool m_converged = false;
+  double m_initialEnergy = 0.0;
+  double m_previousEnergy = 0.0;
+  std::vector<float> m_input;
+  std::vector<float> m_output;
+  // The dual field, one volume per axis
+  std::vector<float> m_dual[3];
+};
+
+/// The total variation descent of TV_Filter.py, run in place on every z
+/// slice of a Fortran ordered dims[0] x dims[1] x dims[2] volume. Each of
+/// the steps moves slice z by stepSizes[z] against the derivative of its
+/// total variation, normalized as TVDerivative() does, with zero outside of
+/// the slice. A slice whose derivative vanishes is left as is. The slices
+/// run in parallel, and so do the rows of each.
+void descendSliceVariation(double* volume, const int dims[3],
+                           const double* stepSizes, int steps);
+
+/// Perona-Malik anisotropic diffusion with the gradient magnitude based
+/// conductance of ITK's GradientAnisotropicDiffusionImageFilter: the same
+/// half voxel derivatives, conductance scaled by the average squared
+/// gradient magnitude, zero flux boundaries and explicit time steps. Each
+/// iteration is one fused stencil pass, parallel over z slabs.
+class PeronaMalikDiffusion
+{
+public:
+  /// volume is a Fortran ordered dims[0] x dims[1] x dims[2] volume, and the
+  /// derivatives are scaled by 1 / spacing.
+  PeronaMalikDiffusion(const float* volume, const int dims[3],
+                       const double spacing[3], double conductance,
+                       double timeStep);
+
+  void iterate(int iterations);
+
+  int dimension(int i) const { return m_dims[i]; }
+
+  /// Copy the diffused volume
+  void result(float* volume) const;
+
+private:
+  double averageGradientMagnitudeSquared() const;
+
+  int m_dims[3];
+  float m_scale[3];
+  double m_conductance;
+  float m_timeStep;
+  std::vector<float> m_volume;
+  std::vector<float> m_next;
+};
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,166 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Dft.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+struct Sample
+{
+  int column;
+  int64_t target;
+  float weight;
+};
+
+} // namespace
+
+bool directFourierReconstruction(const float* tiltSeries, int nx, int ny,
+                                 const std::vector<double>& angles, int npad,
+                                 int kzPlanes, float* volume,
+                                 Complex* spectrum,
+                                 const std::function<bool(double)>& progress)
+{
+  const int nz = ny / 2 + 1;
+  kzPlanes = kzPlanes < 0 ? nz : std::min(kzPlanes, nz);
+  const int padBefore = (npad - ny + 1) / 2;
+  // The columns of the projection transforms that are gridded
+  const int columns = std::min(npad / 2 + 1, (npad + 1) / 2 + 1);
+  const double dk = static_cast<double>(ny) / npad;
+  const int64_t planeSize = static_cast<int64_t>(nx) * ny;
+
+  std::vector<Complex> grid(planeSize * nz, Complex(0.0f, 0.0f));
+  // The weights are the same for every x
+  std::vector<double> weights(static_cast<int64_t>(ny) * nz, 0.0);
+  std::vector<Complex> projection(static_cast<int64_t>(nx) * npad);
+  std::vector<Sample> samples;
+
+  const int nproj = static_cast<int>(angles.size());
+  for (int a = 0; a < nproj; ++a) {
+    // Zero pad along y and move the origin to the first element
+    const float* image = tiltSeries + planeSize * a;
+    tbb::parallel_for(0, npad, [&](int j) {
+      int y = (j + npad / 2) % npad - padBefore;
+      Complex* column = projection.data() + static_cast<int64_t>(nx) * j;
+      for (int x = 0; x < nx; ++x) {
+        float value = 0.0f;
+        if (y >= 0 && y < ny) {
+          value = image[(x + nx / 2) % nx + static_cast<int64_t>(nx) * y];
+        }
+        column[x] = Complex(value, 0.0f);
+      }
+    });
+    const int projectionDims[3] = { nx, npad, 1 };
+    fftAxis(projection.data(), projectionDims, 1, false);
+    // Only the first columns are gridded, and they are contiguous
+    const int griddedDims[3] = { nx, columns, 1 };
+    fftAxis(projection.data(), griddedDims, 0, false);
+
+    // Negative angles use the conjugate symmetric half of the transform
+    double angle = angles[a] * pi / 180.0;
+    const bool flip = angle < 0;
+    if (flip) {
+      angle += pi;
+    }
+
+    samples.clear();
+    for (int i = 0; i < columns; ++i) {
+      double ky = i * dk;
+      double kyNew = std::cos(angle) * ky;
+      double kzNew = std::sin(angle) * ky;
+      double sy = std::abs(std::floor(kyNew) - kyNew);
+      double sz = std::abs(std::floor(kzNew) - kzNew);
+      const double corners[4][3] = {
+        { std::floor(kyNew), std::floor(kzNew), (1 - sy) * (1 - sz) },
+        { std::ceil(kyNew), std::floor(kzNew), sy * (1 - sz) },
+        { std::floor(kyNew), std::ceil(kzNew), (1 - sy) * sz },
+        { std::ceil(kyNew), std::ceil(kzNew), sy * sz },
+      };
+      for (const auto& corner : corners) {
+        int py = static_cast<int>(corner[0]);
+        int pz = static_cast<int>(corner[1]);
+        if (py < 0) {
+          py += ny;
+        }
+        if (py < 0 || py >= ny || pz < 0 || pz >= kzPlanes) {
+          continue;
+        }
+        weights[py + static_cast<int64_t>(ny) * pz] += corner[2];
+        samples.push_back(
+          { i, nx * (py + static_cast<int64_t>(ny) * pz),
+            static_cast<float>(corner[2]) });
+      }
+    }
+
+    // The x lines of the grid are independent, so they are gridded in
+    // parallel without any synchronization, in the order of the samples.
+    tbb::parallel_for(
+      tbb::blocked_range<int>(0, nx), [&](const tbb::blocked_range<int>& r) {
+        for (const auto& sample : samples) {
+          const Complex* column =
+            projection.data() + static_cast<int64_t>(nx) * sample.column;
+          Complex* line = grid.data() + sample.target;
+          for (int x = r.begin(); x != r.end(); ++x) {
+            Complex value = column[x];
+            if (flip) {
+              value = std::conj(column[x == 0 ? 0 : nx - x]);
+            }
+            line[x] += sample.weight * value;
+          }
+        }
+      });
+
+    if (progress && progress(static_cast<double>(a + 1) / nproj)) {
+      return false;
+    }
+  }
+
+  tbb::parallel_for(int64_t(0), static_cast<int64_t>(ny) * nz, [&](int64_t i) {
+    double weight = weights[i];
+    if (weight == 0.0) {
+      return;
+    }
+    Complex* line = grid.data() + nx * i;
+    for (int x = 0; x < nx; ++x) {
+      line[x] = Complex(static_cast<float>(line[x].real() / weight),
+                        static_cast<float>(line[x].imag() / weight));
+    }
+  });
+  if (spectrum) {
+    std::copy(grid.begin(), grid.end(), spectrum);
+  }
+
+  const int dims[3] = { nx, ny, ny };
+  std::vector<float> real(planeSize * ny);
+  inverseReal(grid.data(), dims, real.data());
+  grid = std::vector<Complex>();
+
+  // Normalize, and move the origin to the center of the volume
+  const float scale = 1.0f / (planeSize * ny);
+  tbb::parallel_for(0, ny, [&](int z) {
+    for (int y = 0; y < ny; ++y) {
+      const int64_t row = static_cast<int64_t>(nx) * y;
+      const int64_t shiftedRow = static_cast<int64_t>(nx) * ((y + ny / 2) % ny);
+      const float* in = real.data() + planeSize * z + row;
+      float* out = volume + planeSize * ((z + ny / 2) % ny) + shiftedRow;
+      for (int x = 0; x < nx; ++x) {
+        out[(x + nx / 2) % nx] = in[x] * scale;
+      }
+    }
+  });
+  return true;
+}
+
+} // namespace native
+} // namespace tomviz
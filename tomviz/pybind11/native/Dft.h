@@ -0,0 +1,38 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeDft_h
+#define tomvizNativeDft_h
+
+#include "Fft.h"
+
+#include <functional>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+/// Direct Fourier reconstruction of a parallel beam tilt series tilted about
+/// the x axis, as dfm3() in Recon_DFT_constraint.py: every projection is
+/// zero padded to npad along y and transformed, and its central slice is
+/// gridded with bilinear weights into the half spectrum of the volume, which
+/// is then transformed back.
+///
+/// tiltSeries is a Fortran ordered nx x ny x nproj volume and angles holds
+/// the nproj tilt angles in degrees. Only the first kzPlanes planes of the
+/// half spectrum are gridded (all of them when kzPlanes < 0).
+///
+/// On return, volume holds the Fortran ordered nx x ny x ny reconstruction,
+/// and spectrum, when given, the gridded nx x ny x (ny / 2 + 1) half spectrum.
+///
+/// progress is called with the fraction of the projections gridded, and may
+/// return true to cancel, in which case false is returned.
+bool directFourierReconstruction(
+  const float* tiltSeries, int nx, int ny, const std::vector<double>& angles,
+  int npad, int kzPlanes, float* volume, Complex* spectrum = nullptr,
+  const std::function<bool(double)>& progress = nullptr);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,392 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Fft.h"
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+// std::complex multiplication checks for infinities, which is slow
+inline Complex multiply(const Complex& a, const Complex& b)
+{
+  return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                 a.real() * b.imag() + a.imag() * b.real());
+}
+
+inline Complex multiplyConjugate(const Complex& a, const Complex& b)
+{
+  return Complex(a.real() * b.real() + a.imag() * b.imag(),
+                 a.imag() * b.real() - a.real() * b.imag());
+}
+
+Complex polar(double angle)
+{
+  return Complex(static_cast<float>(std::cos(angle)),
+                 static_cast<float>(std::sin(angle)));
+}
+
+bool isPowerOfTwo(int n)
+{
+  return (n & (n - 1)) == 0;
+}
+
+// Plans are immutable, so they are built once per length and shared
+template <typename Plan>
+std::shared_ptr<const Plan> cachedPlan(int n)
+{
+  static std::mutex mutex;
+  static std::map<int, std::shared_ptr<const Plan>> plans;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = plans.find(n);
+  if (it == plans.end()) {
+    it = plans.emplace(n, std::make_shared<const Plan>(n)).first;
+  }
+  return it->second;
+}
+
+// Visit the lines of a Fortran ordered volume along axis, in parallel, with a
+// per thread work buffer of bufferSize values.
+template <typename Function>
+void forEachLine(const int dims[3], int axis, size_t bufferSize,
+                 Function function)
+{
+  int64_t stride = 1;
+  for (int i = 0; i < axis; ++i) {
+    stride *= dims[i];
+  }
+  const int64_t n = dims[axis];
+  const int64_t lines =
+    static_cast<int64_t>(dims[0]) * dims[1] * dims[2] / std::max<int64_t>(n, 1);
+
+  tbb::enumerable_thread_specific<std::vector<Complex>> buffers(bufferSize);
+  tbb::parallel_for(int64_t(0), lines, [&](int64_t line) {
+    auto& buffer = buffers.local();
+    int64_t inner = line % stride;
+    int64_t outer = line / stride;
+    function(inner + outer * stride * n, stride, buffer.data());
+  });
+}
+
+} // namespace
+
+FftPlan::FftPlan(int n) : m_n(n)
+{
+  if (n < 1) {
+    throw std::invalid_argument("The FFT length must be positive");
+  }
+
+  m_length = n;
+  if (!isPowerOfTwo(n)) {
+    m_length = 1;
+    while (m_length < 2 * n - 1) {
+      m_length *= 2;
+    }
+  }
+
+  int bits = 0;
+  while ((1 << bits) < m_length) {
+    ++bits;
+  }
+  m_reverse.resize(m_length);
+  for (int i = 0; i < m_length; ++i) {
+    int reversed = 0;
+    for (int b = 0; b < bits; ++b) {
+      reversed |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    m_reverse[i] = reversed;
+  }
+  m_twiddles.resize(std::max(m_length / 2, 1));
+  for (int k = 0; k < m_length / 2; ++k) {
+    m_twiddles[k] = polar(-2.0 * pi * k / m_length);
+  }
+
+  if (m_length != n) {
+    // Bluestein: X[k] = c[k] sum_j (x[j] c[j]) conj(c[k - j]), with the chirp
+    // c[k] = exp(-i pi k^2 / n), as a convolution of length m_length.
+    m_chirp.resize(n);
+    for (int64_t k = 0; k < n; ++k) {
+      // k^2 modulo 2n keeps the angle accurate for long transforms
+      int64_t k2 = (k * k) % (2 * static_cast<int64_t>(n));
+      m_chirp[k] = polar(-pi * k2 / n);
+    }
+    m_filter.assign(m_length, Complex(0.0f, 0.0f));
+    m_filter[0] = std::conj(m_chirp[0]);
+    for (int k = 1; k < n; ++k) {
+      m_filter[k] = m_filter[m_length - k] = std::conj(m_chirp[k]);
+    }
+    radix2(m_filter.data(), false);
+  }
+}
+
+std::shared_ptr<const FftPlan> FftPlan::cached(int n)
+{
+  return cachedPlan<FftPlan>(n);
+}
+
+size_t FftPlan::scratchSize() const
+{
+  return m_length != m_n ? m_length : 0;
+}
+
+void FftPlan::transform(Complex* data, bool inverse, Complex* scratch) const
+{
+  if (m_length == m_n) {
+    radix2(data, inverse);
+    return;
+  }
+
+  // The inverse is the conjugate of the forward transform of the conjugate
+  for (int k = 0; k < m_n; ++k) {
+    Complex x = inverse ? std::conj(data[k]) : data[k];
+    scratch[k] = multiply(x, m_chirp[k]);
+  }
+  std::fill(scratch + m_n, scratch + m_length, Complex(0.0f, 0.0f));
+  radix2(scratch, false);
+  for (int k = 0; k < m_length; ++k) {
+    scratch[k] = multiply(scratch[k], m_filter[k]);
+  }
+  radix2(scratch, true);
+  const float scale = 1.0f / m_length;
+  for (int k = 0; k < m_n; ++k) {
+    Complex x = multiply(scratch[k], m_chirp[k]) * scale;
+    data[k] = inverse ? std::conj(x) : x;
+  }
+}
+
+void FftPlan::radix2(Complex* data, bool inverse) const
+{
+  for (int i = 0; i < m_length; ++i) {
+    if (i < m_reverse[i]) {
+      std::swap(data[i], data[m_reverse[i]]);
+    }
+  }
+  for (int length = 2; length <= m_length; length *= 2) {
+    const int half = length / 2;
+    const int step = m_length / length;
+    for (int i = 0; i < m_length; i += length) {
+      for (int j = 0; j < half; ++j) {
+        const Complex& w = m_twiddles[j * step];
+        Complex u = data[i + j];
+        Complex v = inverse ? multiplyConjugate(data[i + j + half], w)
+                            : multiply(data[i + j + half], w);
+        data[i + j] = u + v;
+        data[i + j + half] = u - v;
+      }
+    }
+  }
+}
+
+RealFftPlan::RealFftPlan(int n) : m_n(n)
+{
+  if (n < 1) {
+    throw std::invalid_argument("The FFT length must be positive");
+  }
+
+  if (n % 2 == 0) {
+    m_plan = FftPlan::cached(n / 2);
+    m_twiddles.resize(n / 2 + 1);
+    for (int k = 0; k <= n / 2; ++k) {
+      m_twiddles[k] = polar(-2.0 * pi * k / n);
+    }
+  } else {
+    m_plan = FftPlan::cached(n);
+  }
+}
+
+std::shared_ptr<const RealFftPlan> RealFftPlan::cached(int n)
+{
+  return cachedPlan<RealFftPlan>(n);
+}
+
+size_t RealFftPlan::workSize() const
+{
+  return m_plan->size() + m_plan->scratchSize();
+}
+
+void RealFftPlan::forward(const float* data, int64_t stride,
+                          Complex* spectrum, int64_t spectrumStride,
+                          Complex* work) const
+{
+  const int m = m_plan->size();
+  Complex* scratch = work + m;
+  if (m == m_n) {
+    for (int j = 0; j < m_n; ++j) {
+      work[j] = Complex(data[j * stride], 0.0f);
+    }
+    m_plan->transform(work, false, scratch);
+    for (int k = 0; k <= m_n / 2; ++k) {
+      spectrum[k * spectrumStride] = work[k];
+    }
+    return;
+  }
+
+  // The transform z of the even values plus i times the odd ones holds both
+  // of their transforms, e = (z[k] + conj(z[m - k])) / 2 and
+  // o = (z[k] - conj(z[m - k])) / 2i, and X[k] = e + exp(-2 pi i k / n) o.
+  for (int j = 0; j < m; ++j) {
+    work[j] = Complex(data[2 * j * stride], data[(2 * j + 1) * stride]);
+  }
+  m_plan->transform(work, false, scratch);
+  for (int k = 0; k <= m; ++k) {
+    Complex z = work[k % m];
+    Complex zc = std::conj(work[(m - k) % m]);
+    Complex even = (z + zc) * 0.5f;
+    Complex odd = (z - zc) * Complex(0.0f, -0.5f);
+    spectrum[k * spectrumStride] = even + multiply(m_twiddles[k], odd);
+  }
+}
+
+void RealFftPlan::inverse(const Complex* spectrum, int64_t spectrumStride,
+                          float* data, int64_t stride, Complex* work) const
+{
+  const int m = m_plan->size();
+  Complex* scratch = work + m;
+  const int half = m_n / 2;
+  auto frequency = [&](int k) {
+    Complex value = spectrum[k * spectrumStride];
+    if (k == 0 || 2 * k == m_n) {
+      value.imag(0.0f);
+    }
+    return value;
+  };
+
+  if (m == m_n) {
+    // The negative frequencies are the conjugates of the positive ones
+    for (int k = 0; k <= half; ++k) {
+      work[k] = frequency(k);
+    }
+    for (int k = half + 1; k < m_n; ++k) {
+      work[k] = std::conj(work[m_n - k]);
+    }
+    m_plan->transform(work, true, scratch);
+    for (int j = 0; j < m_n; ++j) {
+      data[j * stride] = work[j].real();
+    }
+    return;
+  }
+
+  // The reverse of forward(): the even and odd values are the real and
+  // imaginary parts of the inverse transform of e + i o, both scaled by 2 so
+  // that the result is not normalized, like the transform of length n.
+  for (int k = 0; k < m; ++k) {
+    Complex x = frequency(k);
+    Complex xc = std::conj(frequency(m - k));
+    Complex odd = multiplyConjugate(x - xc, m_twiddles[k]);
+    work[k] = (x + xc) + Complex(-odd.imag(), odd.real());
+  }
+  m_plan->transform(work, true, scratch);
+  for (int j = 0; j < m; ++j) {
+    data[2 * j * stride] = work[j].real();
+    data[(2 * j + 1) * stride] = work[j].imag();
+  }
+}
+
+ImageFft::ImageFft(int nx, int ny)
+  : m_nx(nx), m_ny(ny), m_planX(FftPlan::cached(nx)),
+    m_planY(RealFftPlan::cached(ny))
+{
+}
+
+size_t ImageFft::spectrumSize() const
+{
+  return static_cast<size_t>(m_nx) * (m_ny / 2 + 1);
+}
+
+size_t ImageFft::workSize() const
+{
+  return std::max(m_planY->workSize(), m_planX->scratchSize());
+}
+
+void ImageFft::forward(const float* image, Complex* spectrum,
+                       Complex* work) const
+{
+  const int half = m_ny / 2 + 1;
+  for (int x = 0; x < m_nx; ++x) {
+    m_planY->forward(image + x, m_nx, spectrum + x, m_nx, work);
+  }
+  // The columns along x are contiguous
+  for (int k = 0; k < half; ++k) {
+    m_planX->transform(spectrum + static_cast<int64_t>(m_nx) * k, false,
+                       work);
+  }
+}
+
+void ImageFft::inverse(Complex* spectrum, float* image, Complex* work) const
+{
+  const int half = m_ny / 2 + 1;
+  for (int k = 0; k < half; ++k) {
+    m_planX->transform(spectrum + static_cast<int64_t>(m_nx) * k, true, work);
+  }
+  for (int x = 0; x < m_nx; ++x) {
+    m_planY->inverse(spectrum + x, m_nx, image + x, m_nx, work);
+  }
+}
+
+void fftAxis(Complex* data, const int dims[3], int axis, bool inverse)
+{
+  const int n = dims[axis];
+  if (n < 2) {
+    return;
+  }
+  auto plan = FftPlan::cached(n);
+  forEachLine(dims, axis, n + plan->scratchSize(),
+              [&](int64_t first, int64_t stride, Complex* line) {
+                for (int k = 0; k < n; ++k) {
+                  line[k] = data[first + k * stride];
+                }
+                plan->transform(line, inverse, line + n);
+                for (int k = 0; k < n; ++k) {
+                  data[first + k * stride] = line[k];
+                }
+              });
+}
+
+void forwardReal(const float* data, const int dims[3], Complex* spectrum)
+{
+  const int half = dims[2] / 2 + 1;
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  auto plan = RealFftPlan::cached(dims[2]);
+  forEachLine(dims, 2, plan->workSize(),
+              [&](int64_t first, int64_t, Complex* work) {
+                plan->forward(data + first, plane, spectrum + first, plane,
+                              work);
+              });
+
+  const int halfDims[3] = { dims[0], dims[1], half };
+  fftAxis(spectrum, halfDims, 0, false);
+  fftAxis(spectrum, halfDims, 1, false);
+}
+
+void inverseReal(Complex* spectrum, const int dims[3], float* data)
+{
+  const int half = dims[2] / 2 + 1;
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  const int halfDims[3] = { dims[0], dims[1], half };
+  fftAxis(spectrum, halfDims, 0, true);
+  fftAxis(spectrum, halfDims, 1, true);
+
+  // The last axis back to real values, ignoring the imaginary parts of its
+  // zero and Nyquist frequencies as FFTW does
+  auto plan = RealFftPlan::cached(dims[2]);
+  forEachLine(dims, 2, plan->workSize(),
+              [&](int64_t first, int64_t, Complex* work) {
+                plan->inverse(spectrum + first, plane, data + first, plane,
+                              work);
+              });
+}
+
+} // namespace native
+} // namespace tomviz
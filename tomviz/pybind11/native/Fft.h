@@ -0,0 +1,124 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeFft_h
+#define tomvizNativeFft_h
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+using Complex = std::complex<float>;
+
+/// A single precision FFT of one length. Powers of two use an iterative
+/// radix 2 transform, other lengths Bluestein's algorithm on top of it. Like
+/// FFTW, the inverse transform is not normalized.
+///
+/// A plan is immutable once built, so one plan can be shared by threads that
+/// each bring their own scratch buffer of scratchSize() values.
+class FftPlan
+{
+public:
+  explicit FftPlan(int n);
+
+  /// The plan of length n, built on first use and kept for later calls
+  static std::shared_ptr<const FftPlan> cached(int n);
+
+  int size() const { return m_n; }
+  size_t scratchSize() const;
+
+  /// Transform the n values of data in place
+  void transform(Complex* data, bool inverse, Complex* scratch) const;
+
+private:
+  void radix2(Complex* data, bool inverse) const;
+
+  int m_n;
+  // The radix 2 transform, of length n or of the Bluestein convolution
+  int m_length;
+  std::vector<int32_t> m_reverse;
+  std::vector<Complex> m_twiddles;
+  // Bluestein's chirp and the transform of its conjugate
+  std::vector<Complex> m_chirp;
+  std::vector<Complex> m_filter;
+};
+
+/// The transform of n real values to their n / 2 + 1 non negative
+/// frequencies, and back. Even lengths transform the values as n / 2 complex
+/// pairs with a plan of half the length, odd ones with a complex plan of
+/// length n. Like FftPlan it is immutable, and threads bring their own work
+/// buffer of workSize() values.
+class RealFftPlan
+{
+public:
+  explicit RealFftPlan(int n);
+
+  /// The plan of length n, built on first use and kept for later calls
+  static std::shared_ptr<const RealFftPlan> cached(int n);
+
+  int size() const { return m_n; }
+  size_t workSize() const;
+
+  /// The values are read, and the frequencies written, every stride elements
+  void forward(const float* data, int64_t stride, Complex* spectrum,
+               int64_t spectrumStride, Complex* work) const;
+
+  /// Not normalized. The imaginary parts of the zero and Nyquist frequencies
+  /// are ignored.
+  void inverse(const Complex* spectrum, int64_t spectrumStride, float* data,
+               int64_t stride, Complex* work) const;
+
+private:
+  int m_n;
+  std::shared_ptr<const FftPlan> m_plan;
+  // exp(-2 pi i k / n) for the n / 2 + 1 frequencies of even lengths
+  std::vector<Complex> m_twiddles;
+};
+
+/// Real transforms of nx x ny Fortran ordered images, as numpy.fft.rfftn on
+/// a 2D array: the spectrum is nx x (ny / 2 + 1). The transforms of a single
+/// image are sequential, so that images can be transformed in parallel, each
+/// thread with its own work buffer of workSize() values.
+class ImageFft
+{
+public:
+  ImageFft(int nx, int ny);
+
+  int nx() const { return m_nx; }
+  int ny() const { return m_ny; }
+  size_t spectrumSize() const;
+  size_t workSize() const;
+
+  void forward(const float* image, Complex* spectrum, Complex* work) const;
+
+  /// Not normalized, and spectrum is overwritten
+  void inverse(Complex* spectrum, float* image, Complex* work) const;
+
+private:
+  int m_nx;
+  int m_ny;
+  std::shared_ptr<const FftPlan> m_planX;
+  std::shared_ptr<const RealFftPlan> m_planY;
+};
+
+/// Transform a Fortran ordered dims[0] x dims[1] x dims[2] complex volume in
+/// place along one axis, the lines in parallel.
+void fftAxis(Complex* data, const int dims[3], int axis, bool inverse);
+
+/// The transform of a Fortran ordered real volume along all its axes, as
+/// numpy.fft.rfftn: only the dims[2] / 2 + 1 non negative frequencies of the
+/// last axis are kept, in a dims[0] x dims[1] x (dims[2] / 2 + 1) volume.
+void forwardReal(const float* data, const int dims[3], Complex* spectrum);
+
+/// The inverse of forwardReal(), not normalized. dims are those of the real
+/// volume, and spectrum is overwritten.
+void inverseReal(Complex* spectrum, const int dims[3], float* data);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,284 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "FrequencyFilters.h"
+
+#include "Fft.h"
+
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+// The work buffers of one thread filtering images of the same size
+struct ImageBuffers
+{
+  explicit ImageBuffers(const ImageFft& fft)
+    : spectrum(fft.spectrumSize()), work(fft.workSize())
+  {
+  }
+
+  std::vector<Complex> spectrum;
+  std::vector<Complex> work;
+};
+
+// The state of the ADMM deconvolution of one image, reused from one image to
+// the next by the same thread.
+struct AdmmBuffers : ImageBuffers
+{
+  AdmmBuffers(const ImageFft& fft, size_t pixels)
+    : ImageBuffers(fft), dataTerm(fft.spectrumSize()),
+      blurNorm(fft.spectrumSize()), f(pixels), previous(pixels), ux(pixels),
+      uy(pixels), yx(pixels), yy(pixels), vx(pixels), vy(pixels),
+      image(pixels)
+  {
+  }
+
+  // conj(H) G and |H|^2
+  std::vector<Complex> dataTerm;
+  std::vector<float> blurNorm;
+  std::vector<float> f, previous, ux, uy, yx, yy, vx, vy, image;
+};
+
+// The circular forward differences of image: along y in dx and x in dy, as
+// der_im() computes them.
+void forwardDifferences(const float* image, int nx, int ny, float* dx,
+                        float* dy)
+{
+  for (int y = 0; y < ny; ++y) {
+    const float* line = image + static_cast<int64_t>(nx) * y;
+    const float* next = image + static_cast<int64_t>(nx) * ((y + 1) % ny);
+    float* outX = dx + static_cast<int64_t>(nx) * y;
+    float* outY = dy + static_cast<int64_t>(nx) * y;
+    for (int x = 0; x < nx; ++x) {
+      outX[x] = next[x] - line[x];
+      outY[x] = line[x + 1 < nx ? x + 1 : 0] - line[x];
+    }
+  }
+}
+
+void deconvolveImage(const ImageFft& fft, const float* g, const float* psf,
+                     int px, int py, double mu, int maxIterations,
+                     const std::vector<float>& differenceNorm,
+                     AdmmBuffers& b, float* result)
+{
+  const int nx = fft.nx();
+  const int ny = fft.ny();
+  const size_t pixels = static_cast<size_t>(nx) * ny;
+  const size_t frequencies = fft.spectrumSize();
+  const float scale = 1.0f / pixels;
+
+  // The point spread function, padded and centered on the first pixel
+  std::fill(b.image.begin(), b.image.end(), 0.0f);
+  for (int j = 0; j < py; ++j) {
+    for (int i = 0; i < px; ++i) {
+      int x = ((i - px / 2) % nx + nx) % nx;
+      int y = ((j - py / 2) % ny + ny) % ny;
+      b.image[x + static_cast<size_t>(nx) * y] =
+        psf[i + static_cast<int64_t>(px) * j];
+    }
+  }
+  fft.forward(b.image.data(), b.spectrum.data(), b.work.data());
+  for (size_t k = 0; k < frequencies; ++k) {
+    b.dataTerm[k] = std::conj(b.spectrum[k]);
+    b.blurNorm[k] = std::norm(b.spectrum[k]);
+  }
+  fft.forward(g, b.spectrum.data(), b.work.data());
+  for (size_t k = 0; k < frequencies; ++k) {
+    b.dataTerm[k] *= b.spectrum[k];
+  }
+
+  std::copy(g, g + pixels, b.f.begin());
+  for (auto* v : { &b.ux, &b.uy, &b.yx, &b.yy }) {
+    std::fill(v->begin(), v->end(), 0.0f);
+  }
+  forwardDifferences(g, nx, ny, b.vx.data(), b.vy.data());
+  double residual = 0.0;
+  for (size_t i = 0; i < pixels; ++i) {
+    residual += std::sqrt(b.vx[i] * b.vx[i] + b.vy[i] * b.vy[i]);
+  }
+
+  const double tolerance = 1e-4;
+  double change = 1.0;
+  double rho = 2.0;
+  for (int iteration = 0; iteration < maxIterations && change > tolerance;
+       ++iteration) {
+    const float r = static_cast<float>(rho);
+    // rho (Dx^T ux + Dy^T uy) - (Dx^T yx + Dy^T yy), with the circular
+    // adjoint differences of der_t()
+    for (int y = 0; y < ny; ++y) {
+      const int64_t line = static_cast<int64_t>(nx) * y;
+      const int64_t previousLine = static_cast<int64_t>(nx) * ((y + ny - 1) % ny);
+      for (int x = 0; x < nx; ++x) {
+        const int64_t i = line + x;
+        const int64_t left = line + (x > 0 ? x - 1 : nx - 1);
+        const int64_t below = previousLine + x;
+        float adjointU = (b.ux[below] - b.ux[i]) + (b.uy[left] - b.uy[i]);
+        float adjointY = (b.yx[below] - b.yx[i]) + (b.yy[left] - b.yy[i]);
+        b.image[i] = r * adjointU - adjointY;
+      }
+    }
+    fft.forward(b.image.data(), b.spectrum.data(), b.work.data());
+    const float m = static_cast<float>(mu);
+    for (size_t k = 0; k < frequencies; ++k) {
+      b.spectrum[k] = (m * b.dataTerm[k] + b.spectrum[k]) /
+                      (m * b.blurNorm[k] + r * differenceNorm[k]);
+    }
+    std::swap(b.f, b.previous);
+    fft.inverse(b.spectrum.data(), b.f.data(), b.work.data());
+
+    forwardDifferences(b.f.data(), nx, ny, b.vx.data(), b.vy.data());
+    double difference = 0.0;
+    double norm = 0.0;
+    double previousResidual = residual;
+    residual = 0.0;
+    for (size_t i = 0; i < pixels; ++i) {
+      b.f[i] *= scale;
+      b.vx[i] *= scale;
+      b.vy[i] *= scale;
+
+      // Isotropic shrinkage
+      float vvx = b.vx[i] + b.yx[i] / r;
+      float vvy = b.vy[i] + b.yy[i] / r;
+      float v = std::sqrt(vvx * vvx + vvy * vvy);
+      if (v == 0.0f) {
+        v = 1.0f;
+      }
+      v = std::max(v - 1.0f / r, 0.0f) / v;
+      b.ux[i] = v * vvx;
+      b.uy[i] = v * vvy;
+
+      float rx = b.ux[i] - b.vx[i];
+      float ry = b.uy[i] - b.vy[i];
+      b.yx[i] -= r * rx;
+      b.yy[i] -= r * ry;
+      residual += std::sqrt(rx * rx + ry * ry);
+
+      double d = b.f[i] - b.previous[i];
+      difference += d * d;
+      norm += static_cast<double>(b.f[i]) * b.f[i];
+    }
+    change = std::sqrt(difference) / std::sqrt(norm);
+    if (residual > 0.7 * previousResidual) {
+      rho *= 2.0;
+    }
+  }
+  std::copy(b.f.begin(), b.f.end(), result);
+}
+
+} // namespace
+
+void filterImages(float* images, int nx, int ny, int count,
+                  const float* filter)
+{
+  const ImageFft fft(nx, ny);
+  const int64_t pixels = static_cast<int64_t>(nx) * ny;
+  const float scale = 1.0f / pixels;
+  tbb::enumerable_thread_specific<ImageBuffers> buffers(fft);
+  tbb::parallel_for(0, count, [&](int i) {
+    auto& b = buffers.local();
+    float* image = images + pixels * i;
+    fft.forward(image, b.spectrum.data(), b.work.data());
+    for (size_t k = 0; k < b.spectrum.size(); ++k) {
+      b.spectrum[k] *= filter[k] * scale;
+    }
+    fft.inverse(b.spectrum.data(), image, b.work.data());
+  });
+}
+
+void wienerFilter(const float* volume, const int dims[3],
+                  const double sigma[3], double snr, float* result)
+{
+  const int half = dims[2] / 2 + 1;
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  std::vector<Complex> spectrum(plane * half);
+  forwardReal(volume, dims, spectrum.data());
+
+  // The Gaussian point spread function and its Wiener filter, both on a grid
+  // centered on the middle of the array as in WienerFilter.py. The filter is
+  // symmetric, so the half spectrum is enough.
+  const double c = -2.0 * pi * pi * sigma[0] * sigma[1] * sigma[2];
+  const double tiny = std::numeric_limits<double>::min();
+  auto frequency = [&dims](int i, int axis) {
+    return (i - dims[axis] / 2.0) / dims[axis];
+  };
+  tbb::parallel_for(0, half, [&](int z) {
+    double kz = frequency(z, 2);
+    for (int y = 0; y < dims[1]; ++y) {
+      double ky = frequency(y, 1);
+      Complex* line = spectrum.data() + plane * z + int64_t(dims[0]) * y;
+      for (int x = 0; x < dims[0]; ++x) {
+        double kx = frequency(x, 0);
+        double psf = std::exp(c * (kx * kx + ky * ky + kz * kz)) + tiny;
+        double w = 1.0 / psf;
+        if (snr != 0.0) {
+          w *= psf * psf / (psf * psf + 1.0 / snr);
+        }
+        line[x] *= static_cast<float>(w);
+      }
+    }
+  });
+
+  inverseReal(spectrum.data(), dims, result);
+  spectrum = std::vector<Complex>();
+
+  const int64_t size = plane * dims[2];
+  float maximum = tbb::parallel_reduce(
+    tbb::blocked_range<int64_t>(0, size), 0.0f,
+    [&](const tbb::blocked_range<int64_t>& r, float value) {
+      for (auto i = r.begin(); i != r.end(); ++i) {
+        result[i] = std::abs(result[i]);
+        value = std::max(value, result[i]);
+      }
+      return value;
+    },
+    [](float a, float b) { return std::max(a, b); });
+  if (maximum > 0.0f) {
+    const float scale = 1.0f / maximum;
+    tbb::parallel_for(int64_t(0), size,
+                      [&](int64_t i) { result[i] *= scale; });
+  }
+}
+
+void deconvolveAdmm(const float* images, int nx, int ny, int count,
+                    const float* psfs, int px, int py, double mu,
+                    int maxIterations, float* result)
+{
+  const ImageFft fft(nx, ny);
+  const int64_t pixels = static_cast<int64_t>(nx) * ny;
+  const int half = ny / 2 + 1;
+
+  // |Dx|^2 + |Dy|^2, the same for every image
+  std::vector<float> differenceNorm(fft.spectrumSize());
+  for (int k = 0; k < half; ++k) {
+    for (int x = 0; x < nx; ++x) {
+      differenceNorm[x + static_cast<int64_t>(nx) * k] =
+        static_cast<float>(4.0 - 2.0 * std::cos(2.0 * pi * x / nx) -
+                           2.0 * std::cos(2.0 * pi * k / ny));
+    }
+  }
+
+  tbb::enumerable_thread_specific<AdmmBuffers> buffers(fft, pixels);
+  tbb::parallel_for(0, count, [&](int i) {
+    deconvolveImage(fft, images + pixels * i,
+                    psfs + static_cast<int64_t>(px) * py * i, px, py, mu,
+                    maxIterations, differenceNorm, buffers.local(),
+                    result + pixels * i);
+  });
+}
+
+} // namespace native
+} // namespace tomviz
@@ -0,0 +1,35 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeFrequencyFilters_h
+#define tomvizNativeFrequencyFilters_h
+
+namespace tomviz {
+namespace native {
+
+/// Multiply the spectrum of each of the count Fortran ordered nx x ny images
+/// by filter, a real nx x (ny / 2 + 1) array laid out as numpy.fft.rfftn()
+/// returns the spectrum, in place. This is the correction of ctf_correct.py.
+/// The images are filtered in parallel, each thread with its own buffers.
+void filterImages(float* images, int nx, int ny, int count,
+                  const float* filter);
+
+/// The Wiener deconvolution of WienerFilter.py, for a Gaussian point spread
+/// function of the given sigmas and a signal to noise ratio snr (none when
+/// 0). The filter is computed on the fly from the frequencies, and the result
+/// is normalized to a maximum of 1.
+void wienerFilter(const float* volume, const int dims[3],
+                  const double sigma[3], double snr, float* result);
+
+/// The ADMM total variation deconvolution of deconv_admm() in
+/// DeconvolutionDenoise.py, applied to count Fortran ordered nx x ny images
+/// with their own px x py point spread functions, in parallel. Stops after
+/// maxIterations, or once the relative change of an image is below 1e-4.
+void deconvolveAdmm(const float* images, int nx, int ny, int count,
+                    const float* psfs, int px, int py, double mu,
+                    int maxIterations, float* result);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,100 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tomviz {
+namespace native {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& fileName)
+{
+  m_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                       nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE) {
+    m_file = nullptr;
+    throw std::runtime_error("Could not open " + fileName);
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file, &size)) {
+    CloseHandle(m_file);
+    throw std::runtime_error("Could not read the size of " + fileName);
+  }
+  m_size = static_cast<std::size_t>(size.QuadPart);
+  if (m_size == 0) {
+    return;
+  }
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping) {
+    m_data = static_cast<const unsigned char*>(
+      MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  }
+  if (!m_data) {
+    if (m_mapping) {
+      CloseHandle(m_mapping);
+    }
+    CloseHandle(m_file);
+    throw std::runtime_error("Could not map " + fileName);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file) {
+    CloseHandle(m_file);
+  }
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& fileName)
+{
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open " + fileName);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not read the size of " + fileName);
+  }
+  m_size = static_cast<std::size_t>(info.st_size);
+  if (m_size > 0) {
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map " + fileName);
+    }
+    m_data = static_cast<const unsigned char*>(data);
+  }
+  // The mapping keeps the file open
+  close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_data) {
+    munmap(const_cast<unsigned char*>(m_data), m_size);
+  }
+}
+
+#endif
+
+} // namespace native
+} // namespace tomviz
@@ -0,0 +1,71 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeMappedFile_h
+#define tomvizNativeMappedFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace tomviz {
+namespace native {
+
+/// A whole file mapped read only into memory, so that readers can parse
+/// headers in place and copy their data from any number of threads without
+/// seeking. Throws std::runtime_error when the file cannot be mapped.
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string& fileName);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const unsigned char* data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+
+  /// Throws std::runtime_error unless [offset, offset + length) is inside
+  /// the file.
+  void check(uint64_t offset, uint64_t length) const
+  {
+    if (offset > m_size || length > m_size - offset) {
+      throw std::runtime_error("Unexpected end of file");
+    }
+  }
+
+  /// The value of type T at offset, in little endian byte order unless
+  /// bigEndian.
+  template <typename T>
+  T value(uint64_t offset, bool bigEndian = false) const
+  {
+    check(offset, sizeof(T));
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, m_data + offset, sizeof(T));
+    if (bigEndian) {
+      for (std::size_t i = 0; i < sizeof(T) / 2; ++i) {
+        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+      }
+    }
+    T result;
+    std::memcpy(&result, bytes, sizeof(T));
+    return result;
+  }
+
+private:
+  const unsigned char* m_data = nullptr;
+  std::size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+#endif
+};
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,394 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Metrics.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double nan = std::numeric_limits<double>::quiet_NaN();
+
+struct Range
+{
+  float min = std::numeric_limits<float>::max();
+  float max = std::numeric_limits<float>::lowest();
+
+  void join(const Range& other)
+  {
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+};
+
+Range planeRange(const float* plane, int64_t size)
+{
+  Range range;
+  for (int64_t i = 0; i < size; ++i) {
+    range.min = std::min(range.min, plane[i]);
+    range.max = std::max(range.max, plane[i]);
+  }
+  return range;
+}
+
+// The sums of a slab of planes, merged across slabs
+struct Accumulator
+{
+  explicit Accumulator(int bins)
+    : histogram(static_cast<size_t>(bins) * bins, 0)
+  {
+  }
+
+  void join(const Accumulator& other)
+  {
+    count += other.count;
+    sumA += other.sumA;
+    sumB += other.sumB;
+    sumAA += other.sumAA;
+    sumBB += other.sumBB;
+    sumAB += other.sumAB;
+    squaredError += other.squaredError;
+    ssim += other.ssim;
+    windows += other.windows;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+      histogram[i] += other.histogram[i];
+    }
+  }
+
+  double count = 0.0;
+  // The moments of the values shifted by their minimum
+  double sumA = 0.0;
+  double sumB = 0.0;
+  double sumAA = 0.0;
+  double sumBB = 0.0;
+  double sumAB = 0.0;
+  double squaredError = 0.0;
+  double ssim = 0.0;
+  int64_t windows = 0;
+  // The joint histogram, bins x bins
+  std::vector<int64_t> histogram;
+};
+
+// The values of one volume as they are compared: (v - offset) * scale, with
+// the minimum and maximum of the scaled values.
+struct Scaling
+{
+  Scaling(const Range& range, bool normalize)
+  {
+    if (normalize) {
+      offset = range.min;
+      // A constant volume can not be normalized, as with numpy
+      scale = range.max > range.min ? 1.0 / (range.max - range.min) : nan;
+    }
+    min = (range.min - offset) * scale;
+    max = (range.max - offset) * scale;
+  }
+
+  double operator()(float v) const { return (v - offset) * scale; }
+
+  double offset = 0.0;
+  double scale = 1.0;
+  double min;
+  double max;
+};
+
+class Comparison
+{
+public:
+  Comparison(const float* a, const float* b, const int dims[3],
+             const SimilarityOptions& options, const Range& rangeA,
+             const Range& rangeB)
+    : m_a(a), m_b(b), m_bins(std::max(options.bins, 1)),
+      m_scaleA(rangeA, options.normalize), m_scaleB(rangeB, options.normalize)
+  {
+    std::copy(dims, dims + 3, m_dims);
+    m_plane = static_cast<int64_t>(dims[0]) * dims[1];
+    for (int i = 0; i < 3; ++i) {
+      m_window[i] = dims[i] >= options.window ? options.window : 1;
+      m_pad[i] = (m_window[i] - 1) / 2;
+    }
+
+    m_dataRange = options.dataRange > 0.0 ? options.dataRange
+                                          : m_scaleA.max - m_scaleA.min;
+    m_binsA = m_scaleA.max > m_scaleA.min
+                ? m_bins / (m_scaleA.max - m_scaleA.min)
+                : 0.0;
+    m_binsB = m_scaleB.max > m_scaleB.min
+                ? m_bins / (m_scaleB.max - m_scaleB.min)
+                : 0.0;
+  }
+
+  int bins() const { return m_bins; }
+
+  // Accumulate the planes [z0, z1), and the SSIM of the windows centered in
+  // them
+  void accumulate(int z0, int z1, Accumulator& sums) const
+  {
+    for (int z = z0; z < z1; ++z) {
+      accumulatePlane(z, sums);
+    }
+    accumulateSsim(std::max(z0, m_pad[2]),
+                   std::min(z1, m_dims[2] - m_pad[2]), sums);
+  }
+
+  SimilarityMetrics metrics(const Accumulator& sums) const
+  {
+    SimilarityMetrics metrics;
+    const double n = sums.count;
+    metrics.mse = sums.squaredError / n;
+    metrics.psnr =
+      10.0 * std::log10(m_dataRange * m_dataRange / metrics.mse);
+
+    double meanA = sums.sumA / n;
+    double meanB = sums.sumB / n;
+    double covariance = sums.sumAB / n - meanA * meanB;
+    double varianceA = std::max(sums.sumAA / n - meanA * meanA, 0.0);
+    double varianceB = std::max(sums.sumBB / n - meanB * meanB, 0.0);
+    metrics.ncc = covariance / std::sqrt(varianceA * varianceB);
+
+    std::vector<double> marginalA(m_bins, 0.0);
+    std::vector<double> marginalB(m_bins, 0.0);
+    for (int j = 0; j < m_bins; ++j) {
+      for (int i = 0; i < m_bins; ++i) {
+        double p = sums.histogram[i + static_cast<size_t>(m_bins) * j] / n;
+        marginalA[i] += p;
+        marginalB[j] += p;
+      }
+    }
+    for (int j = 0; j < m_bins; ++j) {
+      for (int i = 0; i < m_bins; ++i) {
+        double p = sums.histogram[i + static_cast<size_t>(m_bins) * j] / n;
+        if (p > 0.0) {
+          metrics.mutualInformation +=
+            p * std::log(p / (marginalA[i] * marginalB[j]));
+        }
+      }
+    }
+
+    metrics.ssim = sums.windows > 0 ? sums.ssim / sums.windows : nan;
+    return metrics;
+  }
+
+private:
+  int bin(double v, double min, double binsPerUnit) const
+  {
+    // Also the first bin for the NaN of a constant normalized volume
+    double b = (v - min) * binsPerUnit;
+    if (!(b > 0.0)) {
+      return 0;
+    }
+    return std::min(static_cast<int>(std::min(b, double(m_bins))),
+                    m_bins - 1);
+  }
+
+  void accumulatePlane(int z, Accumulator& sums) const
+  {
+    const float* a = m_a + m_plane * z;
+    const float* b = m_b + m_plane * z;
+    for (int64_t i = 0; i < m_plane; ++i) {
+      double va = m_scaleA(a[i]);
+      double vb = m_scaleB(b[i]);
+      double d = va - vb;
+      sums.squaredError += d * d;
+
+      double sa = va - m_scaleA.min;
+      double sb = vb - m_scaleB.min;
+      sums.sumA += sa;
+      sums.sumB += sb;
+      sums.sumAA += sa * sa;
+      sums.sumBB += sb * sb;
+      sums.sumAB += sa * sb;
+
+      int ba = bin(va, m_scaleA.min, m_binsA);
+      int bb = bin(vb, m_scaleB.min, m_binsB);
+      ++sums.histogram[ba + static_cast<size_t>(m_bins) * bb];
+    }
+    sums.count += static_cast<double>(m_plane);
+  }
+
+  // The sums of a, b, a^2, b^2 and a b over the z windows of the planes, one
+  // plane of each.
+  void addPlane(int z, double sign, std::vector<double>* windowSums) const
+  {
+    const float* a = m_a + m_plane * z;
+    const float* b = m_b + m_plane * z;
+    for (int64_t i = 0; i < m_plane; ++i) {
+      double va = m_scaleA(a[i]);
+      double vb = m_scaleB(b[i]);
+      windowSums[0][i] += sign * va;
+      windowSums[1][i] += sign * vb;
+      windowSums[2][i] += sign * va * va;
+      windowSums[3][i] += sign * vb * vb;
+      windowSums[4][i] += sign * va * vb;
+    }
+  }
+
+  // Sum the windows along x then y of a plane, for the window centers
+  // inside of it
+  void boxSum(const std::vector<double>& plane, std::vector<double>& rows,
+              std::vector<double>& result) const
+  {
+    const int nx = m_dims[0];
+    const int ny = m_dims[1];
+    const int wx = m_window[0];
+    const int wy = m_window[1];
+    const int ox = nx - wx + 1;
+    const int oy = ny - wy + 1;
+    for (int y = 0; y < ny; ++y) {
+      const double* line = plane.data() + static_cast<int64_t>(nx) * y;
+      double* out = rows.data() + static_cast<int64_t>(ox) * y;
+      double sum = 0.0;
+      for (int x = 0; x < wx; ++x) {
+        sum += line[x];
+      }
+      out[0] = sum;
+      for (int x = 1; x < ox; ++x) {
+        sum += line[x + wx - 1] - line[x - 1];
+        out[x] = sum;
+      }
+    }
+    for (int x = 0; x < ox; ++x) {
+      double sum = 0.0;
+      for (int y = 0; y < wy; ++y) {
+        sum += rows[x + static_cast<int64_t>(ox) * y];
+      }
+      result[x] = sum;
+      for (int y = 1; y < oy; ++y) {
+        sum += rows[x + static_cast<int64_t>(ox) * (y + wy - 1)] -
+               rows[x + static_cast<int64_t>(ox) * (y - 1)];
+        result[x + static_cast<int64_t>(ox) * y] = sum;
+      }
+    }
+  }
+
+  // The SSIM of the windows centered on the planes [z0, z1), with the window
+  // sums along z sliding from one plane to the next
+  void accumulateSsim(int z0, int z1, Accumulator& sums) const
+  {
+    if (z0 >= z1) {
+      return;
+    }
+    const int pz = m_pad[2];
+    const int64_t outputs = static_cast<int64_t>(m_dims[0] - m_window[0] + 1) *
+                            (m_dims[1] - m_window[1] + 1);
+    std::vector<double> windowSums[5];
+    std::vector<double> boxSums[5];
+    for (int q = 0; q < 5; ++q) {
+      windowSums[q].assign(m_plane, 0.0);
+      boxSums[q].resize(outputs);
+    }
+    std::vector<double> rows(m_plane);
+
+    const double count = static_cast<double>(m_window[0]) * m_window[1] *
+                         m_window[2];
+    const double covarianceNorm = count > 1.0 ? count / (count - 1.0) : 1.0;
+    const double c1 = std::pow(0.01 * m_dataRange, 2);
+    const double c2 = std::pow(0.03 * m_dataRange, 2);
+
+    for (int z = z0 - pz; z <= z0 + pz; ++z) {
+      addPlane(z, 1.0, windowSums);
+    }
+    for (int z = z0; z < z1; ++z) {
+      if (z > z0) {
+        addPlane(z + pz, 1.0, windowSums);
+        addPlane(z - pz - 1, -1.0, windowSums);
+      }
+      for (int q = 0; q < 5; ++q) {
+        boxSum(windowSums[q], rows, boxSums[q]);
+      }
+      for (int64_t i = 0; i < outputs; ++i) {
+        double ux = boxSums[0][i] / count;
+        double uy = boxSums[1][i] / count;
+        double vx = covarianceNorm * (boxSums[2][i] / count - ux * ux);
+        double vy = covarianceNorm * (boxSums[3][i] / count - uy * uy);
+        double vxy = covarianceNorm * (boxSums[4][i] / count - ux * uy);
+        sums.ssim += ((2.0 * ux * uy + c1) * (2.0 * vxy + c2)) /
+                     ((ux * ux + uy * uy + c1) * (vx + vy + c2));
+      }
+      sums.windows += outputs;
+    }
+  }
+
+  const float* m_a;
+  const float* m_b;
+  int m_dims[3];
+  int64_t m_plane;
+  int m_window[3];
+  int m_pad[3];
+  int m_bins;
+  Scaling m_scaleA;
+  Scaling m_scaleB;
+  double m_dataRange;
+  double m_binsA;
+  double m_binsB;
+};
+
+} // namespace
+
+SimilarityMetrics compareVolumes(const float* reference, const float* image,
+                                 const int dims[3],
+                                 const SimilarityOptions& options)
+{
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  using Ranges = std::pair<Range, Range>;
+  Ranges ranges = tbb::parallel_reduce(
+    tbb::blocked_range<int>(0, dims[2]), Ranges(),
+    [&](const tbb::blocked_range<int>& r, Ranges ranges) {
+      for (int z = r.begin(); z != r.end(); ++z) {
+        ranges.first.join(planeRange(reference + plane * z, plane));
+        ranges.second.join(planeRange(image + plane * z, plane));
+      }
+      return ranges;
+    },
+    [](Ranges a, const Ranges& b) {
+      a.first.join(b.first);
+      a.second.join(b.second);
+      return a;
+    });
+
+  const Comparison comparison(reference, image, dims, options, ranges.first,
+                              ranges.second);
+  Accumulator sums = tbb::parallel_reduce(
+    tbb::blocked_range<int>(0, dims[2]), Accumulator(comparison.bins()),
+    [&](const tbb::blocked_range<int>& r, Accumulator sums) {
+      comparison.accumulate(r.begin(), r.end(), sums);
+      return sums;
+    },
+    [](Accumulator a, const Accumulator& b) {
+      a.join(b);
+      return a;
+    });
+  return comparison.metrics(sums);
+}
+
+void compareSlices(const float* reference, const float* image,
+                   const int dims[3], const SimilarityOptions& options,
+                   SimilarityMetrics* metrics)
+{
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  const int sliceDims[3] = { dims[0], dims[1], 1 };
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    const float* a = reference + plane * z;
+    const float* b = image + plane * z;
+    const Comparison comparison(a, b, sliceDims, options,
+                                planeRange(a, plane), planeRange(b, plane));
+    Accumulator sums(comparison.bins());
+    comparison.accumulate(0, 1, sums);
+    metrics[z] = comparison.metrics(sums);
+  });
+}
+
+} // namespace native
+} // namespace tomviz
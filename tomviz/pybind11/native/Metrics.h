@@ -0,0 +1,55 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeMetrics_h
+#define tomvizNativeMetrics_h
+
+namespace tomviz {
+namespace native {
+
+struct SimilarityOptions
+{
+  // The range of the values, for the PSNR and the SSIM constants. The range
+  // of the reference is used when not positive.
+  double dataRange = 0.0;
+  // The number of histogram bins per volume for the mutual information
+  int bins = 64;
+  // The width of the SSIM window, along the axes at least as long
+  int window = 7;
+  // Scale each volume to [0, 1] by its minimum and maximum first, as
+  // SimilarityMetrics.py does with each slice
+  bool normalize = false;
+};
+
+struct SimilarityMetrics
+{
+  double mse = 0.0;
+  double psnr = 0.0;
+  // The normalized cross-correlation, or Pearson correlation coefficient
+  double ncc = 0.0;
+  // In nats, from the joint histogram
+  double mutualInformation = 0.0;
+  // The mean structural similarity over the windows inside the volumes, as
+  // skimage.metrics.structural_similarity() computes it by default
+  double ssim = 0.0;
+};
+
+/// Compare two Fortran ordered dims[0] x dims[1] x dims[2] volumes. All the
+/// metrics are accumulated in one pass over the volumes, after one pass for
+/// their ranges, with parallel reductions over slabs along z. The SSIM
+/// window sums slide along z within each slab, so that no volume sized
+/// temporary is needed.
+SimilarityMetrics compareVolumes(const float* reference, const float* image,
+                                 const int dims[3],
+                                 const SimilarityOptions& options);
+
+/// Compare the dims[2] pairs of dims[0] x dims[1] slices of two Fortran
+/// ordered volumes, one set of metrics per slice, the slices in parallel.
+void compareSlices(const float* reference, const float* image,
+                   const int dims[3], const SimilarityOptions& options,
+                   SimilarityMetrics* metrics);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,673 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "MicroscopyFiles.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+// The coded types of the DM tags and the SER elements do not agree, so each
+// reader maps its own to a ScalarType.
+bool dmImageType(int code, ScalarType& type)
+{
+  switch (code) {
+    case 1:
+      type = ScalarType::Int16;
+      return true;
+    case 2:
+      type = ScalarType::Float32;
+      return true;
+    case 3:
+      type = ScalarType::Complex64;
+      return true;
+    case 6:
+      type = ScalarType::UInt8;
+      return true;
+    case 7:
+      type = ScalarType::Int32;
+      return true;
+    case 9:
+      type = ScalarType::Int8;
+      return true;
+    case 10:
+      type = ScalarType::UInt16;
+      return true;
+    case 11:
+      type = ScalarType::UInt32;
+      return true;
+    case 12:
+      type = ScalarType::Float64;
+      return true;
+    case 13:
+      type = ScalarType::Complex128;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool serElementType(int code, ScalarType& type)
+{
+  static const ScalarType types[] = {
+    ScalarType::UInt8,     ScalarType::UInt16,    ScalarType::UInt32,
+    ScalarType::Int8,      ScalarType::Int16,     ScalarType::Int32,
+    ScalarType::Float32,   ScalarType::Float64,   ScalarType::Complex64,
+    ScalarType::Complex128
+  };
+  if (code < 1 || code > 10) {
+    return false;
+  }
+  type = types[code - 1];
+  return true;
+}
+
+// The size of a DM tag value of a coded type, 0 for a string, struct or
+// array
+std::size_t dmTagSize(uint64_t code)
+{
+  switch (code) {
+    case 8:
+    case 9:
+    case 10:
+      return 1;
+    case 2:
+    case 4:
+      return 2;
+    case 3:
+    case 5:
+    case 6:
+      return 4;
+    case 7:
+    case 11:
+    case 12:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+// Tag text is Latin-1, or UTF-16 code units for arrays of shorts
+void appendCharacter(std::string& text, uint32_t code)
+{
+  if (code < 0x80) {
+    text += static_cast<char>(code);
+  } else if (code < 0x800) {
+    text += static_cast<char>(0xC0 | (code >> 6));
+    text += static_cast<char>(0x80 | (code & 0x3F));
+  } else {
+    text += static_cast<char>(0xE0 | ((code >> 12) & 0x0F));
+    text += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    text += static_cast<char>(0x80 | (code & 0x3F));
+  }
+}
+
+// The bytes of an array of type with dims, which must not be negative
+uint64_t arrayBytes(ScalarType type, const std::vector<int64_t>& dims)
+{
+  uint64_t bytes = scalarSize(type);
+  for (auto size : dims) {
+    auto count = static_cast<uint64_t>(size);
+    if (size < 0 ||
+        (count > 0 && bytes > std::numeric_limits<uint64_t>::max() / count)) {
+      throw std::runtime_error("Invalid image dimensions");
+    }
+    bytes *= count;
+  }
+  return bytes;
+}
+
+const double* number(const std::map<std::string, MetadataValue>& metadata,
+                     const std::string& name)
+{
+  auto it = metadata.find(name);
+  return it == metadata.end() ? nullptr : std::get_if<double>(&it->second);
+}
+
+} // namespace
+
+std::size_t scalarSize(ScalarType type)
+{
+  switch (type) {
+    case ScalarType::Int8:
+    case ScalarType::UInt8:
+      return 1;
+    case ScalarType::Int16:
+    case ScalarType::UInt16:
+      return 2;
+    case ScalarType::Int32:
+    case ScalarType::UInt32:
+    case ScalarType::Float32:
+      return 4;
+    case ScalarType::Int64:
+    case ScalarType::UInt64:
+    case ScalarType::Float64:
+    case ScalarType::Complex64:
+      return 8;
+    case ScalarType::Complex128:
+      return 16;
+  }
+  return 0;
+}
+
+int64_t MicroscopyDataset::frameSize() const
+{
+  int64_t size = 1;
+  for (int i = 0; i < frameAxes && i < static_cast<int>(dims.size()); ++i) {
+    size *= dims[i];
+  }
+  return size;
+}
+
+int64_t MicroscopyDataset::frameCount() const
+{
+  int64_t count = 1;
+  for (std::size_t i = frameAxes; i < dims.size(); ++i) {
+    count *= dims[i];
+  }
+  return count;
+}
+
+// The tag tree is a recursive structure of groups and tags, each prefixed by
+// its coded type, in big endian byte order, while the tag values are in the
+// byte order of the machine that wrote them, which is checked to be little
+// endian. Counts and types are 32 bit in DM3 files and 64 bit in DM4 ones.
+struct DmFile::Parser
+{
+  const MappedFile& file;
+  std::map<std::string, MetadataValue>& tags;
+  bool dm4;
+  uint64_t pos = 0;
+  int depth = 0;
+
+  template <typename T>
+  T read(bool bigEndian = false)
+  {
+    T result = file.value<T>(pos, bigEndian);
+    pos += sizeof(T);
+    return result;
+  }
+
+  uint64_t count()
+  {
+    return dm4 ? read<uint64_t>(true) : read<uint32_t>(true);
+  }
+
+  double value(uint64_t code)
+  {
+    switch (code) {
+      case 2:
+        return read<int16_t>();
+      case 3:
+        return read<int32_t>();
+      case 4:
+        return read<uint16_t>();
+      case 5:
+        return read<uint32_t>();
+      case 6:
+        return read<float>();
+      case 7:
+        return read<double>();
+      case 8:
+        return read<uint8_t>();
+      case 9:
+      case 10:
+        return read<int8_t>();
+      case 11:
+      case 12:
+        return static_cast<double>(read<uint64_t>());
+      default:
+        throw std::runtime_error("Unknown DM tag type");
+    }
+  }
+
+  void group(const std::string& name)
+  {
+    // dm.py gives up at the same depth
+    if (++depth > 64) {
+      throw std::runtime_error("The DM tags are nested too deep");
+    }
+    // Skip the sorted and open flags
+    pos += 2;
+    uint64_t entries = count();
+    for (uint64_t i = 1; i <= entries; ++i) {
+      entry(name, i);
+    }
+    --depth;
+  }
+
+  void entry(const std::string& parent, uint64_t index)
+  {
+    auto kind = read<uint8_t>();
+    auto length = read<uint16_t>(true);
+    file.check(pos, length);
+    std::string label;
+    if (length > 0) {
+      for (uint16_t i = 0; i < length; ++i) {
+        appendCharacter(label, file.data()[pos + i]);
+      }
+    } else {
+      label = std::to_string(index);
+    }
+    pos += length;
+
+    if (kind == 21) {
+      tag(parent, label);
+    } else if (kind == 20) {
+      if (dm4) {
+        // The size of the group
+        count();
+      }
+      group(parent + "." + label);
+    } else {
+      throw std::runtime_error("Unknown DM tag entry");
+    }
+  }
+
+  std::vector<uint64_t> structTypes()
+  {
+    // The length of the name of the struct
+    count();
+    uint64_t fields = count();
+    if (fields > 100) {
+      throw std::runtime_error("Too many fields in a DM struct");
+    }
+    std::vector<uint64_t> types(fields);
+    for (auto& type : types) {
+      // The length of the name of the field
+      count();
+      type = count();
+    }
+    return types;
+  }
+
+  std::vector<uint64_t> arrayTypes()
+  {
+    uint64_t type = count();
+    if (type == 15) {
+      return structTypes();
+    } else if (type == 20) {
+      return arrayTypes();
+    }
+    return { type };
+  }
+
+  void tag(const std::string& parent, const std::string& label)
+  {
+    if (dm4) {
+      // The size of the tag
+      count();
+    }
+    file.check(pos, 4);
+    if (std::string(reinterpret_cast<const char*>(file.data() + pos), 4) !=
+        "%%%%") {
+      throw std::runtime_error("Missing DM tag delimiter");
+    }
+    pos += 4;
+    // The number of type codes that follow
+    count();
+    uint64_t type = count();
+    const std::string name = parent + "." + label;
+
+    if (dmTagSize(type) > 0) {
+      tags[name] = value(type);
+    } else if (type == 18) {
+      auto length = read<uint32_t>(true);
+      file.check(pos, length);
+      std::string text;
+      for (uint32_t i = 0; i < length; ++i) {
+        appendCharacter(text, file.data()[pos + i]);
+      }
+      pos += length;
+      tags[name] = text;
+    } else if (type == 15) {
+      auto types = structTypes();
+      std::vector<double> fields;
+      for (auto field : types) {
+        fields.push_back(value(field));
+      }
+      tags[name] = fields;
+    } else if (type == 20) {
+      array(name, label);
+    } else {
+      throw std::runtime_error("Unknown DM tag type");
+    }
+  }
+
+  void array(const std::string& name, const std::string& label)
+  {
+    auto types = arrayTypes();
+    uint64_t length = count();
+    uint64_t itemSize = 0;
+    for (auto type : types) {
+      if (dmTagSize(type) == 0) {
+        throw std::runtime_error("Unknown DM array type");
+      }
+      itemSize += dmTagSize(type);
+    }
+    if (itemSize > 0 && length > file.size() / itemSize) {
+      throw std::runtime_error("Unexpected end of file");
+    }
+    uint64_t bytes = length * itemSize;
+    file.check(pos, bytes);
+
+    // Short arrays are text, as for the units of the calibrations, and the
+    // location of the longer ones is kept to read them later
+    if (label != "Data" && bytes < 1000) {
+      std::string text;
+      for (auto type : types) {
+        text.clear();
+        for (uint64_t i = 0; i < length; ++i) {
+          appendCharacter(text, static_cast<uint32_t>(value(type)));
+        }
+      }
+      tags[name] = text;
+    } else {
+      tags[name + ".arraySize"] = static_cast<double>(bytes);
+      tags[name + ".arrayOffset"] = static_cast<double>(pos);
+      tags[name + ".arrayType"] = static_cast<double>(types.back());
+      pos += bytes;
+    }
+  }
+};
+
+DmFile::DmFile(const std::string& fileName) : MicroscopyFile(fileName)
+{
+  m_version = static_cast<int>(m_file.value<uint32_t>(0, true));
+  if (m_version != 3 && m_version != 4) {
+    throw std::runtime_error("Not a DM3 or DM4 file: " + fileName);
+  }
+  const bool dm4 = m_version == 4;
+  uint64_t endianOffset = dm4 ? 12 : 8;
+  if (m_file.value<uint32_t>(endianOffset, true) != 1) {
+    throw std::runtime_error("Only little endian DM files can be read");
+  }
+
+  Parser parser{ m_file, m_metadata, dm4 };
+  parser.pos = endianOffset + 4;
+  parser.group("");
+
+  // The images, in the order of the ImageList, as dm.py lists them
+  const std::string list = ".ImageList.";
+  const std::string suffix = ".ImageData.Data.arrayOffset";
+  std::vector<std::pair<long, std::string>> images;
+  for (const auto& tag : m_metadata) {
+    const auto& name = tag.first;
+    if (name.size() <= list.size() + suffix.size() ||
+        name.compare(0, list.size(), list) != 0 ||
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) !=
+          0) {
+      continue;
+    }
+    auto number =
+      name.substr(list.size(), name.size() - suffix.size() - list.size());
+    if (number.find_first_not_of("0123456789") == std::string::npos &&
+        number.size() < 10) {
+      images.emplace_back(std::stol(number), list + number + ".ImageData.");
+    }
+  }
+  std::sort(images.begin(), images.end());
+
+  for (const auto& image : images) {
+    const auto& prefix = image.second;
+    auto code = number(m_metadata, prefix + "DataType");
+    // The RGB thumbnail, or a type without a numeric equivalent
+    MicroscopyDataset dataset;
+    if (!code || !dmImageType(static_cast<int>(*code), dataset.type)) {
+      continue;
+    }
+    for (int axis = 1; axis <= 4; ++axis) {
+      auto size = number(m_metadata, prefix + "Dimensions." +
+                                       std::to_string(axis));
+      if (!size) {
+        break;
+      }
+      // DM stores the dimensions as 32 bit unsigned integers
+      if (!(*size >= 1.0 &&
+            *size <= std::numeric_limits<uint32_t>::max())) {
+        throw std::runtime_error("Invalid DM image dimensions");
+      }
+      dataset.dims.push_back(static_cast<int64_t>(*size));
+
+      const std::string calibration =
+        prefix + "Calibrations.Dimension." + std::to_string(axis) + ".";
+      auto scale = number(m_metadata, calibration + "Scale");
+      auto origin = number(m_metadata, calibration + "Origin");
+      auto units = m_metadata.find(calibration + "Units");
+      dataset.scale.push_back(scale ? *scale : 1.0);
+      // DM origins are in pixels, from the first sample to the zero
+      dataset.origin.push_back(origin ? -*origin * dataset.scale.back() : 0.0);
+      dataset.units.push_back(
+        units != m_metadata.end() && std::holds_alternative<std::string>(
+                                       units->second)
+          ? std::get<std::string>(units->second)
+          : std::string());
+    }
+    if (dataset.dims.empty()) {
+      continue;
+    }
+    dataset.frameAxes = std::min(2, static_cast<int>(dataset.dims.size()));
+
+    uint64_t offset = static_cast<uint64_t>(
+      *number(m_metadata, prefix + "Data.arrayOffset"));
+    m_file.check(offset, arrayBytes(dataset.type, dataset.dims));
+    m_datasets.push_back(dataset);
+    m_offsets.push_back(offset);
+  }
+}
+
+void DmFile::readFrames(std::size_t dataset, int64_t first, int64_t last,
+                        void* out) const
+{
+  const auto& info = m_datasets.at(dataset);
+  // The frames are contiguous
+  const uint64_t frameBytes = info.frameSize() * scalarSize(info.type);
+  std::copy(m_file.data() + m_offsets[dataset] + first * frameBytes,
+            m_file.data() + m_offsets[dataset] + last * frameBytes,
+            static_cast<unsigned char*>(out));
+}
+
+SerFile::SerFile(const std::string& fileName) : MicroscopyFile(fileName)
+{
+  auto byteOrder = m_file.value<int16_t>(0);
+  auto seriesId = m_file.value<int16_t>(2);
+  auto version = m_file.value<int16_t>(4);
+  if (byteOrder != 0x4949 || seriesId != 0x0197) {
+    throw std::runtime_error("Not a little endian SER file: " + fileName);
+  }
+  if (version != 0x0210 && version != 0x0220) {
+    throw std::runtime_error("Unknown SER version");
+  }
+  // Offsets are 64 bit since TIA 4.7.3
+  const bool wide = version == 0x0220;
+  uint64_t pos = 6;
+  auto readInt = [this, &pos]() {
+    auto value = m_file.value<int32_t>(pos);
+    pos += 4;
+    return value;
+  };
+  auto readDouble = [this, &pos]() {
+    auto value = m_file.value<double>(pos);
+    pos += 8;
+    return value;
+  };
+  auto readOffset = [this, &pos, wide]() -> int64_t {
+    int64_t value =
+      wide ? m_file.value<int64_t>(pos) : m_file.value<int32_t>(pos);
+    pos += wide ? 8 : 4;
+    return value;
+  };
+  auto readText = [this, &pos](int32_t length) {
+    m_file.check(pos, static_cast<uint64_t>(std::max(length, 0)));
+    std::string text;
+    for (int32_t i = 0; i < length; ++i) {
+      appendCharacter(text, m_file.data()[pos + i]);
+    }
+    pos += std::max(length, 0);
+    return text;
+  };
+
+  const int32_t dataTypeId = readInt();
+  const int32_t tagTypeId = readInt();
+  const int32_t total = readInt();
+  const int32_t valid = readInt();
+  const int64_t offsetArrayOffset = readOffset();
+  const int32_t dimensionCount = readInt();
+  if (dataTypeId != 0x4120 && dataTypeId != 0x4122) {
+    throw std::runtime_error("Unknown SER data type");
+  }
+  if (total < 0 || valid < 0 || valid > total || dimensionCount < 0) {
+    throw std::runtime_error("Invalid SER header");
+  }
+  m_images = dataTypeId == 0x4122;
+
+  m_metadata["ByteOrder"] = static_cast<double>(byteOrder);
+  m_metadata["SeriesID"] = static_cast<double>(seriesId);
+  m_metadata["SeriesVersion"] = static_cast<double>(version);
+  m_metadata["DataTypeID"] = static_cast<double>(dataTypeId);
+  m_metadata["TagTypeID"] = static_cast<double>(tagTypeId);
+  m_metadata["TotalNumberElements"] = static_cast<double>(total);
+  m_metadata["ValidNumberElements"] = static_cast<double>(valid);
+  m_metadata["OffsetArrayOffset"] = static_cast<double>(offsetArrayOffset);
+  m_metadata["NumberDimensions"] = static_cast<double>(dimensionCount);
+
+  struct Dimension
+  {
+    int32_t size;
+    double offset;
+    double delta;
+    int32_t element;
+    std::string units;
+  };
+  std::vector<Dimension> dimensions;
+  for (int32_t i = 0; i < dimensionCount; ++i) {
+    Dimension dimension;
+    dimension.size = readInt();
+    dimension.offset = readDouble();
+    dimension.delta = readDouble();
+    dimension.element = readInt();
+    auto description = readText(readInt());
+    dimension.units = readText(readInt());
+
+    const std::string prefix = "Dimensions." + std::to_string(i) + ".";
+    m_metadata[prefix + "DimensionSize"] = static_cast<double>(dimension.size);
+    m_metadata[prefix + "CalibrationOffset"] = dimension.offset;
+    m_metadata[prefix + "CalibrationDelta"] = dimension.delta;
+    m_metadata[prefix + "CalibrationElement"] =
+      static_cast<double>(dimension.element);
+    m_metadata[prefix + "Description"] = description;
+    m_metadata[prefix + "Units"] = dimension.units;
+    dimensions.push_back(dimension);
+  }
+
+  if (valid == 0) {
+    return;
+  }
+
+  pos = static_cast<uint64_t>(offsetArrayOffset);
+  std::vector<uint64_t> elements(valid);
+  for (auto& offset : elements) {
+    offset = static_cast<uint64_t>(readOffset());
+  }
+
+  // Every element has its own calibration, type and shape, which must agree
+  // for them to make one dataset
+  MicroscopyDataset dataset;
+  std::vector<int64_t> shape;
+  const int axes = m_images ? 2 : 1;
+  for (std::size_t i = 0; i < elements.size(); ++i) {
+    pos = elements[i];
+    std::vector<double> scale;
+    std::vector<double> origin;
+    for (int axis = 0; axis < axes; ++axis) {
+      double offset = readDouble();
+      double delta = readDouble();
+      int32_t element = readInt();
+      scale.push_back(delta);
+      origin.push_back(offset - element * delta);
+    }
+    ScalarType type;
+    if (!serElementType(m_file.value<int16_t>(pos), type)) {
+      throw std::runtime_error("Unknown SER element type");
+    }
+    pos += 2;
+    std::vector<int64_t> elementShape;
+    for (int axis = 0; axis < axes; ++axis) {
+      elementShape.push_back(readInt());
+    }
+    if (i == 0) {
+      dataset.type = type;
+      dataset.scale = scale;
+      dataset.origin = origin;
+      shape = elementShape;
+    } else if (type != dataset.type || elementShape != shape) {
+      throw std::runtime_error("The SER elements differ in type or shape");
+    }
+    m_file.check(pos, arrayBytes(type, shape));
+    m_offsets.push_back(pos);
+  }
+
+  dataset.dims = shape;
+  dataset.frameAxes = axes;
+  dataset.units.assign(axes, m_images ? "m" : "");
+
+  // A map of spectra is laid out over the scan dimensions, as ser.py
+  // reshapes it, and other series have one axis for the elements
+  int64_t scanned = 1;
+  for (const auto& dimension : dimensions) {
+    scanned *= dimension.size;
+  }
+  std::vector<Dimension> frameAxes;
+  if (!m_images && dimensions.size() > 1 && scanned == valid) {
+    frameAxes = dimensions;
+  } else if (valid > 1) {
+    Dimension series{ valid, 0.0, 1.0, 0, std::string() };
+    if (!dimensions.empty()) {
+      series.offset = dimensions[0].offset;
+      series.delta = dimensions[0].delta;
+      series.element = dimensions[0].element;
+      series.units = dimensions[0].units;
+    }
+    frameAxes.push_back(series);
+  }
+  for (const auto& axis : frameAxes) {
+    dataset.dims.push_back(axis.size);
+    dataset.scale.push_back(axis.delta);
+    dataset.origin.push_back(axis.offset - axis.element * axis.delta);
+    dataset.units.push_back(axis.units);
+  }
+  m_datasets.push_back(dataset);
+}
+
+void SerFile::readFrames(std::size_t dataset, int64_t first, int64_t last,
+                         void* out) const
+{
+  const auto& info = m_datasets.at(dataset);
+  const std::size_t size = scalarSize(info.type);
+  const uint64_t frameBytes = info.frameSize() * size;
+  auto* target = static_cast<unsigned char*>(out);
+  for (int64_t frame = first; frame < last; ++frame) {
+    const unsigned char* source = m_file.data() + m_offsets[frame];
+    if (!m_images) {
+      std::copy(source, source + frameBytes, target);
+    } else {
+      // The rows of the images are stored bottom up
+      const uint64_t rowBytes = info.dims[0] * size;
+      const int64_t rows = info.dims[1];
+      for (int64_t row = 0; row < rows; ++row) {
+        std::copy(source + (rows - 1 - row) * rowBytes,
+                  source + (rows - row) * rowBytes, target + row * rowBytes);
+      }
+    }
+    target += frameBytes;
+  }
+}
+
+} // namespace native
+} // namespace tomviz
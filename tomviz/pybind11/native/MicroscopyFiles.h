@@ -0,0 +1,132 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeMicroscopyFiles_h
+#define tomvizNativeMicroscopyFiles_h
+
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+enum class ScalarType
+{
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Int64,
+  UInt64,
+  Float32,
+  Float64,
+  Complex64,
+  Complex128
+};
+
+std::size_t scalarSize(ScalarType type);
+
+/// A dataset stored as a stack of frames, its axes listed fastest first.
+/// The first frameAxes axes span a frame, an image or a spectrum, and the
+/// remaining ones count the frames.
+struct MicroscopyDataset
+{
+  ScalarType type = ScalarType::Float32;
+  std::vector<int64_t> dims;
+  int frameAxes = 2;
+  // The calibration of each axis, the origin being the coordinate of the
+  // first sample
+  std::vector<double> scale;
+  std::vector<double> origin;
+  std::vector<std::string> units;
+
+  int64_t frameSize() const;
+  int64_t frameCount() const;
+};
+
+/// A numeric, text or struct metadata value
+using MetadataValue =
+  std::variant<double, std::string, std::vector<double>>;
+
+/// A memory mapped microscopy file. The header is parsed when the file is
+/// opened, and the frames are copied from the mapping on demand, so that
+/// callers can copy ranges of frames from several threads at once.
+class MicroscopyFile
+{
+public:
+  virtual ~MicroscopyFile() = default;
+
+  const std::vector<MicroscopyDataset>& datasets() const { return m_datasets; }
+
+  /// The metadata, by the dotted names the Python readers give them.
+  const std::map<std::string, MetadataValue>& metadata() const
+  {
+    return m_metadata;
+  }
+
+  /// Copy the frames [first, last) of a dataset to out, one after the
+  /// other.
+  virtual void readFrames(std::size_t dataset, int64_t first, int64_t last,
+                          void* out) const = 0;
+
+protected:
+  explicit MicroscopyFile(const std::string& fileName) : m_file(fileName) {}
+
+  MappedFile m_file;
+  std::vector<MicroscopyDataset> m_datasets;
+  std::map<std::string, MetadataValue> m_metadata;
+};
+
+/// A Gatan DigitalMicrograph DM3 or DM4 file. The tag tree is parsed in
+/// place into metadata named as dm.py names its allTags, and every image
+/// other than the RGB thumbnail is a dataset, calibrated from its
+/// ImageData.Calibrations tags. Throws std::runtime_error for a file that
+/// is not a little endian DM3 or DM4 file.
+class DmFile : public MicroscopyFile
+{
+public:
+  explicit DmFile(const std::string& fileName);
+
+  int version() const { return m_version; }
+
+  void readFrames(std::size_t dataset, int64_t first, int64_t last,
+                  void* out) const override;
+
+private:
+  struct Parser;
+
+  int m_version = 0;
+  std::vector<uint64_t> m_offsets;
+};
+
+/// A FEI TIA SER series. The elements, spectra or images, are the frames of
+/// its one dataset, and the images are flipped along y as ser.py flips
+/// them. The header fields are the metadata, with the Dimensions flattened
+/// to "Dimensions.<i>.<field>". Throws std::runtime_error for a file that
+/// is not a little endian SER file, or whose elements differ in type or
+/// shape.
+class SerFile : public MicroscopyFile
+{
+public:
+  explicit SerFile(const std::string& fileName);
+
+  void readFrames(std::size_t dataset, int64_t first, int64_t last,
+                  void* out) const override;
+
+private:
+  // The offset of the data of each element, past its calibration
+  std::vector<uint64_t> m_offsets;
+  bool m_images = false;
+};
+
+} // namespace native
+} // namespace tomviz
+
+#endif
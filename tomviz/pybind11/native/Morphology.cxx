@@ -0,0 +1,676 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Morphology.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+// A large distance that stays finite through the distance transforms
+const double infinity = 1e30;
+
+struct Offset
+{
+  int dx;
+  int dy;
+  int dz;
+  int64_t step;
+};
+
+// The 6 face neighbours, or the 26 neighbours when fully connected
+std::vector<Offset> neighbours(const int dims[3], bool fullyConnected)
+{
+  std::vector<Offset> offsets;
+  for (int dz = -1; dz <= 1; ++dz) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        int order = std::abs(dx) + std::abs(dy) + std::abs(dz);
+        if (order == 0 || (!fullyConnected && order > 1)) {
+          continue;
+        }
+        offsets.push_back(
+          { dx, dy, dz,
+            dx + static_cast<int64_t>(dims[0]) *
+                   (dy + static_cast<int64_t>(dims[1]) * dz) });
+      }
+    }
+  }
+  return offsets;
+}
+
+bool inside(const int dims[3], int x, int y, int z, const Offset& o)
+{
+  return x + o.dx >= 0 && x + o.dx < dims[0] && y + o.dy >= 0 &&
+         y + o.dy < dims[1] && z + o.dz >= 0 && z + o.dz < dims[2];
+}
+
+void coordinates(const int dims[3], int64_t i, int& x, int& y, int& z)
+{
+  x = static_cast<int>(i % dims[0]);
+  i /= dims[0];
+  y = static_cast<int>(i % dims[1]);
+  z = static_cast<int>(i / dims[1]);
+}
+
+// A line of the ball along x: its offset along y and z, and its half width
+struct BallLine
+{
+  int dy;
+  int dz;
+  int halfWidth;
+};
+
+std::vector<BallLine> ballLines(const int radius[3])
+{
+  std::vector<BallLine> lines;
+  for (int dz = -radius[2]; dz <= radius[2]; ++dz) {
+    for (int dy = -radius[1]; dy <= radius[1]; ++dy) {
+      double ry = dy / (radius[1] + 0.5);
+      double rz = dz / (radius[2] + 0.5);
+      double rest = 1.0 - ry * ry - rz * rz;
+      if (rest < 0.0) {
+        continue;
+      }
+      int halfWidth = static_cast<int>((radius[0] + 0.5) * std::sqrt(rest));
+      lines.push_back({ dy, dz, std::min(halfWidth, radius[0]) });
+    }
+  }
+  return lines;
+}
+
+// The extremum over a window of 2 w + 1 voxels around each voxel of a line,
+// in constant time per voxel with the algorithm of van Herk and Gil-Werman.
+// The values beyond the line are the identity of the extremum.
+template <typename T, typename Best>
+void lineExtremum(const T* line, int n, int w, T identity, Best best,
+                  std::vector<T>& prefix, std::vector<T>& suffix, T* result)
+{
+  const int k = 2 * w + 1;
+  const int m = n + 2 * w;
+  prefix.resize(m);
+  suffix.resize(m);
+  auto padded = [&](int i) {
+    return i >= w && i < n + w ? line[i - w] : identity;
+  };
+  for (int i = 0; i < m; ++i) {
+    prefix[i] = i % k == 0 ? padded(i) : best(prefix[i - 1], padded(i));
+  }
+  for (int i = m - 1; i >= 0; --i) {
+    suffix[i] = i == m - 1 || (i + 1) % k == 0
+                  ? padded(i)
+                  : best(suffix[i + 1], padded(i));
+  }
+  for (int i = 0; i < n; ++i) {
+    result[i] = best(suffix[i], prefix[i + 2 * w]);
+  }
+}
+
+template <typename T, typename Best>
+void ballExtremum(const T* volume, const int dims[3], const int radius[3],
+                  T identity, Best best, T* result)
+{
+  const std::vector<BallLine> lines = ballLines(radius);
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    std::vector<T> prefix, suffix, filtered(dims[0]);
+    for (int y = 0; y < dims[1]; ++y) {
+      T* out = result + plane * z + static_cast<int64_t>(dims[0]) * y;
+      std::fill(out, out + dims[0], identity);
+      for (const auto& l : lines) {
+        int sy = y + l.dy;
+        int sz = z + l.dz;
+        if (sy < 0 || sy >= dims[1] || sz < 0 || sz >= dims[2]) {
+          continue;
+        }
+        const T* line =
+          volume + plane * sz + static_cast<int64_t>(dims[0]) * sy;
+        lineExtremum(line, dims[0], l.halfWidth, identity, best, prefix,
+                     suffix, filtered.data());
+        for (int x = 0; x < dims[0]; ++x) {
+          out[x] = best(out[x], filtered[x]);
+        }
+      }
+    }
+  });
+}
+
+// The squared distances of the lower envelope of the parabolas of f, at
+// positions i * scale, after Felzenszwalb and Huttenlocher (2012).
+void distanceTransform(const double* f, int n, double scale, double* d,
+                       int* v, double* z)
+{
+  auto position = [scale](int i) { return i * scale; };
+  auto intersection = [&](int q, int r) {
+    double pq = position(q);
+    double pr = position(r);
+    return ((f[q] + pq * pq) - (f[r] + pr * pr)) / (2.0 * (pq - pr));
+  };
+  int k = 0;
+  v[0] = 0;
+  z[0] = -std::numeric_limits<double>::infinity();
+  z[1] = std::numeric_limits<double>::infinity();
+  for (int q = 1; q < n; ++q) {
+    double s = intersection(q, v[k]);
+    while (s <= z[k]) {
+      --k;
+      s = intersection(q, v[k]);
+    }
+    ++k;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = std::numeric_limits<double>::infinity();
+  }
+  k = 0;
+  for (int q = 0; q < n; ++q) {
+    while (z[k + 1] < position(q)) {
+      ++k;
+    }
+    double delta = position(q) - position(v[k]);
+    d[q] = std::min(delta * delta + f[v[k]], infinity);
+  }
+}
+
+// Replace the values of distances, 0 at the sites and infinity elsewhere,
+// by the squared distances to the nearest site, the voxels scale[i] apart
+// along axis i. The lines along each axis are transformed in parallel.
+void squaredDistances(float* distances, const int dims[3],
+                      const double scale[3])
+{
+  const int64_t strides[3] = { 1, dims[0],
+                               static_cast<int64_t>(dims[0]) * dims[1] };
+  for (int axis = 0; axis < 3; ++axis) {
+    const int n = dims[axis];
+    const int a1 = axis == 0 ? 1 : 0;
+    const int a2 = axis == 2 ? 1 : 2;
+    tbb::parallel_for(0, dims[a2], [&](int j) {
+      std::vector<double> f(n), d(n), z(n + 1);
+      std::vector<int> v(n);
+      for (int i = 0; i < dims[a1]; ++i) {
+        float* line = distances + strides[a1] * i + strides[a2] * j;
+        for (int q = 0; q < n; ++q) {
+          f[q] = line[strides[axis] * q];
+        }
+        distanceTransform(f.data(), n, scale[axis], d.data(), v.data(),
+                          z.data());
+        for (int q = 0; q < n; ++q) {
+          line[strides[axis] * q] = static_cast<float>(d[q]);
+        }
+      }
+    });
+  }
+}
+
+// Binary morphology from the squared distances to the sites, scaled so that
+// the ball is the unit sphere
+template <typename Site, typename Keep>
+void binaryMorphology(const uint8_t* mask, const int dims[3],
+                      const int radius[3], Site site, Keep keep,
+                      uint8_t* result)
+{
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  std::vector<float> distances(size);
+  tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+    distances[i] = site(mask[i]) ? 0.0f : static_cast<float>(infinity);
+  });
+  double scale[3];
+  for (int i = 0; i < 3; ++i) {
+    scale[i] = 1.0 / (radius[i] + 0.5);
+  }
+  squaredDistances(distances.data(), dims, scale);
+  tbb::parallel_for(int64_t(0), size,
+                    [&](int64_t i) { result[i] = keep(distances[i]); });
+}
+
+template <typename T, bool Dilation>
+void reconstruct(const T* mask, T* marker, const int dims[3],
+                 bool fullyConnected)
+{
+  // Dilation raises the marker up to the mask, erosion lowers it down to it
+  auto above = [](T a, T b) { return Dilation ? a > b : a < b; };
+  auto raise = [&](T a, T b) { return above(a, b) ? a : b; };
+  auto limit = [&](T a, T b) { return above(a, b) ? b : a; };
+
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  tbb::parallel_for(int64_t(0), size,
+                    [&](int64_t i) { marker[i] = limit(marker[i], mask[i]); });
+
+  // The neighbours before a voxel in raster order, and those after it
+  std::vector<Offset> before, after;
+  for (const auto& o : neighbours(dims, fullyConnected)) {
+    (o.step < 0 ? before : after).push_back(o);
+  }
+
+  int64_t p = 0;
+  for (int z = 0; z < dims[2]; ++z) {
+    for (int y = 0; y < dims[1]; ++y) {
+      for (int x = 0; x < dims[0]; ++x, ++p) {
+        T value = marker[p];
+        for (const auto& o : before) {
+          if (inside(dims, x, y, z, o)) {
+            value = raise(value, marker[p + o.step]);
+          }
+        }
+        marker[p] = limit(value, mask[p]);
+      }
+    }
+  }
+
+  std::deque<int64_t> queue;
+  p = size - 1;
+  for (int z = dims[2] - 1; z >= 0; --z) {
+    for (int y = dims[1] - 1; y >= 0; --y) {
+      for (int x = dims[0] - 1; x >= 0; --x, --p) {
+        T value = marker[p];
+        for (const auto& o : after) {
+          if (inside(dims, x, y, z, o)) {
+            value = raise(value, marker[p + o.step]);
+          }
+        }
+        marker[p] = limit(value, mask[p]);
+        for (const auto& o : after) {
+          if (!inside(dims, x, y, z, o)) {
+            continue;
+          }
+          int64_t q = p + o.step;
+          if (above(marker[p], marker[q]) && above(mask[q], marker[q])) {
+            queue.push_back(p);
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  const std::vector<Offset> offsets = neighbours(dims, fullyConnected);
+  while (!queue.empty()) {
+    p = queue.front();
+    queue.pop_front();
+    int x, y, z;
+    coordinates(dims, p, x, y, z);
+    for (const auto& o : offsets) {
+      if (!inside(dims, x, y, z, o)) {
+        continue;
+      }
+      int64_t q = p + o.step;
+      if (above(marker[p], marker[q]) && marker[q] != mask[q]) {
+        marker[q] = limit(marker[p], mask[q]);
+        queue.push_back(q);
+      }
+    }
+  }
+}
+
+// The flat zones of the volume with no lower neighbour, labeled from 1,
+// the other voxels 0
+uint32_t regionalMinima(const float* volume, const int dims[3],
+                        bool fullyConnected, uint32_t* labels)
+{
+  const uint32_t visited = std::numeric_limits<uint32_t>::max();
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  std::fill(labels, labels + size, 0u);
+  const std::vector<Offset> offsets = neighbours(dims, fullyConnected);
+
+  uint32_t count = 0;
+  std::vector<int64_t> zone;
+  for (int64_t start = 0; start < size; ++start) {
+    if (labels[start] != 0) {
+      continue;
+    }
+    const float value = volume[start];
+    bool minimum = true;
+    zone.clear();
+    zone.push_back(start);
+    labels[start] = visited;
+    for (size_t i = 0; i < zone.size(); ++i) {
+      int64_t p = zone[i];
+      int x, y, z;
+      coordinates(dims, p, x, y, z);
+      for (const auto& o : offsets) {
+        if (!inside(dims, x, y, z, o)) {
+          continue;
+        }
+        int64_t q = p + o.step;
+        if (volume[q] < value) {
+          minimum = false;
+        } else if (volume[q] == value && labels[q] == 0) {
+          labels[q] = visited;
+          zone.push_back(q);
+        }
+      }
+    }
+    if (minimum) {
+      ++count;
+      for (int64_t p : zone) {
+        labels[p] = count;
+      }
+    }
+  }
+  tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+    if (labels[i] == visited) {
+      labels[i] = 0;
+    }
+  });
+  return count;
+}
+
+} // namespace
+
+void medianFilter(const float* volume, const int dims[3], float* result)
+{
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    float values[27];
+    for (int y = 0; y < dims[1]; ++y) {
+      for (int x = 0; x < dims[0]; ++x) {
+        int n = 0;
+        for (int dz = -1; dz <= 1; ++dz) {
+          int sz = std::min(std::max(z + dz, 0), dims[2] - 1);
+          for (int dy = -1; dy <= 1; ++dy) {
+            int sy = std::min(std::max(y + dy, 0), dims[1] - 1);
+            const float* line =
+              volume + plane * sz + static_cast<int64_t>(dims[0]) * sy;
+            for (int dx = -1; dx <= 1; ++dx) {
+              values[n++] = line[std::min(std::max(x + dx, 0), dims[0] - 1)];
+            }
+          }
+        }
+        std::nth_element(values, values + 13, values + 27);
+        result[plane * z + static_cast<int64_t>(dims[0]) * y + x] =
+          values[13];
+      }
+    }
+  });
+}
+
+void gaussianFilter(float* volume, const int dims[3], const double sigma[3])
+{
+  const int64_t strides[3] = { 1, dims[0],
+                               static_cast<int64_t>(dims[0]) * dims[1] };
+  for (int axis = 0; axis < 3; ++axis) {
+    if (sigma[axis] <= 0.0 || dims[axis] < 2) {
+      continue;
+    }
+    const int radius = static_cast<int>(std::ceil(4.0 * sigma[axis]));
+    std::vector<double> kernel(2 * radius + 1);
+    double sum = 0.0;
+    for (int i = -radius; i <= radius; ++i) {
+      kernel[i + radius] =
+        std::exp(-0.5 * i * i / (sigma[axis] * sigma[axis]));
+      sum += kernel[i + radius];
+    }
+    for (auto& k : kernel) {
+      k /= sum;
+    }
+
+    const int n = dims[axis];
+    const int a1 = axis == 0 ? 1 : 0;
+    const int a2 = axis == 2 ? 1 : 2;
+    tbb::parallel_for(0, dims[a2], [&](int j) {
+      std::vector<float> line(n);
+      for (int i = 0; i < dims[a1]; ++i) {
+        float* data = volume + strides[a1] * i + strides[a2] * j;
+        for (int q = 0; q < n; ++q) {
+          line[q] = data[strides[axis] * q];
+        }
+        for (int q = 0; q < n; ++q) {
+          double value = 0.0;
+          for (int k = -radius; k <= radius; ++k) {
+            int s = std::min(std::max(q + k, 0), n - 1);
+            value += kernel[k + radius] * line[s];
+          }
+          data[strides[axis] * q] = static_cast<float>(value);
+        }
+      }
+    });
+  }
+}
+
+template <typename T>
+void erode(const T* volume, const int dims[3], const int radius[3],
+           T* result)
+{
+  ballExtremum(volume, dims, radius, std::numeric_limits<T>::max(),
+               [](T a, T b) { return std::min(a, b); }, result);
+}
+
+template <typename T>
+void dilate(const T* volume, const int dims[3], const int radius[3],
+            T* result)
+{
+  ballExtremum(volume, dims, radius, std::numeric_limits<T>::lowest(),
+               [](T a, T b) { return std::max(a, b); }, result);
+}
+
+void binaryErode(const uint8_t* mask, const int dims[3], const int radius[3],
+                 uint8_t* result)
+{
+  // Keep the voxels with no voxel outside the mask in their ball
+  binaryMorphology(
+    mask, dims, radius, [](uint8_t v) { return v == 0; },
+    [](float d) { return d > 1.0f; }, result);
+}
+
+void binaryDilate(const uint8_t* mask, const int dims[3], const int radius[3],
+                  uint8_t* result)
+{
+  binaryMorphology(
+    mask, dims, radius, [](uint8_t v) { return v != 0; },
+    [](float d) { return d <= 1.0f; }, result);
+}
+
+void binaryClose(const uint8_t* mask, const int dims[3], const int radius[3],
+                 uint8_t* result)
+{
+  int padded[3];
+  for (int i = 0; i < 3; ++i) {
+    padded[i] = dims[i] + 2 * radius[i];
+  }
+  const int64_t size = static_cast<int64_t>(padded[0]) * padded[1] * padded[2];
+  // The offsets of the rows of the volume in the padded volume
+  auto row = [&](int y, int z) {
+    return radius[0] +
+           padded[0] * (y + radius[1] +
+                        static_cast<int64_t>(padded[1]) * (z + radius[2]));
+  };
+  auto line = [&](int y, int z) {
+    return dims[0] * (y + static_cast<int64_t>(dims[1]) * z);
+  };
+
+  std::vector<uint8_t> closed(size, 0);
+  std::vector<uint8_t> dilated(size);
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    for (int y = 0; y < dims[1]; ++y) {
+      std::copy(mask + line(y, z), mask + line(y, z) + dims[0],
+                closed.begin() + row(y, z));
+    }
+  });
+  binaryDilate(closed.data(), padded, radius, dilated.data());
+  binaryErode(dilated.data(), padded, radius, closed.data());
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    for (int y = 0; y < dims[1]; ++y) {
+      std::copy(closed.begin() + row(y, z),
+                closed.begin() + row(y, z) + dims[0], result + line(y, z));
+    }
+  });
+}
+
+template <typename T>
+void reconstructByDilation(const T* mask, T* marker, const int dims[3],
+                           bool fullyConnected)
+{
+  reconstruct<T, true>(mask, marker, dims, fullyConnected);
+}
+
+template <typename T>
+void reconstructByErosion(const T* mask, T* marker, const int dims[3],
+                          bool fullyConnected)
+{
+  reconstruct<T, false>(mask, marker, dims, fullyConnected);
+}
+
+template <typename T>
+void fillHoles(T* volume, const int dims[3], bool fullyConnected)
+{
+  // Erode from the border a marker at the maximum inside
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  std::vector<T> marker(size);
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    for (int y = 0; y < dims[1]; ++y) {
+      for (int x = 0; x < dims[0]; ++x) {
+        int64_t i = plane * z + static_cast<int64_t>(dims[0]) * y + x;
+        bool border = x == 0 || y == 0 || z == 0 || x == dims[0] - 1 ||
+                      y == dims[1] - 1 || z == dims[2] - 1;
+        marker[i] = border ? volume[i] : std::numeric_limits<T>::max();
+      }
+    }
+  });
+  reconstructByErosion(volume, marker.data(), dims, fullyConnected);
+  std::copy(marker.begin(), marker.end(), volume);
+}
+
+void signedDistance(const uint8_t* mask, const int dims[3],
+                    const double spacing[3], float* distance)
+{
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  const std::vector<Offset> faces = neighbours(dims, false);
+  tbb::parallel_for(0, dims[2], [&](int z) {
+    for (int y = 0; y < dims[1]; ++y) {
+      for (int x = 0; x < dims[0]; ++x) {
+        int64_t i = plane * z + static_cast<int64_t>(dims[0]) * y + x;
+        bool contour = false;
+        if (mask[i]) {
+          for (const auto& o : faces) {
+            if (inside(dims, x, y, z, o) && !mask[i + o.step]) {
+              contour = true;
+              break;
+            }
+          }
+        }
+        distance[i] = contour ? 0.0f : static_cast<float>(infinity);
+      }
+    }
+  });
+  squaredDistances(distance, dims, spacing);
+  tbb::parallel_for(int64_t(0), plane * dims[2], [&](int64_t i) {
+    float d = std::sqrt(distance[i]);
+    distance[i] = mask[i] ? d : -d;
+  });
+}
+
+uint32_t watershed(const float* volume, const int dims[3], double level,
+                   bool fullyConnected, uint32_t* labels)
+{
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  uint32_t count;
+  {
+    // The minima of the h-minima transform, which removes those shallower
+    // than level
+    std::vector<float> minima(volume, volume + size);
+    if (level > 0.0) {
+      const float h = static_cast<float>(level);
+      tbb::parallel_for(int64_t(0), size,
+                        [&](int64_t i) { minima[i] += h; });
+      reconstructByErosion(volume, minima.data(), dims, fullyConnected);
+    }
+    count = regionalMinima(minima.data(), dims, fullyConnected, labels);
+  }
+
+  // Flood the basins from their minima, lowest voxels first and in the
+  // order they were reached, with the voxels where basins meet on a line
+  const uint32_t line = std::numeric_limits<uint32_t>::max();
+  const std::vector<Offset> offsets = neighbours(dims, fullyConnected);
+  struct Entry
+  {
+    float value;
+    uint64_t order;
+    int64_t index;
+    bool operator<(const Entry& other) const
+    {
+      // The priority queue pops its largest entry
+      return value != other.value ? value > other.value
+                                  : order > other.order;
+    }
+  };
+  std::priority_queue<Entry> queue;
+  std::vector<uint8_t> queued(size, 0);
+  uint64_t order = 0;
+  auto push = [&](int64_t p) {
+    int x, y, z;
+    coordinates(dims, p, x, y, z);
+    for (const auto& o : offsets) {
+      if (!inside(dims, x, y, z, o)) {
+        continue;
+      }
+      int64_t q = p + o.step;
+      if (labels[q] == 0 && !queued[q]) {
+        queued[q] = 1;
+        queue.push({ volume[q], order++, q });
+      }
+    }
+  };
+  for (int64_t p = 0; p < size; ++p) {
+    if (labels[p] != 0) {
+      push(p);
+    }
+  }
+  while (!queue.empty()) {
+    int64_t p = queue.top().index;
+    queue.pop();
+    int x, y, z;
+    coordinates(dims, p, x, y, z);
+    uint32_t label = 0;
+    for (const auto& o : offsets) {
+      if (!inside(dims, x, y, z, o)) {
+        continue;
+      }
+      uint32_t neighbour = labels[p + o.step];
+      if (neighbour == 0 || neighbour == line) {
+        continue;
+      }
+      if (label == 0) {
+        label = neighbour;
+      } else if (neighbour != label) {
+        label = line;
+        break;
+      }
+    }
+    labels[p] = label;
+    if (label != line) {
+      push(p);
+    }
+  }
+  tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+    if (labels[i] == line) {
+      labels[i] = 0;
+    }
+  });
+  return count;
+}
+
+#define TOMVIZ_MORPHOLOGY_INSTANTIATE(T)                                      \
+  template void erode<T>(const T*, const int[3], const int[3], T*);          \
+  template void dilate<T>(const T*, const int[3], const int[3], T*);         \
+  template void reconstructByDilation<T>(const T*, T*, const int[3], bool);  \
+  template void reconstructByErosion<T>(const T*, T*, const int[3], bool);   \
+  template void fillHoles<T>(T*, const int[3], bool);
+
+TOMVIZ_MORPHOLOGY_INSTANTIATE(uint8_t)
+TOMVIZ_MORPHOLOGY_INSTANTIATE(uint32_t)
+TOMVIZ_MORPHOLOGY_INSTANTIATE(float)
+
+#undef TOMVIZ_MORPHOLOGY_INSTANTIATE
+
+} // namespace native
+} // namespace tomviz
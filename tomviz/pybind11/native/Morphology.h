@@ -0,0 +1,88 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeMorphology_h
+#define tomvizNativeMorphology_h
+
+#include <cstdint>
+
+namespace tomviz {
+namespace native {
+
+// The volumes are Fortran ordered dims[0] x dims[1] x dims[2] arrays. The
+// filters are parallel over planes along z, except for the reconstructions
+// and the watershed, which propagate values through the whole volume from a
+// queue.
+//
+// The structuring elements are the balls of itk::FlatStructuringElement: the
+// offsets (i, j, k) with (i / (r0 + 0.5))^2 + (j / (r1 + 0.5))^2 +
+// (k / (r2 + 0.5))^2 <= 1 for a radius (r0, r1, r2). Voxels outside the
+// volume are ignored.
+
+/// The median of the 3 x 3 x 3 neighbourhood of each voxel, with the edge
+/// voxels repeated.
+void medianFilter(const float* volume, const int dims[3], float* result);
+
+/// Smooth the volume in place with a Gaussian of sigma voxels along each
+/// axis, truncated at 4 sigma and with the edge voxels repeated.
+void gaussianFilter(float* volume, const int dims[3], const double sigma[3]);
+
+/// The grayscale erosion (minimum) or dilation (maximum) over a ball, as
+/// the extrema of the lines of the ball along x, each in constant time per
+/// voxel. Instantiated for uint8_t, uint32_t and float.
+template <typename T>
+void erode(const T* volume, const int dims[3], const int radius[3],
+           T* result);
+template <typename T>
+void dilate(const T* volume, const int dims[3], const int radius[3],
+            T* result);
+
+/// The binary erosion or dilation over a ball of a mask, non-zero inside, in
+/// time independent of the radius: from a distance transform scaled by the
+/// radius along each axis.
+void binaryErode(const uint8_t* mask, const int dims[3], const int radius[3],
+                 uint8_t* result);
+void binaryDilate(const uint8_t* mask, const int dims[3], const int radius[3],
+                  uint8_t* result);
+
+/// The binary closing of a mask over a ball, computed in a volume padded by
+/// the radius so that the sides of the volume do not cut it, as the SafeBorder
+/// of itk::GrayscaleMorphologicalClosingImageFilter does.
+void binaryClose(const uint8_t* mask, const int dims[3], const int radius[3],
+                 uint8_t* result);
+
+/// The morphological reconstruction by dilation of marker under mask, or by
+/// erosion above mask, in place in marker, with the hybrid algorithm of
+/// Vincent (1993). Voxels are connected to their 6 face neighbours, or 26
+/// neighbours when fully connected. Instantiated for uint8_t, uint32_t and
+/// float.
+template <typename T>
+void reconstructByDilation(const T* mask, T* marker, const int dims[3],
+                           bool fullyConnected);
+template <typename T>
+void reconstructByErosion(const T* mask, T* marker, const int dims[3],
+                          bool fullyConnected);
+
+/// Fill in place the regional minima of the volume that do not reach its
+/// border, as itk::GrayscaleFillholeImageFilter does.
+template <typename T>
+void fillHoles(T* volume, const int dims[3], bool fullyConnected);
+
+/// The signed Euclidean distance, in the units of spacing, from each voxel
+/// to the nearest voxel of the contour of the mask (the mask voxels with a
+/// face neighbour outside it), positive inside, as
+/// itk::SignedMaurerDistanceMapImageFilter computes it with InsideIsPositive.
+void signedDistance(const uint8_t* mask, const int dims[3],
+                    const double spacing[3], float* distance);
+
+/// The morphological watershed of the volume: its minima deeper than level
+/// are labeled 1 to the returned count and flooded in order of value, and
+/// the voxels where basins meet are left at 0, as
+/// itk::MorphologicalWatershedImageFilter does with MarkWatershedLine.
+uint32_t watershed(const float* volume, const int dims[3], double level,
+                   bool fullyConnected, uint32_t* labels);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
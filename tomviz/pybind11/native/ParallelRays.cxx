@@ -0,0 +1,153 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "ParallelRays.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+double removeEpsilon(double value)
+{
+  return std::abs(value) < 1e-10 ? 0.0 : value;
+}
+
+struct Crossing
+{
+  double t, x, y;
+};
+
+// Trace one ray the way parallelRay() does: collect the crossings with the
+// grid lines, keep those on the grid, and measure the segments between them.
+void traceRay(int nside, double x0, double y0, double a, double b,
+              std::vector<Crossing>& crossings, std::vector<int32_t>& pixels,
+              std::vector<float>& lengths)
+{
+  const double half = nside * 0.5;
+  crossings.clear();
+  for (int k = 0; k <= nside; ++k) {
+    double line = k - half;
+    if (a != 0.0) {
+      double t = (line - x0) / a;
+      crossings.push_back({ t, line, b * t + y0 });
+    }
+    if (b != 0.0) {
+      double t = (line - y0) / b;
+      crossings.push_back({ t, a * t + x0, line });
+    }
+  }
+  std::sort(crossings.begin(), crossings.end(),
+            [](const Crossing& l, const Crossing& r) { return l.t < r.t; });
+  crossings.erase(std::remove_if(crossings.begin(), crossings.end(),
+                                 [half](const Crossing& c) {
+                                   return c.x < -half || c.x > half ||
+                                          c.y < -half || c.y > half;
+                                 }),
+                  crossings.end());
+  // Crossings of a corner are found on both lines
+  crossings.erase(std::unique(crossings.begin(), crossings.end(),
+                              [](const Crossing& l, const Crossing& r) {
+                                return std::abs(r.x - l.x) <= 1e-8 &&
+                                       std::abs(r.y - l.y) <= 1e-8;
+                              }),
+                  crossings.end());
+
+  // Rays along the top or right edge of the grid belong to no pixel
+  if ((b == 0.0 && std::abs(y0 - half) < 1e-15) ||
+      (a == 0.0 && std::abs(x0 - half) < 1e-15)) {
+    return;
+  }
+
+  for (size_t k = 1; k < crossings.size(); ++k) {
+    const auto& p = crossings[k - 1];
+    const auto& q = crossings[k];
+    double midX = removeEpsilon(0.5 * (p.x + q.x));
+    double midY = removeEpsilon(0.5 * (p.y + q.y));
+    auto row = static_cast<int32_t>(std::floor(half - midY));
+    auto column = static_cast<int32_t>(std::floor(midX + half));
+    if (row < 0 || row >= nside || column < 0 || column >= nside) {
+      continue;
+    }
+    pixels.push_back(row * nside + column);
+    lengths.push_back(static_cast<float>(std::hypot(q.x - p.x, q.y - p.y)));
+  }
+}
+
+} // namespace
+
+ParallelRays::ParallelRays(int nside, const std::vector<double>& angles,
+                           int nray)
+  : m_nside(nside), m_nray(nray), m_nangles(static_cast<int>(angles.size()))
+{
+  struct AngleRays
+  {
+    std::vector<int64_t> sizes;
+    std::vector<int32_t> pixels;
+    std::vector<float> lengths;
+  };
+  std::vector<AngleRays> traced(m_nangles);
+
+  tbb::parallel_for(0, m_nangles, [&](int i) {
+    auto& angle = traced[i];
+    angle.sizes.resize(nray);
+    angle.pixels.reserve(static_cast<size_t>(2) * nside * nray);
+    angle.lengths.reserve(static_cast<size_t>(2) * nside * nray);
+    std::vector<Crossing> crossings;
+
+    double theta = angles[i] * pi / 180.0;
+    double a = removeEpsilon(-std::sin(theta));
+    double b = removeEpsilon(std::cos(theta));
+    for (int j = 0; j < nray; ++j) {
+      double offset = j - (nray - 1) * 0.5;
+      double x0 = std::cos(theta) * offset;
+      double y0 = std::sin(theta) * offset;
+      x0 = std::abs(x0) < 1e-8 ? 0.0 : x0;
+      y0 = std::abs(y0) < 1e-8 ? 0.0 : y0;
+
+      auto before = angle.pixels.size();
+      traceRay(nside, x0, y0, a, b, crossings, angle.pixels, angle.lengths);
+      angle.sizes[j] = static_cast<int64_t>(angle.pixels.size() - before);
+    }
+  });
+
+  m_start.resize(numberOfRows() + 1);
+  m_start[0] = 0;
+  int64_t row = 0;
+  for (const auto& angle : traced) {
+    for (auto size : angle.sizes) {
+      m_start[row + 1] = m_start[row] + size;
+      ++row;
+    }
+  }
+  m_pixels.resize(m_start.back());
+  m_lengths.resize(m_start.back());
+  m_normSquared.resize(numberOfRows());
+
+  tbb::parallel_for(0, m_nangles, [&](int i) {
+    auto& angle = traced[i];
+    int64_t first = static_cast<int64_t>(i) * nray;
+    std::copy(angle.pixels.begin(), angle.pixels.end(),
+              m_pixels.begin() + m_start[first]);
+    std::copy(angle.lengths.begin(), angle.lengths.end(),
+              m_lengths.begin() + m_start[first]);
+    for (int j = 0; j < nray; ++j) {
+      const float* l = lengths(first + j);
+      float norm = 0.0f;
+      for (int64_t k = 0, n = size(first + j); k < n; ++k) {
+        norm += l[k] * l[k];
+      }
+      m_normSquared[first + j] = norm;
+    }
+  });
+}
+
+} // namespace native
+} // namespace tomviz
@@ -0,0 +1,73 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeParallelRays_h
+#define tomvizNativeParallelRays_h
+
+#include <cstdint>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+/// The parallel beam measurement matrix of the iterative reconstructions:
+/// for every tilt angle and every ray, the pixels of an nside x nside slice
+/// the ray crosses and the length of the ray in each of them. This is the
+/// matrix built by parallelRay() in Recon_ART.py (unit pixel and ray width),
+/// stored compactly by row. Row angle * nray + ray holds ray ray at angle
+/// angle, and pixel row * nside + column is at y = nside / 2 - row - 0.5 and
+/// x = column + 0.5 - nside / 2.
+class ParallelRays
+{
+public:
+  /// angles are in degrees
+  ParallelRays(int nside, const std::vector<double>& angles, int nray);
+
+  int nside() const { return m_nside; }
+  int nray() const { return m_nray; }
+  int numberOfAngles() const { return m_nangles; }
+  int64_t numberOfRows() const
+  {
+    return static_cast<int64_t>(m_nangles) * m_nray;
+  }
+
+  /// The pixels crossed by a ray and the lengths inside them
+  int64_t size(int64_t row) const { return m_start[row + 1] - m_start[row]; }
+  const int32_t* pixels(int64_t row) const
+  {
+    return m_pixels.data() + m_start[row];
+  }
+  const float* lengths(int64_t row) const
+  {
+    return m_lengths.data() + m_start[row];
+  }
+
+  /// The squared norm of a row
+  float normSquared(int64_t row) const { return m_normSquared[row]; }
+
+  /// The sum along a ray through the slice image
+  float project(int64_t row, const float* image) const
+  {
+    const int32_t* p = pixels(row);
+    const float* l = lengths(row);
+    float sum = 0.0f;
+    for (int64_t k = 0, n = size(row); k < n; ++k) {
+      sum += l[k] * image[p[k]];
+    }
+    return sum;
+  }
+
+private:
+  int m_nside;
+  int m_nray;
+  int m_nangles;
+  std::vector<int64_t> m_start;
+  std::vector<int32_t> m_pixels;
+  std::vector<float> m_lengths;
+  std::vector<float> m_normSquared;
+};
+
+} // namespace native
+} // namespace tomviz
+
+#endif
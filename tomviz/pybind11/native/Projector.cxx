@@ -0,0 +1,87 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Projector.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+} // namespace
+
+int projectionSize(const int dims[3])
+{
+  double diagonal = std::hypot(dims[1], dims[2]);
+  // numpy rounds halves to even
+  int size = static_cast<int>(std::nearbyint(diagonal));
+  return (size / 2) * 2 + 1;
+}
+
+void forwardProject(const float* volume, const int dims[3],
+                    const std::vector<double>& angles, int size,
+                    float* tiltSeries)
+{
+  const int nx = dims[0];
+  const int ny = dims[1];
+  const int nz = dims[2];
+  // The volume is centered in the size x size grid as np.pad() would
+  const int padY = (size - ny + 1) / 2;
+  const int padZ = (size - nz + 1) / 2;
+  const double center = (size - 1) / 2.0;
+  const int64_t columns = static_cast<int64_t>(angles.size()) * size;
+
+  tbb::parallel_for(int64_t(0), columns, [&](int64_t column) {
+    const int64_t a = column / size;
+    const int y = static_cast<int>(column % size);
+    double angle = angles[a] * pi / 180.0;
+    double c = std::cos(angle);
+    double s = std::sin(angle);
+
+    float* out = tiltSeries + nx * column;
+    std::fill(out, out + nx, 0.0f);
+
+    // The sample of output voxel (y, z) in the grid, as in the affine
+    // transform of scipy.ndimage.rotate(), shifted to the volume.
+    double inY = c * (y - center) - s * center + center - padY;
+    double inZ = -s * (y - center) - c * center + center - padZ;
+    for (int z = 0; z < size; ++z, inY += s, inZ += c) {
+      if (inY <= -1.0 || inZ <= -1.0 || inY >= ny || inZ >= nz) {
+        continue;
+      }
+      int y0 = static_cast<int>(std::floor(inY));
+      int z0 = static_cast<int>(std::floor(inZ));
+      float wy = static_cast<float>(inY - y0);
+      float wz = static_cast<float>(inZ - z0);
+      const float weights[4] = { (1 - wy) * (1 - wz), wy * (1 - wz),
+                                 (1 - wy) * wz, wy * wz };
+      const int corners[4][2] = {
+        { y0, z0 }, { y0 + 1, z0 }, { y0, z0 + 1 }, { y0 + 1, z0 + 1 }
+      };
+      for (int k = 0; k < 4; ++k) {
+        int cy = corners[k][0];
+        int cz = corners[k][1];
+        if (weights[k] == 0.0f || cy < 0 || cy >= ny || cz < 0 || cz >= nz) {
+          continue;
+        }
+        const float* line =
+          volume + nx * (cy + static_cast<int64_t>(ny) * cz);
+        const float w = weights[k];
+        for (int x = 0; x < nx; ++x) {
+          out[x] += w * line[x];
+        }
+      }
+    }
+  });
+}
+
+} // namespace native
+} // namespace tomviz
@@ -0,0 +1,33 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeProjector_h
+#define tomvizNativeProjector_h
+
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+/// The parallel beam projections of a volume tilted about the x axis, as
+/// GenerateTiltSeries.py computes them: the volume is centered in a size x
+/// size grid in the y-z plane, rotated by each angle (in degrees) with
+/// bilinear interpolation, as scipy.ndimage.rotate() does, and summed along
+/// z. The rotated volume is never built: every sample is interpolated and
+/// accumulated directly into its projection.
+///
+/// volume is a Fortran ordered dims[0] x dims[1] x dims[2] volume, and
+/// tiltSeries the Fortran ordered dims[0] x size x angles.size() result.
+/// The angles, and the y lines of each projection, are computed in parallel.
+void forwardProject(const float* volume, const int dims[3],
+                    const std::vector<double>& angles, int size,
+                    float* tiltSeries);
+
+/// The default projection size: the odd size that holds the volume at any
+/// angle.
+int projectionSize(const int dims[3]);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
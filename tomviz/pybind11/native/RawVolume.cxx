@@ -0,0 +1,167 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "RawVolume.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+template <std::size_t N>
+void swapBytes(unsigned char* data, int64_t count)
+{
+  for (int64_t i = 0; i < count; ++i, data += N) {
+    for (std::size_t j = 0; j < N / 2; ++j) {
+      std::swap(data[j], data[N - 1 - j]);
+    }
+  }
+}
+
+// Swap the elements of a row from big endian, complex numbers as pairs
+void swapRow(unsigned char* data, int64_t count, std::size_t elementSize)
+{
+  switch (elementSize) {
+    case 2:
+      swapBytes<2>(data, count);
+      break;
+    case 4:
+      swapBytes<4>(data, count);
+      break;
+    case 8:
+      swapBytes<8>(data, count);
+      break;
+    default:
+      break;
+  }
+}
+
+std::size_t elementSize(ScalarType type)
+{
+  switch (type) {
+    case ScalarType::Complex64:
+      return 4;
+    case ScalarType::Complex128:
+      return 8;
+    default:
+      return scalarSize(type);
+  }
+}
+
+} // namespace
+
+int64_t RawLayout::voxelSize() const
+{
+  return static_cast<int64_t>(scalarSize(type)) * components;
+}
+
+int64_t RawLayout::dataSize() const
+{
+  return voxelSize() * dims[0] * dims[1] * dims[2];
+}
+
+std::array<int64_t, 3> RawRegion::dims() const
+{
+  std::array<int64_t, 3> result;
+  for (int i = 0; i < 3; ++i) {
+    result[i] = std::max<int64_t>(0, (end[i] - begin[i]) / strides[i]);
+  }
+  return result;
+}
+
+int64_t RawRegion::rowCount() const
+{
+  auto d = dims();
+  return d[0] > 0 ? d[1] * d[2] : 0;
+}
+
+RawVolume::RawVolume(const std::string& fileName, const RawLayout& layout)
+  : m_file(fileName), m_layout(layout)
+{
+  if (layout.components < 1 ||
+      std::any_of(layout.dims.begin(), layout.dims.end(),
+                  [](int64_t d) { return d < 1; })) {
+    throw std::invalid_argument("Expected a positive size");
+  }
+
+  auto dataSize = static_cast<uint64_t>(layout.dataSize());
+  if (dataSize > m_file.size()) {
+    throw std::runtime_error("The file is smaller than the volume");
+  }
+  if (m_layout.headerSize < 0) {
+    m_layout.headerSize = static_cast<int64_t>(m_file.size() - dataSize);
+  }
+  m_file.check(m_layout.headerSize, dataSize);
+}
+
+RawRegion RawVolume::region() const
+{
+  RawRegion result;
+  result.end = m_layout.dims;
+  return result;
+}
+
+RawRegion RawVolume::region(const std::array<int64_t, 3>& begin,
+                            const std::array<int64_t, 3>& end,
+                            const std::array<int64_t, 3>& strides) const
+{
+  RawRegion result;
+  for (int i = 0; i < 3; ++i) {
+    if (strides[i] < 1) {
+      throw std::invalid_argument("Expected strides of at least 1");
+    }
+    result.end[i] = end[i] < 0 || end[i] > m_layout.dims[i] ? m_layout.dims[i]
+                                                            : end[i];
+    result.begin[i] =
+      begin[i] < 0 || begin[i] > result.end[i] ? 0 : begin[i];
+    result.strides[i] = strides[i];
+  }
+  return result;
+}
+
+void RawVolume::readRows(const RawRegion& region, int64_t first, int64_t last,
+                         void* out) const
+{
+  const auto dims = region.dims();
+  const int64_t voxelSize = m_layout.voxelSize();
+  const int64_t rowSize = dims[0] * voxelSize;
+  const auto* data = m_file.data() + m_layout.headerSize;
+  auto* output = static_cast<unsigned char*>(out);
+
+  const std::size_t element = elementSize(m_layout.type);
+  const bool swap = m_layout.bigEndian && element > 1;
+  const int64_t elements = dims[0] * voxelSize / element;
+
+  for (int64_t row = first; row < last; ++row, output += rowSize) {
+    int64_t y = region.begin[1] + (row % dims[1]) * region.strides[1];
+    int64_t z = region.begin[2] + (row / dims[1]) * region.strides[2];
+    if (m_layout.flipY) {
+      y = m_layout.dims[1] - 1 - y;
+    }
+
+    const auto* input =
+      data +
+      ((z * m_layout.dims[1] + y) * m_layout.dims[0] + region.begin[0]) *
+        voxelSize;
+    if (region.strides[0] == 1) {
+      std::memcpy(output, input, rowSize);
+    } else {
+      const int64_t step = region.strides[0] * voxelSize;
+      for (int64_t x = 0; x < dims[0]; ++x) {
+        std::memcpy(output + x * voxelSize, input + x * step, voxelSize);
+      }
+    }
+
+    if (swap) {
+      swapRow(output, elements, element);
+    }
+  }
+}
+
+} // namespace native
+} // namespace tomviz
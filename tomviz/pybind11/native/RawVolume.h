@@ -0,0 +1,83 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeRawVolume_h
+#define tomvizNativeRawVolume_h
+
+#include "MappedFile.h"
+#include "MicroscopyFiles.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace tomviz {
+namespace native {
+
+/// The layout of a volume stored without a header describing it: x fastest,
+/// then y, then z, with the components of a voxel interleaved.
+struct RawLayout
+{
+  ScalarType type = ScalarType::UInt8;
+  int components = 1;
+  std::array<int64_t, 3> dims = { { 1, 1, 1 } };
+  bool bigEndian = false;
+  // The rows along y are stored from the top, as 2D image formats do
+  bool flipY = false;
+  // The bytes before the data, or -1 when the data ends the file, as
+  // vtkImageReader assumes
+  int64_t headerSize = -1;
+
+  int64_t voxelSize() const;
+  int64_t dataSize() const;
+};
+
+/// A sub-volume [begin, end) along each axis, sampled every stride voxels.
+struct RawRegion
+{
+  std::array<int64_t, 3> begin = { { 0, 0, 0 } };
+  std::array<int64_t, 3> end = { { 0, 0, 0 } };
+  std::array<int64_t, 3> strides = { { 1, 1, 1 } };
+
+  /// The number of samples along each axis
+  std::array<int64_t, 3> dims() const;
+  /// The number of rows along x, each a line of samples at one y and z
+  int64_t rowCount() const;
+};
+
+/// A memory mapped raw volume. Only the pages of the rows of a region are
+/// touched when it is read, and the rows are copied, swapped to the native
+/// byte order, independently, so that callers can read ranges of rows from
+/// several threads at once. Throws std::runtime_error when the file is
+/// smaller than the layout.
+class RawVolume
+{
+public:
+  RawVolume(const std::string& fileName, const RawLayout& layout);
+
+  const RawLayout& layout() const { return m_layout; }
+
+  /// The whole volume
+  RawRegion region() const;
+
+  /// The region within [begin, end) sampled every strides voxels, the
+  /// bounds clamped to the volume as the HDF5 subsample bounds are. Throws
+  /// std::invalid_argument for a stride below 1.
+  RawRegion region(const std::array<int64_t, 3>& begin,
+                   const std::array<int64_t, 3>& end,
+                   const std::array<int64_t, 3>& strides) const;
+
+  /// Copy the rows [first, last) of region to out, one after the other,
+  /// out pointing at the first of them.
+  void readRows(const RawRegion& region, int64_t first, int64_t last,
+                void* out) const;
+
+private:
+  MappedFile m_file;
+  RawLayout m_layout;
+};
+
+} // namespace native
+} // namespace tomviz
+
+#endif
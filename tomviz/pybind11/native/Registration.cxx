@@ -0,0 +1,540 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Registration.h"
+
+#include "Fft.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+// Pyramid levels are not made smaller than this along either axis
+const int minimumLevelSize = 16;
+
+struct Image
+{
+  int nx = 0;
+  int ny = 0;
+  std::vector<float> data;
+
+  float at(int x, int y) const
+  {
+    return data[x + static_cast<int64_t>(nx) * y];
+  }
+};
+
+// Zero mean and unit standard deviation, so that the squared differences of
+// two images do not depend on their brightness and contrast.
+void normalize(Image& image)
+{
+  double sum = 0.0;
+  double sum2 = 0.0;
+  for (float v : image.data) {
+    sum += v;
+    sum2 += static_cast<double>(v) * v;
+  }
+  const double n = static_cast<double>(image.data.size());
+  const double mean = sum / n;
+  const double variance = std::max(sum2 / n - mean * mean, 0.0);
+  const float scale = variance > 0.0 ? 1.0f / std::sqrt(variance) : 1.0f;
+  for (float& v : image.data) {
+    v = static_cast<float>(v - mean) * scale;
+  }
+}
+
+Image downsample(const Image& image)
+{
+  Image half;
+  half.nx = image.nx / 2;
+  half.ny = image.ny / 2;
+  half.data.resize(static_cast<size_t>(half.nx) * half.ny);
+  for (int y = 0; y < half.ny; ++y) {
+    for (int x = 0; x < half.nx; ++x) {
+      half.data[x + static_cast<int64_t>(half.nx) * y] =
+        0.25f * (image.at(2 * x, 2 * y) + image.at(2 * x + 1, 2 * y) +
+                 image.at(2 * x, 2 * y + 1) + image.at(2 * x + 1, 2 * y + 1));
+    }
+  }
+  return half;
+}
+
+// The levels of the pyramid of an image, finest first, each normalized
+std::vector<Image> pyramid(const float* data, int nx, int ny, int levels)
+{
+  std::vector<Image> pyramid(1);
+  pyramid[0].nx = nx;
+  pyramid[0].ny = ny;
+  pyramid[0].data.assign(data, data + static_cast<int64_t>(nx) * ny);
+  while (static_cast<int>(pyramid.size()) < levels &&
+         pyramid.back().nx / 2 >= minimumLevelSize &&
+         pyramid.back().ny / 2 >= minimumLevelSize) {
+    pyramid.push_back(downsample(pyramid.back()));
+  }
+  for (auto& level : pyramid) {
+    normalize(level);
+  }
+  return pyramid;
+}
+
+// Bilinear interpolation in a Fortran ordered nx x ny image, false outside
+// of it
+inline bool sample(const float* data, int nx, int ny, double x, double y,
+                   float& value)
+{
+  if (x < 0.0 || y < 0.0 || x > nx - 1 || y > ny - 1) {
+    return false;
+  }
+  int ix = std::min(static_cast<int>(x), std::max(nx - 2, 0));
+  int iy = std::min(static_cast<int>(y), std::max(ny - 2, 0));
+  int jx = std::min(ix + 1, nx - 1);
+  int jy = std::min(iy + 1, ny - 1);
+  float fx = static_cast<float>(x - ix);
+  float fy = static_cast<float>(y - iy);
+  const float* below = data + static_cast<int64_t>(nx) * iy;
+  const float* above = data + static_cast<int64_t>(nx) * jy;
+  float b = below[ix] + fx * (below[jx] - below[ix]);
+  float a = above[ix] + fx * (above[jx] - above[ix]);
+  value = b + fy * (a - b);
+  return true;
+}
+
+inline bool sample(const Image& image, double x, double y, float& value)
+{
+  return sample(image.data.data(), image.nx, image.ny, x, y, value);
+}
+
+// Central differences, one sided on the edges
+void gradients(const Image& image, Image& gx, Image& gy)
+{
+  gx.nx = gy.nx = image.nx;
+  gx.ny = gy.ny = image.ny;
+  gx.data.resize(image.data.size());
+  gy.data.resize(image.data.size());
+  for (int y = 0; y < image.ny; ++y) {
+    int y0 = std::max(y - 1, 0);
+    int y1 = std::min(y + 1, image.ny - 1);
+    for (int x = 0; x < image.nx; ++x) {
+      int x0 = std::max(x - 1, 0);
+      int x1 = std::min(x + 1, image.nx - 1);
+      int64_t i = x + static_cast<int64_t>(image.nx) * y;
+      gx.data[i] = x1 > x0 ? (image.at(x1, y) - image.at(x0, y)) / (x1 - x0)
+                           : 0.0f;
+      gy.data[i] = y1 > y0 ? (image.at(x, y1) - image.at(x, y0)) / (y1 - y0)
+                           : 0.0f;
+    }
+  }
+}
+
+// The vertex of the parabola through the correlation around a peak
+double parabolicOffset(double below, double peak, double above)
+{
+  double curvature = below - 2.0 * peak + above;
+  if (curvature >= 0.0) {
+    return 0.0;
+  }
+  return std::max(-0.5, std::min(0.5, 0.5 * (below - above) / curvature));
+}
+
+// The translation t for which moving(x + t) best matches fixed(x), from the
+// peak of their circular correlation. The images are tapered to zero on
+// their edges first, as in AutoCrossCorrelationTiltImageAlignment.py.
+void correlationShift(const Image& fixed, const Image& moving,
+                      RegistrationMetric metric, double shift[2])
+{
+  const int nx = fixed.nx;
+  const int ny = fixed.ny;
+  const ImageFft fft(nx, ny);
+  std::vector<Complex> fixedSpectrum(fft.spectrumSize());
+  std::vector<Complex> movingSpectrum(fft.spectrumSize());
+  std::vector<Complex> work(fft.workSize());
+  std::vector<float> windowed(fixed.data.size());
+
+  auto transform = [&](const Image& image, std::vector<Complex>& spectrum) {
+    for (int y = 0; y < ny; ++y) {
+      double wy = std::sin(pi * (y + 1) / ny);
+      for (int x = 0; x < nx; ++x) {
+        double wx = std::sin(pi * (x + 1) / nx);
+        windowed[x + static_cast<int64_t>(nx) * y] =
+          static_cast<float>(image.at(x, y) * wx * wx * wy * wy);
+      }
+    }
+    fft.forward(windowed.data(), spectrum.data(), work.data());
+  };
+  transform(fixed, fixedSpectrum);
+  transform(moving, movingSpectrum);
+
+  for (size_t k = 0; k < fixedSpectrum.size(); ++k) {
+    Complex c = std::conj(fixedSpectrum[k]) * movingSpectrum[k];
+    if (metric == RegistrationMetric::PhaseCorrelation) {
+      c /= std::abs(c) + 1e-12f;
+    }
+    fixedSpectrum[k] = c;
+  }
+  std::vector<float>& correlation = windowed;
+  fft.inverse(fixedSpectrum.data(), correlation.data(), work.data());
+
+  int64_t peak = std::max_element(correlation.begin(), correlation.end()) -
+                 correlation.begin();
+  int px = static_cast<int>(peak % nx);
+  int py = static_cast<int>(peak / nx);
+  auto value = [&](int x, int y) {
+    return static_cast<double>(
+      correlation[(x + nx) % nx + static_cast<int64_t>(nx) * ((y + ny) % ny)]);
+  };
+  double peakValue = value(px, py);
+  shift[0] = px + parabolicOffset(value(px - 1, py), peakValue,
+                                  value(px + 1, py));
+  shift[1] = py + parabolicOffset(value(px, py - 1), peakValue,
+                                  value(px, py + 1));
+  if (shift[0] > nx / 2) {
+    shift[0] -= nx;
+  }
+  if (shift[1] > ny / 2) {
+    shift[1] -= ny;
+  }
+}
+
+// The parameters of a transform on one level, about the center c of the
+// image: W(x) = A (x - c) + c + d.
+struct Warp
+{
+  double a[4];
+  double d[2];
+  double angle;
+};
+
+int parameterCount(RegistrationModel model)
+{
+  switch (model) {
+    case RegistrationModel::Translation:
+      return 2;
+    case RegistrationModel::Rigid:
+      return 3;
+    default:
+      return 6;
+  }
+}
+
+// The mean squared difference of the overlapping pixels of fixed and the
+// warped moving image, with the normal equations of its Gauss-Newton step.
+// Returns false if the images barely overlap.
+bool evaluate(const Image& fixed, const Image& moving, const Image& gx,
+              const Image& gy, RegistrationModel model, const Warp& warp,
+              double& cost, double hessian[36], double gradient[6])
+{
+  const int n = parameterCount(model);
+  const double cx = 0.5 * (fixed.nx - 1);
+  const double cy = 0.5 * (fixed.ny - 1);
+  std::fill(hessian, hessian + n * n, 0.0);
+  std::fill(gradient, gradient + n, 0.0);
+  double sum = 0.0;
+  int64_t count = 0;
+  double j[6];
+  for (int y = 0; y < fixed.ny; ++y) {
+    double yc = y - cy;
+    for (int x = 0; x < fixed.nx; ++x) {
+      double xc = x - cx;
+      double wx = warp.a[0] * xc + warp.a[1] * yc + cx + warp.d[0];
+      double wy = warp.a[2] * xc + warp.a[3] * yc + cy + warp.d[1];
+      float m, dx = 0.0f, dy = 0.0f;
+      if (!sample(moving, wx, wy, m)) {
+        continue;
+      }
+      sample(gx, wx, wy, dx);
+      sample(gy, wx, wy, dy);
+      double r = m - fixed.at(x, y);
+
+      switch (model) {
+        case RegistrationModel::Translation:
+          j[0] = dx;
+          j[1] = dy;
+          break;
+        case RegistrationModel::Rigid: {
+          double c = std::cos(warp.angle);
+          double s = std::sin(warp.angle);
+          j[0] = dx * (-s * xc - c * yc) + dy * (c * xc - s * yc);
+          j[1] = dx;
+          j[2] = dy;
+          break;
+        }
+        case RegistrationModel::Affine:
+          j[0] = dx * xc;
+          j[1] = dx * yc;
+          j[2] = dy * xc;
+          j[3] = dy * yc;
+          j[4] = dx;
+          j[5] = dy;
+          break;
+      }
+      for (int p = 0; p < n; ++p) {
+        gradient[p] += j[p] * r;
+        for (int q = 0; q <= p; ++q) {
+          hessian[p * n + q] += j[p] * j[q];
+        }
+      }
+      sum += r * r;
+      ++count;
+    }
+  }
+  for (int p = 0; p < n; ++p) {
+    for (int q = p + 1; q < n; ++q) {
+      hessian[p * n + q] = hessian[q * n + p];
+    }
+  }
+  cost = count > 0 ? sum / count : 0.0;
+  return count * 4 >= static_cast<int64_t>(fixed.data.size());
+}
+
+// Solve the n x n system a x = b by Gaussian elimination with partial
+// pivoting, in place. Returns false if a is singular.
+bool solve(double* a, double* b, int n)
+{
+  for (int col = 0; col < n; ++col) {
+    int pivot = col;
+    for (int row = col + 1; row < n; ++row) {
+      if (std::abs(a[row * n + col]) > std::abs(a[pivot * n + col])) {
+        pivot = row;
+      }
+    }
+    if (std::abs(a[pivot * n + col]) < 1e-12) {
+      return false;
+    }
+    if (pivot != col) {
+      for (int k = 0; k < n; ++k) {
+        std::swap(a[col * n + k], a[pivot * n + k]);
+      }
+      std::swap(b[col], b[pivot]);
+    }
+    for (int row = col + 1; row < n; ++row) {
+      double f = a[row * n + col] / a[col * n + col];
+      for (int k = col; k < n; ++k) {
+        a[row * n + k] -= f * a[col * n + k];
+      }
+      b[row] -= f * b[col];
+    }
+  }
+  for (int row = n - 1; row >= 0; --row) {
+    for (int k = row + 1; k < n; ++k) {
+      b[row] -= a[row * n + k] * b[k];
+    }
+    b[row] /= a[row * n + row];
+  }
+  return true;
+}
+
+Warp step(const Warp& warp, RegistrationModel model, const double* delta,
+          double scale)
+{
+  Warp next = warp;
+  switch (model) {
+    case RegistrationModel::Translation:
+      next.d[0] += scale * delta[0];
+      next.d[1] += scale * delta[1];
+      break;
+    case RegistrationModel::Rigid:
+      next.angle += scale * delta[0];
+      next.a[0] = next.a[3] = std::cos(next.angle);
+      next.a[2] = std::sin(next.angle);
+      next.a[1] = -next.a[2];
+      next.d[0] += scale * delta[1];
+      next.d[1] += scale * delta[2];
+      break;
+    case RegistrationModel::Affine:
+      for (int i = 0; i < 4; ++i) {
+        next.a[i] += scale * delta[i];
+      }
+      next.d[0] += scale * delta[4];
+      next.d[1] += scale * delta[5];
+      break;
+  }
+  return next;
+}
+
+// Gauss-Newton iterations on one level, halving the steps that do not
+// decrease the cost.
+void refine(const Image& fixed, const Image& moving, RegistrationModel model,
+            int iterations, Warp& warp)
+{
+  Image gx, gy;
+  gradients(moving, gx, gy);
+
+  const int n = parameterCount(model);
+  const double size = std::max(fixed.nx, fixed.ny);
+  double cost, hessian[36], gradient[6];
+  if (!evaluate(fixed, moving, gx, gy, model, warp, cost, hessian,
+                gradient)) {
+    return;
+  }
+  double scale = 1.0;
+  for (int i = 0; i < iterations; ++i) {
+    double a[36], delta[6];
+    std::copy(hessian, hessian + n * n, a);
+    for (int p = 0; p < n; ++p) {
+      delta[p] = -gradient[p];
+    }
+    if (!solve(a, delta, n)) {
+      return;
+    }
+
+    Warp candidate = step(warp, model, delta, scale);
+    double candidateCost, candidateHessian[36], candidateGradient[6];
+    if (!evaluate(fixed, moving, gx, gy, model, candidate, candidateCost,
+                  candidateHessian, candidateGradient) ||
+        candidateCost > cost) {
+      scale *= 0.5;
+      if (scale < 1e-3) {
+        return;
+      }
+      continue;
+    }
+
+    warp = candidate;
+    cost = candidateCost;
+    std::copy(candidateHessian, candidateHessian + n * n, hessian);
+    std::copy(candidateGradient, candidateGradient + n, gradient);
+
+    // Stop once no pixel moves by more than a thousandth of a pixel
+    double largest = 0.0;
+    for (int p = 0; p < n; ++p) {
+      // The last two parameters are the translation, the others scale with
+      // the distance to the center
+      double reach = p >= n - 2 ? 1.0 : size;
+      largest = std::max(largest, std::abs(scale * delta[p]) * reach);
+    }
+    if (largest < 1e-3) {
+      return;
+    }
+    scale = std::min(1.0, 2.0 * scale);
+  }
+}
+
+// Pixel i of level l covers the pixels s i to s i + s - 1 of the images,
+// with s = 2^l, so its center is at s i + (s - 1) / 2.
+Warp toLevel(const AffineTransform& t, int level, const Image& image)
+{
+  const double s = std::ldexp(1.0, level);
+  const double o = 0.5 * (s - 1.0);
+  const double cx = 0.5 * (image.nx - 1);
+  const double cy = 0.5 * (image.ny - 1);
+  Warp warp;
+  warp.a[0] = t.m[0];
+  warp.a[1] = t.m[1];
+  warp.a[2] = t.m[3];
+  warp.a[3] = t.m[4];
+  warp.angle = std::atan2(t.m[3], t.m[0]);
+  double bx = (t.m[0] * o + t.m[1] * o + t.m[2] - o) / s;
+  double by = (t.m[3] * o + t.m[4] * o + t.m[5] - o) / s;
+  warp.d[0] = bx - cx + warp.a[0] * cx + warp.a[1] * cy;
+  warp.d[1] = by - cy + warp.a[2] * cx + warp.a[3] * cy;
+  return warp;
+}
+
+AffineTransform fromLevel(const Warp& warp, int level, const Image& image)
+{
+  const double s = std::ldexp(1.0, level);
+  const double o = 0.5 * (s - 1.0);
+  const double cx = 0.5 * (image.nx - 1);
+  const double cy = 0.5 * (image.ny - 1);
+  double bx = cx + warp.d[0] - warp.a[0] * cx - warp.a[1] * cy;
+  double by = cy + warp.d[1] - warp.a[2] * cx - warp.a[3] * cy;
+  AffineTransform t;
+  t.m[0] = warp.a[0];
+  t.m[1] = warp.a[1];
+  t.m[3] = warp.a[2];
+  t.m[4] = warp.a[3];
+  t.m[2] = s * bx + o - warp.a[0] * o - warp.a[1] * o;
+  t.m[5] = s * by + o - warp.a[2] * o - warp.a[3] * o;
+  return t;
+}
+
+AffineTransform registerPyramids(const std::vector<Image>& fixed,
+                                 const std::vector<Image>& moving,
+                                 const RegistrationOptions& options)
+{
+  const int coarsest = static_cast<int>(fixed.size()) - 1;
+  double shift[2];
+  correlationShift(fixed[coarsest], moving[coarsest], options.metric, shift);
+
+  Warp warp = toLevel(AffineTransform(), coarsest, fixed[coarsest]);
+  warp.d[0] = shift[0];
+  warp.d[1] = shift[1];
+  AffineTransform transform = fromLevel(warp, coarsest, fixed[coarsest]);
+  for (int level = coarsest; level >= 0; --level) {
+    warp = toLevel(transform, level, fixed[level]);
+    refine(fixed[level], moving[level], options.model, options.iterations,
+           warp);
+    transform = fromLevel(warp, level, fixed[level]);
+  }
+  return transform;
+}
+
+} // namespace
+
+AffineTransform registerImages(const float* fixed, const float* moving,
+                               int nx, int ny,
+                               const RegistrationOptions& options)
+{
+  int levels = std::max(options.levels, 1);
+  return registerPyramids(pyramid(fixed, nx, ny, levels),
+                          pyramid(moving, nx, ny, levels), options);
+}
+
+void registerPairs(const float* images, int nx, int ny, const int* pairs,
+                   int count, const RegistrationOptions& options,
+                   AffineTransform* transforms)
+{
+  // The pyramids of the images in the pairs, built once each
+  const int64_t pixels = static_cast<int64_t>(nx) * ny;
+  int imageCount = 0;
+  for (int i = 0; i < 2 * count; ++i) {
+    imageCount = std::max(imageCount, pairs[i] + 1);
+  }
+  std::vector<char> used(imageCount, 0);
+  for (int i = 0; i < 2 * count; ++i) {
+    used[pairs[i]] = 1;
+  }
+  const int levels = std::max(options.levels, 1);
+  std::vector<std::vector<Image>> pyramids(imageCount);
+  tbb::parallel_for(0, imageCount, [&](int i) {
+    if (used[i]) {
+      pyramids[i] = pyramid(images + pixels * i, nx, ny, levels);
+    }
+  });
+
+  tbb::parallel_for(0, count, [&](int i) {
+    transforms[i] = registerPyramids(pyramids[pairs[2 * i + 1]],
+                                     pyramids[pairs[2 * i]], options);
+  });
+}
+
+void warpImages(const float* images, int nx, int ny, int count,
+                const AffineTransform* transforms, float* result)
+{
+  const int64_t pixels = static_cast<int64_t>(nx) * ny;
+  tbb::parallel_for(0, count * ny, [&](int line) {
+    const int i = line / ny;
+    const int y = line % ny;
+    const double* m = transforms[i].m;
+    float* out = result + pixels * i + static_cast<int64_t>(nx) * y;
+    for (int x = 0; x < nx; ++x) {
+      if (!sample(images + pixels * i, nx, ny, m[0] * x + m[1] * y + m[2],
+                  m[3] * x + m[4] * y + m[5], out[x])) {
+        out[x] = 0.0f;
+      }
+    }
+  });
+}
+
+} // namespace native
+} // namespace tomviz
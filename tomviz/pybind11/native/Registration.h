@@ -0,0 +1,72 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeRegistration_h
+#define tomvizNativeRegistration_h
+
+namespace tomviz {
+namespace native {
+
+enum class RegistrationModel
+{
+  Translation,
+  Rigid,
+  Affine
+};
+
+enum class RegistrationMetric
+{
+  // The cross-correlation of the images, each normalized to zero mean and
+  // unit variance
+  CrossCorrelation,
+  // The cross-correlation with a whitened spectrum
+  PhaseCorrelation
+};
+
+struct RegistrationOptions
+{
+  RegistrationModel model = RegistrationModel::Translation;
+  RegistrationMetric metric = RegistrationMetric::CrossCorrelation;
+  // The number of levels of the image pyramid, 1 for the images alone
+  int levels = 3;
+  // The maximum number of Gauss-Newton iterations per level
+  int iterations = 50;
+};
+
+/// An affine map from the pixel coordinates (along x, y) of a fixed image to
+/// those of a moving image: (m[0] x + m[1] y + m[2], m[3] x + m[4] y + m[5]).
+struct AffineTransform
+{
+  double m[6] = { 1.0, 0.0, 0.0, 0.0, 1.0, 0.0 };
+};
+
+/// Register a moving image to a fixed one, both Fortran ordered nx x ny
+/// images. The translation is first found over the whole image on the
+/// coarsest level of a pyramid of 2 x 2 averages, from the peak of the
+/// correlation of the metric. The transform of the model is then refined
+/// level by level with Gauss-Newton iterations minimizing the mean squared
+/// difference of the overlapping pixels of the images, each normalized to
+/// zero mean and unit variance over the whole image. This is not the
+/// normalized cross-correlation of the overlap: the images are not
+/// renormalized over it.
+AffineTransform registerImages(const float* fixed, const float* moving,
+                               int nx, int ny,
+                               const RegistrationOptions& options);
+
+/// Register count pairs of the Fortran ordered nx x ny images of a stack, in
+/// parallel: pairs[2 i] is the index of the moving image of pair i, and
+/// pairs[2 i + 1] that of its fixed image.
+void registerPairs(const float* images, int nx, int ny, const int* pairs,
+                   int count, const RegistrationOptions& options,
+                   AffineTransform* transforms);
+
+/// Resample each of the count images by its transform, with bilinear
+/// interpolation and zeros outside, so that the moving images line up with
+/// their fixed images. The images are resampled in parallel.
+void warpImages(const float* images, int nx, int ny, int count,
+                const AffineTransform* transforms, float* result);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
@@ -0,0 +1,469 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Segmentation.h"
+
+#include "Morphology.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+// The number of histogram bins of itk::OtsuMultipleThresholdsImageFilter
+const int otsuBins = 128;
+
+// The search of multiOtsuThresholds(), with the prefix sums of the counts
+// and of the counts times the bin indices
+class OtsuSearch
+{
+public:
+  OtsuSearch(const std::vector<int64_t>& counts, int count,
+             bool valleyEmphasis)
+    : m_bins(static_cast<int>(counts.size())), m_count(count),
+      m_valleyEmphasis(valleyEmphasis), m_counts(m_bins + 1, 0.0),
+      m_sums(m_bins + 1, 0.0), m_indices(count), m_best(count)
+  {
+    for (int i = 0; i < m_bins; ++i) {
+      m_counts[i + 1] = m_counts[i] + counts[i];
+      m_sums[i + 1] = m_sums[i] + static_cast<double>(i) * counts[i];
+    }
+    m_total = m_counts[m_bins];
+  }
+
+  std::vector<int> search()
+  {
+    // The last threshold leaves at least one bin above it
+    next(0, 0, 0.0, 0.0);
+    return m_best;
+  }
+
+private:
+  // The contribution of the bins [begin, end) to the between-class
+  // variance, up to constants
+  double variance(int begin, int end) const
+  {
+    double n = m_counts[end] - m_counts[begin];
+    if (n <= 0.0) {
+      return 0.0;
+    }
+    double s = m_sums[end] - m_sums[begin];
+    return s * s / n;
+  }
+
+  void next(int threshold, int first, double variances, double valley)
+  {
+    if (threshold == m_count) {
+      double value = variances + variance(first, m_bins);
+      if (m_valleyEmphasis) {
+        value *= 1.0 - valley / m_total;
+      }
+      if (value > m_value) {
+        m_value = value;
+        m_best = m_indices;
+      }
+      return;
+    }
+    const int remaining = m_count - threshold - 1;
+    for (int t = first; t < m_bins - 1 - remaining; ++t) {
+      m_indices[threshold] = t;
+      next(threshold + 1, t + 1, variances + variance(first, t + 1),
+           valley + (m_counts[t + 1] - m_counts[t]));
+    }
+  }
+
+  int m_bins;
+  int m_count;
+  bool m_valleyEmphasis;
+  std::vector<double> m_counts;
+  std::vector<double> m_sums;
+  double m_total;
+  std::vector<int> m_indices;
+  std::vector<int> m_best;
+  double m_value = -std::numeric_limits<double>::infinity();
+};
+
+double binEdge(const Histogram& h, int bin)
+{
+  return h.minimum + (h.maximum - h.minimum) * bin / h.counts.size();
+}
+
+std::vector<double> otsuThreshold(const float* values, int64_t size)
+{
+  return multiOtsuThresholds(histogram(values, size, otsuBins), 1, false);
+}
+
+// The radius in voxels along each axis of a ball of a physical radius, at
+// least 1 as in SegmentPores.py
+void ballRadius(double radius, const double spacing[3], int result[3])
+{
+  for (int i = 0; i < 3; ++i) {
+    result[i] = std::max(1, static_cast<int>(std::round(radius / spacing[i])));
+  }
+}
+
+// Runs the steps of a pipeline, reporting the progress after each
+class Steps
+{
+public:
+  Steps(int count, const std::function<bool(double)>& progress)
+    : m_count(count), m_progress(progress)
+  {
+  }
+
+  // Returns false if the pipeline was canceled
+  bool done()
+  {
+    ++m_done;
+    return !m_progress || !m_progress(static_cast<double>(m_done) / m_count);
+  }
+
+private:
+  int m_count;
+  int m_done = 0;
+  const std::function<bool(double)>& m_progress;
+};
+
+} // namespace
+
+Histogram histogram(const float* values, int64_t size, int bins)
+{
+  Histogram h;
+  h.counts.assign(bins, 0);
+  if (size == 0) {
+    return h;
+  }
+  using Range = std::pair<float, float>;
+  Range range = tbb::parallel_reduce(
+    tbb::blocked_range<int64_t>(0, size), Range(values[0], values[0]),
+    [&](const tbb::blocked_range<int64_t>& r, Range range) {
+      for (auto i = r.begin(); i != r.end(); ++i) {
+        range.first = std::min(range.first, values[i]);
+        range.second = std::max(range.second, values[i]);
+      }
+      return range;
+    },
+    [](Range a, const Range& b) {
+      return Range(std::min(a.first, b.first), std::max(a.second, b.second));
+    });
+  h.minimum = range.first;
+  h.maximum = range.second;
+
+  const double scale =
+    h.maximum > h.minimum ? bins / (h.maximum - h.minimum) : 0.0;
+  tbb::enumerable_thread_specific<std::vector<int64_t>> counts(
+    std::vector<int64_t>(bins, 0));
+  tbb::parallel_for(tbb::blocked_range<int64_t>(0, size),
+                    [&](const tbb::blocked_range<int64_t>& r) {
+                      auto& local = counts.local();
+                      for (auto i = r.begin(); i != r.end(); ++i) {
+                        int bin = static_cast<int>((values[i] - h.minimum) *
+                                                   scale);
+                        ++local[std::min(std::max(bin, 0), bins - 1)];
+                      }
+                    });
+  for (const auto& local : counts) {
+    for (int i = 0; i < bins; ++i) {
+      h.counts[i] += local[i];
+    }
+  }
+  return h;
+}
+
+std::vector<double> multiOtsuThresholds(const Histogram& histogram, int count,
+                                        bool valleyEmphasis)
+{
+  const int bins = static_cast<int>(histogram.counts.size());
+  count = std::min(count, bins - 1);
+  if (count <= 0) {
+    return {};
+  }
+  OtsuSearch search(histogram.counts, count, valleyEmphasis);
+  std::vector<double> thresholds;
+  for (int index : search.search()) {
+    thresholds.push_back(binEdge(histogram, index + 1));
+  }
+  return thresholds;
+}
+
+void applyThresholds(const float* values, int64_t size,
+                     const std::vector<double>& thresholds, uint8_t* labels)
+{
+  tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+    uint8_t label = 0;
+    while (label < thresholds.size() && values[i] > thresholds[label]) {
+      ++label;
+    }
+    labels[i] = label;
+  });
+}
+
+bool binaryMinMaxCurvatureFlow(float* volume, const int dims[3],
+                               const double spacing[3], int stencilRadius,
+                               int iterations, double threshold,
+                               double timeStep,
+                               const std::function<bool(double)>& progress)
+{
+  const int64_t plane = static_cast<int64_t>(dims[0]) * dims[1];
+  const int64_t size = plane * dims[2];
+
+  // The offsets of the ball of the stencil
+  std::vector<int> stencil;
+  for (int k = -stencilRadius; k <= stencilRadius; ++k) {
+    for (int j = -stencilRadius; j <= stencilRadius; ++j) {
+      for (int i = -stencilRadius; i <= stencilRadius; ++i) {
+        if (i * i + j * j + k * k <= stencilRadius * stencilRadius) {
+          stencil.insert(stencil.end(), { i, j, k });
+        }
+      }
+    }
+  }
+  const double stencilSize = stencil.size() / 3.0;
+  double scale[3];
+  for (int i = 0; i < 3; ++i) {
+    scale[i] = 1.0 / spacing[i];
+  }
+
+  std::vector<float> next(size);
+  float* current = volume;
+  float* updated = next.data();
+  Steps steps(iterations, progress);
+  bool finished = true;
+  for (int iteration = 0; iteration < iterations && finished; ++iteration) {
+    tbb::parallel_for(0, dims[2], [&](int z) {
+      // The value at an offset, with the edge voxels repeated
+      auto at = [&](int x, int y, int z) {
+        x = std::min(std::max(x, 0), dims[0] - 1);
+        y = std::min(std::max(y, 0), dims[1] - 1);
+        z = std::min(std::max(z, 0), dims[2] - 1);
+        return static_cast<double>(
+          current[x + static_cast<int64_t>(dims[0]) * y + plane * z]);
+      };
+      for (int y = 0; y < dims[1]; ++y) {
+        for (int x = 0; x < dims[0]; ++x) {
+          const int p[3] = { x, y, z };
+          const double center = at(x, y, z);
+          double first[3], second[3], cross[3][3];
+          for (int i = 0; i < 3; ++i) {
+            int q[3] = { x, y, z };
+            q[i] = p[i] + 1;
+            double forward = at(q[0], q[1], q[2]);
+            q[i] = p[i] - 1;
+            double backward = at(q[0], q[1], q[2]);
+            first[i] = 0.5 * (forward - backward) * scale[i];
+            second[i] = (forward - 2.0 * center + backward) * scale[i] *
+                        scale[i];
+          }
+          for (int i = 0; i < 3; ++i) {
+            for (int j = i + 1; j < 3; ++j) {
+              double value = 0.0;
+              for (int si = -1; si <= 1; si += 2) {
+                for (int sj = -1; sj <= 1; sj += 2) {
+                  int q[3] = { x, y, z };
+                  q[i] += si;
+                  q[j] += sj;
+                  value += si * sj * at(q[0], q[1], q[2]);
+                }
+              }
+              cross[i][j] = 0.25 * value * scale[i] * scale[j];
+            }
+          }
+
+          double magnitude = 0.0;
+          for (int i = 0; i < 3; ++i) {
+            magnitude += first[i] * first[i];
+          }
+          double update = 0.0;
+          if (magnitude > 1e-9) {
+            for (int i = 0; i < 3; ++i) {
+              double others = magnitude - first[i] * first[i];
+              update += second[i] * others;
+            }
+            for (int i = 0; i < 3; ++i) {
+              for (int j = i + 1; j < 3; ++j) {
+                update -= 2.0 * first[i] * first[j] * cross[i][j];
+              }
+            }
+            update /= magnitude;
+          }
+          if (update != 0.0) {
+            double mean = 0.0;
+            for (size_t s = 0; s < stencil.size(); s += 3) {
+              mean += at(x + stencil[s], y + stencil[s + 1],
+                         z + stencil[s + 2]);
+            }
+            mean /= stencilSize;
+            update = mean < threshold ? std::min(update, 0.0)
+                                      : std::max(update, 0.0);
+          }
+          updated[x + static_cast<int64_t>(dims[0]) * y + plane * z] =
+            static_cast<float>(center + timeStep * update);
+        }
+      }
+    });
+    std::swap(current, updated);
+    finished = steps.done();
+  }
+  if (current != volume) {
+    std::copy(current, current + size, volume);
+  }
+  return finished;
+}
+
+bool segmentParticles(const float* volume, const int dims[3], int radius,
+                      uint8_t* result,
+                      const std::function<bool(double)>& progress)
+{
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  const int ball[3] = { radius, radius, radius };
+  Steps steps(7, progress);
+
+  {
+    std::vector<float> smoothed(size);
+    medianFilter(volume, dims, smoothed.data());
+    if (!steps.done()) {
+      return false;
+    }
+
+    // Reduce the streaks and the artifacts far from the center
+    std::vector<float> opened(size);
+    erode(smoothed.data(), dims, ball, opened.data());
+    reconstructByDilation(smoothed.data(), opened.data(), dims, false);
+    smoothed = std::vector<float>();
+    if (!steps.done()) {
+      return false;
+    }
+
+    applyThresholds(opened.data(), size, otsuThreshold(opened.data(), size),
+                    result);
+    if (!steps.done()) {
+      return false;
+    }
+  }
+
+  // Remove the structures smaller than the ball, keeping the particle shapes
+  std::vector<uint8_t> particles(size);
+  binaryErode(result, dims, ball, particles.data());
+  reconstructByDilation(result, particles.data(), dims, false);
+  if (!steps.done()) {
+    return false;
+  }
+
+  // Fill in the pores
+  binaryClose(particles.data(), dims, ball, result);
+  std::copy(result, result + size, particles.begin());
+  if (!steps.done()) {
+    return false;
+  }
+  fillHoles(particles.data(), dims, false);
+  if (!steps.done()) {
+    return false;
+  }
+
+  // Disconnect the particles
+  binaryErode(particles.data(), dims, ball, result);
+  binaryDilate(result, dims, ball, particles.data());
+  std::copy(particles.begin(), particles.end(), result);
+  return steps.done();
+}
+
+bool segmentPores(const float* volume, const int dims[3],
+                  const double spacing[3], double minimumRadius,
+                  double maximumRadius, uint32_t* result,
+                  const std::function<bool(double)>& progress)
+{
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  Steps steps(8, progress);
+
+  // The material, after reducing the noise and enhancing the pore contrast
+  std::vector<uint8_t> material(size);
+  {
+    std::vector<float> enhanced(size);
+    medianFilter(volume, dims, enhanced.data());
+    if (!steps.done()) {
+      return false;
+    }
+
+    std::vector<float> blurred(enhanced);
+    const double maximumSpacing =
+      std::max({ spacing[0], spacing[1], spacing[2] });
+    double sigma[3];
+    for (int i = 0; i < 3; ++i) {
+      sigma[i] = 2.0 * maximumSpacing / spacing[i];
+    }
+    gaussianFilter(blurred.data(), dims, sigma);
+    tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+      enhanced[i] += 3.0f * (enhanced[i] - blurred[i]);
+    });
+    blurred = std::vector<float>();
+    if (!steps.done()) {
+      return false;
+    }
+
+    applyThresholds(enhanced.data(), size,
+                    otsuThreshold(enhanced.data(), size), material.data());
+    if (!steps.done()) {
+      return false;
+    }
+  }
+
+  // The particles, and the material encapsulated in them
+  int closing[3];
+  ballRadius(maximumRadius, spacing, closing);
+  std::vector<uint8_t> particles(size);
+  std::vector<uint8_t> encapsulated(size);
+  binaryClose(material.data(), dims, closing, particles.data());
+  binaryDilate(material.data(), dims, closing, encapsulated.data());
+  tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+    encapsulated[i] = material[i] || (encapsulated[i] != particles[i]);
+  });
+  if (!steps.done()) {
+    return false;
+  }
+
+  {
+    std::vector<float> distance(size);
+    signedDistance(encapsulated.data(), dims, spacing, distance.data());
+    encapsulated = std::vector<uint8_t>();
+    if (!steps.done()) {
+      return false;
+    }
+    watershed(distance.data(), dims, minimumRadius, true, result);
+    if (!steps.done()) {
+      return false;
+    }
+  }
+
+  // The basins outside the material and inside the particles
+  tbb::parallel_for(int64_t(0), size, [&](int64_t i) {
+    if (material[i] || !particles[i]) {
+      result[i] = 0;
+    }
+  });
+  material = std::vector<uint8_t>();
+  particles = std::vector<uint8_t>();
+  if (!steps.done()) {
+    return false;
+  }
+
+  int opening[3];
+  ballRadius(minimumRadius, spacing, opening);
+  std::vector<uint32_t> opened(size);
+  erode(result, dims, opening, opened.data());
+  reconstructByDilation(result, opened.data(), dims, false);
+  std::copy(opened.begin(), opened.end(), result);
+  return steps.done();
+}
+
+} // namespace native
+} // namespace tomviz
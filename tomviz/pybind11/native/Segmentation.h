@@ -0,0 +1,80 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeSegmentation_h
+#define tomvizNativeSegmentation_h
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+struct Histogram
+{
+  double minimum = 0.0;
+  double maximum = 0.0;
+  // Equal bins over [minimum, maximum], the maximum in the last one
+  std::vector<int64_t> counts;
+};
+
+/// The histogram of size values in bins, counted in parallel.
+Histogram histogram(const float* values, int64_t size, int bins);
+
+/// The count thresholds that maximize the variance between the classes of
+/// the histogram, by an exhaustive search as
+/// itk::OtsuMultipleThresholdsCalculator does, optionally weighted by the
+/// valley emphasis of Ng (2006). The thresholds are the upper edges of their
+/// bins.
+std::vector<double> multiOtsuThresholds(const Histogram& histogram, int count,
+                                        bool valleyEmphasis);
+
+/// Label each value with its class: 0 up to the first threshold (included),
+/// 1 up to the second, and so on.
+void applyThresholds(const float* values, int64_t size,
+                     const std::vector<double>& thresholds, uint8_t* labels);
+
+/// Smooth a binary image in place as itk::BinaryMinMaxCurvatureFlowImageFilter
+/// does. Each iteration adds timeStep times the update of
+/// itk::CurvatureFlowFunction, from derivatives scaled by the spacing with
+/// the edge voxels repeated. Where the mean over a ball of stencilRadius
+/// voxels is below threshold, the update may only lower the voxel, and
+/// elsewhere only raise it. Unlike itk::MinMaxCurvatureFlowFunction, which
+/// measures its threshold across the gradient, the threshold is fixed.
+/// progress is called with the fraction done after each iteration, and may
+/// return true to cancel, in which case it returns false and volume is left
+/// partially smoothed.
+bool binaryMinMaxCurvatureFlow(
+  float* volume, const int dims[3], const double spacing[3], int stencilRadius,
+  int iterations, double threshold, double timeStep,
+  const std::function<bool(double)>& progress = nullptr);
+
+// The pipelines of the segmentation operators, each keeping only the
+// intermediate volumes it still needs. progress is called with the fraction
+// done after each step, and may return true to cancel, in which case the
+// pipeline returns false.
+
+/// SegmentParticles.py: a median filter, an opening by reconstruction by a
+/// ball of radius voxels, an Otsu threshold, then the particles cleaned by
+/// another opening by reconstruction, closed, with their holes filled, and
+/// opened. The result is 1 in the particles and 0 elsewhere.
+bool segmentParticles(const float* volume, const int dims[3], int radius,
+                      uint8_t* result,
+                      const std::function<bool(double)>& progress = nullptr);
+
+/// SegmentPores.py: a median filter, an unsharp mask and an Otsu threshold of
+/// the material, closed by a ball of maximumRadius to find the particles.
+/// The pores are the watershed basins of the distance map of the
+/// encapsulated material, inside the particles and outside the material,
+/// opened by reconstruction by a ball of minimumRadius. The radii are in
+/// the units of spacing. The result labels the pores from 1.
+bool segmentPores(const float* volume, const int dims[3],
+                  const double spacing[3], double minimumRadius,
+                  double maximumRadius, uint32_t* result,
+                  const std::function<bool(double)>& progress = nullptr);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
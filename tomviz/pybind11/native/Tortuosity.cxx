@@ -0,0 +1,223 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include "Tortuosity.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace tomviz {
+namespace native {
+
+namespace {
+
+struct Step
+{
+  int dx, dy, dz;
+  int64_t offset;
+  float length;
+};
+
+std::vector<Step> neighborSteps(int connectivity, bool euclidean,
+                                int64_t nx, int64_t ny)
+{
+  std::vector<Step> steps;
+  for (int dz = -1; dz <= 1; ++dz) {
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        int order = std::abs(dx) + std::abs(dy) + std::abs(dz);
+        if (order == 0 || (connectivity == 6 && order > 1) ||
+            (connectivity == 18 && order > 2)) {
+          continue;
+        }
+        float length = euclidean ? std::sqrt(static_cast<float>(order)) : 1.0f;
+        steps.push_back({ dx, dy, dz, dx + nx * (dy + ny * dz), length });
+      }
+    }
+  }
+  return steps;
+}
+
+// Non-negative floats order the same way as their bit patterns, which lets
+// the tentative distances be lowered with an integer compare and swap.
+uint32_t toBits(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float fromBits(uint32_t bits)
+{
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Returns true if value is now the smallest distance recorded in target
+bool lowerTo(std::atomic<uint32_t>& target, uint32_t value)
+{
+  auto current = target.load(std::memory_order_relaxed);
+  while (value < current) {
+    if (target.compare_exchange_weak(current, value,
+                                     std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+bool geodesicDistance(const uint8_t* mask, const int dims[3], int face,
+                      int connectivity, bool euclidean, float* distance,
+                      const std::function<bool(double)>& progress)
+{
+  const int64_t nx = dims[0];
+  const int64_t ny = dims[1];
+  const int64_t nz = dims[2];
+  const int64_t count = nx * ny * nz;
+  if (count == 0) {
+    return true;
+  }
+
+  const auto steps = neighborSteps(connectivity, euclidean, nx, ny);
+  const uint32_t unreached = toBits(std::numeric_limits<float>::infinity());
+
+  std::unique_ptr<std::atomic<uint32_t>[]> tentative(
+    new std::atomic<uint32_t>[count]);
+  std::unique_ptr<std::atomic<uint8_t>[]> settled(
+    new std::atomic<uint8_t>[count]);
+  const int64_t phaseCount = tbb::parallel_reduce(
+    tbb::blocked_range<int64_t>(0, count), int64_t(0),
+    [&](const tbb::blocked_range<int64_t>& r, int64_t n) {
+      for (auto i = r.begin(); i != r.end(); ++i) {
+        tentative[i].store(unreached, std::memory_order_relaxed);
+        settled[i].store(0, std::memory_order_relaxed);
+        n += mask[i] != 0;
+      }
+      return n;
+    },
+    [](int64_t a, int64_t b) { return a + b; });
+
+  // Buckets are one unit (the shortest step) wide. A step out of a bucket
+  // always lands in a later one, so every voxel in the lowest bucket already
+  // has its final distance and the whole bucket can be expanded in parallel.
+  // Steps are at most sqrt(3) long, so voxels are only ever queued one or two
+  // buckets ahead, and three buckets are reused as a ring.
+  std::array<std::vector<int64_t>, 3> ring;
+
+  // The voxels on the starting face are at distance 1 (bucket 1)
+  const int axis = face / 2;
+  const int64_t dimensions[3] = { nx, ny, nz };
+  int64_t lo[3] = { 0, 0, 0 };
+  int64_t hi[3] = { nx, ny, nz };
+  lo[axis] = face % 2 == 0 ? 0 : dimensions[axis] - 1;
+  hi[axis] = lo[axis] + 1;
+  for (int64_t z = lo[2]; z < hi[2]; ++z) {
+    for (int64_t y = lo[1]; y < hi[1]; ++y) {
+      for (int64_t x = lo[0]; x < hi[0]; ++x) {
+        auto i = x + nx * (y + ny * z);
+        if (mask[i]) {
+          tentative[i].store(toBits(1.0f), std::memory_order_relaxed);
+          ring[1].push_back(i);
+        }
+      }
+    }
+  }
+
+  using Queues = std::array<std::vector<int64_t>, 3>;
+  tbb::enumerable_thread_specific<Queues> queued;
+  int64_t reached = 0;
+  int64_t reported = 0;
+  for (int64_t bucket = 1;
+       !ring[0].empty() || !ring[1].empty() || !ring[2].empty(); ++bucket) {
+    auto& current = ring[bucket % 3];
+    if (current.empty()) {
+      continue;
+    }
+
+    // Expanding the bucket in memory order keeps the neighbours in cache
+    tbb::parallel_sort(current.begin(), current.end());
+    reached += tbb::parallel_reduce(
+      tbb::blocked_range<size_t>(0, current.size(), 256), int64_t(0),
+      [&](const tbb::blocked_range<size_t>& r, int64_t n) {
+        auto& local = queued.local();
+        for (auto k = r.begin(); k != r.end(); ++k) {
+          auto i = current[k];
+          // A voxel may have been queued more than once on its way down
+          if (settled[i].exchange(1, std::memory_order_relaxed)) {
+            continue;
+          }
+          ++n;
+
+          float d = fromBits(tentative[i].load(std::memory_order_relaxed));
+          int64_t x = i % nx;
+          int64_t y = (i / nx) % ny;
+          int64_t z = i / (nx * ny);
+          for (const auto& step : steps) {
+            if (x + step.dx < 0 || x + step.dx >= nx || y + step.dy < 0 ||
+                y + step.dy >= ny || z + step.dz < 0 || z + step.dz >= nz) {
+              continue;
+            }
+            auto j = i + step.offset;
+            if (!mask[j] || settled[j].load(std::memory_order_relaxed)) {
+              continue;
+            }
+            float next = d + step.length;
+            if (lowerTo(tentative[j], toBits(next))) {
+              local[static_cast<int64_t>(next) % 3].push_back(j);
+            }
+          }
+        }
+        return n;
+      },
+      [](int64_t a, int64_t b) { return a + b; });
+
+    current.clear();
+    for (auto& local : queued) {
+      for (size_t s = 0; s < ring.size(); ++s) {
+        ring[s].insert(ring[s].end(), local[s].begin(), local[s].end());
+        local[s].clear();
+      }
+    }
+
+    if (progress && (reached - reported) * 100 >= phaseCount) {
+      reported = reached;
+      if (progress(static_cast<double>(reached) / phaseCount)) {
+        return false;
+      }
+    }
+  }
+
+  tbb::parallel_for(tbb::blocked_range<int64_t>(0, count),
+                    [&](const tbb::blocked_range<int64_t>& r) {
+                      for (auto i = r.begin(); i != r.end(); ++i) {
+                        distance[i] =
+                          settled[i].load(std::memory_order_relaxed)
+                            ? fromBits(tentative[i].load(
+                                std::memory_order_relaxed))
+                            : -1.0f;
+                      }
+                    });
+
+  if (progress) {
+    progress(1.0);
+  }
+  return true;
+}
+
+} // namespace native
+} // namespace tomviz
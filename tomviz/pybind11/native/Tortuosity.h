@@ -0,0 +1,33 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#ifndef tomvizNativeTortuosity_h
+#define tomvizNativeTortuosity_h
+
+#include <cstdint>
+#include <functional>
+
+namespace tomviz {
+namespace native {
+
+/// Geodesic distances through one phase of a labeled volume, measured from
+/// one face of the volume, on the implicit voxel grid (no graph is built).
+///
+/// mask is non-zero for the voxels of the phase, and both mask and distance
+/// are Fortran ordered volumes of dims[0] x dims[1] x dims[2]. face is 0 to 5
+/// for x+, x-, y+, y-, z+ and z-: the phase voxels on the first (+) or last
+/// (-) slice along that axis are at distance 1. Voxels are connected to their
+/// 6 face, 18 face and edge, or 26 face, edge and corner neighbours; steps
+/// have length 1, or their Euclidean length when euclidean is true. Voxels
+/// outside the phase, or that cannot be reached, are set to -1.
+///
+/// progress is called with the fraction of the phase reached so far, and may
+/// return true to cancel, in which case geodesicDistance() returns false.
+bool geodesicDistance(const uint8_t* mask, const int dims[3], int face,
+                      int connectivity, bool euclidean, float* distance,
+                      const std::function<bool(double)>& progress = nullptr);
+
+} // namespace native
+} // namespace tomviz
+
+#endif
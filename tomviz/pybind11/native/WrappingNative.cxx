@@ -0,0 +1,1254 @@
+/* This source file is part of the Tomviz project, https://tomviz.org/.
+   It is released under the 3-Clause BSD License, see "LICENSE". */
+
+#include <pybind11/complex.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "ArrayOps.h"
+#include "Art.h"
+#include "Denoise.h"
+#include "Dft.h"
+#include "FrequencyFilters.h"
+#include "Metrics.h"
+#include "MicroscopyFiles.h"
+#include "Projector.h"
+#include "RawVolume.h"
+#include "Registration.h"
+#include "Segmentation.h"
+#include "Tortuosity.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace {
+
+// Volumes are passed in the Fortran order tomviz uses for its arrays, so the
+// common case does not need a copy.
+template <typename T>
+using Volume = py::array_t<T, py::array::f_style | py::array::forcecast>;
+
+void dimensions(const py::array& volume, int dims[3])
+{
+  if (volume.ndim() < 1 || volume.ndim() > 3) {
+    throw std::invalid_argument("Expected a 1, 2 or 3 dimensional array");
+  }
+  for (int i = 0; i < 3; ++i) {
+    dims[i] = i < volume.ndim() ? static_cast<int>(volume.shape(i)) : 1;
+  }
+}
+
+// Wrap a progress callback so that it can be called from the native code
+// while the GIL is released. The callback returns true to cancel.
+std::function<bool(double)> progressCallback(const py::object& callback)
+{
+  if (callback.is_none()) {
+    return nullptr;
+  }
+  return [callback](double fraction) {
+    py::gil_scoped_acquire gil;
+    return py::bool_(callback(fraction)).cast<bool>();
+  };
+}
+
+py::object geodesicDistance(const Volume<uint8_t>& mask, int face,
+                            int connectivity, bool euclidean,
+                            const py::object& progress)
+{
+  if (face < 0 || face > 5) {
+    throw std::invalid_argument("face must be between 0 and 5");
+  }
+  if (connectivity != 6 && connectivity != 18 && connectivity != 26) {
+    throw std::invalid_argument("connectivity must be 6, 18 or 26");
+  }
+
+  int dims[3];
+  dimensions(mask, dims);
+  Volume<float> distance(std::vector<py::ssize_t>(
+    mask.shape(), mask.shape() + mask.ndim()));
+
+  auto callback = progressCallback(progress);
+  bool finished;
+  {
+    py::gil_scoped_release release;
+    finished =
+      tomviz::native::geodesicDistance(mask.data(), dims, face, connectivity,
+                                       euclidean, distance.mutable_data(),
+                                       callback);
+  }
+  if (!finished) {
+    return py::none();
+  }
+  return std::move(distance);
+}
+
+std::unique_ptr<tomviz::native::ArtReconstruction> createArt(
+  const Volume<float>& tiltSeries, const std::vector<double>& angles)
+{
+  int dims[3];
+  dimensions(tiltSeries, dims);
+  if (dims[2] != static_cast<int>(angles.size())) {
+    throw std::invalid_argument("Expected one tilt angle per projection");
+  }
+  py::gil_scoped_release release;
+  return std::unique_ptr<tomviz::native::ArtReconstruction>(
+    new tomviz::native::ArtReconstruction(tiltSeries.data(), dims[0],
+                                          dims[1], angles));
+}
+
+void artIterate(tomviz::native::ArtReconstruction& art, float beta, int first,
+                int last, const std::optional<py::array_t<int64_t>>& order)
+{
+  if (!order) {
+    py::gil_scoped_release release;
+    art.iterate(beta, first, last);
+    return;
+  }
+  const int64_t rows = art.numberOfRows();
+  if (order->ndim() != 1 || order->shape(0) != rows) {
+    throw std::invalid_argument("Expected the order of every row");
+  }
+  const int64_t* j = order->data();
+  if (std::any_of(j, j + rows,
+                  [rows](int64_t row) { return row < 0 || row >= rows; })) {
+    throw std::invalid_argument("Row out of range");
+  }
+  py::gil_scoped_release release;
+  art.iterate(beta, first, last, j);
+}
+
+Volume<float> artReconstruction(const tomviz::native::ArtReconstruction& art)
+{
+  Volume<float> volume({ art.nslice(), art.nray(), art.nray() });
+  art.reconstruction(volume.mutable_data());
+  return volume;
+}
+
+py::object directFourierReconstruction(const Volume<float>& tiltSeries,
+                                      const std::vector<double>& angles,
+                                      int npad, int kzPlanes,
+                                      const py::object& progress)
+{
+  int dims[3];
+  dimensions(tiltSeries, dims);
+  if (dims[2] != static_cast<int>(angles.size())) {
+    throw std::invalid_argument("Expected one tilt angle per projection");
+  }
+  if (npad < dims[1]) {
+    throw std::invalid_argument("npad must be at least the number of rays");
+  }
+
+  Volume<float> volume({ dims[0], dims[1], dims[1] });
+  Volume<tomviz::native::Complex> spectrum(
+    { dims[0], dims[1], dims[1] / 2 + 1 });
+
+  auto callback = progressCallback(progress);
+  bool finished;
+  {
+    py::gil_scoped_release release;
+    finished = tomviz::native::directFourierReconstruction(
+      tiltSeries.data(), dims[0], dims[1], angles, npad, kzPlanes,
+      volume.mutable_data(), spectrum.mutable_data(), callback);
+  }
+  if (!finished) {
+    return py::none();
+  }
+  return py::make_tuple(volume, spectrum);
+}
+
+Volume<float> forwardProject(const Volume<float>& volume,
+                             const std::vector<double>& angles, int size)
+{
+  int dims[3];
+  dimensions(volume, dims);
+  if (size < 0) {
+    size = tomviz::native::projectionSize(dims);
+  }
+
+  Volume<float> tiltSeries({ dims[0], size, static_cast<int>(angles.size()) });
+  {
+    py::gil_scoped_release release;
+    tomviz::native::forwardProject(volume.data(), dims, angles, size,
+                                   tiltSeries.mutable_data());
+  }
+  return tiltSeries;
+}
+
+Volume<float> filterImages(const Volume<float>& images,
+                           const Volume<float>& filter)
+{
+  int dims[3];
+  dimensions(images, dims);
+  if (filter.ndim() != 2 || filter.shape(0) != dims[0] ||
+      filter.shape(1) != dims[1] / 2 + 1) {
+    throw std::invalid_argument(
+      "Expected a (Nx, Ny // 2 + 1) filter for (Nx, Ny) images");
+  }
+
+  Volume<float> result(std::vector<py::ssize_t>(
+    images.shape(), images.shape() + images.ndim()));
+  std::copy(images.data(), images.data() + images.size(),
+            result.mutable_data());
+  {
+    py::gil_scoped_release release;
+    tomviz::native::filterImages(result.mutable_data(), dims[0], dims[1],
+                                 dims[2], filter.data());
+  }
+  return result;
+}
+
+Volume<float> wienerFilter(const Volume<float>& volume,
+                           const std::vector<double>& sigma, double snr)
+{
+  if (sigma.size() != 3) {
+    throw std::invalid_argument("Expected the sigma along x, y and z");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  Volume<float> result(std::vector<py::ssize_t>(
+    volume.shape(), volume.shape() + volume.ndim()));
+  {
+    py::gil_scoped_release release;
+    tomviz::native::wienerFilter(volume.data(), dims, sigma.data(), snr,
+                                 result.mutable_data());
+  }
+  return result;
+}
+
+Volume<float> deconvolveAdmm(const Volume<float>& images,
+                             const Volume<float>& psfs, double mu,
+                             int maxIterations)
+{
+  int dims[3];
+  dimensions(images, dims);
+  int psfDims[3];
+  dimensions(psfs, psfDims);
+  if (psfDims[2] != dims[2] || psfDims[0] > dims[0] || psfDims[1] > dims[1]) {
+    throw std::invalid_argument(
+      "Expected one point spread function, no larger than the images, per "
+      "image");
+  }
+
+  Volume<float> result(std::vector<py::ssize_t>(
+    images.shape(), images.shape() + images.ndim()));
+  {
+    py::gil_scoped_release release;
+    tomviz::native::deconvolveAdmm(images.data(), dims[0], dims[1], dims[2],
+                                   psfs.data(), psfDims[0], psfDims[1], mu,
+                                   maxIterations, result.mutable_data());
+  }
+  return result;
+}
+
+tomviz::native::RegistrationOptions registrationOptions(
+  const std::string& model, const std::string& metric, int levels,
+  int iterations)
+{
+  tomviz::native::RegistrationOptions options;
+  if (model == "translation") {
+    options.model = tomviz::native::RegistrationModel::Translation;
+  } else if (model == "rigid") {
+    options.model = tomviz::native::RegistrationModel::Rigid;
+  } else if (model == "affine") {
+    options.model = tomviz::native::RegistrationModel::Affine;
+  } else {
+    throw std::invalid_argument(
+      "model must be 'translation', 'rigid' or 'affine'");
+  }
+  if (metric == "ncc") {
+    options.metric = tomviz::native::RegistrationMetric::CrossCorrelation;
+  } else if (metric == "phase") {
+    options.metric = tomviz::native::RegistrationMetric::PhaseCorrelation;
+  } else {
+    throw std::invalid_argument("metric must be 'ncc' or 'phase'");
+  }
+  options.levels = levels;
+  options.iterations = iterations;
+  return options;
+}
+
+py::array_t<double> registerPairs(const Volume<float>& images,
+                                  const py::array_t<int>& pairs,
+                                  const std::string& model,
+                                  const std::string& metric, int levels,
+                                  int iterations)
+{
+  int dims[3];
+  dimensions(images, dims);
+  if (pairs.ndim() != 2 || pairs.shape(1) != 2) {
+    throw std::invalid_argument("Expected (moving, fixed) pairs of indices");
+  }
+  const int count = static_cast<int>(pairs.shape(0));
+  std::vector<int> indices(2 * count);
+  auto p = pairs.unchecked<2>();
+  for (int i = 0; i < count; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      indices[2 * i + j] = p(i, j);
+      if (p(i, j) < 0 || p(i, j) >= dims[2]) {
+        throw std::invalid_argument("Image index out of range");
+      }
+    }
+  }
+  auto options = registrationOptions(model, metric, levels, iterations);
+
+  std::vector<tomviz::native::AffineTransform> transforms(count);
+  {
+    py::gil_scoped_release release;
+    tomviz::native::registerPairs(images.data(), dims[0], dims[1],
+                                  indices.data(), count, options,
+                                  transforms.data());
+  }
+
+  py::array_t<double> matrices({ count, 3, 3 });
+  auto m = matrices.mutable_unchecked<3>();
+  for (int i = 0; i < count; ++i) {
+    for (int row = 0; row < 2; ++row) {
+      for (int col = 0; col < 3; ++col) {
+        m(i, row, col) = transforms[i].m[3 * row + col];
+      }
+    }
+    m(i, 2, 0) = m(i, 2, 1) = 0.0;
+    m(i, 2, 2) = 1.0;
+  }
+  return matrices;
+}
+
+Volume<float> warpImages(const Volume<float>& images,
+                         const py::array_t<double>& matrices)
+{
+  int dims[3];
+  dimensions(images, dims);
+  if (matrices.ndim() != 3 || matrices.shape(0) != dims[2] ||
+      matrices.shape(1) != 3 || matrices.shape(2) != 3) {
+    throw std::invalid_argument("Expected one 3 x 3 matrix per image");
+  }
+  std::vector<tomviz::native::AffineTransform> transforms(dims[2]);
+  auto m = matrices.unchecked<3>();
+  for (int i = 0; i < dims[2]; ++i) {
+    for (int row = 0; row < 2; ++row) {
+      for (int col = 0; col < 3; ++col) {
+        transforms[i].m[3 * row + col] = m(i, row, col);
+      }
+    }
+  }
+
+  Volume<float> result(std::vector<py::ssize_t>(
+    images.shape(), images.shape() + images.ndim()));
+  {
+    py::gil_scoped_release release;
+    tomviz::native::warpImages(images.data(), dims[0], dims[1], dims[2],
+                               transforms.data(), result.mutable_data());
+  }
+  return result;
+}
+
+tomviz::native::SimilarityOptions similarityOptions(double dataRange, int bins,
+                                                    int window, bool normalize)
+{
+  if (bins < 2) {
+    throw std::invalid_argument("bins must be at least 2");
+  }
+  if (window < 3 || window % 2 == 0) {
+    throw std::invalid_argument("win_size must be odd and at least 3");
+  }
+  tomviz::native::SimilarityOptions options;
+  options.dataRange = dataRange;
+  options.bins = bins;
+  options.window = window;
+  options.normalize = normalize;
+  return options;
+}
+
+void checkSameShape(const Volume<float>& reference, const Volume<float>& image)
+{
+  if (reference.ndim() != image.ndim() ||
+      !std::equal(reference.shape(), reference.shape() + reference.ndim(),
+                  image.shape())) {
+    throw std::invalid_argument("Expected arrays of the same shape");
+  }
+}
+
+py::dict similarityMetrics(const Volume<float>& reference,
+                           const Volume<float>& image, double dataRange,
+                           int bins, int window, bool normalize)
+{
+  checkSameShape(reference, image);
+  int dims[3];
+  dimensions(reference, dims);
+  auto options = similarityOptions(dataRange, bins, window, normalize);
+
+  tomviz::native::SimilarityMetrics metrics;
+  {
+    py::gil_scoped_release release;
+    metrics = tomviz::native::compareVolumes(reference.data(), image.data(),
+                                             dims, options);
+  }
+
+  py::dict result;
+  result["mse"] = metrics.mse;
+  result["psnr"] = metrics.psnr;
+  result["ncc"] = metrics.ncc;
+  result["mi"] = metrics.mutualInformation;
+  result["ssim"] = metrics.ssim;
+  return result;
+}
+
+py::dict sliceSimilarityMetrics(const Volume<float>& reference,
+                                const Volume<float>& image, double dataRange,
+                                int bins, int window, bool normalize)
+{
+  checkSameShape(reference, image);
+  int dims[3];
+  dimensions(reference, dims);
+  auto options = similarityOptions(dataRange, bins, window, normalize);
+
+  std::vector<tomviz::native::SimilarityMetrics> metrics(dims[2]);
+  {
+    py::gil_scoped_release release;
+    tomviz::native::compareSlices(reference.data(), image.data(), dims,
+                                  options, metrics.data());
+  }
+
+  py::array_t<double> mse(dims[2]), psnr(dims[2]), ncc(dims[2]), mi(dims[2]),
+    ssim(dims[2]);
+  for (int i = 0; i < dims[2]; ++i) {
+    mse.mutable_at(i) = metrics[i].mse;
+    psnr.mutable_at(i) = metrics[i].psnr;
+    ncc.mutable_at(i) = metrics[i].ncc;
+    mi.mutable_at(i) = metrics[i].mutualInformation;
+    ssim.mutable_at(i) = metrics[i].ssim;
+  }
+  py::dict result;
+  result["mse"] = mse;
+  result["psnr"] = psnr;
+  result["ncc"] = ncc;
+  result["mi"] = mi;
+  result["ssim"] = ssim;
+  return result;
+}
+
+// Call f with a null pointer of the element type of array
+template <typename Function>
+void dispatchScalars(const py::array& array, Function&& f)
+{
+  if (py::isinstance<py::array_t<int8_t>>(array)) {
+    f(static_cast<int8_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<uint8_t>>(array)) {
+    f(static_cast<uint8_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<int16_t>>(array)) {
+    f(static_cast<int16_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<uint16_t>>(array)) {
+    f(static_cast<uint16_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<int32_t>>(array)) {
+    f(static_cast<int32_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<uint32_t>>(array)) {
+    f(static_cast<uint32_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<int64_t>>(array)) {
+    f(static_cast<int64_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<uint64_t>>(array)) {
+    f(static_cast<uint64_t*>(nullptr));
+  } else if (py::isinstance<py::array_t<float>>(array)) {
+    f(static_cast<float*>(nullptr));
+  } else if (py::isinstance<py::array_t<double>>(array)) {
+    f(static_cast<double*>(nullptr));
+  } else {
+    throw std::invalid_argument("Unsupported array type");
+  }
+}
+
+// The dimensions of an array changed in place, which must not be a copy
+void inPlaceDimensions(const py::array& array, int dims[3])
+{
+  if (!array.writeable() || !(array.flags() & py::array::f_style)) {
+    throw std::invalid_argument("Expected a writeable Fortran ordered array");
+  }
+  dimensions(array, dims);
+}
+
+py::array fortranArray(const py::dtype& dtype, const int dims[3], int ndim)
+{
+  std::vector<py::ssize_t> shape(dims, dims + ndim);
+  std::vector<py::ssize_t> strides(ndim);
+  py::ssize_t stride = dtype.itemsize();
+  for (int i = 0; i < ndim; ++i) {
+    strides[i] = stride;
+    stride *= shape[i];
+  }
+  return py::array(dtype, shape, strides);
+}
+
+void checkAxis(int axis)
+{
+  if (axis < 0 || axis > 2) {
+    throw std::invalid_argument("axis must be 0, 1 or 2");
+  }
+}
+
+void circleMask(py::array& array, int axis, double ratio, double value)
+{
+  checkAxis(axis);
+  int dims[3];
+  inPlaceDimensions(array, dims);
+  // The mask of tomopy.misc.corr.circ_mask(), centered between the middle
+  // pixels of even sizes
+  const int a1 = axis == 0 ? 1 : 0;
+  const int a2 = axis == 2 ? 1 : 2;
+  const double center[2] = { dims[a1] / 2.0 - 0.5, dims[a2] / 2.0 - 0.5 };
+  const double radius = ratio * std::min(dims[a1], dims[a2]) / 2.0;
+  dispatchScalars(array, [&](auto* tag) {
+    using T = std::remove_pointer_t<decltype(tag)>;
+    py::gil_scoped_release release;
+    tomviz::native::maskOutsideCircle(static_cast<T*>(array.mutable_data()),
+                                      dims, axis, center, radius,
+                                      static_cast<T>(value));
+  });
+}
+
+void clipEdges(py::array& array, int clip)
+{
+  int dims[3];
+  inPlaceDimensions(array, dims);
+  // The circle of ClipEdges.py, in the planes across the first axis
+  const double center[2] = { dims[1] / 2.0, dims[2] / 2.0 };
+  const double radius = std::min(dims[1], dims[2]) / 2.0 - clip;
+  const int64_t size = static_cast<int64_t>(dims[0]) * dims[1] * dims[2];
+  if (size == 0) {
+    return;
+  }
+  dispatchScalars(array, [&](auto* tag) {
+    using T = std::remove_pointer_t<decltype(tag)>;
+    py::gil_scoped_release release;
+    T* data = static_cast<T*>(array.mutable_data());
+    T value = tomviz::native::minimum(data, size);
+    tomviz::native::maskOutsideCircle(data, dims, 0, center, radius, value);
+  });
+}
+
+void hannWindow(py::array& array)
+{
+  int dims[3];
+  inPlaceDimensions(array, dims);
+  dispatchScalars(array, [&](auto* tag) {
+    using T = std::remove_pointer_t<decltype(tag)>;
+    py::gil_scoped_release release;
+    tomviz::native::hannWindow(static_cast<T*>(array.mutable_data()), dims);
+  });
+}
+
+py::array padVolume(const py::array& array, const std::vector<int>& before,
+                    const std::vector<int>& after, const std::string& mode)
+{
+  if (before.size() != 3 || after.size() != 3) {
+    throw std::invalid_argument("Expected the padding along x, y and z");
+  }
+  tomviz::native::PadMode padMode;
+  if (mode == "constant") {
+    padMode = tomviz::native::PadMode::Constant;
+  } else if (mode == "edge") {
+    padMode = tomviz::native::PadMode::Edge;
+  } else if (mode == "wrap") {
+    padMode = tomviz::native::PadMode::Wrap;
+  } else {
+    throw std::invalid_argument("mode must be 'constant', 'edge' or 'wrap'");
+  }
+
+  auto volume = py::array::ensure(array, py::array::f_style);
+  if (!volume || volume.ndim() != 3) {
+    throw std::invalid_argument("Expected a 3 dimensional array");
+  }
+  int dims[3];
+  int padded[3];
+  dimensions(volume, dims);
+  for (int i = 0; i < 3; ++i) {
+    if (before[i] < 0 || after[i] < 0) {
+      throw std::invalid_argument("The padding can not be negative");
+    }
+    if (dims[i] == 0 && before[i] + after[i] > 0 &&
+        padMode != tomviz::native::PadMode::Constant) {
+      throw std::invalid_argument("Can not pad an empty axis from its values");
+    }
+    padded[i] = dims[i] + before[i] + after[i];
+  }
+
+  auto result = fortranArray(volume.dtype(), padded, 3);
+  {
+    py::gil_scoped_release release;
+    tomviz::native::padVolume(volume.data(), dims,
+                              static_cast<int>(volume.itemsize()),
+                              before.data(), after.data(), padMode,
+                              result.mutable_data());
+  }
+  return result;
+}
+
+py::array deleteSlices(const py::array& array, int first, int last, int axis)
+{
+  checkAxis(axis);
+  auto volume = py::array::ensure(array, py::array::f_style);
+  if (!volume || volume.ndim() != 3) {
+    throw std::invalid_argument("Expected a 3 dimensional array");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  if (first < 0 || last < first || last >= dims[axis]) {
+    throw std::invalid_argument("Slice indices out of range");
+  }
+
+  int remaining[3] = { dims[0], dims[1], dims[2] };
+  remaining[axis] -= last - first + 1;
+  auto result = fortranArray(volume.dtype(), remaining, 3);
+  {
+    py::gil_scoped_release release;
+    tomviz::native::deleteSlices(volume.data(), dims,
+                                 static_cast<int>(volume.itemsize()), axis,
+                                 first, last, result.mutable_data());
+  }
+  return result;
+}
+
+py::array swapAxes(const py::array& array, int axis1, int axis2)
+{
+  checkAxis(axis1);
+  checkAxis(axis2);
+  auto volume = py::array::ensure(array, py::array::f_style);
+  if (!volume || volume.ndim() != 3) {
+    throw std::invalid_argument("Expected a 3 dimensional array");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+
+  int swapped[3] = { dims[0], dims[1], dims[2] };
+  std::swap(swapped[axis1], swapped[axis2]);
+  auto result = fortranArray(volume.dtype(), swapped, 3);
+  {
+    py::gil_scoped_release release;
+    tomviz::native::swapAxes(volume.data(), dims,
+                             static_cast<int>(volume.itemsize()), axis1,
+                             axis2, result.mutable_data());
+  }
+  return result;
+}
+
+py::object reinterpretUnsigned(py::array& array)
+{
+  if (array.dtype().kind() != 'i') {
+    throw std::invalid_argument("Expected a signed integer array");
+  }
+  if (!array.writeable() ||
+      !(array.flags() & (py::array::f_style | py::array::c_style))) {
+    throw std::invalid_argument("Expected a writeable contiguous array");
+  }
+  const int size = static_cast<int>(array.itemsize());
+  {
+    py::gil_scoped_release release;
+    tomviz::native::flipSignBits(array.mutable_data(), array.size(), size);
+  }
+  return array.attr("view")("uint" + std::to_string(8 * size));
+}
+
+py::tuple otsuThresholds(const Volume<float>& volume, int count,
+                         bool valleyEmphasis, int bins)
+{
+  if (count < 1 || count > 254) {
+    throw std::invalid_argument("count must be between 1 and 254");
+  }
+  if (bins <= count) {
+    throw std::invalid_argument("bins must be greater than count");
+  }
+  Volume<uint8_t> labels(std::vector<py::ssize_t>(
+    volume.shape(), volume.shape() + volume.ndim()));
+  std::vector<double> thresholds;
+  {
+    py::gil_scoped_release release;
+    thresholds = tomviz::native::multiOtsuThresholds(
+      tomviz::native::histogram(volume.data(), volume.size(), bins), count,
+      valleyEmphasis);
+    tomviz::native::applyThresholds(volume.data(), volume.size(), thresholds,
+                                    labels.mutable_data());
+  }
+  return py::make_tuple(thresholds, std::move(labels));
+}
+
+void checkSpacing(const std::vector<double>& spacing)
+{
+  if (spacing.size() != 3) {
+    throw std::invalid_argument("Expected the spacing along x, y and z");
+  }
+  for (double s : spacing) {
+    if (!(s > 0.0)) {
+      throw std::invalid_argument("The spacing must be positive");
+    }
+  }
+}
+
+py::object binaryMinMaxCurvatureFlow(const Volume<float>& volume,
+                                     const std::vector<double>& spacing,
+                                     int stencilRadius, int iterations,
+                                     double threshold, double timeStep,
+                                     const py::object& progress)
+{
+  checkSpacing(spacing);
+  if (stencilRadius < 0 || iterations < 0) {
+    throw std::invalid_argument(
+      "stencil_radius and iterations must not be negative");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  Volume<float> result(std::vector<py::ssize_t>(
+    volume.shape(), volume.shape() + volume.ndim()));
+
+  auto callback = progressCallback(progress);
+  bool finished;
+  {
+    py::gil_scoped_release release;
+    std::copy(volume.data(), volume.data() + volume.size(),
+              result.mutable_data());
+    finished = tomviz::native::binaryMinMaxCurvatureFlow(
+      result.mutable_data(), dims, spacing.data(), stencilRadius, iterations,
+      threshold, timeStep, callback);
+  }
+  if (!finished) {
+    return py::none();
+  }
+  return std::move(result);
+}
+
+py::object segmentParticles(const Volume<float>& volume, int radius,
+                            const py::object& progress)
+{
+  if (radius < 1) {
+    throw std::invalid_argument("radius must be at least 1");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  Volume<uint8_t> result(std::vector<py::ssize_t>(
+    volume.shape(), volume.shape() + volume.ndim()));
+
+  auto callback = progressCallback(progress);
+  bool finished;
+  {
+    py::gil_scoped_release release;
+    finished = tomviz::native::segmentParticles(
+      volume.data(), dims, radius, result.mutable_data(), callback);
+  }
+  if (!finished) {
+    return py::none();
+  }
+  return std::move(result);
+}
+
+py::object segmentPores(const Volume<float>& volume,
+                        const std::vector<double>& spacing,
+                        double minimumRadius, double maximumRadius,
+                        const py::object& progress)
+{
+  checkSpacing(spacing);
+  if (!(minimumRadius > 0.0) || maximumRadius < minimumRadius) {
+    throw std::invalid_argument(
+      "Expected 0 < minimum_radius <= maximum_radius");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  Volume<uint32_t> result(std::vector<py::ssize_t>(
+    volume.shape(), volume.shape() + volume.ndim()));
+
+  auto callback = progressCallback(progress);
+  bool finished;
+  {
+    py::gil_scoped_release release;
+    finished = tomviz::native::segmentPores(
+      volume.data(), dims, spacing.data(), minimumRadius, maximumRadius,
+      result.mutable_data(), callback);
+  }
+  if (!finished) {
+    return py::none();
+  }
+  return std::move(result);
+}
+
+std::unique_ptr<tomviz::native::TotalVariationDenoise> createTotalVariation(
+  const Volume<float>& volume, float weight, double eps)
+{
+  if (weight <= 0.0f) {
+    throw std::invalid_argument("weight must be positive");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  return std::unique_ptr<tomviz::native::TotalVariationDenoise>(
+    new tomviz::native::TotalVariationDenoise(volume.data(), dims, weight,
+                                              eps));
+}
+
+Volume<double> descendSliceVariation(const Volume<double>& volume,
+                                     const std::vector<double>& stepSizes,
+                                     int steps)
+{
+  int dims[3];
+  dimensions(volume, dims);
+  if (static_cast<int>(stepSizes.size()) != dims[2]) {
+    throw std::invalid_argument("Expected one step size per slice");
+  }
+  Volume<double> result(std::vector<py::ssize_t>(
+    volume.shape(), volume.shape() + volume.ndim()));
+  double* data = result.mutable_data();
+  {
+    py::gil_scoped_release release;
+    std::copy(volume.data(), volume.data() + volume.size(), data);
+    tomviz::native::descendSliceVariation(data, dims, stepSizes.data(),
+                                          steps);
+  }
+  return result;
+}
+
+std::unique_ptr<tomviz::native::PeronaMalikDiffusion> createPeronaMalik(
+  const Volume<float>& volume, const std::vector<double>& spacing,
+  double conductance, double timeStep)
+{
+  if (spacing.size() != 3) {
+    throw std::invalid_argument("Expected the spacing along x, y and z");
+  }
+  int dims[3];
+  dimensions(volume, dims);
+  return std::unique_ptr<tomviz::native::PeronaMalikDiffusion>(
+    new tomviz::native::PeronaMalikDiffusion(volume.data(), dims,
+                                             spacing.data(), conductance,
+                                             timeStep));
+}
+
+py::dtype scalarDtype(tomviz::native::ScalarType type)
+{
+  using tomviz::native::ScalarType;
+  switch (type) {
+    case ScalarType::Int8:
+      return py::dtype::of<int8_t>();
+    case ScalarType::UInt8:
+      return py::dtype::of<uint8_t>();
+    case ScalarType::Int16:
+      return py::dtype::of<int16_t>();
+    case ScalarType::UInt16:
+      return py::dtype::of<uint16_t>();
+    case ScalarType::Int32:
+      return py::dtype::of<int32_t>();
+    case ScalarType::UInt32:
+      return py::dtype::of<uint32_t>();
+    case ScalarType::Int64:
+      return py::dtype::of<int64_t>();
+    case ScalarType::UInt64:
+      return py::dtype::of<uint64_t>();
+    case ScalarType::Float32:
+      return py::dtype::of<float>();
+    case ScalarType::Float64:
+      return py::dtype::of<double>();
+    case ScalarType::Complex64:
+      return py::dtype::of<std::complex<float>>();
+    case ScalarType::Complex128:
+      return py::dtype::of<std::complex<double>>();
+  }
+  throw std::invalid_argument("Unsupported scalar type");
+}
+
+// The datasets of a microscopy file as Fortran ordered arrays, their frames
+// copied from the mapping in parallel, and its metadata
+py::dict readMicroscopyFile(const tomviz::native::MicroscopyFile& file)
+{
+  py::list datasets;
+  for (std::size_t i = 0; i < file.datasets().size(); ++i) {
+    const auto& info = file.datasets()[i];
+    auto dtype = scalarDtype(info.type);
+    std::vector<py::ssize_t> shape(info.dims.begin(), info.dims.end());
+    std::vector<py::ssize_t> strides(shape.size());
+    py::ssize_t stride = dtype.itemsize();
+    for (std::size_t axis = 0; axis < shape.size(); ++axis) {
+      strides[axis] = stride;
+      stride *= shape[axis];
+    }
+    py::array data(dtype, shape, strides);
+    auto* out = static_cast<unsigned char*>(data.mutable_data());
+    const int64_t frameBytes = info.frameSize() * dtype.itemsize();
+    {
+      py::gil_scoped_release release;
+      tbb::parallel_for(tbb::blocked_range<int64_t>(0, info.frameCount()),
+                        [&](const tbb::blocked_range<int64_t>& frames) {
+                          file.readFrames(i, frames.begin(), frames.end(),
+                                          out + frames.begin() * frameBytes);
+                        });
+    }
+
+    py::dict dataset;
+    dataset["data"] = data;
+    dataset["scale"] = info.scale;
+    dataset["origin"] = info.origin;
+    dataset["units"] = info.units;
+    datasets.append(dataset);
+  }
+
+  py::dict metadata;
+  for (const auto& entry : file.metadata()) {
+    metadata[py::str(entry.first)] = std::visit(
+      [](const auto& value) { return py::cast(value); }, entry.second);
+  }
+
+  py::dict result;
+  result["datasets"] = datasets;
+  result["metadata"] = metadata;
+  return result;
+}
+
+py::dict readDm(const std::string& fileName)
+{
+  tomviz::native::DmFile file(fileName);
+  return readMicroscopyFile(file);
+}
+
+py::dict readSer(const std::string& fileName)
+{
+  tomviz::native::SerFile file(fileName);
+  return readMicroscopyFile(file);
+}
+
+tomviz::native::ScalarType scalarType(const py::dtype& dtype)
+{
+  using tomviz::native::ScalarType;
+  auto size = dtype.itemsize();
+  switch (dtype.kind()) {
+    case 'i':
+      switch (size) {
+        case 1:
+          return ScalarType::Int8;
+        case 2:
+          return ScalarType::Int16;
+        case 4:
+          return ScalarType::Int32;
+        case 8:
+          return ScalarType::Int64;
+      }
+      break;
+    case 'u':
+      switch (size) {
+        case 1:
+          return ScalarType::UInt8;
+        case 2:
+          return ScalarType::UInt16;
+        case 4:
+          return ScalarType::UInt32;
+        case 8:
+          return ScalarType::UInt64;
+      }
+      break;
+    case 'f':
+      if (size == 4) {
+        return ScalarType::Float32;
+      } else if (size == 8) {
+        return ScalarType::Float64;
+      }
+      break;
+    case 'c':
+      if (size == 8) {
+        return ScalarType::Complex64;
+      } else if (size == 16) {
+        return ScalarType::Complex128;
+      }
+      break;
+  }
+  throw std::invalid_argument("Unsupported dtype");
+}
+
+// The region of a raw volume as a Fortran ordered array, x first and the
+// components last, its rows copied from the mapping in parallel
+py::array readRaw(const std::string& fileName, const py::dtype& dtype,
+                  const std::vector<int64_t>& shape, int components,
+                  bool bigEndian, std::optional<int64_t> headerSize,
+                  std::optional<std::vector<int64_t>> bounds,
+                  const std::vector<int64_t>& strides)
+{
+  if (shape.size() != 3 || strides.size() != 3) {
+    throw std::invalid_argument("Expected the shape and strides along x, y "
+                                "and z");
+  }
+  if (bounds && bounds->size() != 6) {
+    throw std::invalid_argument("Expected bounds as (x0, x1, y0, y1, z0, "
+                                "z1)");
+  }
+
+  tomviz::native::RawLayout layout;
+  layout.type = scalarType(dtype);
+  layout.components = components;
+  std::copy(shape.begin(), shape.end(), layout.dims.begin());
+  layout.bigEndian = bigEndian;
+  layout.headerSize = headerSize.value_or(-1);
+  tomviz::native::RawVolume volume(fileName, layout);
+
+  std::array<int64_t, 3> begin = { { 0, 0, 0 } };
+  std::array<int64_t, 3> end = layout.dims;
+  if (bounds) {
+    for (int i = 0; i < 3; ++i) {
+      begin[i] = (*bounds)[i * 2];
+      end[i] = (*bounds)[i * 2 + 1];
+    }
+  }
+  auto region = volume.region(begin, end, { { strides[0], strides[1],
+                                              strides[2] } });
+  auto dims = region.dims();
+
+  std::vector<py::ssize_t> outShape(dims.begin(), dims.end());
+  std::vector<py::ssize_t> outStrides(3);
+  py::ssize_t stride = dtype.itemsize() * components;
+  for (int axis = 0; axis < 3; ++axis) {
+    outStrides[axis] = stride;
+    stride *= outShape[axis];
+  }
+  if (components > 1) {
+    outShape.push_back(components);
+    outStrides.push_back(dtype.itemsize());
+  }
+  py::array data(dtype, outShape, outStrides);
+  auto* out = static_cast<unsigned char*>(data.mutable_data());
+  const int64_t rowBytes = dims[0] * layout.voxelSize();
+  {
+    py::gil_scoped_release release;
+    tbb::parallel_for(tbb::blocked_range<int64_t>(0, region.rowCount()),
+                      [&](const tbb::blocked_range<int64_t>& rows) {
+                        volume.readRows(region, rows.begin(), rows.end(),
+                                        out + rows.begin() * rowBytes);
+                      });
+  }
+  return data;
+}
+
+template <typename Filter>
+Volume<float> filterResult(const Filter& filter)
+{
+  Volume<float> volume({ filter.dimension(0), filter.dimension(1),
+                         filter.dimension(2) });
+  filter.result(volume.mutable_data());
+  return volume;
+}
+
+} // namespace
+
+PYBIND11_MODULE(_native, m)
+{
+  m.doc() = "Native implementations of the compute heavy operators";
+
+  m.def("geodesic_distance", &geodesicDistance, py::arg("mask"),
+        py::arg("face"), py::arg("connectivity") = 26,
+        py::arg("euclidean") = true, py::arg("progress") = py::none(),
+        "Distances through the non-zero voxels of mask from one face of the "
+        "volume (0 to 5 for x+, x-, y+, y-, z+, z-). Voxels outside the mask "
+        "or unreachable are -1. Returns None if progress returned True.");
+
+  m.def("direct_fourier_reconstruction", &directFourierReconstruction,
+        py::arg("tilt_series"), py::arg("angles"), py::arg("npad"),
+        py::arg("kz_planes") = -1, py::arg("progress") = py::none(),
+        "Direct Fourier reconstruction of a (Nx, Ny, Nproj) tilt series, "
+        "tilted about the x axis by angles (in degrees), with the "
+        "projections zero padded to npad. Only the first kz_planes planes of "
+        "the half spectrum are gridded (all of them if negative). Returns "
+        "the (Nx, Ny, Ny) reconstruction and the gridded (Nx, Ny, Ny // 2 + "
+        "1) spectrum, or None if progress returned True.");
+
+  m.def("forward_project", &forwardProject, py::arg("volume"),
+        py::arg("angles"), py::arg("size") = -1,
+        "The (Nx, size, len(angles)) projections along z of volume rotated "
+        "about the x axis by angles (in degrees), as GenerateTiltSeries.py "
+        "computes them. By default size is the odd size that holds the "
+        "volume at any angle.");
+
+  m.def("filter_images", &filterImages, py::arg("images"), py::arg("filter"),
+        "Multiply the spectrum of each (Nx, Ny) image of a (Nx, Ny, N) stack "
+        "by the real (Nx, Ny // 2 + 1) filter, laid out as numpy.fft.rfftn() "
+        "returns the spectrum. Returns the filtered images.");
+
+  m.def("wiener_filter", &wienerFilter, py::arg("volume"), py::arg("sigma"),
+        py::arg("snr"),
+        "The Wiener deconvolution of volume for a Gaussian point spread "
+        "function of the sigma along x, y and z, normalized to a maximum of "
+        "1. No noise is assumed if snr is 0.");
+
+  m.def("deconvolve_admm", &deconvolveAdmm, py::arg("images"),
+        py::arg("psfs"), py::arg("mu"), py::arg("max_iter") = 50,
+        "The ADMM total variation deconvolution of each (Nx, Ny) image of a "
+        "(Nx, Ny, N) stack by its own point spread function in a (Px, Py, N) "
+        "stack.");
+
+  m.def("register_pairs", &registerPairs, py::arg("images"), py::arg("pairs"),
+        py::arg("model") = "translation", py::arg("metric") = "ncc",
+        py::arg("levels") = 3, py::arg("iterations") = 50,
+        "Register pairs of the (Nx, Ny) images of a (Nx, Ny, N) stack in "
+        "parallel. pairs is an (M, 2) array of (moving, fixed) image "
+        "indices, model 'translation', 'rigid' or 'affine', and metric "
+        "'ncc' (the cross-correlation of the normalized images) or 'phase' "
+        "for the initial correlation. The refinement minimizes the squared "
+        "differences of the normalized images. Returns (M, 3, 3) "
+        "matrices that map the (x, y) pixel coordinates of the fixed images "
+        "to those of the moving images.");
+
+  m.def("warp_images", &warpImages, py::arg("images"), py::arg("transforms"),
+        "Resample the images of a (Nx, Ny, N) stack with (N, 3, 3) matrices "
+        "as register_pairs() returns them, with bilinear interpolation and "
+        "zeros outside, so that the moving images line up with their fixed "
+        "images.");
+
+  m.def("similarity_metrics", &similarityMetrics, py::arg("reference"),
+        py::arg("image"), py::arg("data_range") = 0.0, py::arg("bins") = 64,
+        py::arg("win_size") = 7, py::arg("normalize") = false,
+        "Compare two arrays of the same shape in one parallel pass. Returns "
+        "a dict of the 'mse', 'psnr', 'ncc' (Pearson correlation), 'mi' "
+        "(mutual information in nats, from a bins x bins joint histogram) "
+        "and 'ssim' (as skimage.metrics.structural_similarity() with a "
+        "uniform win_size window). The range of the reference is used if "
+        "data_range is not positive. With normalize, each array is first "
+        "scaled to [0, 1] by its minimum and maximum.");
+
+  m.def("slice_similarity_metrics", &sliceSimilarityMetrics,
+        py::arg("reference"), py::arg("image"), py::arg("data_range") = 0.0,
+        py::arg("bins") = 64, py::arg("win_size") = 7,
+        py::arg("normalize") = false,
+        "As similarity_metrics(), for each pair of (Nx, Ny) slices of two "
+        "(Nx, Ny, N) stacks, the ranges and the normalization per slice. "
+        "Returns a dict of arrays of N values.");
+
+  m.def("circle_mask", &circleMask, py::arg("array"), py::arg("axis"),
+        py::arg("ratio") = 1.0, py::arg("value") = 0.0,
+        "Set the voxels of a Fortran ordered array outside of the cylinder "
+        "along axis of tomopy.misc.corr.circ_mask() to value, in place.");
+
+  m.def("clip_edges", &clipEdges, py::arg("array"), py::arg("clip") = 5,
+        "Set the voxels of a Fortran ordered array outside of a cylinder "
+        "along the first axis, clip voxels inside the planes across it, to "
+        "the minimum of the array, in place.");
+
+  m.def("hann_window", &hannWindow, py::arg("array"),
+        "Multiply a Fortran ordered array by a separable Hann window, in "
+        "place.");
+
+  m.def("pad", &padVolume, py::arg("array"), py::arg("before"),
+        py::arg("after"), py::arg("mode") = "constant",
+        "A Fortran ordered copy of a 3D array padded as numpy.pad() does, "
+        "by before and after elements along each axis, with mode "
+        "'constant' (zeros), 'edge' or 'wrap'.");
+
+  m.def("delete_slices", &deleteSlices, py::arg("array"), py::arg("first"),
+        py::arg("last"), py::arg("axis") = 2,
+        "A Fortran ordered copy of a 3D array without its slices first to "
+        "last (inclusive) along axis.");
+
+  m.def("swap_axes", &swapAxes, py::arg("array"), py::arg("axis1"),
+        py::arg("axis2"),
+        "A Fortran ordered copy of a 3D array with two of its axes "
+        "swapped.");
+
+  m.def("reinterpret_unsigned", &reinterpretUnsigned, py::arg("array"),
+        "Offset a signed integer array by half of its range in place, and "
+        "return it viewed as the unsigned type of the same size.");
+
+  m.def("otsu_thresholds", &otsuThresholds, py::arg("volume"),
+        py::arg("count"), py::arg("valley_emphasis") = false,
+        py::arg("bins") = 128,
+        "The count multiple Otsu thresholds of volume, from a histogram of "
+        "bins, as itk.OtsuMultipleThresholdsImageFilter computes them. "
+        "Returns the thresholds and the labels of the voxels, 0 up to the "
+        "first threshold, 1 up to the second, and so on.");
+
+  m.def("binary_min_max_curvature_flow", &binaryMinMaxCurvatureFlow,
+        py::arg("volume"), py::arg("spacing"), py::arg("stencil_radius"),
+        py::arg("iterations"), py::arg("threshold"),
+        py::arg("time_step") = 0.0625, py::arg("progress") = py::none(),
+        "A copy of volume smoothed as "
+        "itk.BinaryMinMaxCurvatureFlowImageFilter does. Returns None if "
+        "progress returned True.");
+
+  m.def("segment_particles", &segmentParticles, py::arg("volume"),
+        py::arg("radius"), py::arg("progress") = py::none(),
+        "The uint8 mask of the particles SegmentParticles.py segments, for "
+        "a structuring element of radius voxels. Returns None if progress "
+        "returned True.");
+
+  m.def("segment_pores", &segmentPores, py::arg("volume"),
+        py::arg("spacing"), py::arg("minimum_radius"),
+        py::arg("maximum_radius"), py::arg("progress") = py::none(),
+        "The uint32 label map of the pores SegmentPores.py segments, for "
+        "radii in the units of spacing. Returns None if progress returned "
+        "True.");
+
+  m.def("read_dm", &readDm, py::arg("filename"),
+        "Read a DM3 or DM4 file through a memory mapping. Returns a dict of "
+        "the 'datasets', each a dict of its Fortran ordered 'data', x "
+        "first, and the 'scale', 'origin' and 'units' of its axes, and of "
+        "the 'metadata', the tags as dm.py names them.");
+
+  m.def("read_ser", &readSer, py::arg("filename"),
+        "Read a SER series through a memory mapping, as read_dm does. The "
+        "elements are stacked along the last axes, and the metadata is the "
+        "header as ser.py reads it.");
+
+  m.def("read_raw", &readRaw, py::arg("filename"), py::arg("dtype"),
+        py::arg("shape"), py::arg("components") = 1,
+        py::arg("big_endian") = false, py::arg("header_size") = py::none(),
+        py::arg("bounds") = py::none(),
+        py::arg("strides") = std::vector<int64_t>{ 1, 1, 1 },
+        "Read a raw volume of shape (x, y, z), x fastest, through a memory "
+        "mapping. The data ends the file unless header_size is given. Only "
+        "the region within bounds, (x0, x1, y0, y1, z0, z1), sampled every "
+        "strides voxels is read. Returns a Fortran ordered array, with the "
+        "components along a last axis when there are several.");
+
+  using tomviz::native::TotalVariationDenoise;
+  py::class_<TotalVariationDenoise>(m, "TotalVariationDenoise")
+    .def(py::init(&createTotalVariation), py::arg("volume"),
+         py::arg("weight"), py::arg("eps") = 2e-4,
+         "Prepare Chambolle's total variation denoising of volume. The "
+         "larger weight, the more denoising.")
+    .def("iterate", &TotalVariationDenoise::iterate, py::arg("iterations"),
+         py::call_guard<py::gil_scoped_release>(),
+         "Run up to iterations iterations, and return the number run")
+    .def_property_readonly("converged", &TotalVariationDenoise::converged)
+    .def_property_readonly("result", &filterResult<TotalVariationDenoise>,
+                           "A copy of the 3D denoised volume");
+
+  m.def("descend_slice_variation", &descendSliceVariation,
+        py::arg("volume"), py::arg("step_sizes"), py::arg("steps"),
+        "Run TV_Filter's total variation descent on a copy of every z slice "
+        "of volume, steps times, by step_sizes[z] for slice z");
+
+  using tomviz::native::PeronaMalikDiffusion;
+  py::class_<PeronaMalikDiffusion>(m, "PeronaMalikDiffusion")
+    .def(py::init(&createPeronaMalik), py::arg("volume"), py::arg("spacing"),
+         py::arg("conductance"), py::arg("time_step"),
+         "Prepare the gradient anisotropic diffusion of volume")
+    .def("iterate", &PeronaMalikDiffusion::iterate, py::arg("iterations"),
+         py::call_guard<py::gil_scoped_release>())
+    .def_property_readonly("result", &filterResult<PeronaMalikDiffusion>,
+                           "A copy of the 3D diffused volume");
+
+  using tomviz::native::ArtReconstruction;
+  py::class_<ArtReconstruction>(m, "ArtReconstruction")
+    .def(py::init(&createArt), py::arg("tilt_series"), py::arg("angles"),
+         "Prepare an ART reconstruction of a (Nslice, Nray, Nproj) tilt "
+         "series, tilted about the x axis by angles (in degrees)")
+    .def("iterate", &artIterate, py::arg("beta"), py::arg("first"),
+         py::arg("last"), py::arg("order") = py::none(),
+         "Update slices [first, last) with one pass over every ray, in row "
+         "order or in the order of the row indices in order")
+    .def("positivity", &ArtReconstruction::positivity,
+         py::call_guard<py::gil_scoped_release>(),
+         "Set the negative voxels to zero")
+    .def_property_readonly("reconstruction", &artReconstruction,
+                           "A copy of the (Nslice, Nray, Nray) "
+                           "reconstruction");
+}
@@ -1,4 +1,10 @@
 import tomviz.operators
+from tomviz.itkutils import itk_available
+
+try:
+    from tomviz._native import binary_min_max_curvature_flow
+except ImportError:
+    binary_min_max_curvature_flow = None
 
 
 class BinaryMinMaxCurvatureFlow(tomviz.operators.CancelableOperator):
@@ -11,6 +17,10 @@ class BinaryMinMaxCurvatureFlow(tomviz.operators.CancelableOperator):
         brightness to discriminate between two pixel classes.
         """
 
+        if binary_min_max_curvature_flow is not None and not itk_available():
+            return self.native_transform(dataset, stencil_radius, iterations,
+                                         threshold)
+
         # Initial progress
         self.progress.value = 0
         self.progress.maximum = 100
@@ -100,3 +110,25 @@ class BinaryMinMaxCurvatureFlow(tomviz.operators.CancelableOperator):
             raise exc
 
         return returnValue
+
+    def native_transform(self, dataset, stencil_radius, iterations,
+                         threshold):
+        """The same flow, multithreaded, without ITK"""
+        array = dataset.active_scalars
+
+        self.progress.value = 0
+        self.progress.maximum = 100
+        self.progress.message = "Running filter"
+
+        def progress(fraction):
+            self.progress.value = int(100 * fraction)
+            return self.canceled
+
+        result = binary_min_max_curvature_flow(
+            array, list(dataset.spacing), stencil_radius, iterations,
+            threshold, progress=progress)
+        if result is None:
+            return
+
+        self.progress.message = "Saving results"
+        dataset.active_scalars = result.astype(array.dtype, order='F')
@@ -1,12 +1,27 @@
 def transform(dataset, axis, ratio, value):
+    import numpy as np
+
+    try:
+        from tomviz._native import circle_mask
+    except ImportError:
+        circle_mask = None
+
+    array = dataset.active_scalars
+
+    if circle_mask is not None and array.ndim == 3:
+        # tomopy returns float32, so only the other types are copied, and the
+        # voxels are masked in place
+        array = np.asfortranarray(array, dtype=np.float32)
+        circle_mask(array, axis, ratio, value)
+        dataset.active_scalars = array
+        return
+
     try:
         import tomopy
     except ImportError:
         print('Failed to import tomopy, which is required for this operator')
         raise
 
-    array = dataset.active_scalars
-
     result = tomopy.misc.corr.circ_mask(array, axis, ratio, value)
 
     dataset.active_scalars = result
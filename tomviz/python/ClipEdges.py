@@ -4,8 +4,25 @@ def transform(dataset, clipNum=5):
 
     import numpy as np
 
+    try:
+        from tomviz._native import clip_edges
+    except ImportError:
+        clip_edges = None
+
     array = dataset.active_scalars
 
+    if clip_edges is not None:
+        # Clip in place, with no copy of Fortran ordered arrays
+        array = np.asfortranarray(array)
+        try:
+            clip_edges(array, clipNum)
+        except ValueError:
+            # Not a type of the native module
+            pass
+        else:
+            dataset.active_scalars = array
+            return
+
     # Constant values
     numX = array.shape[1]
     numY = array.shape[2]
@@ -3,6 +3,11 @@ import tomviz.operators
 import numpy as np
 import scipy
 
+try:
+    from tomviz._native import deconvolve_admm
+except ImportError:
+    deconvolve_admm = None
+
 
 def deconv_admm(g, psf, mu, is_canceled=None, max_iter=50):
     # Fast ADMM_TV/L2 algorithm based on "An Augmented Lagrangian Method for Total Variation Video Restoration",
@@ -698,6 +703,24 @@ def RMSE(ori_im, rec_im):
     return rmse
 
 
+def slice_indexing(ndim, axis, index):
+    indexing = [slice(None)] * ndim
+    indexing[axis] = index
+    return tuple(indexing)
+
+
+def probe_psf(probe_slice, pw):
+    prb_sz = np.shape(probe_slice)
+    psf = (
+        probe_slice[
+            prb_sz[0] // 2 - pw // 2 : prb_sz[0] // 2 - pw // 2 + pw,
+            prb_sz[1] // 2 - pw // 2 : prb_sz[1] // 2 - pw // 2 + pw,
+        ]
+        ** 2
+    )
+    return psf / np.sum(psf.ravel())
+
+
 class DeconvolutionDenoise(tomviz.operators.CancelableOperator):
 
     def transform(
@@ -817,6 +840,15 @@ class DeconvolutionDenoise(tomviz.operators.CancelableOperator):
 
             output_scalars = np.empty(output_shape)
 
+            if method == "ADMM_TV" and deconvolve_admm is not None:
+                if not self.native_admm(scalars, probe_scalars, slice_indices,
+                                        axis_index, probe_kernel, mu,
+                                        max_iter, output_scalars):
+                    return
+
+                dataset.set_scalars(name, output_scalars)
+                continue
+
             for output_slice_index, (
                 dataset_slice_index,
                 probe_slice_index,
@@ -827,31 +859,17 @@ class DeconvolutionDenoise(tomviz.operators.CancelableOperator):
                 # for slice_index in range(n_slices):
                 self.progress.value = output_slice_index
 
-                dataset_slice_indexing_list = [slice(None)] * scalars.ndim
-                dataset_slice_indexing_list[axis_index] = dataset_slice_index
-                dataset_slice_indexing = tuple(dataset_slice_indexing_list)
-
-                probe_slice_indexing_list = [slice(None)] * scalars.ndim
-                probe_slice_indexing_list[axis_index] = probe_slice_index
-                probe_slice_indexing = tuple(probe_slice_indexing_list)
-
-                output_slice_indexing_list = [slice(None)] * scalars.ndim
-                output_slice_indexing_list[axis_index] = output_slice_index
-                output_slice_indexing = tuple(output_slice_indexing_list)
-
-                scalars_slice = scalars[dataset_slice_indexing]
-                probe_slice = probe_scalars[probe_slice_indexing]
-
-                prb_sz = np.shape(probe_slice)
-                pw = probe_kernel
-                psf = (
-                    probe_slice[
-                        prb_sz[0] // 2 - pw // 2 : prb_sz[0] // 2 - pw // 2 + pw,
-                        prb_sz[1] // 2 - pw // 2 : prb_sz[1] // 2 - pw // 2 + pw,
-                    ]
-                    ** 2
+                scalars_slice = scalars[
+                    slice_indexing(scalars.ndim, axis_index, dataset_slice_index)
+                ]
+                probe_slice = probe_scalars[
+                    slice_indexing(scalars.ndim, axis_index, probe_slice_index)
+                ]
+                output_slice_indexing = slice_indexing(
+                    scalars.ndim, axis_index, output_slice_index
                 )
-                psf = psf / np.sum(psf.ravel())
+
+                psf = probe_psf(probe_slice, probe_kernel)
 
                 w, scaled_slice, loss, rdiff = deconv(
                     scalars_slice,
@@ -884,3 +902,37 @@ class DeconvolutionDenoise(tomviz.operators.CancelableOperator):
         # Set the tilt angles on the output
         if dataset_tilt_angles is not None:
             dataset.tilt_angles = np.array(output_tilt_angles)
+
+    def native_admm(self, scalars, probe_scalars, slice_indices, axis_index,
+                    probe_kernel, mu, max_iter, output_scalars):
+        # The slices are deconvolved in parallel, in batches so that the
+        # progress can be reported and the operator canceled between them.
+        n_slices = len(slice_indices)
+        batch_size = 8
+        for start in range(0, n_slices, batch_size):
+            if self.canceled:
+                return False
+
+            self.progress.value = start
+
+            batch = slice_indices[start:start + batch_size]
+            images = np.stack(
+                [scalars[slice_indexing(scalars.ndim, axis_index, i)]
+                 for i, _ in batch],
+                axis=2,
+            )
+            psfs = np.stack(
+                [probe_psf(
+                    probe_scalars[slice_indexing(scalars.ndim, axis_index, i)],
+                    probe_kernel)
+                 for _, i in batch],
+                axis=2,
+            )
+            result = deconvolve_admm(images, psfs, mu, max_iter)
+            for j in range(len(batch)):
+                output_scalars[
+                    slice_indexing(scalars.ndim, axis_index, start + j)
+                ] = result[:, :, j]
+
+        self.progress.value = n_slices
+        return True
@@ -19,8 +19,17 @@ def transform(dataset, firstSlice=None, lastSlice=None, axis=2):
     indices = np.linspace(firstSlice, lastSlice,
                           lastSlice - firstSlice + 1).astype(int)
 
+    try:
+        from tomviz._native import delete_slices
+    except ImportError:
+        delete_slices = None
+
     # Delete the specified slices.
-    array = np.delete(array, indices, axis)
+    if delete_slices is not None and array.ndim == 3 and firstSlice >= 0:
+        # Copy the remaining slices straight into a Fortran ordered array
+        array = delete_slices(array, firstSlice, lastSlice, axis)
+    else:
+        array = np.delete(array, indices, axis)
 
     # Set the result as the new scalars.
     dataset.active_scalars = array
@@ -10,6 +10,12 @@ def transform(moving_dataset, fixed_dataset, max_num_iterations,
         from itk import elastix_registration_method
         import numpy as np
     except Exception:
+        if native_translation_available(moving_dataset, fixed_dataset,
+                                        disable_rotation):
+            print('ITKElastix is not available, so only the translation is '
+                  'registered, natively. The elastix parameters are unused.')
+            return native_translation(moving_dataset, fixed_dataset,
+                                      lower_threshold, upper_threshold)
         print('Could not import the necessary modules')
         raise
 
@@ -77,3 +83,60 @@ def transform(moving_dataset, fixed_dataset, max_num_iterations,
         fixed_image, moving_image, **kwargs)
 
     itkutils.set_itk_image_on_dataset(result_image, moving_dataset)
+
+
+def native_translation_available(moving_dataset, fixed_dataset,
+                                 disable_rotation):
+    """Whether native_translation() can stand in for elastix: only the
+    translation is wanted, and the volumes are on the same grid"""
+    from tomviz import registration
+
+    same_grid = (
+        moving_dataset.active_scalars.shape ==
+        fixed_dataset.active_scalars.shape and
+        tuple(moving_dataset.spacing) == tuple(fixed_dataset.spacing)
+    )
+    return registration.available() and disable_rotation and same_grid
+
+
+def native_translation(moving_dataset, fixed_dataset, lower_threshold,
+                       upper_threshold):
+    """The fallback when ITKElastix is missing. The x and y shifts are
+    registered between the sums of the volumes along z, and the z shift
+    between their sums along y, each in 2D, so the volumes should overlap
+    well in both projections. The iterations, resolutions and interpolators
+    of elastix do not apply."""
+    import numpy as np
+    from tomviz import registration
+
+    def masked(array):
+        # Only the voxels within the thresholds take part, as with the masks
+        # given to elastix
+        array = array.astype(np.float32)
+        array[(array < lower_threshold) | (array > upper_threshold)] = 0
+        return array
+
+    moving_array = moving_dataset.active_scalars
+    moving = masked(moving_array)
+    fixed = masked(fixed_dataset.active_scalars)
+
+    def register(axis):
+        images = np.stack((fixed.sum(axis=axis), moving.sum(axis=axis)),
+                          axis=2)
+        return registration.register_stack(images, reference='first')[1]
+
+    # The x and y shifts from the projections along z, the z shift from
+    # those along y
+    (tx, ty) = register(2)[:2, 2]
+    tz = register(1)[1, 2]
+
+    Nz = moving_array.shape[2]
+    Ny = moving_array.shape[1]
+    xy = registration.translations(np.tile((-tx, -ty), (Nz, 1)))
+    z = registration.translations(np.tile((0, -tz), (Ny, 1)))
+
+    result = registration.warp(moving_array.astype(np.float32), xy)
+    result = registration.warp(np.asfortranarray(result.transpose(0, 2, 1)),
+                               z)
+    moving_dataset.active_scalars = np.asfortranarray(
+        result.transpose(0, 2, 1))
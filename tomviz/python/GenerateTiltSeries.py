@@ -3,6 +3,11 @@ import scipy.ndimage
 
 import tomviz.operators
 
+try:
+    from tomviz._native import forward_project
+except ImportError:
+    forward_project = None
+
 
 class GenerateTiltSeriesOperator(tomviz.operators.CancelableOperator):
 
@@ -23,6 +28,15 @@ class GenerateTiltSeriesOperator(tomviz.operators.CancelableOperator):
         N = np.round(np.sqrt(Ny**2 + Nz**2))
         N = int(np.floor(N / 2.0) * 2 + 1)  # make the size an odd integer
 
+        if forward_project is not None:
+            tiltSeries = self.native_projections(volume, angles, N)
+            if tiltSeries is None:
+                return
+
+            dataset.active_scalars = tiltSeries
+            dataset.tilt_angles = angles
+            return
+
         # pad volume
         pad_y_pre = int(np.ceil((N - Ny) / 2.0))
         pad_y_post = int(np.floor((N - Ny) / 2.0))
@@ -60,3 +74,27 @@ class GenerateTiltSeriesOperator(tomviz.operators.CancelableOperator):
 
         # Save tilt angles.
         dataset.tilt_angles = angles
+
+    def native_projections(self, volume, angles, N):
+        """Project the volume without resampling it, the angles in parallel"""
+        num_tilts = len(angles)
+        tiltSeries = np.empty([volume.shape[0], N, num_tilts], dtype=float,
+                              order='F')
+        volume = volume.astype(np.float32, order='F', copy=False)
+
+        # Project a few tilts at a time, to report progress and check for
+        # cancellation in between.
+        self.progress.maximum = num_tilts
+        chunk = max(1, num_tilts // 20)
+        for first in range(0, num_tilts, chunk):
+            if self.canceled:
+                return None
+            last = min(first + chunk, num_tilts)
+            self.progress.message = 'Generating tilt images No.%d-%d/%d' % (
+                first + 1, last, num_tilts)
+
+            tiltSeries[:, :, first:last] = forward_project(
+                volume, angles[first:last], N)
+            self.progress.value = last
+
+        return tiltSeries
@@ -2,9 +2,26 @@ def transform(dataset):
 
     import numpy as np
 
+    try:
+        from tomviz._native import hann_window
+    except ImportError:
+        hann_window = None
+
     # Get the current volume as a numpy array.
     array = dataset.active_scalars
 
+    if hann_window is not None:
+        # Multiply in place, with no copy of Fortran ordered arrays
+        array = np.asfortranarray(array)
+        try:
+            hann_window(array)
+        except ValueError:
+            # Not a type of the native module
+            pass
+        else:
+            dataset.active_scalars = array
+            return
+
     # Save the type
     input_dtype = array.dtype
     array = array.astype(np.float32)
@@ -1,4 +1,10 @@
 import tomviz.operators
+from tomviz.itkutils import itk_available
+
+try:
+    from tomviz._native import otsu_thresholds
+except ImportError:
+    otsu_thresholds = None
 
 
 class OtsuMultipleThreshold(tomviz.operators.CancelableOperator):
@@ -11,6 +17,10 @@ class OtsuMultipleThreshold(tomviz.operators.CancelableOperator):
         is a label map with one label per voxel class.
         """
 
+        if otsu_thresholds is not None and not itk_available():
+            return self.native_transform(dataset, number_of_thresholds,
+                                         enable_valley_emphasis)
+
         # Initial progress
         self.progress.value = 0
         self.progress.maximum = 100
@@ -106,3 +116,27 @@ class OtsuMultipleThreshold(tomviz.operators.CancelableOperator):
             raise exc
 
         return returnValues
+
+    def native_transform(self, dataset, number_of_thresholds,
+                         enable_valley_emphasis):
+        """The same thresholds, from a parallel histogram of the voxels"""
+        import numpy as np
+
+        array = dataset.active_scalars
+
+        self.progress.message = "Computing thresholds"
+        thresholds, labels = otsu_thresholds(array, number_of_thresholds,
+                                             enable_valley_emphasis)
+        print("Otsu threshold(s): %s" % (tuple(thresholds),))
+
+        self.progress.message = "Saving results"
+
+        # The labels stay unsigned char for floating point data, as ITK casts
+        # them, and have the input type otherwise.
+        if not np.issubdtype(array.dtype, np.floating):
+            labels = labels.astype(array.dtype, order='F')
+
+        label_map_dataset = dataset.create_child_dataset()
+        label_map_dataset.active_scalars = labels
+
+        return {"label_map": label_map_dataset}
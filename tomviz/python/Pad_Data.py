@@ -21,10 +21,19 @@ def transform(dataset, pad_size_before=[0, 0, 0], pad_size_after=[0, 0, 0],
     result_shape[1] = array.shape[1] + pad_size_before[1] + pad_size_after[1]
     result_shape[2] = array.shape[2] + pad_size_before[2] + pad_size_after[2]
 
-    result = np.empty(result_shape, array.dtype, order='F')
-
-    # pad the data.
-    result[:] = np.pad(array, pad_width, padMode)
+    try:
+        from tomviz._native import pad
+    except ImportError:
+        pad = None
+
+    if pad is not None and padMode in ('constant', 'edge', 'wrap'):
+        # Pad straight into the Fortran ordered result
+        result = pad(array, pad_size_before, pad_size_after, padMode)
+    else:
+        result = np.empty(result_shape, array.dtype, order='F')
+
+        # pad the data.
+        result[:] = np.pad(array, pad_width, padMode)
 
     dataset.active_scalars = result
 
@@ -1,7 +1,17 @@
 import numpy as np
 
+from tomviz import registration
+from tomviz._internal import in_application
 from tomviz.utils import pad_array, depad_array
 
+# The transformation types that the native registration engine supports,
+# with its names for them
+NATIVE_MODELS = {
+    'translation': 'translation',
+    'rigid body': 'rigid',
+    'affine': 'affine',
+}
+
 
 def transform(
     dataset,
@@ -46,16 +56,21 @@ def transform_generate(dataset, transform_type='translation', padding=0,
                        reference='previous', ref_slice_index=0,
                        apply_to_all_arrays=True, axis=0,
                        transforms_save_file=''):
-    from pystackreg import StackReg
-
     array = dataset.active_scalars
-    sr = StackReg(transform_type_map()[transform_type])
 
     # Apply padding if specified
     array = pad_array(array, padding, axis)
 
     # First, determine the transform matrices
-    if reference != 'slice_index':
+    if registration.available() and axis == 2 and \
+       transform_type in NATIVE_MODELS:
+        transforms = registration.register_stack(
+            array, NATIVE_MODELS[transform_type], reference,
+            ref_slice_index)
+        tmats = registration.to_stackreg(transforms)
+    elif reference != 'slice_index':
+        from pystackreg import StackReg
+        sr = StackReg(transform_type_map()[transform_type])
         tmats = sr.register_stack(
             array,
             axis=axis,
@@ -63,6 +78,8 @@ def transform_generate(dataset, transform_type='translation', padding=0,
         )
     else:
         # We have to do our own special magic to handle this
+        from pystackreg import StackReg
+        sr = StackReg(transform_type_map()[transform_type])
         tmats = register_stack_from_slice(
             sr,
             array,
@@ -81,19 +98,34 @@ def transform_generate(dataset, transform_type='translation', padding=0,
         )
 
     # Now apply the transform to all specified scalars
-    apply_tmats(sr, dataset, tmats, padding, axis, apply_to_all_arrays)
+    return apply_tmats(dataset, tmats, transform_type, padding, axis,
+                       apply_to_all_arrays)
 
 
-def apply_tmats(sr, dataset, tmats, padding, axis, apply_to_all_arrays):
+def apply_tmats(dataset, tmats, transform_type, padding, axis,
+                apply_to_all_arrays):
     if apply_to_all_arrays:
         names = dataset.scalars_names
     else:
         names = [dataset.active_name]
 
+    # The bilinear transformations are not affine, only pystackreg can
+    # apply them
+    native = (registration.available() and axis == 2 and
+              transform_type != 'bilinear')
+    if not native:
+        from pystackreg import StackReg
+        sr = StackReg(transform_type_map()[transform_type])
+
     for name in names:
         array = dataset.scalars(name)
         array = pad_array(array, padding, axis)
-        output = sr.transform_stack(array, axis=axis, tmats=tmats)
+        if native:
+            # pystackreg outputs doubles
+            output = registration.warp(array.astype(np.float64),
+                                       registration.from_stackreg(tmats))
+        else:
+            output = sr.transform_stack(array, axis=axis, tmats=tmats)
 
         # Now remove the padding, if there was any
         output = depad_array(output, padding, axis)
@@ -101,6 +133,18 @@ def apply_tmats(sr, dataset, tmats, padding, axis, apply_to_all_arrays):
         # Convert to Fortran to help VTK
         dataset.set_scalars(name, output)
 
+    # Tables are only available within the application
+    if transform_type == 'bilinear' or not in_application():
+        return
+
+    # The matrices are in the coordinates of the padded images
+    transforms = registration.from_stackreg(tmats)
+    pad = registration.translations(np.full((len(tmats), 2), -padding))
+    transforms = np.linalg.inv(pad) @ transforms @ pad
+    return {
+        'alignments': registration.alignments_table(transforms),
+    }
+
 
 def transform_from_file(dataset, transform_file, apply_to_all_arrays=True,
                         axis=0):
@@ -126,9 +170,8 @@ def transform_from_file(dataset, transform_file, apply_to_all_arrays=True,
     tmats = rescale_tmats(tmats, transform_type, tmat_shape, tmat_spacing,
                           tmat_padding, frame_shape, spacing)
 
-    from pystackreg import StackReg
-    sr = StackReg(transform_type_map()[transform_type])
-    apply_tmats(sr, dataset, tmats, padding, axis, apply_to_all_arrays)
+    return apply_tmats(dataset, tmats, transform_type, padding, axis,
+                       apply_to_all_arrays)
 
 
 def transform_type_map():
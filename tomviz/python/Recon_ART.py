@@ -3,10 +3,16 @@ import scipy.sparse as ss
 import tomviz.operators
 import time
 
+try:
+    from tomviz._native import ArtReconstruction
+except ImportError:
+    ArtReconstruction = None
+
 
 class ReconARTOperator(tomviz.operators.CompletableOperator):
 
-    def transform(self, dataset, Niter=1, Nupdates=0, beta=1.0):
+    def transform(self, dataset, Niter=1, Nupdates=0, beta=1.0,
+                  randomize=False):
         """
         3D Reconstruction using Algebraic Reconstruction Technique (ART)
         """
@@ -29,6 +35,10 @@ class ReconARTOperator(tomviz.operators.CompletableOperator):
         # Determine the slices for live updates.
         Nupdates = calc_Nupdates(Nupdates, Niter)
 
+        if ArtReconstruction is not None:
+            return self.native_transform(dataset, tiltSeries, tiltAngles,
+                                         Niter, Nupdates, beta, randomize)
+
         # Generate measurement matrix
         self.progress.message = 'Generating measurement matrix'
         A = parallelRay(Nray, 1.0, tiltAngles, Nray, 1.0) #A is a sparse matrix
@@ -73,7 +83,7 @@ class ReconARTOperator(tomviz.operators.CompletableOperator):
 
                 b = tiltSeries[s, :, :].transpose().flatten()
 
-                for j in range(Nrow):
+                for j in row_order(Nrow, randomize, i):
                     row[:] = A[j, :].toarray()
                     a = (b[j] - np.dot(row, f))/rowInnerProduct[j]
                     f = f + row * a * beta
@@ -111,6 +121,83 @@ class ReconARTOperator(tomviz.operators.CompletableOperator):
         returnValues["reconstruction"] = child
         return returnValues
 
+    def native_transform(self, dataset, tiltSeries, tiltAngles, Niter,
+                         Nupdates, beta, randomize):
+        """ART with rays traced once and the slices updated in parallel."""
+        (Nslice, Nray, Nproj) = tiltSeries.shape
+
+        self.progress.message = 'Tracing rays'
+        art = ArtReconstruction(tiltSeries.astype(np.float32, order='F'),
+                                np.asarray(tiltAngles, dtype=np.float64))
+
+        # The slices are updated in blocks, to report progress and check for
+        # cancellation in between. The first iteration is split in quarters
+        # for the live updates.
+        n_blocks = max(1, min(Nslice, 10))
+
+        self.progress.maximum = Nslice * Niter
+        t0 = time.time()
+
+        #create child for recon
+        child = dataset.create_child_dataset()
+
+        for i in range(Niter):
+            if self.completed:
+                break
+
+            # Visit the rays in the order of the Python implementation
+            order = None
+            if randomize:
+                order = row_order(Nray * Nproj, randomize, i)
+
+            quarters = Nupdates != 0 and i == 0
+            blocks = 4 if quarters else n_blocks
+            bounds = np.linspace(0, Nslice, min(blocks, Nslice) + 1)
+            bounds = bounds.round().astype(int)
+            for first, last in zip(bounds[:-1], bounds[1:]):
+                if self.canceled or self.completed:
+                    return
+
+                art.iterate(beta, int(first), int(last), order)
+
+                step = i * Nslice + last
+                self.progress.value = step
+                timeLeft = (time.time() - t0) / step * \
+                    (Nslice * Niter - step)
+                timeLeftMin, timeLeftSec = divmod(timeLeft, 60)
+                timeLeftHour, timeLeftMin = divmod(timeLeftMin, 60)
+                self.progress.message = (
+                    'Iteration No.%d/%d,Slice No.%d/%d.' % (
+                        i + 1, Niter, last, Nslice) +
+                    'Estimated time to complete: %02d:%02d:%02d' % (
+                        timeLeftHour, timeLeftMin, timeLeftSec))
+
+                # Give 4 updates for first iteration.
+                if quarters:
+                    child.active_scalars = art.reconstruction
+                    self.progress.data = child
+
+            art.positivity()
+
+            #Update for XX iterations.
+            if Nupdates != 0 and (i + 1) % Nupdates == 0:
+                child.active_scalars = art.reconstruction
+                self.progress.data = child
+
+        # One last update of the child data.
+        child.active_scalars = art.reconstruction #add recon to child
+        self.progress.data = child
+
+        returnValues = {}
+        returnValues["reconstruction"] = child
+        return returnValues
+
+
+def row_order(Nrow, randomize, iteration):
+    if randomize:
+        return np.random.RandomState(iteration).permutation(Nrow)
+    return range(Nrow)
+
 
 def parallelRay(Nside, pixelWidth, angles, Nray, rayWidth):
     # Suppress warning messages that pops up when dividing zeros
@@ -1,8 +1,12 @@
-import pyfftw
 import numpy as np
 import tomviz.operators
 import time
 
+try:
+    from tomviz._native import direct_fourier_reconstruction
+except ImportError:
+    direct_fourier_reconstruction = None
+
 
 class ReconDFMOperator(tomviz.operators.CancelableOperator):
 
@@ -25,10 +29,27 @@ class ReconDFMOperator(tomviz.operators.CancelableOperator):
 
         for array_idx, array_name in enumerate(scalars_names):
             tiltSeries = dataset.scalars(array_name)
-            tiltSeries = np.double(tiltSeries)
             (Nx, Ny, Nproj) = tiltSeries.shape
             Npad = Ny * 2
 
+            if direct_fourier_reconstruction is not None:
+                self.progress.message = f'{array_name}: Gridding projections'
+                recon = self.native_reconstruction(tiltSeries, tiltAngles,
+                                                   Npad, array_idx)
+                if recon is None:
+                    return
+
+                if child_dataset is None:
+                    child_dataset = dataset.create_child_dataset()
+
+                child_dataset.set_scalars(array_name, recon)
+                continue
+
+            # Only the fallback needs FFTW
+            import pyfftw
+
+            tiltSeries = np.double(tiltSeries)
+
             tiltAngles = np.double(tiltAngles)
             pad_pre = int(np.ceil((Npad - Ny) / 2.0))
             pad_post = int(np.floor((Npad - Ny) / 2.0))
@@ -124,6 +145,24 @@ class ReconDFMOperator(tomviz.operators.CancelableOperator):
         returnValues["reconstruction"] = child_dataset
         return returnValues
 
+    def native_reconstruction(self, tiltSeries, tiltAngles, Npad, array_idx):
+        Nproj = tiltSeries.shape[2]
+
+        def progress(fraction):
+            self.progress.value = round(fraction * Nproj) + \
+                array_idx * Nproj
+            return self.canceled
+
+        result = direct_fourier_reconstruction(
+            tiltSeries.astype(np.float32, order='F'),
+            np.asarray(tiltAngles, dtype=np.float64), Npad,
+            progress=progress)
+        if result is None:
+            return None
+
+        recon, _ = result
+        return recon
+
 
 # Bilinear extrapolation
 def bilinear(kz_new, ky_new, sz, sy, N, p):
@@ -3,6 +3,11 @@ import numpy as np
 import tomviz.operators
 import time
 
+try:
+    from tomviz._native import direct_fourier_reconstruction
+except ImportError:
+    direct_fourier_reconstruction = None
+
 
 class ReconConstrintedDFMOperator(tomviz.operators.CancelableOperator):
 
@@ -157,8 +162,17 @@ class ReconConstrintedDFMOperator(tomviz.operators.CancelableOperator):
 
 
 def dfm3(input, angles, Npad):
-    input = np.double(input)
     (Nx, Ny, Nproj) = input.shape
+    if direct_fourier_reconstruction is not None:
+        # Only the kz < Nz / 2 + 1 planes of the Nz = Ny // 2 + 1 planes of the
+        # half spectrum are gridded.
+        Nz = Ny // 2 + 1
+        return direct_fourier_reconstruction(
+            input.astype(np.float32, order='F'),
+            np.asarray(angles, dtype=np.float64), Npad,
+            kz_planes=int(np.ceil(Nz / 2 + 1)))
+
+    input = np.double(input)
     angles = np.double(angles)
     pad_pre = int(np.ceil((Npad - Ny) / 2.0))
     pad_post = int(np.floor((Npad - Ny) / 2.0))
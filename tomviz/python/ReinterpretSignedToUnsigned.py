@@ -26,6 +26,18 @@ def transform(dataset):
     if dtype not in typeMap:
         raise RuntimeError("Scalars are not int8, int16, or int32")
 
+    try:
+        from tomviz._native import reinterpret_unsigned
+    except ImportError:
+        reinterpret_unsigned = None
+
+    if reinterpret_unsigned is not None and scalars.flags.writeable and (
+            scalars.flags.f_contiguous or scalars.flags.c_contiguous):
+        # Adding half of the range flips the sign bit, which is done in
+        # place, and the array is then viewed as unsigned
+        dataset.active_scalars = reinterpret_unsigned(scalars)
+        return
+
     newType = typeMap[dtype]
     addend = typeAddend[dtype]
 
@@ -1,4 +1,10 @@
 import tomviz.operators
+from tomviz.itkutils import itk_available
+
+try:
+    from tomviz._native import segment_particles
+except ImportError:
+    segment_particles = None
 
 
 def median_filter(operator, step_pct, input_image):
@@ -159,6 +165,9 @@ class SegmentParticles(tomviz.operators.CancelableOperator):
         structures.
         """
 
+        if segment_particles is not None and not itk_available():
+            return self.native_transform(dataset, minimum_radius)
+
         # Initial progress
         self.progress.value = 0
         self.progress.maximum = 100
@@ -235,3 +244,28 @@ class SegmentParticles(tomviz.operators.CancelableOperator):
             raise exc
 
         return returnValues
+
+    def native_transform(self, dataset, minimum_radius):
+        """The same segmentation, multithreaded and keeping only the
+        intermediate volumes each step needs"""
+        array = dataset.active_scalars
+
+        self.progress.value = 0
+        self.progress.maximum = 100
+        self.progress.message = "Segmenting particles"
+
+        def progress(fraction):
+            self.progress.value = int(100 * fraction)
+            return self.canceled
+
+        particles = segment_particles(array, minimum_radius, progress)
+        if particles is None:
+            return
+
+        self.progress.message = "Saving results"
+
+        label_map_dataset = dataset.create_child_dataset()
+        label_map_dataset.active_scalars = particles.astype(array.dtype,
+                                                            order='F')
+
+        return {"label_map": label_map_dataset}
@@ -1,4 +1,10 @@
 import tomviz.operators
+from tomviz.itkutils import itk_available
+
+try:
+    from tomviz._native import segment_pores
+except ImportError:
+    segment_pores = None
 
 
 def median_filter(operator, step_pct, input_image):
@@ -273,6 +279,10 @@ class SegmentPores(tomviz.operators.CancelableOperator):
         and less than the maximum radius.  Pores will be separated according to
         the minimum radius."""
 
+        if segment_pores is not None and not itk_available():
+            return self.native_transform(dataset, minimum_radius,
+                                         maximum_radius)
+
         # Initial progress
         self.progress.value = 0
         self.progress.maximum = 100
@@ -367,3 +377,35 @@ class SegmentPores(tomviz.operators.CancelableOperator):
             raise exc
 
         return returnValues
+
+    def native_transform(self, dataset, minimum_radius, maximum_radius):
+        """The same segmentation, multithreaded and keeping only the
+        intermediate volumes each step needs"""
+        import numpy as np
+
+        array = dataset.active_scalars
+
+        self.progress.value = 0
+        self.progress.maximum = 100
+        self.progress.message = "Segmenting pores"
+
+        def progress(fraction):
+            self.progress.value = int(100 * fraction)
+            return self.canceled
+
+        pores = segment_pores(array, list(dataset.spacing), minimum_radius,
+                              maximum_radius, progress)
+        if pores is None:
+            return
+
+        self.progress.message = "Saving results"
+
+        # Unsigned short labels, as the ITK watershed produces, unless there
+        # are too many pores for them
+        if pores.max() <= np.iinfo(np.uint16).max:
+            pores = pores.astype(np.uint16, order='F')
+
+        label_map_dataset = dataset.create_child_dataset()
+        label_map_dataset.active_scalars = pores
+
+        return {"label_map": label_map_dataset}
@@ -1,5 +1,10 @@
+import tomviz.metrics
 import tomviz.operators
 
+# The metrics of the table, the MSE and SSIM first
+METRICS = ("mse", "ssim", "psnr", "ncc", "mi")
+METRIC_LABELS = ("MSE", "SSIM", "PSNR", "NCC", "MI")
+
 
 class SimilarityMetrics(tomviz.operators.CancelableOperator):
 
@@ -9,7 +14,6 @@ class SimilarityMetrics(tomviz.operators.CancelableOperator):
         """
         import numpy as np  # noqa: F811
         from skimage.transform import resize
-        from skimage.metrics import structural_similarity, mean_squared_error
 
         if reference_dataset is None:
             raise Exception("A probe dataset is required.")
@@ -76,8 +80,7 @@ class SimilarityMetrics(tomviz.operators.CancelableOperator):
 
         column_names = ["x"]
         all_table_data = None
-        mse_columns = []
-        ssim_columns = []
+        metric_columns = []
 
         for name in selected_scalars:
             scalars = dataset.scalars(name) if name in dataset_scalars_names else None
@@ -98,76 +101,76 @@ class SimilarityMetrics(tomviz.operators.CancelableOperator):
             self.progress.maximum = n_slices
             self.progress.message = f"Array: {name}"
 
-            mse_data = np.empty(n_slices)
-            ssim_data = np.empty(n_slices)
+            data = {metric: np.empty(n_slices) for metric in METRICS}
+
+            # Slices that need no resizing are compared in batches, by the
+            # native module when it is available
+            dataset_slice_shape = tuple(
+                s for i, s in enumerate(scalars.shape) if i != axis_index
+            )
+            reference_slice_shape = tuple(
+                s for i, s in enumerate(reference_scalars.shape)
+                if i != axis_index
+            )
+            batched = (dataset_slice_shape == common_slice_shape and
+                       reference_slice_shape == common_slice_shape)
+            batch_size = 16 if batched else 1
 
-            for output_slice_index, (
-                dataset_slice_index,
-                reference_slice_index,
-            ) in enumerate(slice_indices):
+            for start in range(0, n_slices, batch_size):
                 if self.canceled:
                     return
 
-                self.progress.value = output_slice_index
-
-                dataset_slice_indexing_list = [slice(None)] * scalars.ndim
-                dataset_slice_indexing_list[axis_index] = dataset_slice_index
-                dataset_slice_indexing = tuple(dataset_slice_indexing_list)
-
-                reference_slice_indexing_list = [slice(None)] * scalars.ndim
-                reference_slice_indexing_list[axis_index] = reference_slice_index
-                reference_slice_indexing = tuple(reference_slice_indexing_list)
+                self.progress.value = start
+                batch = slice_indices[start:start + batch_size]
 
-                scalars_slice = scalars[dataset_slice_indexing]
-                reference_slice = reference_scalars[reference_slice_indexing]
-
-                if scalars_slice.shape == common_slice_shape:
-                    resized_scalars_slice = scalars_slice
-                else:
-                    resized_scalars_slice = resize(scalars_slice, common_slice_shape)
-
-                if reference_slice.shape == common_slice_shape:
-                    resized_reference_slice = reference_slice
-                else:
-                    resized_reference_slice = resize(
-                        reference_slice, common_slice_shape
+                if batched:
+                    batch_metrics = tomviz.metrics.compare_slices(
+                        np.take(reference_scalars, [r for _, r in batch],
+                                axis=axis_index),
+                        np.take(scalars, [d for d, _ in batch],
+                                axis=axis_index),
+                        axis=axis_index, data_range=1.0, normalize=True,
                     )
-
-                # normalize the arrays
-                resized_scalars_slice = (
-                    resized_scalars_slice - np.min(resized_scalars_slice)
-                ) / np.ptp(resized_scalars_slice)
-                resized_reference_slice = (
-                    resized_reference_slice - np.min(resized_reference_slice)
-                ) / np.ptp(resized_reference_slice)
-
-                mse_data[output_slice_index] = mean_squared_error(
-                    resized_reference_slice, resized_scalars_slice
-                )
-                ssim_data[output_slice_index] = structural_similarity(
-                    resized_reference_slice, resized_scalars_slice, data_range=1.0
+                    for metric in METRICS:
+                        data[metric][start:start + len(batch)] = (
+                            batch_metrics[metric]
+                        )
+                    continue
+
+                dataset_slice_index, reference_slice_index = batch[0]
+                scalars_slice = np.take(scalars, dataset_slice_index,
+                                        axis=axis_index)
+                reference_slice = np.take(reference_scalars,
+                                          reference_slice_index,
+                                          axis=axis_index)
+
+                if scalars_slice.shape != common_slice_shape:
+                    scalars_slice = resize(scalars_slice, common_slice_shape)
+
+                if reference_slice.shape != common_slice_shape:
+                    reference_slice = resize(reference_slice,
+                                             common_slice_shape)
+
+                slice_metrics = tomviz.metrics.compare(
+                    reference_slice, scalars_slice, data_range=1.0,
+                    normalize=True,
                 )
+                for metric in METRICS:
+                    data[metric][start] = slice_metrics[metric]
 
             self.progress.value = n_slices
 
             if all_table_data is None:
                 all_table_data = np.arange(n_slices, dtype=float)
 
-            column_names.append(f"{name} MSE")
-            column_names.append(f"{name} SSIM")
-            mse_columns.append(mse_data)
-            ssim_columns.append(ssim_data)
+            for metric, label in zip(METRICS, METRIC_LABELS):
+                column_names.append(f"{name} {label}")
+                metric_columns.append(data[metric])
 
         if all_table_data is None:
             raise RuntimeError("No scalars found!")
 
-        n = len(all_table_data)
-        num_cols = 1 + len(mse_columns) + len(ssim_columns)
-        table_data = np.empty(shape=(n, num_cols))
-        table_data[:, 0] = all_table_data
-        for i, (mse_col, ssim_col) in enumerate(zip(mse_columns, ssim_columns)):
-            table_data[:, 1 + 2 * i] = mse_col
-            table_data[:, 2 + 2 * i] = ssim_col
+        table_data = np.column_stack([all_table_data] + metric_columns)
 
         # Return similarity table as operator result
         return_values = {}
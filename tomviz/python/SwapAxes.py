@@ -3,6 +3,16 @@ def transform(dataset, axis1, axis2):
 
     import numpy as np
 
+    try:
+        from tomviz._native import swap_axes
+    except ImportError:
+        swap_axes = None
+
     data_py = dataset.active_scalars
+    if swap_axes is not None and data_py.ndim == 3:
+        # A tiled transpose straight into the Fortran ordered result
+        dataset.active_scalars = swap_axes(data_py, axis1, axis2)
+        return
+
     swapped = data_py.swapaxes(axis1, axis2)
     dataset.active_scalars = np.asfortranarray(swapped)
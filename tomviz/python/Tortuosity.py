@@ -7,6 +7,11 @@ import numpy as np
 from scipy.sparse import csr_matrix
 from scipy.sparse.csgraph import dijkstra
 
+try:
+    from tomviz._native import geodesic_distance
+except ImportError:
+    geodesic_distance = None
+
 
 class DistanceMethod(Enum):
     Eucledian = 0
@@ -276,6 +281,81 @@ def calculate_tortuosity_distribution(volume, propagation_direction):
     return column_names, table_data
 
 
+def native_connectivity(method):
+    # The neighbours and step lengths that match get_distance_function()
+    if method == DistanceMethod.Eucledian:
+        return 26, True
+    elif method == DistanceMethod.ChessBoard:
+        return 26, False
+    elif method == DistanceMethod.CityBlock:
+        return 6, False
+    else:
+        raise Exception("Unknown distance method %s" % method)
+
+
+def native_distance_maps(operator, volume, phase, method, directions):
+    """Propagate along each direction directly on the voxel grid, without
+    building the graph. Yields (direction, distance map) pairs."""
+    update_progress = get_update_progress_fn(operator.progress, None)
+    connectivity, euclidean = native_connectivity(method)
+    mask = np.asfortranarray(volume == phase).view(np.uint8)
+    n_directions = len(directions)
+
+    for i, direction in enumerate(directions):
+        operator.progress.message = "Propagating along %s" % direction.name
+
+        def progress(value, i=i):
+            update_progress((i + value) / n_directions)
+            return operator.canceled
+
+        result = geodesic_distance(mask, direction.value, connectivity,
+                                   euclidean, progress)
+        if result is None:
+            return
+
+        yield direction, result
+
+
+def python_distance_maps(operator, volume, phase, method, directions):
+    """Build the voxel graph in Python and run Dijkstra along each
+    direction. Yields (direction, distance map) pairs."""
+    graph_generation_update_progress_fn = get_update_progress_fn(
+        operator.progress, OperatorStages.GraphGeneration)
+    graph_traversal_update_progress_fn = get_update_progress_fn(
+        operator.progress, OperatorStages.GraphTraversal)
+
+    operator.progress.message = "Converting volume to graph..."
+    node_map, inv_node_map, node_map_array, edges, aux_edges = (
+        volume_to_graph(
+            volume, phase, method,
+            graph_generation_update_progress_fn)
+    )
+
+    n_directions = len(directions)
+
+    for i, direction in enumerate(directions):
+        operator.progress.message = "Propagating along %s" % direction.name
+        graph_traversal_update_progress_fn(i / n_directions)
+
+        csgraph = edges_to_sparse_matrix(
+            edges, aux_edges, direction.value,
+            len(inv_node_map), volume.ndim)
+
+        graph_traversal_update_progress_fn(i / n_directions + 0.33)
+
+        dist_matrix = dijkstra(csgraph, directed=False,
+                               indices=direction.value)
+
+        graph_traversal_update_progress_fn(i / n_directions + 0.9)
+
+        # Generate the distance map
+
+        result = distance_matrix_to_volume(inv_node_map, dist_matrix,
+                                           volume.shape)
+
+        yield direction, result
+
+
 def get_update_progress_fn(progress, stage):
     GRAPH_GENERATION_FRACTION = 0.9
     OTHER_FRACTION = 1 - GRAPH_GENERATION_FRACTION
@@ -346,42 +426,16 @@ class TortuosityOperator(tomviz.operators.CancelableOperator):
 
         self.progress.maximum = 100
 
-        graph_generation_update_progress_fn = get_update_progress_fn(
-            self.progress, OperatorStages.GraphGeneration)
-        graph_traversal_update_progress_fn = get_update_progress_fn(
-            self.progress, OperatorStages.GraphTraversal)
-
-        self.progress.message = "Converting volume to graph..."
-        node_map, inv_node_map, node_map_array, edges, aux_edges = (
-            volume_to_graph(
-                scalars, phase, distance_method,
-                graph_generation_update_progress_fn)
-        )
-
-        n_directions = len(propagation_directions)
+        if geodesic_distance is not None and scalars.ndim <= 3:
+            distance_maps = native_distance_maps(
+                self, scalars, phase, distance_method, propagation_directions)
+        else:
+            distance_maps = python_distance_maps(
+                self, scalars, phase, distance_method, propagation_directions)
 
         return_values = {}
 
-        for i, direction in enumerate(propagation_directions):
-            self.progress.message = "Propagating along %s" % direction.name
-            graph_traversal_update_progress_fn(i / n_directions)
-
-            csgraph = edges_to_sparse_matrix(
-                edges, aux_edges, direction.value,
-                len(inv_node_map), scalars.ndim)
-
-            graph_traversal_update_progress_fn(i / n_directions + 0.33)
-
-            dist_matrix = dijkstra(csgraph, directed=False,
-                                   indices=direction.value)
-
-            graph_traversal_update_progress_fn(i / n_directions + 0.9)
-
-            # Generate the distance map
-
-            result = distance_matrix_to_volume(inv_node_map, dist_matrix,
-                                               scalars.shape)
-
+        for direction, result in distance_maps:
             if save_to_file:
                 filename = "distance_map_%s.npy" % direction.name
                 np.save(os.path.join(output_folder, filename), result)
@@ -9,6 +9,18 @@ def transform(dataset, SX=0.5, SY=0.5, SZ=0.5, noise=15.0):
     array = dataset.active_scalars
     dim = array.shape
 
+    try:
+        from tomviz._native import wiener_filter
+    except ImportError:
+        wiener_filter = None
+
+    if wiener_filter is not None and array.ndim == 3:
+        # The filter is computed on the fly from the frequencies, instead of
+        # as full complex volumes
+        final = wiener_filter(array, [SX, SY, SZ], noise)
+        dataset.active_scalars = final
+        return
+
     #Point Spread Function (Estimated with Gaussian Function)
     def gaussian(SX, SY, SZ):
         x = np.arange(-dim[0]/2, dim[0]/2)
@@ -1,5 +1,10 @@
 import numpy as np
 
+try:
+    from tomviz._native import filter_images
+except ImportError:
+    filter_images = None
+
 
 # Given an dataset containing one or more 2D images,
 # apply CTF operations on them.
@@ -10,6 +15,16 @@ def transform(dataset, apix=None, df1=None, df2=None, ast=None, ampcon=None,
 
     methods = ('wiener_filter', 'ctf_multiply', 'phase_flip')
 
+    if filter_images is not None:
+        # The images share one CTF, so the filter is computed once and the
+        # images are filtered in parallel.
+        CTFim = -CTF(tiltSeries.shape[:2], df1, df2, ast, ampcon, cs, kev,
+                     apix)
+        CTFfilter = correction_filter(CTFim, methods[ctf_method], snr)
+        tiltSeries[:] = filter_images(tiltSeries, CTFfilter)
+        dataset.active_scalars = tiltSeries
+        return
+
     # Main loop
     for i in range(tiltSeries.shape[2]):
         tiltSeries[:, :, i] = correct_CTF(tiltSeries[:, :, i], df1, df2, ast,
@@ -25,17 +40,21 @@ def correct_CTF(img, DF1, DF2, AST, AmpCon, Cs, kV, apix, method, snr):
     CTFim = -CTF(img.shape, DF1, DF2, AST, AmpCon, Cs, kV, apix)
 
     FTim = np.fft.rfftn(img)
-    if method == 'wiener_filter':
-        CTFcor = np.fft.irfftn((FTim * CTFim) / (CTFim * CTFim + snr))
-    if method == 'phase_flip':
-        s = np.sign(CTFim)
-        CTFcor = np.fft.irfftn(FTim * s)
-    if method == 'ctf_multiply':
-        CTFcor = np.fft.irfftn(FTim * CTFim)
+    CTFcor = np.fft.irfftn(FTim * correction_filter(CTFim, method, snr),
+                           img.shape)
 
     return CTFcor
 
 
+# The real filter correct_CTF() multiplies the spectrum of an image by
+def correction_filter(CTFim, method, snr):
+    if method == 'wiener_filter':
+        return CTFim / (CTFim * CTFim + snr)
+    if method == 'phase_flip':
+        return np.sign(CTFim)
+    return CTFim
+
+
 # Generates 2D CTF Function
 # Underfocus is positive following conventions of FREALIGN and most packages
 # DF - (in Microns)
@@ -1,10 +1,14 @@
-import tomviz._realtime.wbp as wbp
+from tomviz._realtime.watcher import DirectoryWatcher
 from tomviz.io import ser
 from tomviz.io import dm
 import numpy as np
-import time
 import os
 
+try:
+    import tomviz._native as native
+except ImportError:
+    native = None
+
 
 # Class for listening and logging new files for real-time reconstruction
 class Logger:
@@ -21,119 +25,147 @@ class Logger:
         self.alignMethod = alignMethod
         self.invert = invert
 
-        self.listenFiles = self.listen_files_list(self.listenDir)
-        self.logFiles, self.logTiltSeries, self.logTiltAngles = [], [], []
-        self.logTiltSeries0 = []
+        self.watcher = DirectoryWatcher(self.listenDir, self.fileExt)
+        self.pendingFiles = []
+        self.logFiles, self.logTiltAngles = [], np.empty(0)
+
+        # The aligned projections, in a buffer grown by doubling so that
+        # appending one does not copy the others
+        self._projections = None
+        self._count = 0
+        # The re-centered tilt series, until a projection is appended
+        self._series = None
+        self._filters = None
+        self.tiltAxis = TiltAxisEstimate()
         print("Listener on {} created.".format(self.listenDir))
 
-    def listen_files_list(self, directory):
-        """Grab current files in listen directory"""
-        files = [f for f in os.listdir(directory) if
-                 f[-len(self.fileExt):] == self.fileExt]
-        return files
-
-    def CHANGE_appendAll(self):
-        """Append stored files for each new element"""
-        # Separate new files to be loaded
-        FoI = list(set(self.listenFiles)-set(self.logFiles))
-        FoI.sort()
-        for file in FoI:
+    @property
+    def logTiltSeries(self):
+        """The aligned tilt series, (Nslice, Nray, Nproj), re-centered on
+        the tilt axis when aligning by cross-correlation. It is computed once
+        per projection appended, not on every access."""
+        if self._series is not None:
+            return self._series
+        series = self._projections[:, :, :self._count]
+        if self.alignMethod == 'xcor':
+            shift = self.tiltAxis.shift(series.shape[1])
+            if shift != 0:
+                series = np.roll(series, shift, axis=1)
+        self._series = series
+        return series
+
+    def append_files(self, files):
+        """Append the new files, in order. A file that can not be read is
+        retried, with the ones after it, on the next pass."""
+        self.pendingFiles.extend(files)
+        appended = 0
+        while self.pendingFiles:
+            file = self.pendingFiles[0]
             print("Loading {}".format(file))
             filePath = os.path.join(self.listenDir, file)
 
             try:
                 (newProj, newAngle) = self.read_projection_image(filePath)
-
-                self.logTiltAngles = np.append(self.logTiltAngles, newAngle)
-
-                # Invert Contrast for BF-TEM
-                if self.invert:
-                    newProj *= -1
-
-                newProj = self.background_subtract(newProj)
-
-                # Apply Center of Mass (if selected)
-                if self.alignMethod == 'CoM':
-                    newProj = self.center_of_mass_align(newProj)
-
-                # Account for Python's disdain for AxAx1 arrays
-                # (compresses to 2D)
-                if (len(self.logTiltSeries0) == 0):
-                    dataDim = np.shape(newProj)
-                    self.logTiltSeries0 = np.zeros([dataDim[0], dataDim[1], 1])
-                    self.logTiltSeries0[:, :, 0] = newProj
-                    self.wbp = wbp.WBP(dataDim[0], dataDim[1], 1)
-                else:
-                    self.logTiltSeries0 = np.dstack((self.logTiltSeries0,
-                                                     newProj))
-
-                self.logFiles = np.append(self.logFiles, file)
-
+                self.append_projection(newProj, newAngle)
             except Exception:
                 print('Could not read : {}, will proceed with reconstruction\
                         and re-download on next pass'.format(file))
                 break
 
-        # Apply Cross-Correlation after reading images (if selected)
-        if self.alignMethod == 'xcor':
-            self.logTiltSeries = self.xcorr_align(self.logTiltSeries0)
-            # update tilt angles and sinogram
-            self.wbp.set_tilt_series(self.logTiltSeries, self.logTiltAngles)
-            # re-center tilt axis
-            self.logTiltSeries = self.shift_tilt_axis(self.logTiltSeries,
-                                                      self.logTiltAngles)
-        else:
-            self.logTiltSeries = self.logTiltSeries0
+            self.logFiles.append(file)
+            self.pendingFiles.pop(0)
+            appended += 1
 
-    def monitor(self, seconds=1):
-        """Return true if, within seconds, any new files exist in listenDir
-        NOTE: Lazy Scheme is used (set difference), can update """
+        return appended
 
-        for ts in range(0, seconds):
-            self.listenFiles = self.listen_files_list(self.listenDir)
-            FoI = list(set(self.listenFiles)-set(self.logFiles))
-            if len(FoI) == 0:
-                time.sleep(1)
-            else:
-                self.CHANGE_appendAll() # Can be probamatic for first iter..
-                return True
+    def monitor(self, seconds=1):
+        """Return true if, within seconds, any new files were written to
+        listenDir and logged. The directory is watched rather than polled."""
+
+        files = self.watcher.wait(seconds)
+        if not files and not self.pendingFiles:
+            return False
+        return self.append_files(files) > 0
+
+    def append_projection(self, projection, angle):
+        """Prepare and align one projection, and add it to the tilt series.
+        Its cost does not depend on the number of projections logged."""
+
+        projection = np.array(projection, dtype=np.float32)
+        if self._count > 0 and \
+           projection.shape != self._projections.shape[:2]:
+            raise ValueError('Expected a {} projection'.format(
+                self._projections.shape[:2]))
+
+        # Invert Contrast for BF-TEM
+        if self.invert:
+            projection *= -1
+
+        projection = self.background_subtract(projection)
+
+        # Apply Center of Mass (if selected)
+        if self.alignMethod == 'CoM':
+            projection = self.center_of_mass_align(projection)
+        # Or align to the projection nearest in tilt angle
+        elif self.alignMethod == 'xcor' and self._count > 0:
+            neighbour = np.argmin(np.abs(self.logTiltAngles - angle))
+            rFilter, kFilter = self.xcorr_filters(projection.shape)
+            projection = self.crossCorrelationAlign(
+                projection, self._projections[:, :, neighbour], rFilter,
+                kFilter)
+
+        if self._projections is None:
+            self._projections = np.empty(projection.shape + (16,),
+                                         dtype=np.float32, order='F')
+        elif self._count == self._projections.shape[2]:
+            grown = np.empty(projection.shape + (2 * self._count,),
+                             dtype=np.float32, order='F')
+            grown[:, :, :self._count] = self._projections
+            self._projections = grown
+        self._projections[:, :, self._count] = projection
+        self._count += 1
+        self._series = None
+        self.logTiltAngles = np.append(self.logTiltAngles, angle)
 
-        return False
+        if self.alignMethod == 'xcor':
+            self.tiltAxis.add(projection, angle)
 
     def read_projection_image(self, fname):
         """Acquires angles from metadata of .dm4 files"""
 
         if self.fileExt == 'dm4':
-            file = dm.FileDM(fname)
             alphaTag = '.ImageList.2.ImageTags.Microscope Info.'\
                        'Stage Position.Stage Alpha'
-            return (file.getDataset(0)['data'], file.allTags[alphaTag])
+            (data, tags) = read_dm(fname)
+            return (data, tags[alphaTag])
         elif self.fileExt == 'ser':
-            file = ser.SerReader(fname)
-            return (file['data'], file['metadata']['Stage A [deg]'])
+            file = ser.FileSER(fname)
+            (data, _) = file.getDataset(0)
+            return (data, file._emi['Stage A [deg]'])
         # Stage Alpha isn't stored in metadata for dm3 or tif
         elif self.fileExt == 'dm3':
             # Parse fname for stage alpha
-            file = dm.FileDM(fname)
+            (data, _) = read_dm(fname)
 
             match = 'degrees'
             tags = fname.split('_')
 
             angle = [tag for tag in tags if match in tag][0]
             angleInd = angle.find(match)
-            return (file.getDataset(0)['data'], float(angle[:angleInd]))
+            return (data, float(angle[:angleInd]))
 
     # Pass Tilt Series to Reconstruction Objects
     def load_tilt_series(self, tomo, alg):
 
+        series = self.logTiltSeries
         if alg != 'WBP':
-            (Nslice, Nray, Nproj) = self.logTiltSeries.shape
-            b = np.zeros([Nslice, Nray * Nproj], dtype=np.float32)
-            for s in range(Nslice):
-                b[s, :] = self.logTiltSeries[s, :, :].transpose().ravel()
-            tomo.set_tilt_series(b)
+            # Each row is the sinogram of a slice, one projection after another
+            (Nslice, Nray, Nproj) = series.shape
+            b = np.ascontiguousarray(series.transpose(0, 2, 1),
+                                     dtype=np.float32)
+            tomo.set_tilt_series(b.reshape(Nslice, Nproj * Nray))
         else:
-            tomo.set_tilt_series(self.logTiltSeries, self.logTiltAngles)
+            tomo.set_tilt_series(series, self.logTiltAngles)
 
     # Remove Background Intensity
     def background_subtract(self, image):
@@ -167,14 +199,15 @@ class Logger:
 
         return output
 
-    # Automatically align tilt images by cross-correlation
-    def xcorr_align(self, tiltSeries):
+    # The filters of the cross-correlation of projections of shape
+    def xcorr_filters(self, shape):
 
-        referenceIndex = tiltSeries.shape[2] // 2
+        if self._filters is not None and self._filters[0] == shape:
+            return self._filters[1:]
 
         # create Fourier space filter
         filterCutoff = 4
-        (Ny, Nx, Nproj) = tiltSeries.shape
+        (Ny, Nx) = shape
         ky = np.fft.fftfreq(Ny)
         kx = np.fft.fftfreq(Nx)
         [kX, kY] = np.meshgrid(kx, ky)
@@ -188,15 +221,8 @@ class Logger:
         [X, Y] = np.meshgrid(x, y)
         rFilter = (np.sin(np.pi * X / Nx) * np.sin(np.pi * Y / Ny)) ** 2
 
-        for i in range(referenceIndex, Nproj - 1):
-            tiltSeries[:, :, i + 1] = self.crossCorrelationAlign(
-                tiltSeries[:, :, i + 1], tiltSeries[:, :, i], rFilter, kFilter)
-
-        for i in range(referenceIndex, 0, -1):
-            tiltSeries[:, :, i - 1] = self.crossCorrelationAlign(
-                tiltSeries[:, :, i - 1], tiltSeries[:, :, i], rFilter, kFilter)
-
-        return tiltSeries
+        self._filters = (shape, rFilter, kFilter)
+        return self._filters[1:]
 
     # Align image to reference by cross-correlation
     def crossCorrelationAlign(self, image, reference, rFilter, kFilter):
@@ -212,31 +238,52 @@ class Logger:
 
         return output
 
-    # Recenter the tilt axis after xcorr
-    def shift_tilt_axis(self, tiltSeries, tiltAngles):
-
-        Nx, Ny, Nz = tiltSeries.shape
-
-        shifts = (np.linspace(-20, 20, 41)).astype('int')
-        numberOfSlices = 5  # number of slices used for recon
-
-        # randomly choose slices with top 50% total intensities
-        tiltSeriesSum = np.sum(tiltSeries, axis=(1, 2))
-        temp = tiltSeriesSum.argsort()[Nx // 2:]
-        slices = temp[np.random.permutation(temp.size)[:numberOfSlices]]
-
-        I = np.zeros(shifts.size)
-
-        for i in range(shifts.size):
-
-            shiftedTiltSeries = np.roll(
-                tiltSeries[slices, :, :, ], shifts[i], axis=1)
-            for s in range(numberOfSlices):
-
-                recon = self.wbp.wbp2(shiftedTiltSeries[s, :, :],
-                                      'ramp', 'linear')
-                I[i] = I[i] + np.amax(recon)
-
-        tiltSeries = np.roll(tiltSeries, shifts[np.argmax(I)], axis=1)
 
-        return tiltSeries
+def read_dm(fname):
+    """The first image of a DM file, as FileDM reads it, and its tags"""
+
+    if native is not None:
+        result = native.read_dm(fname)
+        return (result['datasets'][0]['data'].T, result['metadata'])
+    file = dm.FileDM(fname)
+    return (file.getDataset(0)['data'], file.allTags)
+
+
+class TiltAxisEstimate:
+    """Locates the tilt axis along the rays from the centers of mass of the
+    projections. Rotating about an axis at d, the center of mass of the
+    projections follows d + a cos(angle) + b sin(angle), which is fitted by
+    least squares. The sums of the normal equations are updated with each
+    projection, so the cost does not depend on the number of projections.
+    """
+
+    def __init__(self):
+        self.normal = np.zeros((3, 3))
+        self.rhs = np.zeros(3)
+
+    def add(self, projection, angle):
+        profile = np.sum(projection, axis=0, dtype=np.float64)
+        total = np.sum(profile)
+        if total <= 0:
+            return
+        center = np.dot(profile, np.arange(profile.size)) / total
+        theta = np.deg2rad(angle)
+        basis = np.array([1.0, np.cos(theta), np.sin(theta)])
+        self.normal += np.outer(basis, basis)
+        self.rhs += basis * center
+
+    def axis(self):
+        """The position of the axis along the rays, None until there are
+        enough distinct angles"""
+
+        if np.linalg.matrix_rank(self.normal, tol=1e-6) < 3:
+            return None
+        return np.linalg.solve(self.normal, self.rhs)[0]
+
+    def shift(self, Nray):
+        """The shift along the rays that moves the axis to the center"""
+
+        axis = self.axis()
+        if axis is None:
+            return 0
+        return int(np.round(Nray // 2 - axis))
@@ -0,0 +1,144 @@
+import ctypes
+import ctypes.util
+import os
+import select
+import struct
+import sys
+import time
+
+# inotify events of a file closed after writing, or moved in
+IN_CLOSE_WRITE = 0x00000008
+IN_MOVED_TO = 0x00000080
+IN_Q_OVERFLOW = 0x00004000
+
+_EVENT_HEADER = struct.Struct('iIII')
+
+
+def _inotify_libc():
+    if not sys.platform.startswith('linux'):
+        return None
+    try:
+        libc = ctypes.CDLL(ctypes.util.find_library('c') or 'libc.so.6',
+                           use_errno=True)
+        libc.inotify_init1
+        libc.inotify_add_watch
+    except (OSError, AttributeError):
+        return None
+    return libc
+
+
+class DirectoryWatcher:
+    """Reports the files with an extension written to a directory.
+
+    On Linux the directory is watched with inotify, and a file is reported
+    once it is closed after writing, or moved in, so that it is not read
+    while it is being written. Elsewhere the directory is listed only when
+    its modification time changes, and a file is reported once its size
+    stayed the same between two listings. The files already in the directory
+    are reported first.
+    """
+
+    def __init__(self, directory, extension, poll_interval=0.25):
+        self.directory = directory
+        self.extension = extension
+        self.poll_interval = poll_interval
+        self._reported = set()
+        self._sizes = {}
+        self._mtime = None
+        self._fd = None
+
+        libc = _inotify_libc()
+        if libc is not None:
+            fd = libc.inotify_init1(os.O_NONBLOCK | os.O_CLOEXEC)
+            if fd >= 0:
+                wd = libc.inotify_add_watch(fd, os.fsencode(directory),
+                                            IN_CLOSE_WRITE | IN_MOVED_TO)
+                if wd >= 0:
+                    self._fd = fd
+                else:
+                    os.close(fd)
+
+        # Watch before listing, so that no file is missed in between
+        self._pending = [f for f in self._list() if self._complete(f)]
+
+    def close(self):
+        if self._fd is not None:
+            os.close(self._fd)
+            self._fd = None
+
+    def __del__(self):
+        self.close()
+
+    def wait(self, timeout):
+        """The sorted names of the files written since the last call,
+        waiting up to timeout seconds for one."""
+        deadline = time.monotonic() + timeout
+        while True:
+            files = self._take()
+            remaining = deadline - time.monotonic()
+            if files or remaining <= 0:
+                return files
+            if self._fd is not None:
+                ready, _, _ = select.select([self._fd], [], [], remaining)
+                if ready:
+                    self._read_events()
+            else:
+                time.sleep(min(self.poll_interval, remaining))
+                self._poll()
+
+    def _take(self):
+        files = sorted(set(self._pending) - self._reported)
+        self._reported.update(files)
+        self._pending = []
+        for name in files:
+            self._sizes.pop(name, None)
+        return files
+
+    def _matches(self, name):
+        return name.endswith(self.extension)
+
+    def _list(self):
+        return [f for f in os.listdir(self.directory) if self._matches(f)]
+
+    def _complete(self, name):
+        # Without inotify, a file is complete once its size holds still
+        if self._fd is not None:
+            return True
+        try:
+            size = os.stat(os.path.join(self.directory, name)).st_size
+        except OSError:
+            return False
+        previous = self._sizes.get(name)
+        self._sizes[name] = size
+        return previous == size
+
+    def _read_events(self):
+        try:
+            buffer = os.read(self._fd, 64 * 1024)
+        except BlockingIOError:
+            return
+        offset = 0
+        while offset + _EVENT_HEADER.size <= len(buffer):
+            _, mask, _, length = _EVENT_HEADER.unpack_from(buffer, offset)
+            offset += _EVENT_HEADER.size
+            name = buffer[offset:offset + length].rstrip(b'\0')
+            offset += length
+            if mask & IN_Q_OVERFLOW:
+                # Events were dropped, so list the directory again
+                self._pending.extend(self._list())
+            elif name:
+                name = os.fsdecode(name)
+                if self._matches(name):
+                    self._pending.append(name)
+
+    def _poll(self):
+        try:
+            mtime = os.stat(self.directory).st_mtime_ns
+        except OSError:
+            return
+        # Files still being written are listed again until they are complete
+        if mtime == self._mtime and not self._sizes:
+            return
+        self._mtime = mtime
+        self._pending.extend(f for f in self._list()
+                             if f not in self._reported and self._complete(f))
@@ -5,6 +5,7 @@ from pathlib import Path
 
 from tomviz import executor
 
+from .batch import run_batch
 from .load_data_source import create_read_options, extract_data_path
 from .data_source_dependencies import load_dependencies
 
@@ -112,8 +113,20 @@ def _extract_pipeline(state, selected_data_source=None):
 @click.option('-i', '--operator-index',
               help='The operator to start at.',
               type=int, default=0)
+@click.option('-j', '--jobs',
+              help='The number of files of a directory to run the pipeline '
+                   'on concurrently. The files progress of each is written '
+                   'to a subdirectory named after it, and the socket '
+                   'progress method can not be used with more than one.',
+              type=click.IntRange(min=1), default=1)
+@click.option('-m', '--memory-limit',
+              help='The memory, in GB, that the files of a directory run '
+                   'concurrently may use. Half of the physical memory by '
+                   'default.',
+              type=click.FloatRange(min=0), default=None)
 def main(data_path, state_file_path, output_file_path, progress_method,
-         socket_path, operator_index, selected_data_source):
+         socket_path, operator_index, selected_data_source, jobs,
+         memory_limit):
 
     # Extract the pipeline
     with open(state_file_path, encoding='utf-8') as fp:
@@ -160,6 +173,16 @@ def main(data_path, state_file_path, output_file_path, progress_method,
     elif number_of_files > 1:
         logger.info('Executing pipeline on %d files.' % number_of_files)
 
+    if data_path.is_dir():
+        # Run the files of a directory concurrently, skipping the ones
+        # completed by a previous run
+        if memory_limit is not None:
+            memory_limit = int(memory_limit * 1e9)
+        run_batch(operators, operator_index, data_file_paths,
+                  output_file_paths, progress_method, socket_path,
+                  read_options, dependencies, jobs, memory_limit)
+        return
+
     for (data_file_path, output_file_path) in zip(data_file_paths,
                                                   output_file_paths):
         logger.info('Executing pipeline on %s' % data_file_path)
@@ -0,0 +1,265 @@
+from concurrent.futures import (FIRST_COMPLETED, Future, ProcessPoolExecutor,
+                                ThreadPoolExecutor, wait)
+import hashlib
+import json
+import logging
+import os
+from pathlib import Path
+import time
+
+import h5py
+
+from tomviz import executor
+
+logger = logging.getLogger('tomviz')
+
+MANIFEST_NAME = 'tomviz_batch_manifest.json'
+MANIFEST_VERSION = 1
+
+# The memory a pipeline needs, relative to its input: the input, the result
+# and the intermediate arrays of an operator
+MEMORY_FACTOR = 3
+
+
+def file_hash(path, chunk_size=1 << 20):
+    sha = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for chunk in iter(lambda: f.read(chunk_size), b''):
+            sha.update(chunk)
+    return sha.hexdigest()
+
+
+def pipeline_hash(operators, start_at):
+    description = json.dumps([start_at, operators[start_at:]], sort_keys=True)
+    return hashlib.sha256(description.encode()).hexdigest()
+
+
+def estimate_memory(path):
+    """The bytes needed to run the pipeline on the HDF5 file at path, from
+    the sizes of its datasets"""
+    size = 0
+
+    def add(name, item):
+        nonlocal size
+        if isinstance(item, h5py.Dataset):
+            size += item.size * item.dtype.itemsize
+
+    try:
+        with h5py.File(path, 'r') as f:
+            f.visititems(add)
+    except OSError:
+        size = os.path.getsize(path)
+
+    return MEMORY_FACTOR * size
+
+
+def default_memory_limit():
+    """Half of the physical memory, or None if it is not known"""
+    try:
+        return os.sysconf('SC_PHYS_PAGES') * os.sysconf('SC_PAGE_SIZE') // 2
+    except (AttributeError, ValueError, OSError):
+        return None
+
+
+class Manifest:
+    """The outputs written by previous runs of a pipeline, with the hashes
+    of their inputs, so that a rerun skips the files that were finished."""
+
+    def __init__(self, path, pipeline):
+        self.path = Path(path)
+        self.pipeline = pipeline
+        self.files = {}
+
+        if self.path.exists():
+            try:
+                with open(self.path, encoding='utf-8') as fp:
+                    manifest = json.load(fp)
+            except ValueError:
+                logger.warning('Ignoring invalid manifest %s' % self.path)
+                return
+
+            # Outputs of another pipeline have to be written again
+            if manifest.get('version') == MANIFEST_VERSION and \
+                    manifest.get('pipeline') == pipeline:
+                self.files = manifest.get('files', {})
+
+    def is_complete(self, input_path, input_hash, output_path):
+        entry = self.files.get(str(Path(input_path).resolve()))
+        return entry is not None and entry['sha256'] == input_hash and \
+            entry['output'] == str(Path(output_path).resolve()) and \
+            Path(output_path).exists()
+
+    def add(self, input_path, input_hash, output_path):
+        self.files[str(Path(input_path).resolve())] = {
+            'sha256': input_hash,
+            'output': str(Path(output_path).resolve()),
+        }
+        self.save()
+
+    def save(self):
+        manifest = {
+            'version': MANIFEST_VERSION,
+            'pipeline': self.pipeline,
+            'files': self.files,
+        }
+        # Replace it whole, so that a crash leaves the previous one
+        temp_path = self.path.with_name(self.path.name + '.tmp')
+        with open(temp_path, 'w', encoding='utf-8') as fp:
+            json.dump(manifest, fp, indent=2)
+        os.replace(temp_path, self.path)
+
+
+def file_progress_path(progress_method, progress_path, data_file_path):
+    """The progress path of a file. The progress files of each input are
+    written to a subdirectory named after it, so that the files run
+    concurrently do not overwrite each other's."""
+    if progress_method != 'files':
+        return progress_path
+
+    path = Path(progress_path) / Path(data_file_path).name
+    path.mkdir(parents=True, exist_ok=True)
+    return str(path)
+
+
+# The pipeline of a worker process, with its operator modules loaded once
+_worker = {}
+
+
+def _init_worker(operators, start_at, progress_method, read_options,
+                 dependencies):
+    _worker.update(
+        operators=operators,
+        start_at=start_at,
+        progress_method=progress_method,
+        read_options=read_options,
+        dependencies=dependencies,
+        transforms=executor.load_transform_functions(operators, start_at),
+    )
+
+
+def _run(data_file_path, output_file_path, progress_path):
+    executor.execute(_worker['operators'], _worker['start_at'],
+                     data_file_path, output_file_path,
+                     _worker['progress_method'], progress_path,
+                     _worker['read_options'], _worker['dependencies'],
+                     _worker['transforms'])
+
+
+class _SerialExecutor:
+    """Runs the files in this process, as a pool of one worker would"""
+
+    def __init__(self, initargs):
+        _init_worker(*initargs)
+
+    def submit(self, fn, *args):
+        future = Future()
+        try:
+            future.set_result(fn(*args))
+        except Exception as e:
+            future.set_exception(e)
+        return future
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        _worker.clear()
+        return False
+
+
+def run_batch(operators, start_at, data_file_paths, output_file_paths,
+              progress_method, progress_path, read_options, dependencies,
+              jobs=1, memory_limit=None):
+    """Run the pipeline on each file, up to jobs at a time while their
+    estimated memory fits within memory_limit bytes. The outputs are
+    recorded in a manifest next to them, and the files whose output is
+    recorded for the same input and pipeline are skipped. The progress
+    files of each input are written to a subdirectory of progress_path."""
+
+    if not data_file_paths:
+        return
+
+    # The messages of files run concurrently would interleave on the socket
+    if progress_method == 'socket' and jobs > 1:
+        raise Exception('The progress of files run concurrently can not be '
+                        'sent to a socket, use the tqdm or files progress '
+                        'method.')
+
+    output_dir = Path(output_file_paths[0]).resolve().parent
+    manifest = Manifest(output_dir / MANIFEST_NAME,
+                        pipeline_hash(operators, start_at))
+
+    # Hashing reads every input, so do it concurrently
+    with ThreadPoolExecutor(max_workers=max(jobs, 4)) as pool:
+        hashes = list(pool.map(file_hash, data_file_paths))
+
+    pending = []
+    skipped = 0
+    for (data_file_path, output_file_path, input_hash) in zip(
+            data_file_paths, output_file_paths, hashes):
+        if manifest.is_complete(data_file_path, input_hash, output_file_path):
+            skipped += 1
+            continue
+        pending.append((data_file_path, output_file_path, input_hash,
+                        estimate_memory(data_file_path)))
+
+    if skipped:
+        logger.info('Skipping %d files already completed.' % skipped)
+
+    if memory_limit is None:
+        memory_limit = default_memory_limit()
+
+    initargs = (operators, start_at, progress_method, read_options,
+                dependencies)
+    if jobs > 1:
+        pool = ProcessPoolExecutor(max_workers=jobs, initializer=_init_worker,
+                                   initargs=initargs)
+    else:
+        pool = _SerialExecutor(initargs)
+
+    running = {}
+    failed = []
+    completed = 0
+    completed_bytes = 0
+    start = time.perf_counter()
+    with pool:
+        while pending or running:
+            # Start files while they fit, but always at least one
+            in_use = sum(item[3] for item in running.values())
+            while pending and len(running) < jobs and \
+                    (not running or memory_limit is None or
+                     in_use + pending[0][3] <= memory_limit):
+                item = pending.pop(0)
+                logger.info('Executing pipeline on %s' % item[0])
+                running[pool.submit(
+                    _run, str(item[0]), str(item[1]),
+                    file_progress_path(progress_method, progress_path,
+                                       item[0]))] = item
+                in_use += item[3]
+
+            done, _ = wait(running, return_when=FIRST_COMPLETED)
+            for future in done:
+                (data_file_path, output_file_path, input_hash, _) = \
+                    running.pop(future)
+                try:
+                    future.result()
+                except Exception as e:
+                    logger.error('Pipeline failed on %s: %s'
+                                 % (data_file_path, e))
+                    failed.append(data_file_path)
+                    continue
+
+                manifest.add(data_file_path, input_hash, output_file_path)
+                completed += 1
+                completed_bytes += os.path.getsize(data_file_path)
+
+    elapsed = time.perf_counter() - start
+    if completed:
+        logger.info('Completed %d files, %.3f GB, in %.1f s: %.3f files/s, '
+                    '%.3f GB/s' % (completed, completed_bytes / 1e9, elapsed,
+                                   completed / elapsed,
+                                   completed_bytes / 1e9 / elapsed))
+
+    if failed:
+        raise Exception('The pipeline failed on %d files: %s'
+                        % (len(failed), ', '.join(str(x) for x in failed)))
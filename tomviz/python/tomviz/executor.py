@@ -320,8 +320,6 @@ class FilesProgress(WriteToFileMixin, JsonProgress):
         with open(file_path, 'w') as f:
             json.dump(data, f)
 
-        return filename
-
 
 def _progress(progress_method, progress_path):
     if progress_method == 'tqdm':
@@ -788,12 +786,18 @@ def load_dataset(data_file_path, read_options=None):
     return data
 
 
+def load_transform_functions(operators, start_at=0):
+    """Load the operator modules of the pipeline from start_at, so that they
+    can be run on several datasets"""
+    return _load_transform_functions(operators[start_at:])
+
+
 def run_pipeline(data, operators, start_at, progress, child_output_path=None,
-                 dataset_dependencies=None):
+                 dataset_dependencies=None, transforms=None):
 
     dims = data.dims
-    operators = operators[start_at:]
-    transforms = _load_transform_functions(operators)
+    if transforms is None:
+        transforms = load_transform_functions(operators, start_at)
 
     operator_index = start_at
     for (label, transform, arguments) in transforms:
@@ -815,7 +819,7 @@ def run_pipeline(data, operators, start_at, progress, child_output_path=None,
 
 def execute(operators, start_at, data_file_path, output_file_path,
             progress_method, progress_path, read_options=None,
-            dataset_dependencies=None):
+            dataset_dependencies=None, transforms=None):
 
     if dataset_dependencies is None:
         dataset_dependencies = {}
@@ -832,7 +836,8 @@ def execute(operators, start_at, data_file_path, output_file_path,
 
         # Run the pipeline
         result = run_pipeline(data, operators, start_at, progress,
-                              child_output_path, dataset_dependencies)
+                              child_output_path, dataset_dependencies,
+                              transforms)
 
         # Now write out the transformed data.
         logger.info('Writing transformed data.')
@@ -5,6 +5,8 @@
 # It is released under the 3-Clause BSD License, see "LICENSE".
 ###############################################################################
 
+import importlib.util
+
 from tomviz._internal import in_application
 from tomviz._internal import require_internal_mode
 from tomviz._internal import with_dataset
@@ -26,6 +28,13 @@ _itkctype_to_python_types = None
 _vtk_to_python_types = None
 
 
+def itk_available():
+    """Whether ITK can be imported. The operators built on ITK filters use
+    them whenever it is: they are the reference, and the native ports of
+    their pipelines only run without ITK."""
+    return importlib.util.find_spec('itk') is not None
+
+
 def vtk_itk_type_map():
     """Set up mappings between VTK image types and available ITK image
     types."""
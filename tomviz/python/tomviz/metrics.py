@@ -0,0 +1,115 @@
+"""Similarity metrics between two arrays of the same shape.
+
+The metrics are computed by the native module when it is available, in one
+parallel pass with no temporary the size of the arrays, and with NumPy and
+scikit-image otherwise. Both return the same values:
+
+- 'mse': the mean squared error
+- 'psnr': the peak signal to noise ratio, in dB
+- 'ncc': the normalized cross-correlation (Pearson correlation coefficient)
+- 'mi': the mutual information, in nats, from a bins x bins joint histogram
+- 'ssim': the mean structural similarity, as
+  skimage.metrics.structural_similarity() computes it with a uniform
+  win_size window
+"""
+import numpy as np
+
+try:
+    from tomviz._native import similarity_metrics as _similarity_metrics
+    from tomviz._native import (
+        slice_similarity_metrics as _slice_similarity_metrics)
+except ImportError:
+    _similarity_metrics = None
+    _slice_similarity_metrics = None
+
+METRICS = ('mse', 'psnr', 'ncc', 'mi', 'ssim')
+
+
+def compare(reference, image, data_range=None, bins=64, win_size=7,
+            normalize=False):
+    """Compare image to reference, returning a dict of the metrics.
+
+    The range of the reference is used for the PSNR and the SSIM when
+    data_range is None. With normalize, each array is first scaled to [0, 1]
+    by its minimum and maximum.
+    """
+    reference = np.asarray(reference)
+    image = np.asarray(image)
+    if reference.shape != image.shape:
+        raise ValueError('The arrays must have the same shape')
+
+    if _similarity_metrics is not None and reference.ndim <= 3:
+        return _similarity_metrics(reference, image, data_range or 0.0, bins,
+                                   win_size, normalize)
+
+    return _compare(reference, image, data_range, bins, win_size, normalize)
+
+
+def compare_slices(reference, image, axis=2, data_range=None, bins=64,
+                   win_size=7, normalize=False):
+    """Compare each pair of slices along axis of two 3D arrays.
+
+    Returns a dict of arrays with one value per slice. The ranges and the
+    normalization are those of each slice.
+    """
+    reference = np.asarray(reference)
+    image = np.asarray(image)
+    if reference.shape != image.shape or reference.ndim != 3:
+        raise ValueError('The arrays must be 3D and have the same shape')
+
+    if _slice_similarity_metrics is not None:
+        # The native module compares the slices along z
+        reference = np.asfortranarray(np.moveaxis(reference, axis, 2),
+                                      dtype=np.float32)
+        image = np.asfortranarray(np.moveaxis(image, axis, 2),
+                                  dtype=np.float32)
+        return _slice_similarity_metrics(reference, image, data_range or 0.0,
+                                         bins, win_size, normalize)
+
+    n = reference.shape[axis]
+    result = {name: np.empty(n) for name in METRICS}
+    for i in range(n):
+        metrics = _compare(np.take(reference, i, axis=axis),
+                           np.take(image, i, axis=axis), data_range, bins,
+                           win_size, normalize)
+        for name in METRICS:
+            result[name][i] = metrics[name]
+    return result
+
+
+def _compare(reference, image, data_range, bins, win_size, normalize):
+    from skimage.metrics import structural_similarity
+
+    reference = reference.astype(np.float64)
+    image = image.astype(np.float64)
+    if normalize:
+        reference = (reference - reference.min()) / np.ptp(reference)
+        image = (image - image.min()) / np.ptp(image)
+    if data_range is None:
+        data_range = np.ptp(reference)
+
+    mse = np.mean((reference - image) ** 2)
+    with np.errstate(divide='ignore'):
+        psnr = 10 * np.log10(data_range ** 2 / mse)
+    ncc = np.corrcoef(reference.ravel(), image.ravel())[0, 1]
+
+    histogram, _, _ = np.histogram2d(reference.ravel(), image.ravel(),
+                                     bins=bins)
+    joint = histogram / histogram.sum()
+    outer = np.outer(joint.sum(axis=1), joint.sum(axis=0))
+    nonzero = joint > 0
+    mi = np.sum(joint[nonzero] * np.log(joint[nonzero] / outer[nonzero]))
+
+    # structural_similarity() needs a window that fits along every axis, so
+    # average it over the axes that are too short, as the native module does
+    long_axes = [i for i, s in enumerate(reference.shape) if s >= win_size]
+    short_axes = [i for i in range(reference.ndim) if i not in long_axes]
+    shape = (-1,) + tuple(reference.shape[i] for i in long_axes)
+    references = np.transpose(reference, short_axes + long_axes)
+    images = np.transpose(image, short_axes + long_axes)
+    ssim = np.mean([
+        structural_similarity(r, i, win_size=win_size, data_range=data_range)
+        for r, i in zip(references.reshape(shape), images.reshape(shape))
+    ])
+
+    return {'mse': mse, 'psnr': psnr, 'ncc': ncc, 'mi': mi, 'ssim': ssim}
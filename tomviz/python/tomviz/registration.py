@@ -0,0 +1,169 @@
+"""Registration of the tilt images of an (Nx, Ny, Nproj) stack on the native
+engine, shared by the alignment operators.
+
+A transform is a 3 x 3 matrix that maps the (x, y) pixel coordinates, along
+the first two axes, of the reference of a tilt image to those of the tilt
+image. Resampling the tilt image through it lines the image up with its
+reference. A translation is the opposite of the offset that
+TranslateAlignOperator, the manual image alignment, applies to the image:
+whole pixel translations are resampled exactly as it shifts the images, the
+other transforms with bilinear interpolation. Outside of the images, the
+resampled values are zero.
+
+The functions that register or resample need the native module. Operators
+check available() and keep their own implementation as the fallback.
+"""
+import json
+
+import numpy as np
+
+from tomviz import utils
+
+try:
+    from tomviz._native import register_pairs as _register_pairs
+    from tomviz._native import warp_images as _warp_images
+except ImportError:
+    _register_pairs = None
+    _warp_images = None
+
+# The pairs are registered in parallel, in batches of this many so that the
+# progress can be reported and the operator canceled between them
+BATCH_SIZE = 16
+
+
+def available():
+    """Whether the native registration engine can be used"""
+    return _register_pairs is not None
+
+
+def registration_pairs(Nproj, reference, ref_slice_index=0):
+    """The (moving, fixed) image pairs to register for a reference: the
+    'previous' image, the 'first', the 'mean' of the images, which follows
+    them in the stack, or the one at 'slice_index'"""
+    if reference == 'previous':
+        return np.array([(i, i - 1) for i in range(1, Nproj)], dtype=np.int32)
+    if reference == 'first':
+        fixed = 0
+    elif reference == 'mean':
+        fixed = Nproj
+    elif reference == 'slice_index':
+        if not 0 <= ref_slice_index < Nproj:
+            raise ValueError(f'Invalid reference slice: {ref_slice_index}')
+        fixed = ref_slice_index
+    else:
+        raise ValueError(f'Unknown reference: {reference}')
+
+    return np.array([(i, fixed) for i in range(Nproj) if i != fixed],
+                    dtype=np.int32)
+
+
+def compose_transforms(matrices, pairs, Nproj, reference):
+    """The transform of every tilt image from those of the registered
+    pairs"""
+    transforms = np.tile(np.eye(3), (Nproj, 1, 1))
+    if reference == 'previous':
+        # Chain the transforms back to the first image
+        for (moving, fixed), matrix in zip(pairs, matrices):
+            transforms[moving] = matrix @ transforms[fixed]
+    else:
+        transforms[pairs[:, 0]] = matrices
+    return transforms
+
+
+def register_stack(images, model='translation', reference='previous',
+                   ref_slice_index=0, metric='ncc', levels=3, operator=None):
+    """The transforms that align the tilt images of a stack to a reference,
+    for a 'translation', 'rigid' or 'affine' model. The progress of operator
+    is updated between the batches of pairs, and None is returned if it is
+    canceled."""
+    images = np.asfortranarray(images, dtype=np.float32)
+    Nproj = images.shape[2]
+    if reference == 'mean':
+        images = np.asfortranarray(np.concatenate(
+            (images, images.mean(axis=2, keepdims=True)), axis=2))
+
+    pairs = registration_pairs(Nproj, reference, ref_slice_index)
+    if operator is not None:
+        operator.progress.maximum = len(pairs)
+        operator.progress.message = 'Registering tilt images'
+
+    matrices = np.empty((len(pairs), 3, 3))
+    for start in range(0, len(pairs), BATCH_SIZE):
+        if operator is not None and operator.canceled:
+            return None
+        end = min(start + BATCH_SIZE, len(pairs))
+        matrices[start:end] = _register_pairs(
+            images, pairs[start:end], model=model, metric=metric,
+            levels=levels)
+        if operator is not None:
+            operator.progress.value = end
+
+    return compose_transforms(matrices, pairs, Nproj, reference)
+
+
+def translations(offsets):
+    """The transforms of TranslateAlignOperator's (X, Y) offsets"""
+    transforms = np.tile(np.eye(3), (len(offsets), 1, 1))
+    transforms[:, :2, 2] = -np.asarray(offsets, dtype=float)
+    return transforms
+
+
+def offsets(transforms):
+    """TranslateAlignOperator's (X, Y) offsets of translations"""
+    return -transforms[:, :2, 2]
+
+
+def is_translation(transforms):
+    return np.allclose(transforms[:, :2, :2], np.eye(2))
+
+
+def warp(array, transforms):
+    """Resample the tilt images of array through their transforms, keeping
+    its type"""
+    warped = _warp_images(array, transforms)
+    if np.issubdtype(array.dtype, np.integer):
+        warped = np.rint(warped)
+    return np.asfortranarray(warped.astype(array.dtype, copy=False))
+
+
+def apply_transforms(dataset, transforms, names=None):
+    """Resample the arrays of dataset with names, all of them by default"""
+    if names is None:
+        names = dataset.scalars_names
+    for name in names:
+        dataset.set_scalars(name, warp(dataset.scalars(name), transforms))
+
+
+def alignments_table(transforms):
+    """The 'alignments' table of the transforms: TranslateAlignOperator's
+    offsets for translations, and the first two rows of the matrices
+    otherwise"""
+    if is_translation(transforms):
+        return utils.make_spreadsheet(['X Offset', 'Y Offset'],
+                                      offsets(transforms))
+    column_names = ['XX', 'XY', 'X Offset', 'YX', 'YY', 'Y Offset']
+    return utils.make_spreadsheet(column_names,
+                                  transforms[:, :2, :].reshape(-1, 6))
+
+
+def save_alignments(path, transforms):
+    """Save the rounded offsets of translations in the JSON format that Load
+    Alignments of the manual image alignment reads, so that they can be
+    reviewed and adjusted there"""
+    rounded = np.rint(offsets(transforms)).astype(int).tolist()
+    with open(path, 'w') as f:
+        json.dump(rounded, f)
+
+
+# pystackreg's matrices map (column, row) coordinates, that is (y, x)
+_SWAP = np.array([[0, 1, 0], [1, 0, 0], [0, 0, 1]], dtype=float)
+
+
+def to_stackreg(transforms):
+    """pystackreg's matrices of transforms"""
+    return _SWAP @ transforms @ _SWAP
+
+
+def from_stackreg(tmats):
+    """The transforms of pystackreg's matrices"""
+    return _SWAP @ np.asarray(tmats, dtype=float) @ _SWAP
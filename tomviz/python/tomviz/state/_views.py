@@ -1,9 +1,13 @@
 from enum import Enum
+import json
+
 from paraview.simple import (
     Render,
     SaveScreenshot
 )
 
+from ._pipeline import PipelineStateManager
+
 
 class Palette(Enum):
     Current = ""
@@ -170,3 +174,13 @@ class View(object):
     @property
     def camera(self):
         return Camera(self._render_view)
+
+    @property
+    def render_statistics(self):
+        """
+        Statistics for the last frame rendered in this view: the frame time,
+        the time, triangles and voxels drawn by each module, and the render
+        quality chosen by the frame budget.
+        """
+        view_id = self._render_view.GetGlobalID()
+        return json.loads(PipelineStateManager().render_statistics(view_id))
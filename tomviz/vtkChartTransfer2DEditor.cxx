@@ -6,13 +6,11 @@
 #include <vtkAxis.h>
 #include <vtkCallbackCommand.h>
 #include <vtkColorTransferFunction.h>
-#include <vtkFloatArray.h>
 #include <vtkImageData.h>
 #include <vtkObjectFactory.h>
 #include <vtkPNGWriter.h>
 #include <vtkPiecewiseFunction.h>
 #include <vtkPlotHistogram2D.h>
-#include <vtkPointData.h>
 #include <vtkRect.h>
 #include <vtkTextProperty.h>
 #include <vtkTransferFunctionBoxItem.h>
@@ -92,32 +90,28 @@ void vtkChartTransfer2DEditor::GenerateTransfer2D()
     return;
   }
 
-  // Update size (match the number of bins of the histogram)
-  int bins[3];
-  Histogram->GetInputImageData()->GetDimensions(bins);
-  Transfer2D->SetDimensions(bins[0], bins[1], 1);
-  Transfer2D->AllocateScalars(VTK_FLOAT, 4);
-
-  // Initialize as fully transparent
-  vtkFloatArray* arr =
-    vtkFloatArray::SafeDownCast(Transfer2D->GetPointData()->GetScalars());
-  void* dataPtr = arr->GetVoidPointer(0);
-  memset(dataPtr, 0, bins[0] * bins[1] * 4 * sizeof(float));
+  // The transfer function matches the number of bins of the histogram
+  Raster.setHistogram(Histogram->GetInputImageData());
 
-  // Raster each box into the 2D table
+  // Update the layer of each box, only the area a box moved over is redrawn
   const vtkIdType numPlots = GetNumberOfPlots();
   for (vtkIdType i = 0; i < numPlots; i++) {
     typedef vtkTransferFunctionBoxItem BoxType;
     auto boxItem = BoxType::SafeDownCast(GetPlot(i));
     if (!boxItem) {
+      Raster.removeBox(i);
       continue;
     }
 
     *this->Transfer2DBox = boxItem->GetBox();
-    vtkTransferFunctionBoxItem::rasterTransferFunction2DBox(
-      Histogram->GetInputImageData(), boxItem->GetBox(), Transfer2D,
-      boxItem->GetColorFunction(), boxItem->GetOpacityFunction());
+    Raster.setBox(i, boxItem->GetBox(), boxItem->GetColorFunction(),
+                  boxItem->GetOpacityFunction());
+  }
+  for (vtkIdType i = numPlots; i < RasteredPlots; i++) {
+    Raster.removeBox(i);
   }
+  RasteredPlots = numPlots;
+  Raster.update(Transfer2D);
 
   InvokeEvent(vtkCommand::EndEvent);
 }
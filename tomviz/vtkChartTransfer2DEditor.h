@@ -23,6 +23,8 @@
 #include <vtkNew.h>
 #include <vtkSmartPointer.h>
 
+#include "TransferFunction2DRaster.h"
+
 class vtkCallbackCommand;
 class vtkImageData;
 class vtkTransferFunctionBoxItem;
@@ -48,11 +50,11 @@ public:
   vtkIdType AddFunction(vtkTransferFunctionBoxItem* boxItem);
 
   /**
-   * Allocates and clears Transfer2D to be updated, the dimensions of the
-   * histogram (e.g. number of bins) are used as dimensions for the transfer
-   * function. Calls Utilities::rasterTransferFunction2DBox for the actual
-   * update. It invokes vtkCommand::EndEvent after the update, this signal
-   * should be caught by handlers using the generated 2DTF.
+   * Updates Transfer2D from the boxes, the dimensions of the histogram (e.g.
+   * number of bins) are used as dimensions for the transfer function. Each box
+   * keeps a layer in a tomviz::TransferFunction2DRaster, so that only the area
+   * a box moved over is redrawn. It invokes vtkCommand::EndEvent after the
+   * update, this signal should be caught by handlers using the generated 2DTF.
    */
   void GenerateTransfer2D();
 
@@ -66,6 +68,8 @@ protected:
   vtkNew<vtkCallbackCommand> Callback;
   vtkRectd* Transfer2DBox;
   vtkRectd DummyBox;
+  tomviz::TransferFunction2DRaster Raster;
+  vtkIdType RasteredPlots = 0;
 
   vtkPlot* GetPlot(vtkIdType index) override;
 
@@ -1953,7 +1953,7 @@ vtkVector3d vtkNonOrthoImagePlaneWidget::PickPointOnSlice(
 }
 
 void vtkNonOrthoImagePlaneWidget::SetVoxelValueFn(
-  std::function<void(const vtkVector3i&, double)> fn)
+  std::function<void(const vtkVector3d&)> fn)
 {
   this->VoxelValueFn = fn;
 }
@@ -1975,13 +1975,8 @@ void vtkNonOrthoImagePlaneWidget::VoxelTimerFired(vtkObject*, unsigned long,
     bool onSlice;
     vtkVector2i displayPos(self->Interactor->GetEventPosition());
     auto pickPoint = self->PickPointOnSlice(displayPos, onSlice);
-    auto data = vtkImageData::SafeDownCast(self->Reslice->GetInput());
-    if (onSlice && data) {
-      vtkVector3i ijk;
-      double scalar = tomviz::getVoxelValue(data, pickPoint, ijk, onSlice);
-      if (onSlice) {
-        self->VoxelValueFn(ijk, scalar);
-      }
+    if (onSlice) {
+      self->VoxelValueFn(pickPoint);
     }
   }
 
@@ -236,9 +236,9 @@ public:
   vtkImageData* GetResliceOutput();
 
   // Description:
-  // Set the callback that is called every time the mouse is moving over the
-  // slice.
-  void SetVoxelValueFn(std::function<void(const vtkVector3i&, double)> fn);
+  // Set the callback that is called with the world coordinates of the point
+  // under the mouse every time it is moving over the slice.
+  void SetVoxelValueFn(std::function<void(const vtkVector3d&)> fn);
 
   // Description:
   // Specify whether to interpolate the texture or not. When off, the
@@ -336,6 +336,10 @@ public:
   vtkGetObjectMacro(ResliceAxes, vtkMatrix4x4)
   vtkGetObjectMacro(Reslice, vtkImageReslice)
 
+  // Description:
+  // Get the actor that draws the resliced image.
+  vtkGetObjectMacro(TexturePlaneActor, vtkActor)
+
   // Description:
   // Enable/disable mouse interaction so the widget remains on display.
   void SetInteraction(int interact);
@@ -429,7 +433,7 @@ protected:
                               void* clientdata, void* calldata);
   vtkNew<vtkCallbackCommand> VoxelTimerCommand;
   int VoxelTimerId = -1;
-  std::function<void(const vtkVector3i&, double)> VoxelValueFn = 0;
+  std::function<void(const vtkVector3d&)> VoxelValueFn = 0;
 
   // internal utility method that adds observers to the RenderWindowInteractor
   // so that our ProcessEvents is eventually called.  this method is called
@@ -9,6 +9,7 @@
 #include "vtkImageData.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 
@@ -16,6 +17,8 @@
 #include "vtk_pugixml.h"
 
 #include <sys/stat.h>
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <algorithm>
@@ -182,6 +185,8 @@ public:
   double OmePhysicalPixelSize[3];
   std::string OmePhysicalPixelUnits[3];
   bool OmeBigEndian;
+  // The width and height of each resolution level, the full one first
+  std::vector<std::array<int, 2>> LevelSizes;
   static void ErrorHandler(const char* module, const char* fmt, va_list ap);
 };
 
@@ -264,6 +269,7 @@ void vtkOMETiffReader::vtkOMETiffReaderInternal::Clean()
     this->OmePhysicalPixelSize[2] = 1;
   this->OmePhysicalPixelUnits[0] = this->OmePhysicalPixelUnits[1] =
     this->OmePhysicalPixelUnits[2] = "um";
+  this->LevelSizes.clear();
 }
 
 //-------------------------------------------------------------------------
@@ -342,6 +348,32 @@ bool vtkOMETiffReader::vtkOMETiffReaderInternal::Initialize()
       TIFFSetDirectory(this->Image, 0);
     }
 
+    // Pyramidal OME-TIFFs store the sub-resolutions of a plane in the
+    // SubIFDs of its page, the largest first.
+    this->LevelSizes.push_back(
+      { { static_cast<int>(this->Width), static_cast<int>(this->Height) } });
+    uint16_t subIFDCount = 0;
+    toff_t* subIFDs = NULL;
+    if (TIFFGetField(this->Image, TIFFTAG_SUBIFD, &subIFDCount, &subIFDs) &&
+        subIFDCount > 0)
+    {
+      // The offsets belong to the current directory, which is about to change
+      std::vector<toff_t> offsets(subIFDs, subIFDs + subIFDCount);
+      for (auto offset : offsets)
+      {
+        unsigned int width, height;
+        if (!TIFFSetSubDirectory(this->Image, offset) ||
+            !TIFFGetField(this->Image, TIFFTAG_IMAGEWIDTH, &width) ||
+            !TIFFGetField(this->Image, TIFFTAG_IMAGELENGTH, &height))
+        {
+          break;
+        }
+        this->LevelSizes.push_back(
+          { { static_cast<int>(width), static_cast<int>(height) } });
+      }
+      TIFFSetDirectory(this->Image, 0);
+    }
+
     this->OmeXmlRaw = new char*[255];
     if (!TIFFGetField(this->Image, TIFFTAG_IMAGEDESCRIPTION, this->OmeXmlRaw))
     {
@@ -372,27 +404,27 @@ bool vtkOMETiffReader::vtkOMETiffReaderInternal::Initialize()
       this->OmeSizeT = pixelNode.attribute("SizeT").as_int();
       if (pixelNode.attribute("PhysicalSizeX")) {
         this->OmePhysicalPixelSize[0] =
-          pixelNode.attribute("PhysicalPixelSizeX").as_float();
+          pixelNode.attribute("PhysicalSizeX").as_float();
       }
       if (pixelNode.attribute("PhysicalSizeY")) {
         this->OmePhysicalPixelSize[1] =
-          pixelNode.attribute("PhysicalPixelSizeY").as_float();
+          pixelNode.attribute("PhysicalSizeY").as_float();
       }
       if (pixelNode.attribute("PhysicalSizeZ")) {
         this->OmePhysicalPixelSize[2] =
-          pixelNode.attribute("PhysicalPixelSizeZ").as_float();
+          pixelNode.attribute("PhysicalSizeZ").as_float();
       }
       if (pixelNode.attribute("PhysicalSizeXUnit")) {
         this->OmePhysicalPixelUnits[0] =
-          pixelNode.attribute("PhysicalPixelSizeXUnit").as_string();
+          pixelNode.attribute("PhysicalSizeXUnit").as_string();
       }
       if (pixelNode.attribute("PhysicalSizeYUnit")) {
         this->OmePhysicalPixelUnits[1] =
-          pixelNode.attribute("PhysicalPixelSizeYUnit").as_string();
+          pixelNode.attribute("PhysicalSizeYUnit").as_string();
       }
       if (pixelNode.attribute("PhysicalSizeZUnit")) {
         this->OmePhysicalPixelUnits[2] =
-          pixelNode.attribute("PhysicalPixelSizeZUnit").as_string();
+          pixelNode.attribute("PhysicalSizeZUnit").as_string();
       }
       this->OmeDimOrder = pixelNode.attribute("DimensionOrder").as_string();
       this->OmeBigEndian = pixelNode.attribute("BigEndian").as_bool();
@@ -488,6 +520,9 @@ vtkOMETiffReader::vtkOMETiffReader()
 
   //Make the default orientation type to be ORIENTATION_BOTLEFT
   this->OrientationType = 4;
+
+  this->ResolutionLevel = 0;
+  this->ActiveResolutionLevel = 0;
 }
 
 //-------------------------------------------------------------------------
@@ -522,6 +557,8 @@ void vtkOMETiffReader::ExecuteInformation()
     this->DataExtent[4] = 0;
     this->DataExtent[5] = 0;
     this->SetNumberOfScalarComponents(1);
+    this->ActiveResolutionLevel = 0;
+    this->ResolutionLevelSizes.clear();
     this->vtkImageReader2::ExecuteInformation();
     return;
   }
@@ -589,6 +626,26 @@ void vtkOMETiffReader::ExecuteInformation()
     this->SetNumberOfScalarComponents(3);
   }
 
+  // The sub-resolutions can only be decoded by region
+  this->ResolutionLevelSizes = this->InternalImage->LevelSizes;
+  this->ActiveResolutionLevel = 0;
+  if (this->ResolutionLevel > 0 && this->CanReadRegion())
+  {
+    this->ActiveResolutionLevel =
+      std::min(this->ResolutionLevel,
+               static_cast<int>(this->ResolutionLevelSizes.size()) - 1);
+  }
+  else if (this->ResolutionLevel > 0)
+  {
+    vtkWarningMacro("Only the full resolution of this image can be read");
+  }
+  if (this->ActiveResolutionLevel > 0)
+  {
+    const auto& size = this->ResolutionLevelSizes[this->ActiveResolutionLevel];
+    this->DataExtent[1] = size[0] - 1;
+    this->DataExtent[3] = size[1] - 1;
+  }
+
   this->vtkImageReader2::ExecuteInformation();
   // Don't close the file yet, since we need the image internal
   // parameters such as NumberOfPages, NumberOfTiles to decide
@@ -615,27 +672,31 @@ void vtkOMETiffReader::Process2(OT *outPtr, int *)
 template <class OT>
 void vtkOMETiffReader::Process(OT *outPtr, int outExtent[6], vtkIdType outIncr[3])
 {
-  // multiple number of pages
-  if (this->InternalImage->NumberOfPages > 1)
+  // tiled images, volumes and sub-resolutions that can be decoded straight
+  // into the output extent
+  if ((this->InternalImage->NumberOfPages > 1 ||
+       this->InternalImage->NumberOfTiles > 0 ||
+       this->ActiveResolutionLevel > 0) &&
+      this->CanReadRegion())
   {
-    this->ReadVolume(outPtr);
+    this->ReadRegion(outPtr);
     // close the TIFF file
     this->InternalImage->Clean();
     return;
   }
 
-  // tiled image
-  if (this->InternalImage->NumberOfTiles > 0)
+  // multiple number of pages
+  if (this->InternalImage->NumberOfPages > 1)
   {
-    this->ReadTiles(outPtr);
+    this->ReadVolume(outPtr);
     // close the TIFF file
     this->InternalImage->Clean();
     return;
   }
 
   // The input tiff dataset is neither multiple pages and nor
-  // tiled. Hence close the image and start reading each TIFF
-  // file
+  // tiled, or is tiled in a format only read whole as RGBA. Hence close
+  // the image and start reading each TIFF file
   this->InternalImage->Clean();
 
   OT *outPtr2 = outPtr;
@@ -668,6 +729,22 @@ void vtkOMETiffReader::ExecuteDataWithInformation(vtkDataObject *output,
 
   this->ComputeDataIncrements();
 
+  // Processing closes the file, taking the OME metadata with it
+  double spacing[3];
+  std::string units[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    spacing[i] = this->InternalImage->OmePhysicalPixelSize[i];
+    units[i] = this->InternalImage->OmePhysicalPixelUnits[i];
+  }
+  if (this->ActiveResolutionLevel > 0)
+  {
+    const auto& full = this->ResolutionLevelSizes[0];
+    const auto& size = this->ResolutionLevelSizes[this->ActiveResolutionLevel];
+    spacing[0] *= static_cast<double>(full[0]) / size[0];
+    spacing[1] *= static_cast<double>(full[1]) / size[1];
+  }
+
   // Get the data
   vtkImageData *data = this->AllocateOutputData(output, outInfo);
   data->GetExtent(this->OutputExtent);
@@ -689,16 +766,16 @@ void vtkOMETiffReader::ExecuteDataWithInformation(vtkDataObject *output,
     fd = vtkSmartPointer<vtkFieldData>::New();
     data->SetFieldData(fd);
   }
-  vtkSmartPointer<vtkStringArray> units =
+  vtkSmartPointer<vtkStringArray> unitsArray =
     vtkSmartPointer<vtkStringArray>::New();
-  units->SetName("units");
-  units->SetNumberOfValues(3);
-  units->SetValue(0, this->InternalImage->OmePhysicalPixelUnits[0]);
-  units->SetValue(1, this->InternalImage->OmePhysicalPixelUnits[1]);
-  units->SetValue(2, this->InternalImage->OmePhysicalPixelUnits[2]);
-  fd->AddArray(units);
-
-  data->SetSpacing(this->InternalImage->OmePhysicalPixelSize);
+  unitsArray->SetName("units");
+  unitsArray->SetNumberOfValues(3);
+  unitsArray->SetValue(0, units[0]);
+  unitsArray->SetValue(1, units[1]);
+  unitsArray->SetValue(2, units[2]);
+  fd->AddArray(unitsArray);
+
+  data->SetSpacing(spacing);
 }
 
 //----------------------------------------------------------------------------
@@ -922,136 +999,223 @@ void vtkOMETiffReader::ReadVolume(T* buffer)
   }
 }
 
-/** Read a tiled tiff */
-void vtkOMETiffReader::ReadTiles(void* buffer)
+//-------------------------------------------------------------------------
+bool vtkOMETiffReader::CanReadRegion()
+{
+  if (!this->InternalImage->CanRead())
+  {
+    return false;
+  }
+
+  // The samples are copied as they are stored, which needs them interleaved
+  // and in whole bytes. Planar or sub-byte images go through the full reader.
+  const unsigned short bits = this->InternalImage->BitsPerSample;
+  if (this->InternalImage->PlanarConfig != PLANARCONFIG_CONTIG ||
+      (bits != 8 && bits != 16 && bits != 32))
+  {
+    return false;
+  }
+
+  switch (this->GetFormat())
+  {
+    case vtkOMETiffReader::GRAYSCALE:
+      return this->InternalImage->Photometrics == PHOTOMETRIC_MINISBLACK &&
+             this->InternalImage->SamplesPerPixel == 1;
+    case vtkOMETiffReader::RGB:
+      return this->InternalImage->SamplesPerPixel == 3;
+    default:
+      return false;
+  }
+}
+
+//-------------------------------------------------------------------------
+void vtkOMETiffReader::ReadRegion(void* buffer)
 {
-  unsigned char* volume =
-    reinterpret_cast<unsigned char*>(buffer);
-  unsigned char *tile
-    = new unsigned char[TIFFTileSize(this->InternalImage->Image)];
-
-  const unsigned int width = this->InternalImage->Width;
-  const unsigned int height = this->InternalImage->Height;
-  const unsigned int tileWidth = this->InternalImage->TileWidth;
-  const unsigned int tileHeight = this->InternalImage->TileHeight;
-  const unsigned int pixelSize = this->InternalImage->SamplesPerPixel;
-  const bool rowMultiple = (height % tileHeight == 0 ) ? true : false;
-  const bool colMultiple = (width % tileWidth == 0 ) ? true : false;
-  const bool flip = this->InternalImage->Orientation != ORIENTATION_TOPLEFT;
-
-  for (unsigned int slice = 0; slice < this->InternalImage->NumberOfPages;
-       ++slice)
-  {
-    for (unsigned int row = 0;
-         row < (rowMultiple ? height : height - tileHeight);
-         row += tileHeight)
+  if (!this->InternalImage->Image &&
+      !this->InternalImage->Open(this->InternalFileName))
+  {
+    vtkErrorMacro(<< "Cannot open " << this->InternalFileName);
+    return;
+  }
+  TIFF* image = this->InternalImage->Image;
+  const int* extent = this->OutputExtent;
+  const int level = this->ActiveResolutionLevel;
+
+  // Find the directories of the slices in the output extent, by offset so
+  // that every thread can seek to them directly. The pages of other subfile
+  // types are not slices.
+  std::vector<toff_t> directories;
+  int slice = 0;
+  if (!TIFFSetDirectory(image, 0))
+  {
+    vtkErrorMacro(<< "Cannot read the first page");
+    return;
+  }
+  do
+  {
+    uint32_t subfiletype = 0;
+    if (this->InternalImage->SubFiles > 0 &&
+        TIFFGetField(image, TIFFTAG_SUBFILETYPE, &subfiletype) &&
+        subfiletype != 0)
     {
-      const unsigned int r = flip ? height - row - tileHeight : row;
-      for (unsigned int col = 0;
-           col < (colMultiple ? width : width - tileWidth);
-           col += tileWidth)
-      {
-        if (TIFFReadTile(this->InternalImage->Image, tile, col, r, slice, 0) < 0)
-        {
-          vtkErrorMacro(<< "Cannot read tile : "<< r << "," << col << " from file");
-          delete [] tile;
-          return;
-        }
-        // Currently not using tile depth
-        unsigned int zz = 0;
-        for (unsigned int yy = 0; yy < tileHeight; ++yy)
-        {
-          const unsigned int y = flip ? tileHeight + height % tileHeight - yy - 1 : yy;
-          memcpy (
-            volume + (((slice + zz) * height + row + y) * width + col) * pixelSize,
-            tile + (zz * tileHeight + yy) * tileWidth * pixelSize,
-            tileWidth * pixelSize);
-        }
-      }
+      continue;
     }
-  }
-    // Fill the boundaries
-    if (!colMultiple)
+    if (slice >= extent[4])
     {
-      const unsigned int lenx = width % tileWidth;
-      const unsigned int col = width - lenx;
-      const unsigned int tilexWidth = lenx;
-      for (unsigned int row = 0;
-           row < (rowMultiple ? height : height - tileHeight);
-           row += tileHeight)
+      toff_t offset = TIFFCurrentDirOffset(image);
+      if (level > 0)
       {
-        const unsigned int r = flip ? height - row - tileHeight - 1 : row;
-        if (TIFFReadTile(this->InternalImage->Image, tile, col, r, 0, 0) < 0)
+        uint16_t subIFDCount = 0;
+        toff_t* subIFDs = NULL;
+        if (!TIFFGetField(image, TIFFTAG_SUBIFD, &subIFDCount, &subIFDs) ||
+            subIFDCount < level)
         {
-          vtkErrorMacro(<< "Cannot read tile : "<< r << "," << col << " from file");
-          delete [] tile;
+          vtkErrorMacro(<< "Slice " << slice << " has no resolution level "
+                        << level);
           return;
         }
-        const unsigned int zz = 0;
-        for (unsigned int yy = 0; yy < tileHeight; ++yy)
-        {
-          const unsigned int y = flip ? tileHeight + height % tileHeight - yy - 1 : yy;
-          memcpy (
-            volume + (((0 + zz) * height + row + y) * width + col) * pixelSize,
-            tile + (zz * tileHeight + yy) * tileWidth * pixelSize,
-            tilexWidth * pixelSize);
-        }
+        offset = subIFDs[level - 1];
       }
+      directories.push_back(offset);
     }
-    if (!rowMultiple)
+    ++slice;
+  } while (slice <= extent[5] && TIFFReadDirectory(image));
+
+  if (static_cast<int>(directories.size()) != extent[5] - extent[4] + 1)
+  {
+    vtkErrorMacro(<< "The file has fewer pages than slices");
+    return;
+  }
+
+  // Strips are decoded as tiles as wide as the image
+  uint32_t width = 0;
+  uint32_t height = 0;
+  if (!TIFFSetSubDirectory(image, directories[0]) ||
+      !TIFFGetField(image, TIFFTAG_IMAGEWIDTH, &width) ||
+      !TIFFGetField(image, TIFFTAG_IMAGELENGTH, &height))
+  {
+    vtkErrorMacro(<< "Cannot read the size of resolution level " << level);
+    return;
+  }
+  const bool tiled = TIFFIsTiled(image) != 0;
+  uint32_t tileWidth = width;
+  uint32_t tileHeight = height;
+  if (tiled)
+  {
+    TIFFGetField(image, TIFFTAG_TILEWIDTH, &tileWidth);
+    TIFFGetField(image, TIFFTAG_TILELENGTH, &tileHeight);
+  }
+  else
+  {
+    TIFFGetFieldDefaulted(image, TIFFTAG_ROWSPERSTRIP, &tileHeight);
+    tileHeight = std::min(tileHeight, height);
+  }
+  const tmsize_t tileSize = tiled ? TIFFTileSize(image) : TIFFStripSize(image);
+  if (tileWidth == 0 || tileHeight == 0 || tileSize <= 0)
+  {
+    vtkErrorMacro(<< "Cannot read the tile size of resolution level "
+                  << level);
+    return;
+  }
+
+  // The rows of the file the output rows come from
+  const bool flip =
+    this->InternalImage->Orientation != ORIENTATION_TOPLEFT;
+  const int firstRow = flip ? height - 1 - extent[3] : extent[2];
+  const int lastRow = flip ? height - 1 - extent[2] : extent[3];
+
+  // Only the tiles intersecting the output extent are decoded, numbered as
+  // libtiff numbers the tiles of contiguous samples
+  struct Tile
+  {
+    int slice;
+    uint32_t index;
+  };
+  const uint32_t across = (width + tileWidth - 1) / tileWidth;
+  std::vector<Tile> tiles;
+  for (int z = 0; z < static_cast<int>(directories.size()); ++z)
+  {
+    for (uint32_t ty = firstRow / tileHeight; ty <= lastRow / tileHeight;
+         ++ty)
     {
-      const unsigned int leny = height % tileHeight;
-      const unsigned int row = height - leny;
-      const unsigned int r = flip ? 0 : row;
-      for (unsigned int col = 0;
-           col < (colMultiple ? width : width - tileWidth);
-           col += tileWidth)
+      for (uint32_t tx = extent[0] / tileWidth; tx <= extent[1] / tileWidth;
+           ++tx)
       {
-        if (TIFFReadTile(this->InternalImage->Image, tile, col, row, 0, 0) < 0)
-        {
-          vtkErrorMacro(<< "Cannot read tile : "<< r << "," << col << " from file");
-          delete [] tile;
-          return;
-        }
-        const unsigned int zz = 0;
-        for (unsigned int yy = 0; yy < leny; ++yy)
-        {
-          const unsigned int y = flip ? leny - yy - 1 : yy;
-          memcpy (
-            volume + (((0 + zz) * height + r + y) * width + col) * pixelSize,
-            tile + (zz * tileHeight + yy) * tileWidth * pixelSize,
-            tileWidth * pixelSize);
-        }
+        tiles.push_back({ z, ty * across + tx });
       }
     }
-    if (!colMultiple && !rowMultiple)
-    {
-      const unsigned int lenx = width % tileWidth;
-      const unsigned int col = width - lenx;
-
-      const unsigned int leny = height % tileHeight;
-      const unsigned int row = height - leny;
-      const unsigned int tilexWidth = lenx;
+  }
 
-      const unsigned int r = flip ? 0 : row;
-      if (TIFFReadTile(this->InternalImage->Image, tile, col, row, 0, 0) < 0)
+  const int sampleSize = this->InternalImage->BitsPerSample / 8;
+  const int pixelSize = sampleSize * this->InternalImage->SamplesPerPixel;
+  const vtkIdType* increments = this->OutputIncrements;
+  auto* out = static_cast<unsigned char*>(buffer);
+  const std::string fileName = this->InternalFileName;
+  std::atomic<bool> failed(false);
+
+  vtkSMPTools::For(
+    0, static_cast<vtkIdType>(tiles.size()),
+    [&](vtkIdType first, vtkIdType last) {
+      // A TIFF handle cannot be shared between threads
+      TIFF* tiff = TIFFOpen(fileName.c_str(), "r");
+      if (!tiff)
       {
-        vtkErrorMacro(<< "Cannot read tile : "<< r << "," << col << " from file");
-        delete [] tile;
+        failed = true;
         return;
       }
-      const unsigned int zz = 0;
-      unsigned int y;
-      for (unsigned int yy = 0; yy < leny; ++yy)
+      std::vector<unsigned char> data(tileSize);
+      int current = -1;
+      for (vtkIdType i = first; i < last && !failed; ++i)
       {
-        y = flip ? leny - yy - 1 : yy;
-        memcpy (
-          volume + (((0 + zz) * height + r + y) * width + col) * pixelSize,
-          tile + (zz * tileHeight + yy) * tileWidth * pixelSize,
-          tilexWidth * pixelSize);
+        const Tile& tile = tiles[i];
+        if (tile.slice != current)
+        {
+          if (!TIFFSetSubDirectory(tiff, directories[tile.slice]))
+          {
+            failed = true;
+            break;
+          }
+          current = tile.slice;
+        }
+        tmsize_t size =
+          tiled ? TIFFReadEncodedTile(tiff, tile.index, data.data(), tileSize)
+                : TIFFReadEncodedStrip(tiff, tile.index, data.data(),
+                                       tileSize);
+        if (size < 0)
+        {
+          failed = true;
+          break;
+        }
+
+        // Copy the part of every row of the tile within the output extent,
+        // the tiles on the right and bottom edges being padded
+        const int x0 = (tile.index % across) * tileWidth;
+        const int y0 = (tile.index / across) * tileHeight;
+        const int begin = std::max(x0, extent[0]);
+        const int end = std::min<int>(x0 + tileWidth, extent[1] + 1);
+        const int rowEnd =
+          std::min(std::min<int>(y0 + tileHeight, height), lastRow + 1);
+        for (int fileRow = std::max(y0, firstRow); fileRow < rowEnd;
+             ++fileRow)
+        {
+          const int row = flip ? height - 1 - fileRow : fileRow;
+          std::memcpy(out + (tile.slice * increments[2] +
+                             (row - extent[2]) * increments[1] +
+                             (begin - extent[0]) * increments[0]) *
+                              sampleSize,
+                      data.data() +
+                        ((fileRow - y0) * tileWidth + begin - x0) * pixelSize,
+                      (end - begin) * pixelSize);
+        }
       }
-    }
-  delete [] tile;
+      TIFFClose(tiff);
+    });
+
+  if (failed)
+  {
+    vtkErrorMacro(<< "Cannot read the tiles of " << fileName);
+  }
+  this->UpdateProgress(1.0);
 }
 
 /** To Support Zeiss images that contains only 2 samples per pixel but are actually
@@ -1455,6 +1619,25 @@ int vtkOMETiffReader::EvaluateImageAt(T* out, T* in)
   }
 }
 
+//-------------------------------------------------------------------------
+int vtkOMETiffReader::GetNumberOfResolutionLevels()
+{
+  return std::max(1, static_cast<int>(this->ResolutionLevelSizes.size()));
+}
+
+//-------------------------------------------------------------------------
+void vtkOMETiffReader::GetResolutionLevelDimensions(int level, int dims[3])
+{
+  dims[0] = dims[1] = dims[2] = 0;
+  if (level < 0 || level >= static_cast<int>(this->ResolutionLevelSizes.size()))
+  {
+    return;
+  }
+  dims[0] = this->ResolutionLevelSizes[level][0];
+  dims[1] = this->ResolutionLevelSizes[level][1];
+  dims[2] = this->DataExtent[5] - this->DataExtent[4] + 1;
+}
+
 //-------------------------------------------------------------------------
 int vtkOMETiffReader::CanReadFile(const char* fname)
 {
@@ -1476,5 +1659,6 @@ void vtkOMETiffReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "OrientationTypeSpecifiedFlag: " << this->OrientationTypeSpecifiedFlag << std::endl;
   os << indent << "OriginSpecifiedFlag: " << this->OriginSpecifiedFlag << std::endl;
   os << indent << "SpacingSpecifiedFlag: " << this->SpacingSpecifiedFlag << std::endl;
+  os << indent << "ResolutionLevel: " << this->ResolutionLevel << std::endl;
 }
 }
@@ -6,6 +6,9 @@
 
 #include "vtkImageReader2.h"
 
+#include <array>
+#include <vector>
+
 namespace tomviz
 {
 
@@ -35,6 +38,25 @@ public:
    */
   const char* GetDescriptiveName() override { return "TIFF"; }
 
+  /**
+   * The resolution level of a pyramidal OME-TIFF to read, 0 being the full
+   * resolution and each level after it a sub-resolution stored in the
+   * SubIFDs of the pages. Levels past the last one read the last one.
+   */
+  vtkSetClampMacro(ResolutionLevel, int, 0, VTK_INT_MAX);
+  vtkGetMacro(ResolutionLevel, int);
+
+  /**
+   * The number of resolution levels of the file, 1 when it is not a
+   * pyramid. Valid after UpdateInformation().
+   */
+  int GetNumberOfResolutionLevels();
+
+  /**
+   * The dimensions of a resolution level. Valid after UpdateInformation().
+   */
+  void GetResolutionLevelDimensions(int level, int dims[3]);
+
 protected:
   vtkOMETiffReader();
   ~vtkOMETiffReader() override;
@@ -86,9 +108,16 @@ private:
   void ReadVolume(T* buffer);
 
   /**
-   * Reads 3D data from tiled tiff
+   * Whether the pages can be decoded straight into the output, a tile or
+   * strip at a time.
+   */
+  bool CanReadRegion();
+
+  /**
+   * Reads the output extent of the resolution level, decoding only the
+   * tiles or strips of the pages it intersects, in parallel.
    */
-  void ReadTiles(void* buffer);
+  void ReadRegion(void* buffer);
 
   /**
    * Reads a generic image.
@@ -122,6 +151,10 @@ private:
   bool OrientationTypeSpecifiedFlag;
   bool OriginSpecifiedFlag;
   bool SpacingSpecifiedFlag;
+  int ResolutionLevel;
+  // The level being read, 0 when the pages cannot be read by region
+  int ActiveResolutionLevel;
+  std::vector<std::array<int, 2>> ResolutionLevelSizes;
 };
 
 }
@@ -15,10 +15,13 @@
 #include <vtkPiecewiseFunction.h>
 #include <vtkPointData.h>
 #include <vtkPoints2D.h>
+#include <vtkSMPTools.h>
 #include <vtkTransform2D.h>
 #include <vtkUnsignedCharArray.h>
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace {
 inline bool PointIsWithinBounds2D(double point[2], double bounds[4],
@@ -591,11 +594,19 @@ void vtkTransferFunctionBoxItem::rasterTransferFunction2DBox(
   double range[2];
   colorFunc->GetRange(range);
 
-  double* dataRGB = new double[width * 3];
-  colorFunc->GetTable(range[0], range[1], width, dataRGB);
-
-  double* dataAlpha = new double[width];
-  opacFunc->GetTable(range[0], range[1], width, dataAlpha);
+  std::vector<float> row(width * 4);
+  {
+    std::vector<double> dataRGB(width * 3);
+    colorFunc->GetTable(range[0], range[1], width, dataRGB.data());
+    std::vector<double> dataAlpha(width);
+    opacFunc->GetTable(range[0], range[1], width, dataAlpha.data());
+    for (vtkIdType i = 0; i < width; i++) {
+      row[i * 4] = static_cast<float>(dataRGB[i * 3]);
+      row[i * 4 + 1] = static_cast<float>(dataRGB[i * 3 + 1]);
+      row[i * 4 + 2] = static_cast<float>(dataRGB[i * 3 + 2]);
+      row[i * 4 + 3] = static_cast<float>(dataAlpha[i]);
+    }
+  }
 
   // Copy the values into Transfer2D
   vtkFloatArray* transfer =
@@ -608,19 +619,13 @@ void vtkTransferFunctionBoxItem::rasterTransferFunction2DBox(
   width = vtkMath::ClampValue(width, static_cast<vtkIdType>(0), bins[0] - x0);
   height = vtkMath::ClampValue(height, static_cast<vtkIdType>(0), bins[1] - y0);
 
-  for (vtkIdType j = 0; j < height; j++)
-    for (vtkIdType i = 0; i < width; i++) {
-      double color[4];
-
-      color[0] = dataRGB[i * 3];
-      color[1] = dataRGB[i * 3 + 1];
-      color[2] = dataRGB[i * 3 + 2];
-      color[3] = dataAlpha[i];
-
-      const vtkIdType index = (y0 + j) * bins[1] + (x0 + i);
-      transfer->SetTuple(index, color);
+  // Every row of the box is the same, copy it row by row across threads
+  float* data = transfer->GetPointer(0);
+  vtkSMPTools::For(0, height, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType j = begin; j < end; j++) {
+      std::copy(row.begin(), row.begin() + width * 4,
+                data + ((y0 + j) * bins[0] + x0) * 4);
     }
-
-  delete[] dataRGB;
-  delete[] dataAlpha;
+  });
+  transfer->Modified();
 }